@@ -0,0 +1,93 @@
+#
+# Copyright (c) 2025 Huawei Technologies Co., Ltd.
+# This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+# CANN Open Software License Agreement Version 2.0 (the "License").
+# Please refer to the License for details. You may not use this file except in compliance with the License.
+# THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+# INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+# See LICENSE in the root of the software repository for the full text of the License.
+#
+"""Compare rdma_perftest suite results against a stored baseline and flag regressions.
+
+Usage: python3 compare_results.py <baseline.csv|json> <current.csv|json> [--threshold PERCENT]
+
+Rows are matched on (test, pattern, ranks, size). A latency that grows, or a bandwidth that drops, by more than
+the threshold is a regression, as is any row with delivery errors. Exits 1 when a regression is found.
+"""
+
+import argparse
+import csv
+import json
+import sys
+
+KEY_FIELDS = ("test", "pattern", "ranks", "size")
+
+
+def load_results(path):
+    if path.endswith(".json"):
+        with open(path) as f:
+            rows = json.load(f)
+    else:
+        with open(path, newline="") as f:
+            rows = list(csv.DictReader(f))
+    results = {}
+    for row in rows:
+        key = (row["test"], row["pattern"], int(row["ranks"]), int(row["size"]))
+        results[key] = {"metric": row["metric"], "value": float(row["value"]), "errors": int(row["errors"])}
+    return results
+
+
+def change_percent(metric, base, cur):
+    """Signed change in percent, positive when the current result is worse than the baseline."""
+    if base == 0:
+        return 0.0
+    if metric == "bandwidth_gbps":
+        return (base - cur) / base * 100.0
+    return (cur - base) / base * 100.0
+
+
+def compare(baseline, current, threshold):
+    regressions = []
+    lines = []
+    for key in sorted(current):
+        cur = current[key]
+        base = baseline.get(key)
+        name = "%s/%s/%d ranks/%d B" % key
+        if base is None:
+            lines.append("%-48s %14.3f %14s %9s  new" % (name, cur["value"], "-", "-"))
+            continue
+        change = change_percent(cur["metric"], base["value"], cur["value"])
+        status = "ok"
+        if cur["errors"] != 0:
+            status = "ERRORS"
+        elif change > threshold:
+            status = "REGRESSION"
+        if status != "ok":
+            regressions.append(key)
+        lines.append("%-48s %14.3f %14.3f %+8.1f%%  %s" % (name, cur["value"], base["value"], change, status))
+    for key in sorted(set(baseline) - set(current)):
+        lines.append("%-48s %14s %14.3f %9s  missing" % ("%s/%s/%d ranks/%d B" % key, "-", baseline[key]["value"], "-"))
+    return lines, regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flag rdma_perftest regressions against a baseline.")
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="tolerated slowdown in percent before a row is flagged, default 10")
+    args = parser.parse_args()
+
+    lines, regressions = compare(load_results(args.baseline), load_results(args.current), args.threshold)
+    print("%-48s %14s %14s %9s  %s" % ("# test/pattern/ranks/size", "current", "baseline", "worse", "status"))
+    for line in lines:
+        print(line)
+    if regressions:
+        print("[ERROR] %d regression(s) beyond %.1f%%" % (len(regressions), args.threshold))
+        return 1
+    print("[SUCCESS] no regression beyond %.1f%%" % args.threshold)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -8,6 +8,7 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <cstdlib>
 #include <string>
@@ -19,6 +20,7 @@
 #include "acl/acl.h"
 #include "shmem_api.h"
 #include "shmemi_host_common.h"
+#include "perftest_report.h"
 
 int g_npus = 8;
 const char *ipport;
@@ -29,7 +31,22 @@ const char *test_type;
 extern void rdma_highlevel_put_pingpong_latency_do(uint32_t block_dim, void* st, uint64_t cfg, uint8_t* gva, int len);
 extern void rdma_postsend_cost_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int len);
 extern void rdma_highlevel_put_bw_do(uint32_t block_dim, void* stream, uint64_t cfg, uint8_t* gva, int len);
+extern void rdma_batch_put_bw_do(uint32_t block_dim, void* stream, uint64_t cfg, uint8_t* gva, int len);
 extern void rdma_mte_put_bw_do(uint32_t block_dim, void* stream, uint64_t cfg, uint8_t* gva, int len, int64_t iter);
+extern void signal_pingpong_latency_do(uint32_t block_dim, void* stream, uint64_t cfg, uint8_t* gva, int len,
+    int use_quiet);
+extern void perftest_suite_do(void *stream, uint64_t cfg, uint8_t *gva, uint32_t test, uint32_t pattern,
+    uint64_t msg_len, uint64_t max_len, uint64_t ctrl_off, uint32_t iters, uint32_t warmup);
+
+struct perftest_options {
+    uint32_t pattern = PERFTEST_PAIR;
+    uint32_t iters = 1000;
+    uint32_t warmup = 100;
+    bool roce = false;
+    std::string csv;
+    std::string json;
+    std::vector<uint64_t> sizes;
+};
 
 int test_shmem_rdma_highlevel_put_pingpong_latency(int rank_id, int n_ranks, uint64_t mem_size, int message_length)
 {
@@ -136,7 +153,8 @@ int test_shmem_rdma_postsend_cost(int rank_id, int n_ranks, uint64_t local_mem_s
     return 0;
 }
 
-int test_shmem_rdma_highlevel_put_bw(int rank_id, int n_ranks, uint64_t local_mem_size, int message_length)
+int test_shmem_rdma_highlevel_put_bw(int rank_id, int n_ranks, uint64_t local_mem_size, int message_length,
+    bool batched)
 {
     int32_t device_id = rank_id % g_npus + f_npu;
     int status = 0;
@@ -167,13 +185,17 @@ int test_shmem_rdma_highlevel_put_bw(int rank_id, int n_ranks, uint64_t local_me
     }
     aclrtMemcpy(gva + rank_id * message_length, message_length, xHost, message_length, ACL_MEMCPY_HOST_TO_DEVICE);
 
-    rdma_highlevel_put_bw_do(1, stream, fftsConfig, gva, message_length);
+    if (batched) {
+        rdma_batch_put_bw_do(1, stream, fftsConfig, gva, message_length);
+    } else {
+        rdma_highlevel_put_bw_do(1, stream, fftsConfig, gva, message_length);
+    }
     aclrtSynchronizeStream(stream);
     if (rank_id == 0) {
         aclrtMemcpy(xHost, sizeof(int64_t), gva + message_length * n_ranks, sizeof(int64_t),
             ACL_MEMCPY_DEVICE_TO_HOST);
-        std::cout << "RDMA high level put bandwidth test. Message length = " << message_length
-            << " Byte; time = " << xHost[0] / ration50 << " us." << std::endl;
+        std::cout << "RDMA " << (batched ? "batched" : "high level") << " put bandwidth test. Message length = "
+            << message_length << " Byte; time = " << xHost[0] / ration50 << " us." << std::endl;
     }
 
     aclrtFreeHost(xHost);
@@ -254,40 +276,271 @@ int test_shmem_rdma_mte_put_bw(int rank_id, int n_ranks, uint64_t local_mem_size
     return 0;
 }
 
+int test_shmem_signal_pingpong(int rank_id, int n_ranks, uint64_t local_mem_size, int message_length, bool use_quiet)
+{
+    int32_t device_id = rank_id % g_npus + f_npu;
+    int status = 0;
+    aclrtStream stream = nullptr;
+    const double ration50 = 50.0;
+    const int iterations = 1000;
+    const int cachelines = 4 + 32;  // signal, stamp, results, then the local working set of the kernel
+    const int size6M = 6 * 1024 * 1024;
+
+    status = aclInit(nullptr);
+    status = aclrtSetDevice(device_id);
+    status = aclrtCreateStream(&stream);
+
+    // MTE transport, the ordering cost of shmem_fence and shmem_quiet is what is measured
+    shmem_init_attr_t *attributes;
+    status = shmem_set_attr(rank_id, n_ranks, local_mem_size, ipport, &attributes);
+    shmem_set_conf_store_tls(false, nullptr, 0);
+    status = shmem_init_attr(attributes);
+
+    uint64_t fftsConfig = shmemx_get_ffts_config();
+    uint8_t *gva = static_cast<uint8_t*>(shmem_malloc(size6M));
+    size_t total_size = message_length + cachelines * SCALAR_DATA_CACHELINE_SIZE;
+    aclrtMemset(gva, total_size, 0, total_size);
+    shm::shmemi_control_barrier_all();
+
+    signal_pingpong_latency_do(1, stream, fftsConfig, gva, message_length, use_quiet ? 1 : 0);
+    aclrtSynchronizeStream(stream);
+    int64_t result[2] = {0, 0};
+    aclrtMemcpy(result, sizeof(result), gva + message_length + 2 * SCALAR_DATA_CACHELINE_SIZE, sizeof(result),
+        ACL_MEMCPY_DEVICE_TO_HOST);
+    if (rank_id == 0) {
+        std::cout << "Signal pingpong latency test (" << (use_quiet ? "quiet" : "fence") << "). Message length = "
+            << message_length << " Byte; round trip = " << result[0] / ration50 / iterations << " us." << std::endl;
+    }
+    if (result[1] != 0) {
+        std::cout << "[ERROR] rank " << rank_id << " observed " << result[1] << " stale stamps." << std::endl;
+    }
+
+    shmem_free(gva);
+    shmem_finalize();
+    aclrtDestroyStream(stream);
+    aclrtResetDevice(device_id);
+    aclFinalize();
+    return result[1] == 0 ? 0 : -1;
+}
+
+// Partial barrier groups, the pair of each rank, or every rank for many_to_one
+std::vector<uint32_t> perftest_partial_barrier_pes(int rank_id, int n_ranks, uint32_t pattern)
+{
+    std::vector<uint32_t> pes;
+    if (pattern == PERFTEST_MANY_TO_ONE) {
+        for (int r = 0; r < n_ranks; r++) {
+            pes.push_back(static_cast<uint32_t>(r));
+        }
+        return pes;
+    }
+    int half = n_ranks / 2;
+    int partner = rank_id < half ? rank_id + half : rank_id - half;
+    pes.push_back(static_cast<uint32_t>(std::min(rank_id, partner)));
+    pes.push_back(static_cast<uint32_t>(std::max(rank_id, partner)));
+    return pes;
+}
+
+int test_shmem_perftest_suite(int rank_id, int n_ranks, uint64_t local_mem_size, const std::vector<uint32_t> &tests,
+    const perftest_options &opts)
+{
+    if (n_ranks < 2 || (opts.pattern != PERFTEST_MANY_TO_ONE && n_ranks % 2 != 0)) {
+        std::cout << "[ERROR] Pattern " << PERFTEST_PATTERN_NAMES[opts.pattern] << " needs an even number of ranks."
+            << std::endl;
+        return -1;
+    }
+    int32_t device_id = rank_id % g_npus + f_npu;
+    int status = 0;
+    aclrtStream stream = nullptr;
+    const uint64_t heap_margin = 16UL * 1024 * 1024;
+    uint64_t max_len = *std::max_element(opts.sizes.begin(), opts.sizes.end());
+    uint64_t ctrl_off = (max_len * (n_ranks + 1) + PERFTEST_CTRL_ALIGN - 1) / PERFTEST_CTRL_ALIGN *
+        PERFTEST_CTRL_ALIGN;
+    uint64_t buf_size = ctrl_off + PERFTEST_PES_OFF + n_ranks * sizeof(uint32_t);
+    local_mem_size = std::max(local_mem_size, buf_size + heap_margin);
+
+    status = aclInit(nullptr);
+    status = aclrtSetDevice(device_id);
+    status = aclrtCreateStream(&stream);
+
+    shmem_init_attr_t *attributes;
+    status = shmem_set_attr(rank_id, n_ranks, local_mem_size, ipport, &attributes);
+    attributes->option_attr.data_op_engine_type = opts.roce ? SHMEM_DATA_OP_ROCE : SHMEM_DATA_OP_MTE;
+    shmem_set_conf_store_tls(false, nullptr, 0);
+    status = shmem_init_attr(attributes);
+
+    uint64_t fftsConfig = shmemx_get_ffts_config();
+    uint8_t *gva = static_cast<uint8_t*>(shmem_malloc(buf_size));
+    aclrtMemset(gva, max_len, rank_id + 1, max_len);
+    std::vector<uint32_t> pes = perftest_partial_barrier_pes(rank_id, n_ranks, opts.pattern);
+    std::vector<int64_t> result(2);
+    std::vector<int64_t> results(2 * n_ranks);
+    std::vector<perftest_record> records;
+    int64_t errors = 0;
+
+    for (uint32_t test : tests) {
+        // remote atomics and the signal add only exist over MTE, the kernel would trap on a RoCE peer
+        if (opts.roce && (test == PERFTEST_ATOMIC_LAT || test == PERFTEST_PUT_SIGNAL_LAT)) {
+            if (rank_id == 0) {
+                std::cout << "[INFO] Skip " << PERFTEST_TEST_NAMES[test] << ", not supported over RoCE." << std::endl;
+            }
+            continue;
+        }
+        std::vector<uint64_t> sizes = opts.sizes;
+        if (test == PERFTEST_ATOMIC_LAT) {
+            sizes = {sizeof(int64_t)};
+        } else if (test == PERFTEST_BARRIER_LAT || test == PERFTEST_PARTIAL_BARRIER_LAT ||
+            test == PERFTEST_BARRIER_SKEW_LAT) {
+            sizes = {0};
+        }
+        if (rank_id == 0) {
+            perftest_print_header(test, opts.pattern, n_ranks, opts.iters);
+        }
+        for (uint64_t size : sizes) {
+            // counters start from zero, and no rank may launch before every rank has cleared them
+            aclrtMemset(gva + ctrl_off, PERFTEST_PES_OFF, 0, PERFTEST_PES_OFF);
+            aclrtMemcpy(gva + ctrl_off + PERFTEST_PES_OFF, pes.size() * sizeof(uint32_t), pes.data(),
+                pes.size() * sizeof(uint32_t), ACL_MEMCPY_HOST_TO_DEVICE);
+            shm::shmemi_control_barrier_all();
+            perftest_suite_do(stream, fftsConfig, gva, test, opts.pattern, size, max_len, ctrl_off, opts.iters,
+                opts.warmup);
+            aclrtSynchronizeStream(stream);
+            aclrtMemcpy(result.data(), result.size() * sizeof(int64_t), gva + ctrl_off + PERFTEST_RESULT_OFF,
+                result.size() * sizeof(int64_t), ACL_MEMCPY_DEVICE_TO_HOST);
+            shm::shmemi_control_allgather(result.data(), result.size() * sizeof(int64_t), results.data(),
+                results.size() * sizeof(int64_t));
+            perftest_record rec = perftest_summarize(test, opts.pattern, n_ranks, size, opts.iters, results);
+            errors += rec.errors;
+            if (rank_id == 0) {
+                perftest_print_row(rec);
+                records.push_back(rec);
+            }
+        }
+    }
+    if (rank_id == 0 && !opts.csv.empty() && !perftest_write_csv(opts.csv, records)) {
+        std::cout << "[ERROR] Failed to write " << opts.csv << std::endl;
+    }
+    if (rank_id == 0 && !opts.json.empty() && !perftest_write_json(opts.json, records)) {
+        std::cout << "[ERROR] Failed to write " << opts.json << std::endl;
+    }
+    if (errors != 0) {
+        std::cout << "[ERROR] rank " << rank_id << " observed " << errors << " lost or duplicated updates."
+            << std::endl;
+    }
+
+    shmem_free(gva);
+    shmem_finalize();
+    aclrtDestroyStream(stream);
+    aclrtResetDevice(device_id);
+    aclFinalize();
+    return errors == 0 ? 0 : -1;
+}
+
+// Suite options after the positional arguments: --pattern, --iters, --warmup, --roce, --csv, --json
+bool parse_perftest_options(int argc, char *argv[], int first, const char *msg_spec, perftest_options &opts)
+{
+    if (!perftest_parse_sizes(msg_spec, opts.sizes)) {
+        return false;
+    }
+    for (int i = first; i < argc; i++) {
+        std::string opt = argv[i];
+        if (opt == "--roce") {
+            opts.roce = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string value = argv[++i];
+        if (opt == "--pattern") {
+            int32_t pattern = perftest_find(value.c_str(), PERFTEST_PATTERN_NAMES, PERFTEST_PATTERN_NUM);
+            if (pattern < 0) {
+                return false;
+            }
+            opts.pattern = static_cast<uint32_t>(pattern);
+        } else if (opt == "--iters") {
+            opts.iters = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (opt == "--warmup") {
+            opts.warmup = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (opt == "--csv") {
+            opts.csv = value;
+        } else if (opt == "--json") {
+            opts.json = value;
+        } else {
+            return false;
+        }
+    }
+    return opts.iters > 0;
+}
+
 int main(int argc, char *argv[])
 {
     const int expected_argc = 9;
-    if (argc != expected_argc) {
+    if (argc < expected_argc) {
         std::cout << "[ERROR] Paramater number mismatch." << std::endl;
         std::cout << "[USAGE] ./rdma_perftest <n_ranks> <rank_id> <ipport> <g_npus> <f_rank> <f_npu> "
-            << "<test_type> <msg_len>. See README for more details." << std::endl;
+            << "<test_type> <msg_len> [options]. See README for more details." << std::endl;
+        return -1;
     }
     int sub = 1;
     int status = 0;
     int n_ranks = atoi(argv[sub++]);
-    const int rank_max = 2;
-    if (n_ranks != rank_max) {
-        std::cout << "[ERROR] Error number of ranks! Only support 2 ranks!" << std::endl;
-    }
     int rank_id = atoi(argv[sub++]);
-    if (rank_id >= rank_max) {
-        std::cout << "[ERROR] Error rank ID! Only support 2 ranks!" << std::endl;
-    }
     ipport = argv[sub++];
     g_npus = atoi(argv[sub++]);
     f_rank = atoi(argv[sub++]);
     f_npu = atoi(argv[sub++]);
     test_type = argv[sub++];
-    int msg_len = atoi(argv[sub++]);
+    const char *msg_spec = argv[sub++];
+    int msg_len = atoi(msg_spec);
     uint64_t local_mem_size = 1024UL * 1024UL * 64;
+
+    std::vector<uint32_t> suite_tests;
+    if (std::string(test_type) == "suite") {
+        for (uint32_t test = 0; test < PERFTEST_TEST_NUM; test++) {
+            suite_tests.push_back(test);
+        }
+    } else if (perftest_find(test_type, PERFTEST_TEST_NAMES, PERFTEST_TEST_NUM) >= 0) {
+        suite_tests.push_back(static_cast<uint32_t>(perftest_find(test_type, PERFTEST_TEST_NAMES,
+            PERFTEST_TEST_NUM)));
+    }
+    if (!suite_tests.empty()) {
+        perftest_options opts;
+        if (!parse_perftest_options(argc, argv, sub, msg_spec, opts)) {
+            std::cout << "[ERROR] Invalid message sizes or options. See README for more details." << std::endl;
+            return -1;
+        }
+        status = test_shmem_perftest_suite(rank_id, n_ranks, local_mem_size, suite_tests, opts);
+        if (status != 0) {
+            return status;
+        }
+        std::cout << "[SUCCESS] demo run success in rank " << rank_id << std::endl;
+        return 0;
+    }
+
+    const int rank_max = 2;
+    if (n_ranks != rank_max) {
+        std::cout << "[ERROR] Error number of ranks! Only support 2 ranks!" << std::endl;
+    }
+    if (rank_id >= rank_max) {
+        std::cout << "[ERROR] Error rank ID! Only support 2 ranks!" << std::endl;
+    }
     if (std::string(test_type) == "highlevel_put_pingpong_latency") {
         test_shmem_rdma_highlevel_put_pingpong_latency(rank_id, n_ranks, local_mem_size, msg_len);
     } else if (std::string(test_type) == "postsend_cost") {
         test_shmem_rdma_postsend_cost(rank_id, n_ranks, local_mem_size, msg_len);
     } else if (std::string(test_type) == "highlevel_put_bw") {
-        test_shmem_rdma_highlevel_put_bw(rank_id, n_ranks, local_mem_size, msg_len);
+        test_shmem_rdma_highlevel_put_bw(rank_id, n_ranks, local_mem_size, msg_len, false);
+    } else if (std::string(test_type) == "batch_put_bw") {
+        test_shmem_rdma_highlevel_put_bw(rank_id, n_ranks, local_mem_size, msg_len, true);
     } else if (std::string(test_type) == "rdma_mte_bw") {
         test_shmem_rdma_mte_put_bw(rank_id, n_ranks, local_mem_size, msg_len);
+    } else if (std::string(test_type) == "signal_pingpong_fence") {
+        status = test_shmem_signal_pingpong(rank_id, n_ranks, local_mem_size, msg_len, false);
+    } else if (std::string(test_type) == "signal_pingpong_quiet") {
+        status = test_shmem_signal_pingpong(rank_id, n_ranks, local_mem_size, msg_len, true);
+    }
+    if (status != 0) {
+        return status;
     }
 
     std::cout << "[SUCCESS] demo run success in rank " << rank_id << std::endl;
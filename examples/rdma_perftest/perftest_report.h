@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef PERFTEST_REPORT_H
+#define PERFTEST_REPORT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "perftest_suite.h"
+
+/*
+ * Host side of the benchmark suite: names, message size sweep, reduction of the per rank results gathered to
+ * rank 0, and the table, CSV and JSON outputs that compare_results.py reads back.
+ */
+constexpr const char *PERFTEST_TEST_NAMES[PERFTEST_TEST_NUM] = {
+    "put_lat", "get_lat", "put_bw", "get_bw", "put_signal_lat", "atomic_lat", "barrier_lat", "partial_barrier_lat",
+    "alltoallv_lat", "barrier_skew_lat",
+};
+constexpr const char *PERFTEST_PATTERN_NAMES[PERFTEST_PATTERN_NUM] = {"pair", "bidir", "many_to_one"};
+
+struct perftest_record {
+    std::string test;
+    std::string pattern;
+    int32_t ranks;
+    uint64_t size;
+    uint32_t iters;
+    std::string metric;  // latency_us, lower is better, or bandwidth_gbps, higher is better
+    double value;        // mean latency over the measured ranks, or their summed bandwidth
+    double min;          // per rank minimum and maximum of the same metric
+    double max;
+    int64_t errors;      // signals or atomics not delivered exactly once, summed over ranks
+};
+
+inline int32_t perftest_find(const char *name, const char *const *names, int32_t num)
+{
+    for (int32_t i = 0; i < num; i++) {
+        if (name == std::string(names[i])) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+inline bool perftest_is_bw(uint32_t test)
+{
+    return test == PERFTEST_PUT_BW || test == PERFTEST_GET_BW;
+}
+
+inline bool perftest_is_collective(uint32_t test)
+{
+    return test == PERFTEST_BARRIER_LAT || test == PERFTEST_PARTIAL_BARRIER_LAT || test == PERFTEST_ALLTOALLV_LAT ||
+        test == PERFTEST_BARRIER_SKEW_LAT;
+}
+
+// Ranks whose timing is reported, the senders of the pattern or every rank for collectives, see perftest_active
+inline bool perftest_measured(uint32_t test, uint32_t pattern, int32_t rank, int32_t n_ranks)
+{
+    if (perftest_is_collective(test)) {
+        return true;
+    }
+    if (pattern == PERFTEST_MANY_TO_ONE) {
+        return rank != 0;
+    }
+    return pattern == PERFTEST_BIDIR || rank < n_ranks / 2;
+}
+
+// "64" or "8:1048576", the sweep doubles from the lower bound up to the upper one
+inline bool perftest_parse_sizes(const std::string &spec, std::vector<uint64_t> &sizes)
+{
+    size_t colon = spec.find(':');
+    char *end = nullptr;
+    uint64_t lo = std::strtoull(spec.c_str(), &end, 10);
+    uint64_t hi = lo;
+    if (colon != std::string::npos) {
+        if (end != spec.c_str() + colon) {
+            return false;
+        }
+        hi = std::strtoull(spec.c_str() + colon + 1, &end, 10);
+    }
+    if (*end != '\0' || lo == 0 || hi < lo || hi > UINT32_MAX) {
+        return false;
+    }
+    sizes.clear();
+    for (uint64_t size = lo; size < hi; size *= 2) {
+        sizes.push_back(size);
+    }
+    sizes.push_back(hi);
+    return true;
+}
+
+// results holds {elapsed cycles, errors} of every rank in rank order
+inline perftest_record perftest_summarize(uint32_t test, uint32_t pattern, int32_t n_ranks, uint64_t size,
+    uint32_t iters, const std::vector<int64_t> &results)
+{
+    perftest_record rec = {PERFTEST_TEST_NAMES[test], PERFTEST_PATTERN_NAMES[pattern], n_ranks, size, iters,
+        perftest_is_bw(test) ? "bandwidth_gbps" : "latency_us", 0.0, 0.0, 0.0, 0};
+    std::vector<double> values;
+    for (int32_t r = 0; r < n_ranks; r++) {
+        rec.errors += results[r * 2 + 1];
+        if (!perftest_measured(test, pattern, r, n_ranks)) {
+            continue;
+        }
+        double us = static_cast<double>(results[r * 2]) / PERFTEST_CYCLES_PER_US;
+        if (perftest_is_bw(test)) {
+            // bytes per microsecond is MB/s
+            double bytes = static_cast<double>(size) * PERFTEST_WINDOW * iters;
+            values.push_back(us > 0 ? bytes / us / 1000.0 : 0.0);
+        } else {
+            values.push_back(iters > 0 ? us / iters : 0.0);
+        }
+    }
+    if (values.empty()) {
+        return rec;
+    }
+    double sum = 0.0;
+    for (double v : values) {
+        sum += v;
+    }
+    rec.value = perftest_is_bw(test) ? sum : sum / values.size();
+    rec.min = *std::min_element(values.begin(), values.end());
+    rec.max = *std::max_element(values.begin(), values.end());
+    return rec;
+}
+
+inline void perftest_print_header(uint32_t test, uint32_t pattern, int32_t n_ranks, uint32_t iters)
+{
+    // the partial barrier groups follow the pattern, the other collectives involve every rank
+    bool all = test == PERFTEST_BARRIER_LAT || test == PERFTEST_ALLTOALLV_LAT || test == PERFTEST_BARRIER_SKEW_LAT;
+    std::printf("# SHMEM %s, pattern %s, %d ranks, %u iterations\n", PERFTEST_TEST_NAMES[test],
+        all ? "all" : PERFTEST_PATTERN_NAMES[pattern], n_ranks, iters);
+    std::printf("%-12s %16s %14s %14s %8s\n", "# Size", perftest_is_bw(test) ? "Bandwidth(GB/s)" : "Latency(us)",
+        "Min", "Max", "Errors");
+}
+
+inline void perftest_print_row(const perftest_record &rec)
+{
+    std::printf("%-12lu %16.3f %14.3f %14.3f %8ld\n", static_cast<unsigned long>(rec.size), rec.value, rec.min,
+        rec.max, static_cast<long>(rec.errors));
+}
+
+inline bool perftest_write_csv(const std::string &path, const std::vector<perftest_record> &records)
+{
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    out << "test,pattern,ranks,size,iters,metric,value,min,max,errors\n";
+    for (const auto &rec : records) {
+        out << rec.test << ',' << rec.pattern << ',' << rec.ranks << ',' << rec.size << ',' << rec.iters << ','
+            << rec.metric << ',' << rec.value << ',' << rec.min << ',' << rec.max << ',' << rec.errors << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+inline bool perftest_write_json(const std::string &path, const std::vector<perftest_record> &records)
+{
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    out << "[\n";
+    for (size_t i = 0; i < records.size(); i++) {
+        const auto &rec = records[i];
+        out << "  {\"test\": \"" << rec.test << "\", \"pattern\": \"" << rec.pattern << "\", \"ranks\": " << rec.ranks
+            << ", \"size\": " << rec.size << ", \"iters\": " << rec.iters << ", \"metric\": \"" << rec.metric
+            << "\", \"value\": " << rec.value << ", \"min\": " << rec.min << ", \"max\": " << rec.max
+            << ", \"errors\": " << rec.errors << "}" << (i + 1 < records.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+    return static_cast<bool>(out);
+}
+
+#endif  // PERFTEST_REPORT_H
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef PERFTEST_SUITE_H
+#define PERFTEST_SUITE_H
+
+#include <cstdint>
+
+/*
+ * Shared between the host driver and the suite kernel. Symmetric buffer layout, with max_len the largest message
+ * of the sweep and ctrl_off aligned to PERFTEST_CTRL_ALIGN:
+ *   [0, max_len)                            source of every transfer
+ *   [max_len * (1 + r), max_len * (2 + r))  destination slot written by rank r
+ *   ctrl_off + PERFTEST_SIG_OFF              int32 signal counted by put_signal
+ *   ctrl_off + PERFTEST_COUNTER_OFF          int64 counter of the atomic test
+ *   ctrl_off + PERFTEST_RESULT_OFF           int64 {elapsed cycles, errors} of this rank
+ *   ctrl_off + PERFTEST_PES_OFF              uint32 PE list of the partial barrier, n_ranks entries
+ */
+enum perftest_test : uint32_t {
+    PERFTEST_PUT_LAT = 0,
+    PERFTEST_GET_LAT,
+    PERFTEST_PUT_BW,
+    PERFTEST_GET_BW,
+    PERFTEST_PUT_SIGNAL_LAT,
+    PERFTEST_ATOMIC_LAT,
+    PERFTEST_BARRIER_LAT,
+    PERFTEST_PARTIAL_BARRIER_LAT,
+    PERFTEST_ALLTOALLV_LAT,
+    PERFTEST_BARRIER_SKEW_LAT,
+    PERFTEST_TEST_NUM,
+};
+
+// pair: rank r < n/2 sends to r + n/2; bidir: both ranks of a pair send; many_to_one: every rank but 0 sends to 0
+enum perftest_pattern : uint32_t {
+    PERFTEST_PAIR = 0,
+    PERFTEST_BIDIR,
+    PERFTEST_MANY_TO_ONE,
+    PERFTEST_PATTERN_NUM,
+};
+
+constexpr uint32_t PERFTEST_WINDOW = 64;         // nbi transfers between two quiets of the bandwidth tests
+constexpr int64_t PERFTEST_SKEW_CYCLES = 500;    // late arrival of the last rank in barrier_skew_lat, 10us
+constexpr uint64_t PERFTEST_CTRL_ALIGN = 512;
+constexpr uint64_t PERFTEST_SIG_OFF = 0;
+constexpr uint64_t PERFTEST_COUNTER_OFF = 64;
+constexpr uint64_t PERFTEST_RESULT_OFF = 128;
+constexpr uint64_t PERFTEST_PES_OFF = 192;
+constexpr double PERFTEST_CYCLES_PER_US = 50.0;  // system counter runs at 50MHz
+
+#endif  // PERFTEST_SUITE_H
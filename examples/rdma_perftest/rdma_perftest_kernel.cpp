@@ -10,6 +10,7 @@
 #include "kernel_operator.h"
 #include "acl/acl.h"
 #include "shmem_api.h"
+#include "perftest_suite.h"
 
 constexpr uint32_t MAGIC_VAL = 10;
 constexpr uint32_t WARMUP_MSG_LEN = 32;
@@ -163,6 +164,54 @@ void rdma_highlevel_put_bw_do(uint32_t block_dim, void* stream, uint64_t fftsCon
     rdma_highlevel_put_bw<<<1, nullptr, stream>>>(fftsConfig, gva, message_length);
 }
 
+extern "C" __global__ __aicore__ void rdma_batch_put_bw(uint64_t fftsConfig, GM_ADDR gva, int message_length) {
+    shmemx_set_ffts_config(fftsConfig);
+    if (AscendC::GetSubBlockIdx() != 0) {
+        return;
+    }
+    AscendC::TPipe pipe;
+    AscendC::TBuf<AscendC::TPosition::VECOUT> buf;
+    pipe.InitBuffer(buf, UB_ALIGN_SIZE * 2);
+    AscendC::LocalTensor<uint32_t> ubLocal32 = buf.GetWithOffset<uint32_t>(UB_ALIGN_SIZE / sizeof(uint32_t), 0);
+    AscendC::LocalTensor<uint64_t> ubLocal64 =
+        buf.GetWithOffset<uint64_t>(UB_ALIGN_SIZE / sizeof(uint64_t), UB_ALIGN_SIZE);
+
+    int64_t rank = smem_shm_get_global_rank();
+    int64_t rank_size = smem_shm_get_global_rank_size();
+    uint32_t peer;
+
+    // Same traffic as rdma_highlevel_put_bw, posted as one batch with selective signaling
+    GM_ADDR src_addr = gva + rank * message_length;
+    if (rank == 0) {
+        peer = 1;
+        int64_t start = AscendC::GetSystemCycle();
+        shmemi_roce_write_batch((GM_ADDR)shmem_ptr(src_addr, peer), src_addr, peer, 0, message_length, 10000,
+            0, 0, SHMEM_ROCE_SIGNAL_INTERVAL, ubLocal64, ubLocal32);
+        shmemi_roce_quiet(peer, 0, ubLocal64, ubLocal32);
+        shmem_put_uint8_mem_nbi(gva + rank_size * message_length + 8, src_addr, sizeof(uint32_t), peer);
+        while (*(__gm__ uint32_t*)(gva + message_length * rank_size + 16) != peer + MAGIC_VAL) {
+            cacheWriteThrough(gva + message_length * rank_size + 16, 8);
+            AscendC::GetSystemCycle();
+        }
+        AscendC::PipeBarrier<PIPE_ALL>();
+        int64_t end = AscendC::GetSystemCycle();
+        *(__gm__ int64_t*)(gva + message_length * rank_size) = end - start;
+    } else {
+        peer = 0;
+        while (*(__gm__ uint32_t*)(gva + rank_size * message_length + 8) != peer + MAGIC_VAL) {
+            cacheWriteThrough(gva + rank_size * message_length + 8, 8);
+            AscendC::GetSystemCycle();
+        }
+        AscendC::PipeBarrier<PIPE_ALL>();
+        shmem_put_uint8_mem_nbi(gva + message_length * rank_size + 16, src_addr, sizeof(uint32_t), peer);
+    }
+}
+
+void rdma_batch_put_bw_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int message_length)
+{
+    rdma_batch_put_bw<<<1, nullptr, stream>>>(fftsConfig, gva, message_length);
+}
+
 extern "C" __global__ __aicore__ void rdma_mte_put_bw(uint64_t cfg, GM_ADDR gva, int message_length, int64_t iter) {
     shmemx_set_ffts_config(cfg);
     AscendC::LocalTensor<uint32_t> ubLocal32;
@@ -248,4 +297,208 @@ extern "C" __global__ __aicore__ void rdma_mte_put_bw(uint64_t cfg, GM_ADDR gva,
 void rdma_mte_put_bw_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int len, int64_t iter)
 {
     rdma_mte_put_bw<<<2, nullptr, stream>>>(fftsConfig, gva, len, iter);
-}
\ No newline at end of file
+}
+constexpr int32_t SIGNAL_PINGPONG_ITERS = 1000;
+constexpr int32_t SIGNAL_PINGPONG_DIRTY_LINES = 32;
+
+extern "C" __global__ __aicore__ void signal_pingpong_latency(uint64_t cfg, GM_ADDR gva, int message_length,
+    int use_quiet)
+{
+    shmemx_set_ffts_config(cfg);
+    if (AscendC::GetBlockIdx() != 0) {
+        return;
+    }
+
+    int64_t rank = smem_shm_get_global_rank();
+    int peer = rank == 0 ? 1 : 0;
+    // payload, then the signal, a sequence stamp, the results and a local working set on separate cachelines
+    GM_ADDR payload = gva;
+    __gm__ int32_t *sig = (__gm__ int32_t *)(gva + message_length);
+    __gm__ int32_t *stamp = (__gm__ int32_t *)(gva + message_length + SHMEM_DATA_CACHE_LINE_SIZE);
+    __gm__ int64_t *result = (__gm__ int64_t *)(gva + message_length + SHMEM_DATA_CACHE_LINE_SIZE * 2);
+    __gm__ int32_t *work = (__gm__ int32_t *)(gva + message_length + SHMEM_DATA_CACHE_LINE_SIZE * 4);
+    constexpr int32_t work_stride = SHMEM_DATA_CACHE_LINE_SIZE / sizeof(int32_t);
+
+    int64_t errors = 0;
+    int64_t start = AscendC::GetSystemCycle();
+    for (int32_t i = 1; i <= SIGNAL_PINGPONG_ITERS; i++) {
+        if (rank != 0) {
+            shmem_signal_wait_until(sig, SHMEM_CMP_EQ, i);
+            errors += (shmem_int32_g(stamp, rank) != i);
+        }
+        // local state a compute kernel would keep dirty, shmem_quiet writes it back and shmem_fence does not
+        for (int32_t l = 0; l < SIGNAL_PINGPONG_DIRTY_LINES; l++) {
+            work[l * work_stride] = i;
+        }
+        shmem_put_uint8_mem_nbi(payload, payload, message_length, peer);
+        shmemx_int32_p_nbi(stamp, i, peer);
+        if (use_quiet) {
+            shmem_quiet();
+        } else {
+            shmem_fence();
+        }
+        shmemx_signal_op(sig, i, SHMEM_SIGNAL_SET, peer);
+        if (rank == 0) {
+            shmem_signal_wait_until(sig, SHMEM_CMP_EQ, i);
+            errors += (shmem_int32_g(stamp, rank) != i);
+        }
+    }
+    int64_t end = AscendC::GetSystemCycle();
+    result[0] = end - start;
+    result[1] = errors;
+    dcci_cacheline((__gm__ uint8_t *)result);
+}
+
+void signal_pingpong_latency_do(uint32_t block_dim, void* stream, uint64_t cfg, uint8_t* gva, int len, int use_quiet)
+{
+    signal_pingpong_latency<<<1, nullptr, stream>>>(cfg, gva, len, use_quiet);
+}
+
+constexpr int64_t PERFTEST_CHECK_TIMEOUT = 50L * 1000 * 1000;  // 1s of system cycles
+
+// Whether this rank issues transfers under pattern, target receives them, see perftest_suite.h
+__aicore__ inline bool perftest_active(uint32_t pattern, int64_t rank, int64_t rank_size, int64_t &target)
+{
+    int64_t half = rank_size / 2;
+    if (pattern == PERFTEST_MANY_TO_ONE) {
+        target = 0;
+        return rank != 0;
+    }
+    target = rank < half ? rank + half : rank - half;
+    return pattern == PERFTEST_BIDIR || rank < half;
+}
+
+__aicore__ inline int64_t perftest_senders(uint32_t pattern, int64_t rank, int64_t rank_size)
+{
+    if (pattern == PERFTEST_MANY_TO_ONE) {
+        return rank == 0 ? rank_size - 1 : 0;
+    }
+    return (pattern == PERFTEST_BIDIR || rank >= rank_size / 2) ? 1 : 0;
+}
+
+// Every rank sends a different share of msg_len to each peer, at least one byte
+__aicore__ inline void perftest_alltoallv(GM_ADDR src, GM_ADDR dst, uint64_t msg_len, int64_t rank, int64_t rank_size)
+{
+    for (int64_t j = 1; j < rank_size; j++) {
+        int64_t peer = (rank + j) % rank_size;
+        uint64_t bytes = msg_len * (uint64_t)(1 + (rank + peer) % rank_size) / (uint64_t)rank_size;
+        shmem_putmem_nbi(dst, src, bytes > 0 ? (uint32_t)bytes : 1, peer);
+    }
+    shmem_quiet();
+    shmemx_barrier_all_vec();
+}
+
+__aicore__ inline void perftest_step(uint32_t test, bool active, int64_t target, GM_ADDR src, GM_ADDR dst,
+    uint64_t msg_len, GM_ADDR ctrl, uint32_t pes_count, int64_t rank, int64_t rank_size)
+{
+    __gm__ int32_t *sig = (__gm__ int32_t *)(ctrl + PERFTEST_SIG_OFF);
+    __gm__ int64_t *counter = (__gm__ int64_t *)(ctrl + PERFTEST_COUNTER_OFF);
+    uint32_t len = (uint32_t)msg_len;
+    switch (test) {
+        case PERFTEST_PUT_LAT:
+            if (active) {
+                shmem_putmem(dst, src, len, target);
+            }
+            break;
+        case PERFTEST_GET_LAT:
+            if (active) {
+                shmem_getmem(dst, src, len, target);
+            }
+            break;
+        case PERFTEST_PUT_BW:
+        case PERFTEST_GET_BW:
+            if (active) {
+                for (uint32_t w = 0; w < PERFTEST_WINDOW; w++) {
+                    if (test == PERFTEST_PUT_BW) {
+                        shmem_putmem_nbi(dst, src, len, target);
+                    } else {
+                        shmem_getmem_nbi(dst, src, len, target);
+                    }
+                }
+                shmem_quiet();
+            }
+            break;
+        case PERFTEST_PUT_SIGNAL_LAT:
+            if (active) {
+                shmem_putmem_signal(dst, src, msg_len, sig, 1, SHMEM_SIGNAL_ADD, target);
+            }
+            break;
+        case PERFTEST_ATOMIC_LAT:
+            if (active) {
+                shmem_int64_atomic_fetch_add(counter, 1, target);
+            }
+            break;
+        case PERFTEST_BARRIER_LAT:
+            shmemx_barrier_all_vec();
+            break;
+        case PERFTEST_PARTIAL_BARRIER_LAT:
+            shmemx_partial_barrier_vec(SHMEM_TEAM_WORLD, (__gm__ uint32_t *)(ctrl + PERFTEST_PES_OFF), pes_count);
+            break;
+        case PERFTEST_ALLTOALLV_LAT:
+            perftest_alltoallv(src, dst, msg_len, rank, rank_size);
+            break;
+        case PERFTEST_BARRIER_SKEW_LAT:
+            // the other ranks wait past their spin phase, what remains once the skew is removed is their wakeup
+            if (rank == rank_size - 1) {
+                int64_t until = AscendC::GetSystemCycle() + PERFTEST_SKEW_CYCLES;
+                while (AscendC::GetSystemCycle() < until) {
+                }
+            }
+            shmemx_barrier_all_vec();
+            break;
+        default:
+            break;
+    }
+}
+
+// One vector core per rank runs warmup + iters steps of test, the timed part starts after the warmup steps
+extern "C" __global__ __aicore__ void perftest_suite(uint64_t cfg, GM_ADDR gva, uint32_t test, uint32_t pattern,
+    uint64_t msg_len, uint64_t max_len, uint64_t ctrl_off, uint32_t iters, uint32_t warmup)
+{
+    shmemx_set_ffts_config(cfg);
+    int64_t rank = smem_shm_get_global_rank();
+    int64_t rank_size = smem_shm_get_global_rank_size();
+    int64_t target = 0;
+    bool active = perftest_active(pattern, rank, rank_size, target);
+    GM_ADDR src = gva;
+    GM_ADDR dst = gva + max_len * (1 + rank);
+    GM_ADDR ctrl = gva + ctrl_off;
+    uint32_t pes_count = pattern == PERFTEST_MANY_TO_ONE ? (uint32_t)rank_size : 2;
+
+    shmemx_barrier_all_vec();
+    int64_t start = AscendC::GetSystemCycle();
+    for (uint32_t i = 0; i < warmup + iters; i++) {
+        if (i == warmup) {
+            start = AscendC::GetSystemCycle();
+        }
+        perftest_step(test, active, target, src, dst, msg_len, ctrl, pes_count, rank, rank_size);
+    }
+    int64_t end = AscendC::GetSystemCycle();
+    shmem_quiet();
+    shmemx_barrier_all_vec();
+
+    // every signal and atomic issued, warmup included, has to have landed exactly once
+    int64_t expected = perftest_senders(pattern, rank, rank_size) * (warmup + iters);
+    int64_t errors = 0;
+    if (test == PERFTEST_PUT_SIGNAL_LAT) {
+        __gm__ int32_t *sig = (__gm__ int32_t *)(ctrl + PERFTEST_SIG_OFF);
+        errors = shmemx_signal_wait_until_timeout(sig, SHMEM_CMP_EQ, (int32_t)expected, PERFTEST_CHECK_TIMEOUT) != 0;
+    } else if (test == PERFTEST_ATOMIC_LAT) {
+        __gm__ int64_t *counter = (__gm__ int64_t *)(ctrl + PERFTEST_COUNTER_OFF);
+        dcci_cacheline((__gm__ uint8_t *)counter);
+        errors = *counter != expected;
+    }
+    if (test == PERFTEST_BARRIER_SKEW_LAT) {
+        end -= PERFTEST_SKEW_CYCLES * iters;
+    }
+    __gm__ int64_t *result = (__gm__ int64_t *)(ctrl + PERFTEST_RESULT_OFF);
+    result[0] = end - start;
+    result[1] = errors;
+    dcci_cacheline((__gm__ uint8_t *)result);
+}
+
+void perftest_suite_do(void *stream, uint64_t cfg, uint8_t *gva, uint32_t test, uint32_t pattern, uint64_t msg_len,
+    uint64_t max_len, uint64_t ctrl_off, uint32_t iters, uint32_t warmup)
+{
+    perftest_suite<<<1, nullptr, stream>>>(cfg, gva, test, pattern, msg_len, max_len, ctrl_off, iters, warmup);
+}
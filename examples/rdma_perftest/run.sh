@@ -1,18 +1,21 @@
 #!/bin/bash
 
+# Usage: bash run.sh [n_ranks] [test_type] [msg_len] [suite options...]
 script_dir="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 project_root="$(cd ${script_dir}/../../ && pwd)"
 export PROJECT_ROOT=${project_root}
 export LD_LIBRARY_PATH=${PROJECT_ROOT}/build/lib:${PROJECT_ROOT}/src/memfabric_hybrid/output/smem/lib64/:${PROJECT_ROOT}/src/memfabric_hybrid/output/hybm/lib64/:$LD_LIBRARY_PATH
+n_ranks=${1:-2}
+test_type=${2:-highlevel_put_pingpong_latency}
+msg_len=${3:-64}
+shift 3 2>/dev/null || shift $#
 cd $PROJECT_ROOT
 pids=()
-./build/bin/rdma_perftest 2 0 tcp://127.0.0.1:8765 2 0 0 highlevel_put_pingpong_latency 64 & # rank 0
-pid=$!
-pids+=("$pid")
-
-./build/bin/rdma_perftest 2 1 tcp://127.0.0.1:8765 2 0 0 highlevel_put_pingpong_latency 64 & # rank 1
-pid=$!
-pids+=("$pid")
+for ((rank = 0; rank < n_ranks; rank++)); do
+    ./build/bin/rdma_perftest ${n_ranks} ${rank} tcp://127.0.0.1:8765 ${n_ranks} 0 0 ${test_type} ${msg_len} "$@" &
+    pid=$!
+    pids+=("$pid")
+done
 
 ret=0
 for pid in ${pids[@]}; do
@@ -23,4 +26,4 @@ for pid in ${pids[@]}; do
     fi
     echo "wait $pid finished"
 done
-exit $ret
\ No newline at end of file
+exit $ret
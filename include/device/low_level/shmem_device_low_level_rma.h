@@ -55,6 +55,7 @@ template <typename T>
 SHMEM_DEVICE void shmem_mte_get_mem_nbi(__gm__ T *dst, __gm__ T *src, __ubuf__ T *buf, uint32_t ub_size,
                                         uint32_t elem_size, int pe, AscendC::TEventID EVENT_ID)
 {
+    SHMEMI_TRACE_BEGIN(trace_start);
     auto ptr = shmem_ptr(src, pe);
     __gm__ T *remote_ptr = reinterpret_cast<__gm__ T *>(ptr);
 
@@ -81,6 +82,7 @@ SHMEM_DEVICE void shmem_mte_get_mem_nbi(__gm__ T *dst, __gm__ T *src, __ubuf__ T
         AscendC::WaitFlag<AscendC::HardEvent::MTE2_MTE3>(EVENT_ID);
         smem_shm_copy_ub2gm(dst + repeat_times * repeat_elem, buf, remain);
     }
+    SHMEMI_TRACE_END(trace_start, SHMEMX_TRACE_GET, pe, (uint64_t)elem_size * sizeof(T));
 }
 
 /**
@@ -107,7 +109,7 @@ SHMEM_DEVICE void shmem_roce_get_mem_nbi(__gm__ T* dst, __gm__ T* src, __ubuf__
     ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
     ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(buf) + UB_ALIGN_SIZE;
     ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
-    shmemi_roce_read((__gm__ uint8_t*)dst, (__gm__ uint8_t*)ptr, pe, 0, elem_size * sizeof(T),
+    shmemi_roce_read_striped((__gm__ uint8_t*)dst, (__gm__ uint8_t*)ptr, pe, elem_size * sizeof(T),
         ub_tensor_64, ub_tensor_32);
 }
 
@@ -227,7 +229,7 @@ SHMEM_DEVICE void shmem_roce_get_mem_nbi(AscendC::GlobalTensor<T> dst, AscendC::
     ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
     ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(buf.GetPhyAddr()) + UB_ALIGN_SIZE;
     ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
-    shmemi_roce_read((__gm__ uint8_t*)dst.GetPhyAddr(), (__gm__ uint8_t*)ptr, pe, 0, elem_size * sizeof(T),
+    shmemi_roce_read_striped((__gm__ uint8_t*)dst.GetPhyAddr(), (__gm__ uint8_t*)ptr, pe, elem_size * sizeof(T),
         ub_tensor_64, ub_tensor_32);
 }
 
@@ -283,6 +285,7 @@ template <typename T>
 SHMEM_DEVICE void shmem_mte_put_mem_nbi(__gm__ T *dst, __gm__ T *src, __ubuf__ T *buf, uint32_t ub_size,
                                         uint32_t elem_size, int pe, AscendC::TEventID EVENT_ID)
 {
+    SHMEMI_TRACE_BEGIN(trace_start);
     auto ptr = shmem_ptr(dst, pe);
     __gm__ T *remote_ptr = reinterpret_cast<__gm__ T *>(ptr);
 
@@ -309,6 +312,7 @@ SHMEM_DEVICE void shmem_mte_put_mem_nbi(__gm__ T *dst, __gm__ T *src, __ubuf__ T
         AscendC::WaitFlag<AscendC::HardEvent::MTE2_MTE3>(EVENT_ID);
         smem_shm_copy_ub2gm(remote_ptr + repeat_times * repeat_elem, buf, remain);
     }
+    SHMEMI_TRACE_END(trace_start, SHMEMX_TRACE_PUT, pe, (uint64_t)elem_size * sizeof(T));
 }
 
 /**
@@ -334,7 +338,7 @@ SHMEM_DEVICE void shmem_roce_put_mem_nbi(__gm__ T* dst, __gm__ T* src, __ubuf__
     ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
     ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(buf) + UB_ALIGN_SIZE;
     ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
-    shmemi_roce_write((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)src, pe, 0, elem_size * sizeof(T),
+    shmemi_roce_write_striped((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)src, pe, elem_size * sizeof(T),
         ub_tensor_64, ub_tensor_32);
 }
 
@@ -451,7 +455,7 @@ SHMEM_DEVICE void shmem_roce_put_mem_nbi(AscendC::GlobalTensor<T> dst, AscendC::
     ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
     ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(buf.GetPhyAddr()) + UB_ALIGN_SIZE;
     ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
-    shmemi_roce_write((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)(src.GetPhyAddr()), pe, 0,
+    shmemi_roce_write_striped((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)(src.GetPhyAddr()), pe,
         elem_size * sizeof(T), ub_tensor_64, ub_tensor_32);
 }
 
@@ -14,6 +14,11 @@
 #include "internal/device/shmemi_device_common.h"
 
 constexpr uint32_t SHMEM_NUM_CQE_PER_POLL_CQ = 100;
+constexpr uint32_t SHMEM_ROCE_POLL_WINDOW = 32; // CQEs invalidated and scanned at once, one CQ doorbell per window
+constexpr uint32_t SHMEM_ROCE_SQ_RESERVED_WQE = 10; // free WQE slots kept before the SQ is treated as full
+constexpr uint32_t SHMEM_ROCE_SIGNAL_INTERVAL = 16; // default k for batched posts, one CQE per k WQEs
+constexpr uint64_t SHMEM_ROCE_STRIPE_MIN_BYTES = 64 * 1024; // messages below this size stay on a single QP
+constexpr uint64_t SHMEM_ROCE_STRIPE_ALIGN = 512; // stripe boundary alignment in Bytes
 
 enum class SHMEMAIVOPCODE : uint32_t {
     OP_SEND = 0,
@@ -103,74 +108,197 @@ struct SHMEMHybmDeviceMeta {
 };
 
 SHMEM_DEVICE void shmemi_roce_poll_cq_update_info(AscendC::LocalTensor<uint64_t> &ubLocal64,
-    AscendC::LocalTensor<uint32_t> &ubLocal32, uint32_t &curTail, uint32_t &rRankId, uint32_t &qpIdx);
+    AscendC::LocalTensor<uint32_t> &ubLocal32, uint32_t &curTail, uint32_t &wqTail, uint32_t &rRankId,
+    uint32_t &qpIdx);
 SHMEM_DEVICE void shmemi_rdma_post_send_update_info(AscendC::LocalTensor<uint64_t> &ubLocal64,
     AscendC::LocalTensor<uint32_t> &ubLocal32, uint32_t &curHead, __gm__ SHMEMWQCtx *&qpCtxEntry);
 
 /**
- * @brief RDMA Poll Completion Queue (CQ) function. Return status: 0 means success, non-zero means error.
+ * @brief Reap the CQEs already written to the CQ of one QP without waiting. Each window of up to
+ *        SHMEM_ROCE_POLL_WINDOW CQEs is invalidated with a single cache operation and scanned for valid owner bits,
+ *        then the CQ consumer index, CQ doorbell and WQ tail are published once for the whole window.
+ *        A CQE of a signaled WQE also retires the unsignaled WQEs posted before it, so the send queue tail follows
+ *        the WQE index carried by each CQE. A failed CQE is consumed and ends the reaping.
  *
  * @param remoteRankId           [in] destination rank ID
  * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
- * @param idx                    [in] expect completion queue consumer index after polling
+ * @param maxWindows             [in] maximum number of windows to scan
+ * @param status                 [out] status of the failed CQE, 0 when every reaped CQE succeeded
  * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
  * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @return Number of CQEs reaped.
  */
-SHMEM_DEVICE uint32_t shmemi_roce_poll_cq(uint32_t remoteRankId, uint32_t qpIdx, uint32_t idx,
-                                          AscendC::LocalTensor<uint64_t> ubLocal64,
+SHMEM_DEVICE uint32_t shmemi_roce_reap_cq(uint32_t remoteRankId, uint32_t qpIdx, uint32_t maxWindows,
+                                          uint32_t &status, AscendC::LocalTensor<uint64_t> ubLocal64,
                                           AscendC::LocalTensor<uint32_t> ubLocal32)
 {
-    if (idx == 0) {
-        return 0;
-    }
-
     __gm__ SHMEMHybmDeviceMeta* metaPtr = (__gm__ SHMEMHybmDeviceMeta*)(SMEM_SHM_DEVICE_META_ADDR +
                                                                 SMEM_SHM_DEVICE_GLOBAL_META_SIZE);
     __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(metaPtr->qpInfoAddress);
     uint32_t qpNum = RDMAInfo->qpNum;
+    __gm__ SHMEMWQCtx* wqCtxEntry = (__gm__ SHMEMWQCtx*)(RDMAInfo->sqPtr
+        + (remoteRankId * qpNum + qpIdx) * sizeof(SHMEMWQCtx));
     __gm__ SHMEMCQCtx* cqCtxEntry = (__gm__ SHMEMCQCtx*)(RDMAInfo->scqPtr
         + (remoteRankId * qpNum + qpIdx) * sizeof(SHMEMCQCtx));
+    auto curWQTailAddr = wqCtxEntry->tailAddr;
+    auto wqDepth = wqCtxEntry->depth;
     auto cqBaseAddr = cqCtxEntry->bufAddr;
     auto cqeSize = cqCtxEntry->cqeSize;
     auto depth = cqCtxEntry->depth;
     auto curHardwareTailAddr = cqCtxEntry->tailAddr;
+    dcci_cachelines((__gm__ uint8_t*)curWQTailAddr, 8);
     dcci_cachelines((__gm__ uint8_t*)curHardwareTailAddr, 8);
+    uint32_t wqTail = *(__gm__ uint32_t*)(curWQTailAddr);
     uint32_t curTail = *(__gm__ uint32_t*)(curHardwareTailAddr);
 
-    const uint32_t shiftWidth = 7;
-    AscendC::DataCopyExtParams copyParamsTail{1, 1 * sizeof(uint32_t), 0, 0, 0};
-    while (curTail != idx) {
-        __gm__ SHMEMcqeCtx* cqeAddr = (__gm__ SHMEMcqeCtx*)(cqBaseAddr + cqeSize * (curTail & (depth - 1)));
-        uint32_t cqeByte4 = *(__gm__ uint32_t*)cqeAddr;
-        while (((cqeByte4 & (1 << shiftWidth)) != 0) == ((curTail & depth) != 0)) {
-            int64_t tmp = AscendC::GetSystemCycle(); // reserved for timeout check
-            dcci_cachelines((__gm__ uint8_t*)cqeAddr, 32);
-            cqeByte4 = *(__gm__ uint32_t*)cqeAddr;
+    const uint32_t ownerBit = 1 << 7;
+    uint32_t reaped = 0;
+    status = 0;
+    for (uint32_t w = 0; w < maxWindows; w++) {
+        // a window never crosses the end of the ring, so it is one contiguous range of cachelines
+        uint32_t offset = curTail & (depth - 1);
+        uint32_t window = (depth - offset) < SHMEM_ROCE_POLL_WINDOW ? (depth - offset) : SHMEM_ROCE_POLL_WINDOW;
+        dcci_cachelines((__gm__ uint8_t*)(cqBaseAddr + cqeSize * offset), cqeSize * window);
+        uint32_t n = 0;
+        while (n < window) {
+            __gm__ SHMEMcqeCtx* cqeAddr = (__gm__ SHMEMcqeCtx*)(cqBaseAddr + cqeSize * (offset + n));
+            uint32_t cqeByte4 = cqeAddr->byte4;
+            if (((cqeByte4 & ownerBit) != 0) == (((curTail + n) & depth) != 0)) {
+                break;
+            }
+            // [16:31] WQE index of the completed WQE, unsignaled WQEs before it are retired with it
+            uint32_t wqeIdx = (cqeByte4 >> 16) & 0xFFFF;
+            wqTail += (wqeIdx - (wqTail & 0xFFFF)) & (wqDepth - 1);
+            wqTail++;
+            n++;
+            status = (cqeByte4 >> 8) & 0xFF;
+            if (status) {
+                break;
+            }
+        }
+        if (n == 0) {
+            break;
+        }
+        curTail += n;
+        reaped += n;
+        shmemi_roce_poll_cq_update_info(ubLocal64, ubLocal32, curTail, wqTail, remoteRankId, qpIdx);
+        if (status != 0 || n < window) {
+            break;
         }
-        curTail++;
-        uint32_t wqn = cqeAddr->byte16 & 0xFFFFFF; // reserved for multi WQ share the same CQ
+    }
+    return reaped;
+}
+
+/**
+ * @brief RDMA Poll Completion Queue (CQ) function. Return status: 0 means success, non-zero means error.
+ *        Reaps the CQ a window at a time with shmemi_roce_reap_cq until the send queue tail reaches idx.
+ *
+ * @param remoteRankId           [in] destination rank ID
+ * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
+ * @param idx                    [in] expect send queue consumer index after polling
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ */
+SHMEM_DEVICE uint32_t shmemi_roce_poll_cq(uint32_t remoteRankId, uint32_t qpIdx, uint32_t idx,
+                                          AscendC::LocalTensor<uint64_t> ubLocal64,
+                                          AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    __gm__ SHMEMHybmDeviceMeta* metaPtr = (__gm__ SHMEMHybmDeviceMeta*)(SMEM_SHM_DEVICE_META_ADDR +
+                                                                SMEM_SHM_DEVICE_GLOBAL_META_SIZE);
+    __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(metaPtr->qpInfoAddress);
+    uint32_t qpNum = RDMAInfo->qpNum;
+    __gm__ SHMEMWQCtx* wqCtxEntry = (__gm__ SHMEMWQCtx*)(RDMAInfo->sqPtr
+        + (remoteRankId * qpNum + qpIdx) * sizeof(SHMEMWQCtx));
+    auto curWQTailAddr = wqCtxEntry->tailAddr;
+    dcci_cachelines((__gm__ uint8_t*)curWQTailAddr, 8);
+    uint32_t wqTail = *(__gm__ uint32_t*)(curWQTailAddr);
 
-        // Check CQE status
-        uint32_t status = (cqeAddr->byte4 >> 8) & 0xFF;
-        if (status) {
-            return status;
+    const uint32_t spinPolls = 64;
+    uint32_t polls = 0;
+    uint32_t status = 0;
+    while ((int32_t)(idx - wqTail) > 0) {
+        if (shmemi_roce_reap_cq(remoteRankId, qpIdx, 1, status, ubLocal64, ubLocal32) == 0) {
+            int64_t tmp = AscendC::GetSystemCycle(); // reserved for timeout check
+            if (++polls == spinPolls) {
+                shmemi_watchdog_mark(SHMEMI_SITE_ROCE_QUIET, -1, (int32_t)remoteRankId);
+            }
+        } else if (status != 0) {
+            break;
         }
+        dcci_cachelines((__gm__ uint8_t*)curWQTailAddr, 8);
+        wqTail = *(__gm__ uint32_t*)(curWQTailAddr);
+    }
+    if (polls >= spinPolls) {
+        shmemi_watchdog_mark(SHMEMI_SITE_IDLE, -1, (int32_t)remoteRankId);
     }
+    return status;
+}
 
-    // Update CQ tail
-    ubLocal32.SetValue(0, (uint32_t)curTail);
-    AscendC::GlobalTensor<uint32_t> TailGlobalTensor;
-    TailGlobalTensor.SetGlobalBuffer((__gm__ uint32_t*)curHardwareTailAddr);
-    AscendC::PipeBarrier<PIPE_ALL>();
-    AscendC::DataCopyPad(TailGlobalTensor, ubLocal32, copyParamsTail);
-    AscendC::PipeBarrier<PIPE_ALL>();
+/**
+ * @brief Send queue credits of one QP, the WQE slots that may still be posted before the ring is full.
+ *        Credits are consumed by the producer index and returned when shmemi_roce_reap_cq moves the WQ tail.
+ *
+ * @param wqCtxEntry             [in] send queue context of the QP
+ * @param curHead                [in] producer index the next WQE will be posted at
+ */
+SHMEM_DEVICE uint32_t shmemi_roce_sq_credits(__gm__ SHMEMWQCtx* wqCtxEntry, uint32_t curHead)
+{
+    auto curWQTailAddr = wqCtxEntry->tailAddr;
+    dcci_cachelines((__gm__ uint8_t*)curWQTailAddr, 8);
+    uint32_t inflight = curHead - *(__gm__ uint32_t*)(curWQTailAddr);
+    uint32_t usable = wqCtxEntry->depth - SHMEM_ROCE_SQ_RESERVED_WQE;
+    return inflight < usable ? usable - inflight : 0;
+}
 
-    shmemi_roce_poll_cq_update_info(ubLocal64, ubLocal32, curTail, remoteRankId, qpIdx);
-    return 0;
+/**
+ * @brief Wait until the send queue of one QP has at least wanted credits, reaping every completion that is
+ *        already available on each pass so the credits come back in bulk. Every rung doorbell ends with a
+ *        signaled WQE, so the credits of all posted WQEs are eventually returned.
+ *
+ * @param destRankId             [in] destination rank ID
+ * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
+ * @param wqCtxEntry             [in] send queue context of the QP
+ * @param curHead                [in] producer index the next WQE will be posted at
+ * @param wanted                 [in] credits needed, at most depth - SHMEM_ROCE_SQ_RESERVED_WQE
+ * @param status                 [out] status of a failed CQE, 0 when every reaped CQE succeeded
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @return Credits available, below wanted only when status is non-zero.
+ */
+SHMEM_DEVICE uint32_t shmemi_roce_wait_sq_credits(uint32_t destRankId, uint32_t qpIdx,
+                                                  __gm__ SHMEMWQCtx* wqCtxEntry, uint32_t curHead,
+                                                  uint32_t wanted, uint32_t &status,
+                                                  AscendC::LocalTensor<uint64_t> ubLocal64,
+                                                  AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    const uint32_t spinPolls = 64;
+    uint32_t polls = 0;
+    uint32_t credits = shmemi_roce_sq_credits(wqCtxEntry, curHead);
+    status = 0;
+    while (credits < wanted) {
+        if (shmemi_roce_reap_cq(destRankId, qpIdx, wqCtxEntry->depth / SHMEM_ROCE_POLL_WINDOW, status,
+                                ubLocal64, ubLocal32) == 0) {
+            if (++polls == spinPolls) {
+                shmemi_watchdog_mark(SHMEMI_SITE_ROCE_QUIET, -1, (int32_t)destRankId);
+            }
+        } else if (status != 0) {
+            break;
+        }
+        credits = shmemi_roce_sq_credits(wqCtxEntry, curHead);
+    }
+    if (polls >= spinPolls) {
+        shmemi_watchdog_mark(SHMEMI_SITE_IDLE, -1, (int32_t)destRankId);
+    }
+    return credits;
 }
 
+/**
+ * @brief Publish the CQ consumer index and WQ tail after a poll window. The two tails are software words written
+ *        back with the data cache, only the CQ doorbell goes through UB, so a window costs one barrier pair.
+ */
 SHMEM_DEVICE void shmemi_roce_poll_cq_update_info(AscendC::LocalTensor<uint64_t> &ubLocal64,
-    AscendC::LocalTensor<uint32_t> &ubLocal32, uint32_t &curTail, uint32_t &remoteRankId, uint32_t &qpIdx)
+    AscendC::LocalTensor<uint32_t> &ubLocal32, uint32_t &curTail, uint32_t &wqTail, uint32_t &remoteRankId,
+    uint32_t &qpIdx)
 {
     __gm__ SHMEMHybmDeviceMeta* metaPtr = (__gm__ SHMEMHybmDeviceMeta*)(SMEM_SHM_DEVICE_META_ADDR +
                                                                 SMEM_SHM_DEVICE_GLOBAL_META_SIZE);
@@ -178,7 +306,16 @@ SHMEM_DEVICE void shmemi_roce_poll_cq_update_info(AscendC::LocalTensor<uint64_t>
     uint32_t qpNum = RDMAInfo->qpNum;
     __gm__ SHMEMCQCtx* cqCtxEntry = (__gm__ SHMEMCQCtx*)(RDMAInfo->scqPtr
         + (remoteRankId * qpNum + qpIdx) * sizeof(SHMEMCQCtx));
-    AscendC::DataCopyExtParams copyParamsTail{1, 1 * sizeof(uint32_t), 0, 0, 0};
+    __gm__ SHMEMWQCtx* wqCtxEntry = (__gm__ SHMEMWQCtx*)(RDMAInfo->sqPtr
+        + (remoteRankId * qpNum + qpIdx) * sizeof(SHMEMWQCtx));
+
+    // Update CQ tail and WQ tail
+    __gm__ uint32_t* cqTailAddr = (__gm__ uint32_t*)(cqCtxEntry->tailAddr);
+    __gm__ uint32_t* wqTailAddr = (__gm__ uint32_t*)(wqCtxEntry->tailAddr);
+    *cqTailAddr = curTail;
+    *wqTailAddr = wqTail;
+    dcci_cachelines((__gm__ uint8_t*)cqTailAddr, sizeof(uint32_t));
+    dcci_cachelines((__gm__ uint8_t*)wqTailAddr, sizeof(uint32_t));
 
     // Ring CQ Doorbell
     auto cqDBAddr = cqCtxEntry->dbAddr;
@@ -186,8 +323,9 @@ SHMEM_DEVICE void shmemi_roce_poll_cq_update_info(AscendC::LocalTensor<uint64_t>
         ubLocal32.SetValue(0, (uint32_t)(curTail & 0xFFFFFF));
         AscendC::GlobalTensor<uint32_t> CQDBGlobalTensor;
         CQDBGlobalTensor.SetGlobalBuffer((__gm__ uint32_t*)cqDBAddr);
+        AscendC::DataCopyExtParams copyParams{1, 1 * sizeof(uint32_t), 0, 0, 0};
         AscendC::PipeBarrier<PIPE_ALL>();
-        AscendC::DataCopyPad(CQDBGlobalTensor, ubLocal32, copyParamsTail);
+        AscendC::DataCopyPad(CQDBGlobalTensor, ubLocal32, copyParams);
         AscendC::PipeBarrier<PIPE_ALL>();
     } else if (cqCtxEntry->dbMode == SHMEMDBMode::HW_DB) {
         uint64_t doorBellInfo = 0;
@@ -203,19 +341,62 @@ SHMEM_DEVICE void shmemi_roce_poll_cq_update_info(AscendC::LocalTensor<uint64_t>
         AscendC::DataCopyPad(DBGlobalTensor, ubLocal64, copyParams);
         AscendC::PipeBarrier<PIPE_ALL>();
     }
+}
 
-    // Update WQ tail
-    __gm__ SHMEMWQCtx* wqCtxEntry = (__gm__ SHMEMWQCtx*)(RDMAInfo->sqPtr
-        + (remoteRankId * qpNum + qpIdx) * sizeof(SHMEMWQCtx));
-    auto curWQTailAddr = wqCtxEntry->tailAddr;
-    dcci_cachelines((__gm__ uint8_t*)curWQTailAddr, 8);
-    uint32_t curWQTail = *(__gm__ uint32_t*)(curWQTailAddr);
-    ubLocal32.SetValue(0, curTail);
-    AscendC::GlobalTensor<uint32_t> WQTailGlobalTensor;
-    WQTailGlobalTensor.SetGlobalBuffer((__gm__ uint32_t*)curWQTailAddr);
-    AscendC::PipeBarrier<PIPE_ALL>();
-    AscendC::DataCopyPad(WQTailGlobalTensor, ubLocal32, copyParamsTail);
-    AscendC::PipeBarrier<PIPE_ALL>();
+/**
+ * @brief Fill one WQE and its single SGE in the send queue ring and flush them out of the data cache.
+ *
+ * @param wqeAddr                [in] address of the WQE slot in the send queue ring
+ * @param curHead                [in] send queue producer index of this WQE
+ * @param opcode                 [in] rdma opcode in SHMEMAIVOPCODE enum class
+ * @param messageLen             [in] message length in Bytes
+ * @param rkey                   [in] remote key of the destination memory region
+ * @param lkey                   [in] local key of the source memory region
+ * @param remoteAddr             [in] address in remote HBM
+ * @param localAddr              [in] address in local HBM
+ * @param signaled               [in] whether the WQE generates a CQE
+ * @param fenced                 [in] whether the WQE waits for all previous WQEs of the QP to complete
+ */
+SHMEM_DEVICE void shmemi_rdma_write_wqe(__gm__ uint8_t* wqeAddr, uint32_t curHead, SHMEMAIVOPCODE opcode,
+                                        uint64_t messageLen, uint32_t rkey, uint32_t lkey,
+                                        uint64_t remoteAddr, uint64_t localAddr, bool signaled,
+                                        bool fenced = false)
+{
+    auto shift = 13;
+    uint64_t ownBit = (curHead >> shift) & 0x1;
+    uint32_t byte4 = (uint32_t)opcode & 0x1F;       // [0:4] opcode
+    byte4 |= ((~ownBit) << 7) & (1 << 7); // [7] owner_bit
+    if (signaled) {
+        byte4 |= 1 << 8;                  // [8] IBV_SEND_SINGNALED
+    }
+    if (fenced) {
+        byte4 |= 1 << 9;                  // [9] IBV_SEND_FENCE
+    }
+    *(__gm__ uint32_t*)(wqeAddr) = byte4; // control set by local parameter, see above lines
+    *(__gm__ uint32_t*)(wqeAddr + 4) = messageLen; // message size in bytes
+    *(__gm__ uint32_t*)(wqeAddr + 8) = 0; // immtdata is always 0 till we provide poll CQ flow in AIV
+    *(__gm__ uint32_t*)(wqeAddr + 12) = 1 << 24; // [120:127] num_sge = 1
+    *(__gm__ uint32_t*)(wqeAddr + 16) = 0; // [128:151] start_sge_index = 0
+    *(__gm__ uint32_t*)(wqeAddr + 20) = rkey; // rkey
+    *(__gm__ uint64_t*)(wqeAddr + 24) = remoteAddr; // remote VA
+
+    // Write SGE to HBM
+    __gm__ uint8_t* sgeAddr = wqeAddr + sizeof(SHMEMwqeCtx);
+    *(__gm__ uint32_t*)(sgeAddr) = messageLen; // message size in bytes
+    *(__gm__ uint32_t*)(sgeAddr + 4) = lkey; // lkey
+    *(__gm__ uint64_t*)(sgeAddr + 8) = localAddr; // local VA
+
+    // WQE & SGE cache flush
+    dcci_cachelines(wqeAddr, sizeof(SHMEMwqeCtx) + sizeof(SHMEMsegCtx));
+}
+
+/**
+ * @brief Report a RoCE post that dropped WQEs because the QP to pe is in error, see SHMEMX_DIAG_ERR_ROCE_QP.
+ */
+SHMEM_DEVICE void shmemi_roce_diag_dropped(__gm__ uint8_t* remoteAddr, uint32_t destRankId, uint32_t status)
+{
+    shmemi_wait_diag_record(remoteAddr, SHMEMX_DIAG_ERR_ROCE_QP, status, 0, SHMEM_TEAM_INVALID, 0,
+                            (int32_t)destRankId, 0);
 }
 
 /**
@@ -229,12 +410,14 @@ SHMEM_DEVICE void shmemi_roce_poll_cq_update_info(AscendC::LocalTensor<uint64_t>
  * @param messageLen             [in] message length in Bytes
  * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
  * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @return 0 when the WQE was posted. Otherwise the status of the failed CQE reaped while waiting for send queue
+ *         credits; the QP is in error, the WQE is dropped and reported to the wait diagnostic ring.
  */
-SHMEM_DEVICE void shmemi_rdma_post_send(__gm__ uint8_t* remoteAddr, __gm__ uint8_t* localAddr,
-                                        uint32_t destRankId, uint32_t qpIdx,
-                                        SHMEMAIVOPCODE opcode, uint64_t messageLen,
-                                        AscendC::LocalTensor<uint64_t> ubLocal64,
-                                        AscendC::LocalTensor<uint32_t> ubLocal32)
+SHMEM_DEVICE uint32_t shmemi_rdma_post_send(__gm__ uint8_t* remoteAddr, __gm__ uint8_t* localAddr,
+                                            uint32_t destRankId, uint32_t qpIdx,
+                                            SHMEMAIVOPCODE opcode, uint64_t messageLen,
+                                            AscendC::LocalTensor<uint64_t> ubLocal64,
+                                            AscendC::LocalTensor<uint32_t> ubLocal32)
 {
     __gm__ SHMEMHybmDeviceMeta* metaPtr = (__gm__ SHMEMHybmDeviceMeta*)(SMEM_SHM_DEVICE_META_ADDR +
                                                                 SMEM_SHM_DEVICE_GLOBAL_META_SIZE);
@@ -248,47 +431,242 @@ SHMEM_DEVICE void shmemi_rdma_post_send(__gm__ uint8_t* remoteAddr, __gm__ uint8
     auto curHardwareHeadAddr = qpCtxEntry->headAddr;
     dcci_cachelines((__gm__ uint8_t*)curHardwareHeadAddr, 8);
     uint32_t curHead = *(__gm__ uint32_t*)(curHardwareHeadAddr);
-    auto curHardwareTailAddr = qpCtxEntry->tailAddr;
     auto depth = qpCtxEntry->depth;
-    auto shift = 13;
     AscendC::PipeBarrier<PIPE_ALL>();
 
-    // Poll CQ if send queue is full
-    dcci_cachelines((__gm__ uint8_t*)curHardwareTailAddr, 8);
-    if ((curHead + 10) % depth == (*(__gm__ uint32_t*)(curHardwareTailAddr)) % depth) {
-        shmemi_roce_poll_cq(destRankId, qpIdx, *(__gm__ uint32_t*)(curHardwareTailAddr) +
-            SHMEM_NUM_CQE_PER_POLL_CQ, ubLocal64, ubLocal32);
+    // Reap completions if the send queue is out of credits, a QP in error posts nothing
+    uint32_t status = 0;
+    shmemi_roce_wait_sq_credits(destRankId, qpIdx, qpCtxEntry, curHead, 1, status, ubLocal64, ubLocal32);
+    if (status != 0) {
+        shmemi_roce_diag_dropped(remoteAddr, destRankId, status);
+        return status;
     }
 
     // Write WQE to HBM
     __gm__ uint8_t* wqeAddr = (__gm__ uint8_t*)(sqBaseAddr + wqeSize * (curHead % depth));
-    uint64_t ownBit = (curHead >> shift) & 0x1;
-    uint32_t byte4 = (uint32_t)opcode & 0x1F;       // [0:4] opcode
-    byte4 |= ((~ownBit) << 7) & (1 << 7); // [7] owner_bit
-    byte4 |= 1 << 8;                      // [8] IBV_SEND_SINGNALED
-    *(__gm__ uint32_t*)(wqeAddr) = byte4; // control set by local parameter, see above lines
-    *(__gm__ uint32_t*)(wqeAddr + 4) = messageLen; // message size in bytes
-    *(__gm__ uint32_t*)(wqeAddr + 8) = 0; // immtdata is always 0 till we provide poll CQ flow in AIV
-    *(__gm__ uint32_t*)(wqeAddr + 12) = 1 << 24; // [120:127] num_sge = 1
-    *(__gm__ uint32_t*)(wqeAddr + 16) = 0; // [128:151] start_sge_index = 0
     __gm__ SHMEMmemInfo* remoteMemInfo = (__gm__ SHMEMmemInfo*)(SHMEMmemInfoTable + sizeof(SHMEMmemInfo) * destRankId);
-    *(__gm__ uint32_t*)(wqeAddr + 20) = remoteMemInfo->rkey; // rkey
-    *(__gm__ uint64_t*)(wqeAddr + 24) = (uint64_t)remoteAddr; // remote VA
+    __gm__ SHMEMmemInfo* localMemInfo = (__gm__ SHMEMmemInfo*)(SHMEMmemInfoTable
+        + sizeof(SHMEMmemInfo) * shmemi_get_my_pe());
+    shmemi_rdma_write_wqe(wqeAddr, curHead, opcode, messageLen, remoteMemInfo->rkey, localMemInfo->lkey,
+                          (uint64_t)remoteAddr, (uint64_t)localAddr, true);
+    AscendC::PipeBarrier<PIPE_ALL>();
+    curHead++;
 
-    // Write SGE to HBM
-    __gm__ uint8_t* sgeAddr = wqeAddr + sizeof(SHMEMwqeCtx);
-    *(__gm__ uint32_t*)(sgeAddr) = messageLen; // message size in bytes
+    shmemi_rdma_post_send_update_info(ubLocal64, ubLocal32, curHead, qpCtxEntry);
+    return 0;
+}
+
+/**
+ * @brief AIV direct RDMA helper function for batched post send. Writes count WQEs into the send queue ring,
+ *        requests a CQE only for every signalInterval-th WQE and for the last one, and rings a single doorbell
+ *        for the batch. If the send queue fills up, the WQEs written so far are rung and retired first.
+ *        Message i moves messageLen bytes between remoteAddr + i * remoteStride and localAddr + i * localStride.
+ *
+ * @param remoteAddr             [in] address of the first message in remote HBM
+ * @param localAddr              [in] address of the first message in local HBM
+ * @param destRankId             [in] destination rank ID
+ * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
+ * @param opcode                 [in] rdma opcode in SHMEMAIVOPCODE enum class
+ * @param messageLen             [in] message length of each WQE in Bytes
+ * @param count                  [in] number of WQEs
+ * @param remoteStride           [in] distance between consecutive messages in remote HBM in Bytes
+ * @param localStride            [in] distance between consecutive messages in local HBM in Bytes
+ * @param signalInterval         [in] signal every k-th WQE, 0 signals only the last WQE of each doorbell
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @return 0 when every WQE was posted. Otherwise the status of the failed CQE reaped while waiting for send queue
+ *         credits; the QP is in error and the WQEs not yet written are dropped and reported to the wait
+ *         diagnostic ring.
+ */
+SHMEM_DEVICE uint32_t shmemi_rdma_post_send_batch(__gm__ uint8_t* remoteAddr, __gm__ uint8_t* localAddr,
+                                                  uint32_t destRankId, uint32_t qpIdx,
+                                                  SHMEMAIVOPCODE opcode, uint64_t messageLen, uint32_t count,
+                                                  uint64_t remoteStride, uint64_t localStride,
+                                                  uint32_t signalInterval,
+                                                  AscendC::LocalTensor<uint64_t> ubLocal64,
+                                                  AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    if (count == 0) {
+        return 0;
+    }
+    __gm__ SHMEMHybmDeviceMeta* metaPtr = (__gm__ SHMEMHybmDeviceMeta*)(SMEM_SHM_DEVICE_META_ADDR +
+                                                                SMEM_SHM_DEVICE_GLOBAL_META_SIZE);
+    __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(metaPtr->qpInfoAddress);
+    uint32_t qpNum = RDMAInfo->qpNum;
+    __gm__ SHMEMWQCtx* qpCtxEntry = (__gm__ SHMEMWQCtx*)(RDMAInfo->sqPtr
+        + (destRankId * qpNum + qpIdx) * sizeof(SHMEMWQCtx));
+    auto SHMEMmemInfoTable = RDMAInfo->memPtr;
+    __gm__ SHMEMmemInfo* remoteMemInfo = (__gm__ SHMEMmemInfo*)(SHMEMmemInfoTable + sizeof(SHMEMmemInfo) * destRankId);
     __gm__ SHMEMmemInfo* localMemInfo = (__gm__ SHMEMmemInfo*)(SHMEMmemInfoTable
         + sizeof(SHMEMmemInfo) * shmemi_get_my_pe());
-    *(__gm__ uint32_t*)(sgeAddr + 4) = localMemInfo->lkey; // lkey
-    *(__gm__ uint64_t*)(sgeAddr + 8) = (uint64_t)localAddr; // local VA
+    uint32_t rkey = remoteMemInfo->rkey;
+    uint32_t lkey = localMemInfo->lkey;
+    auto sqBaseAddr = qpCtxEntry->bufAddr;
+    auto wqeSize = qpCtxEntry->wqeSize;
+    auto depth = qpCtxEntry->depth;
+    auto curHardwareHeadAddr = qpCtxEntry->headAddr;
+    dcci_cachelines((__gm__ uint8_t*)curHardwareHeadAddr, 8);
+    uint32_t curHead = *(__gm__ uint32_t*)(curHardwareHeadAddr);
+    AscendC::PipeBarrier<PIPE_ALL>();
 
-    // WQE & SGE cache flush
-    dcci_cachelines(wqeAddr, sizeof(SHMEMwqeCtx) + sizeof(SHMEMsegCtx));
+    uint32_t posted = 0;
+    uint32_t sinceSignal = 0;
+    uint32_t credits = shmemi_roce_sq_credits(qpCtxEntry, curHead);
+    while (posted < count) {
+        if (credits == 0) {
+            uint32_t status = 0;
+            credits = shmemi_roce_wait_sq_credits(destRankId, qpIdx, qpCtxEntry, curHead, 1, status,
+                                                  ubLocal64, ubLocal32);
+            if (status != 0) {
+                shmemi_roce_diag_dropped(remoteAddr, destRankId, status);
+                return status;
+            }
+        }
+        uint32_t num = (count - posted) < credits ? (count - posted) : credits;
+        for (uint32_t i = 0; i < num; i++) {
+            bool signaled = (++sinceSignal == signalInterval) || (i == num - 1);
+            if (signaled) {
+                sinceSignal = 0;
+            }
+            __gm__ uint8_t* wqeAddr = (__gm__ uint8_t*)(sqBaseAddr + wqeSize * (curHead % depth));
+            uint64_t offset = posted + i;
+            shmemi_rdma_write_wqe(wqeAddr, curHead, opcode, messageLen, rkey, lkey,
+                                  (uint64_t)remoteAddr + offset * remoteStride,
+                                  (uint64_t)localAddr + offset * localStride, signaled);
+            curHead++;
+        }
+        AscendC::PipeBarrier<PIPE_ALL>();
+        shmemi_rdma_post_send_update_info(ubLocal64, ubLocal32, curHead, qpCtxEntry);
+        posted += num;
+        credits -= num;
+    }
+    return 0;
+}
+
+/**
+ * @brief AIV direct RDMA helper function for put with signal. Writes an unsignaled RDMA WRITE of the payload and a
+ *        fenced, signaled 4 Bytes RDMA WRITE of the signal word behind it, then rings a single doorbell for both.
+ *        The fence keeps the signal from being placed before the payload, so the remote side may consume the
+ *        payload as soon as it observes the signal.
+ *
+ * @param remoteAddr             [in] payload destination address in remote HBM
+ * @param localAddr              [in] payload source address in local HBM
+ * @param messageLen             [in] payload length in Bytes
+ * @param remoteSigAddr          [in] signal word address in remote HBM
+ * @param localSigAddr           [in] address in local HBM holding the signal value, read by the NIC after the post
+ * @param destRankId             [in] destination rank ID
+ * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @return Send queue index of the signal WQE, completed once the WQ tail moves past it. When the QP is in error
+ *         nothing is posted and the index of the last posted WQE is returned.
+ */
+SHMEM_DEVICE uint32_t shmemi_rdma_post_write_signal(__gm__ uint8_t* remoteAddr, __gm__ uint8_t* localAddr,
+                                                    uint64_t messageLen, __gm__ uint8_t* remoteSigAddr,
+                                                    __gm__ uint8_t* localSigAddr, uint32_t destRankId,
+                                                    uint32_t qpIdx, AscendC::LocalTensor<uint64_t> ubLocal64,
+                                                    AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    const uint32_t wqeCount = 2;
+    __gm__ SHMEMHybmDeviceMeta* metaPtr = (__gm__ SHMEMHybmDeviceMeta*)(SMEM_SHM_DEVICE_META_ADDR +
+                                                                SMEM_SHM_DEVICE_GLOBAL_META_SIZE);
+    __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(metaPtr->qpInfoAddress);
+    uint32_t qpNum = RDMAInfo->qpNum;
+    __gm__ SHMEMWQCtx* qpCtxEntry = (__gm__ SHMEMWQCtx*)(RDMAInfo->sqPtr
+        + (destRankId * qpNum + qpIdx) * sizeof(SHMEMWQCtx));
+    auto SHMEMmemInfoTable = RDMAInfo->memPtr;
+    __gm__ SHMEMmemInfo* remoteMemInfo = (__gm__ SHMEMmemInfo*)(SHMEMmemInfoTable + sizeof(SHMEMmemInfo) * destRankId);
+    __gm__ SHMEMmemInfo* localMemInfo = (__gm__ SHMEMmemInfo*)(SHMEMmemInfoTable
+        + sizeof(SHMEMmemInfo) * shmemi_get_my_pe());
+    uint32_t rkey = remoteMemInfo->rkey;
+    uint32_t lkey = localMemInfo->lkey;
+    auto sqBaseAddr = qpCtxEntry->bufAddr;
+    auto wqeSize = qpCtxEntry->wqeSize;
+    auto depth = qpCtxEntry->depth;
+    auto curHardwareHeadAddr = qpCtxEntry->headAddr;
+    dcci_cachelines((__gm__ uint8_t*)curHardwareHeadAddr, 8);
+    uint32_t curHead = *(__gm__ uint32_t*)(curHardwareHeadAddr);
     AscendC::PipeBarrier<PIPE_ALL>();
-    curHead++;
 
+    uint32_t status = 0;
+    shmemi_roce_wait_sq_credits(destRankId, qpIdx, qpCtxEntry, curHead, wqeCount, status, ubLocal64, ubLocal32);
+    if (status != 0) {
+        // QP in error, nothing is posted
+        return curHead - 1;
+    }
+
+    __gm__ uint8_t* wqeAddr = (__gm__ uint8_t*)(sqBaseAddr + wqeSize * (curHead % depth));
+    shmemi_rdma_write_wqe(wqeAddr, curHead, SHMEMAIVOPCODE::OP_RDMA_WRITE, messageLen, rkey, lkey,
+                          (uint64_t)remoteAddr, (uint64_t)localAddr, false);
+    curHead++;
+    wqeAddr = (__gm__ uint8_t*)(sqBaseAddr + wqeSize * (curHead % depth));
+    shmemi_rdma_write_wqe(wqeAddr, curHead, SHMEMAIVOPCODE::OP_RDMA_WRITE, sizeof(int32_t), rkey, lkey,
+                          (uint64_t)remoteSigAddr, (uint64_t)localSigAddr, true, true);
+    uint32_t sigIdx = curHead;
+    curHead++;
+    AscendC::PipeBarrier<PIPE_ALL>();
     shmemi_rdma_post_send_update_info(ubLocal64, ubLocal32, curHead, qpCtxEntry);
+    return sigIdx;
+}
+
+// Layout of one RoCE signal staging slot, see SHMEM_ROCE_SIGNAL_POOL_SIZE.
+constexpr uint32_t SHMEMI_ROCE_SIG_VALUE_OFFSET = 0;   // int32 signal value read by the NIC
+constexpr uint32_t SHMEMI_ROCE_SIG_PE_OFFSET = 8;      // peer of the signal WQE still using the slot
+constexpr uint32_t SHMEMI_ROCE_SIG_QP_OFFSET = 12;     // QP of that WQE
+constexpr uint32_t SHMEMI_ROCE_SIG_IDX_OFFSET = 16;    // send queue index of that WQE
+constexpr uint32_t SHMEMI_ROCE_SIG_BUSY_OFFSET = 20;   // 1 while the WQE may still read the slot
+
+/**
+ * @brief Put with signal staged through a ring of signal slots. The first slot of the ring holds the cursor, the
+ *        others hold the signal value the NIC reads after the post. A slot whose earlier signal WQE may still read
+ *        it is reaped by polling the CQ up to that WQE before the slot is reused.
+ *
+ * @param ring                   [in] SHMEM_ROCE_SIGNAL_SLOTS slots of SHMEMI_SYNCBIT_SIZE Bytes in local HBM
+ * @param remoteAddr             [in] payload destination address in remote HBM
+ * @param localAddr              [in] payload source address in local HBM
+ * @param messageLen             [in] payload length in Bytes
+ * @param remoteSigAddr          [in] signal word address in remote HBM
+ * @param signal                 [in] signal value
+ * @param destRankId             [in] destination rank ID
+ * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
+ * @param blocking               [in] wait for the signal WQE to complete, otherwise leave the slot busy
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ */
+SHMEM_DEVICE void shmemi_roce_put_signal_staged(__gm__ uint8_t* ring, __gm__ uint8_t* remoteAddr,
+                                                __gm__ uint8_t* localAddr, uint64_t messageLen,
+                                                __gm__ uint8_t* remoteSigAddr, int32_t signal, uint32_t destRankId,
+                                                uint32_t qpIdx, bool blocking, AscendC::LocalTensor<uint64_t> ubLocal64,
+                                                AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    dcci_cacheline(ring);
+    uint32_t cursor = *(__gm__ uint32_t*)ring;
+    __gm__ uint8_t* slot = ring + (cursor % (SHMEM_ROCE_SIGNAL_SLOTS - 1) + 1) * SHMEMI_SYNCBIT_SIZE;
+    *(__gm__ uint32_t*)ring = cursor + 1;
+    dcci_cacheline(ring);
+
+    dcci_cacheline(slot);
+    if (*(__gm__ uint32_t*)(slot + SHMEMI_ROCE_SIG_BUSY_OFFSET) != 0) {
+        shmemi_roce_poll_cq(*(__gm__ uint32_t*)(slot + SHMEMI_ROCE_SIG_PE_OFFSET),
+                            *(__gm__ uint32_t*)(slot + SHMEMI_ROCE_SIG_QP_OFFSET),
+                            *(__gm__ uint32_t*)(slot + SHMEMI_ROCE_SIG_IDX_OFFSET) + 1, ubLocal64, ubLocal32);
+    }
+
+    *(__gm__ int32_t*)(slot + SHMEMI_ROCE_SIG_VALUE_OFFSET) = signal;
+    dcci_cacheline(slot);
+    uint32_t sigIdx = shmemi_rdma_post_write_signal(remoteAddr, localAddr, messageLen, remoteSigAddr,
+                                                    slot + SHMEMI_ROCE_SIG_VALUE_OFFSET, destRankId, qpIdx,
+                                                    ubLocal64, ubLocal32);
+    if (blocking) {
+        shmemi_roce_poll_cq(destRankId, qpIdx, sigIdx + 1, ubLocal64, ubLocal32);
+        *(__gm__ uint32_t*)(slot + SHMEMI_ROCE_SIG_BUSY_OFFSET) = 0;
+    } else {
+        *(__gm__ uint32_t*)(slot + SHMEMI_ROCE_SIG_PE_OFFSET) = destRankId;
+        *(__gm__ uint32_t*)(slot + SHMEMI_ROCE_SIG_QP_OFFSET) = qpIdx;
+        *(__gm__ uint32_t*)(slot + SHMEMI_ROCE_SIG_IDX_OFFSET) = sigIdx;
+        *(__gm__ uint32_t*)(slot + SHMEMI_ROCE_SIG_BUSY_OFFSET) = 1;
+    }
+    dcci_cacheline(slot);
 }
 
 SHMEM_DEVICE void shmemi_rdma_post_send_update_info(AscendC::LocalTensor<uint64_t> &ubLocal64,
@@ -332,15 +710,19 @@ SHMEM_DEVICE void shmemi_rdma_post_send_update_info(AscendC::LocalTensor<uint64_
  * @param messageLen             [in] message length in Bytes
  * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
  * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @return 0 on success, otherwise the failed CQE status of shmemi_rdma_post_send.
  */
 template<typename T>
-SHMEM_DEVICE void shmemi_roce_write(__gm__ T* destDmaAddr, __gm__ T* srcDmaAddr, uint32_t destRankId,
-                                    uint32_t qpIdx, uint64_t messageLen,
-                                    AscendC::LocalTensor<uint64_t> ubLocal64,
-                                    AscendC::LocalTensor<uint32_t> ubLocal32)
+SHMEM_DEVICE uint32_t shmemi_roce_write(__gm__ T* destDmaAddr, __gm__ T* srcDmaAddr, uint32_t destRankId,
+                                        uint32_t qpIdx, uint64_t messageLen,
+                                        AscendC::LocalTensor<uint64_t> ubLocal64,
+                                        AscendC::LocalTensor<uint32_t> ubLocal32)
 {
-    shmemi_rdma_post_send(destDmaAddr, srcDmaAddr, destRankId, qpIdx, SHMEMAIVOPCODE::OP_RDMA_WRITE,
-                            messageLen, ubLocal64, ubLocal32);
+    SHMEMI_TRACE_BEGIN(trace_start);
+    uint32_t status = shmemi_rdma_post_send(destDmaAddr, srcDmaAddr, destRankId, qpIdx,
+                                            SHMEMAIVOPCODE::OP_RDMA_WRITE, messageLen, ubLocal64, ubLocal32);
+    SHMEMI_TRACE_END(trace_start, SHMEMX_TRACE_ROCE_WRITE, (int32_t)destRankId, messageLen);
+    return status;
 }
 
 /**
@@ -353,20 +735,208 @@ SHMEM_DEVICE void shmemi_roce_write(__gm__ T* destDmaAddr, __gm__ T* srcDmaAddr,
  * @param messageLen             [in] message length in Bytes
  * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
  * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @return 0 on success, otherwise the failed CQE status of shmemi_rdma_post_send.
+ */
+template<typename T>
+SHMEM_DEVICE uint32_t shmemi_roce_read(__gm__ T* destDmaAddr, __gm__ T* srcDmaAddr, uint32_t srcRankId,
+                                       uint32_t qpIdx, uint64_t messageLen,
+                                       AscendC::LocalTensor<uint64_t> ubLocal64,
+                                       AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    SHMEMI_TRACE_BEGIN(trace_start);
+    uint32_t status = shmemi_rdma_post_send(srcDmaAddr, destDmaAddr, srcRankId, qpIdx,
+                                            SHMEMAIVOPCODE::OP_RDMA_READ, messageLen, ubLocal64, ubLocal32);
+    SHMEMI_TRACE_END(trace_start, SHMEMX_TRACE_ROCE_READ, (int32_t)srcRankId, messageLen);
+    return status;
+}
+
+/**
+ * @brief Number of QPs created to each remote rank, set at init through SHMEM_ROCE_QP_NUM.
+ */
+SHMEM_DEVICE uint32_t shmemi_roce_qp_num()
+{
+    __gm__ SHMEMHybmDeviceMeta* metaPtr = (__gm__ SHMEMHybmDeviceMeta*)(SMEM_SHM_DEVICE_META_ADDR +
+                                                                SMEM_SHM_DEVICE_GLOBAL_META_SIZE);
+    __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(metaPtr->qpInfoAddress);
+    uint32_t qpNum = RDMAInfo->qpNum;
+    return qpNum == 0 ? 1 : qpNum;
+}
+
+/**
+ * @brief First QP to each remote rank owned by the calling core, see shmemi_rdma_post_send_striped.
+ */
+SHMEM_DEVICE uint32_t shmemi_roce_first_owned_qp()
+{
+    return AscendC::GetBlockIdx() % shmemi_roce_qp_num();
+}
+
+/**
+ * @brief Distance between the QPs owned by the calling core, larger than the QP count when it owns a single one.
+ */
+SHMEM_DEVICE uint32_t shmemi_roce_owned_qp_step()
+{
+    uint32_t coreNum = AscendC::GetBlockNum() * AscendC::GetTaskRation();
+    return coreNum == 0 ? shmemi_roce_qp_num() : coreNum;
+}
+
+/**
+ * @brief Posts one RDMA message striped across the QPs owned by the calling core. Core c owns QPs
+ *        c, c + coreNum, ... so that no two cores post to the same QP while coreNum <= qpNum; with more cores
+ *        than QPs each core uses QP (c % qpNum). Messages shorter than SHMEM_ROCE_STRIPE_MIN_BYTES, or cores
+ *        owning a single QP, post one WQE. Completion of all stripes is observed by shmemi_roce_quiet_owned.
+ *
+ * @param remoteAddr             [in] address in remote HBM
+ * @param localAddr              [in] address in local HBM
+ * @param destRankId             [in] remote rank ID
+ * @param opcode                 [in] OP_RDMA_WRITE or OP_RDMA_READ
+ * @param messageLen             [in] message length in Bytes
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @return 0 when every stripe was posted, otherwise the failed CQE status of the first QP in error.
+ */
+SHMEM_DEVICE uint32_t shmemi_rdma_post_send_striped(__gm__ uint8_t* remoteAddr, __gm__ uint8_t* localAddr,
+                                                    uint32_t destRankId, SHMEMAIVOPCODE opcode, uint64_t messageLen,
+                                                    AscendC::LocalTensor<uint64_t> ubLocal64,
+                                                    AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    uint32_t qpNum = shmemi_roce_qp_num();
+    uint32_t step = shmemi_roce_owned_qp_step();
+    uint32_t firstQp = shmemi_roce_first_owned_qp();
+    uint32_t ownedQp = step >= qpNum ? 1 : (qpNum - 1 - firstQp) / step + 1;
+    if (ownedQp == 1 || messageLen < SHMEM_ROCE_STRIPE_MIN_BYTES) {
+        return shmemi_rdma_post_send(remoteAddr, localAddr, destRankId, firstQp, opcode, messageLen,
+                                     ubLocal64, ubLocal32);
+    }
+
+    uint64_t stripe = (messageLen + ownedQp - 1) / ownedQp;
+    stripe = (stripe + SHMEM_ROCE_STRIPE_ALIGN - 1) / SHMEM_ROCE_STRIPE_ALIGN * SHMEM_ROCE_STRIPE_ALIGN;
+    uint64_t offset = 0;
+    uint32_t status = 0;
+    for (uint32_t qpIdx = firstQp; qpIdx < qpNum && offset < messageLen; qpIdx += step) {
+        uint64_t len = (messageLen - offset) < stripe ? (messageLen - offset) : stripe;
+        uint32_t qpStatus = shmemi_rdma_post_send(remoteAddr + offset, localAddr + offset, destRankId, qpIdx, opcode,
+                                                  len, ubLocal64, ubLocal32);
+        status = status != 0 ? status : qpStatus;
+        offset += len;
+    }
+    return status;
+}
+
+/**
+ * @brief Asynchronous RDMA Write striped across the QPs owned by the calling core,
+ *        see shmemi_rdma_post_send_striped.
+ *
+ * @param destDmaAddr            [in] destination address in remote HBM
+ * @param srcDmaAddr             [in] source address in local HBM
+ * @param destRankId             [in] destination rank ID
+ * @param messageLen             [in] message length in Bytes
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @return 0 on success, otherwise the failed CQE status of shmemi_rdma_post_send_striped.
  */
 template<typename T>
-SHMEM_DEVICE void shmemi_roce_read(__gm__ T* destDmaAddr, __gm__ T* srcDmaAddr, uint32_t srcRankId,
-                                   uint32_t qpIdx, uint64_t messageLen,
-                                   AscendC::LocalTensor<uint64_t> ubLocal64,
-                                   AscendC::LocalTensor<uint32_t> ubLocal32)
+SHMEM_DEVICE uint32_t shmemi_roce_write_striped(__gm__ T* destDmaAddr, __gm__ T* srcDmaAddr, uint32_t destRankId,
+                                                uint64_t messageLen, AscendC::LocalTensor<uint64_t> ubLocal64,
+                                                AscendC::LocalTensor<uint32_t> ubLocal32)
 {
-    shmemi_rdma_post_send(srcDmaAddr, destDmaAddr, srcRankId, qpIdx, SHMEMAIVOPCODE::OP_RDMA_READ,
-                            messageLen, ubLocal64, ubLocal32);
+    SHMEMI_TRACE_BEGIN(trace_start);
+    uint32_t status = shmemi_rdma_post_send_striped((__gm__ uint8_t*)destDmaAddr, (__gm__ uint8_t*)srcDmaAddr,
+                                                    destRankId, SHMEMAIVOPCODE::OP_RDMA_WRITE, messageLen,
+                                                    ubLocal64, ubLocal32);
+    SHMEMI_TRACE_END(trace_start, SHMEMX_TRACE_ROCE_WRITE, (int32_t)destRankId, messageLen);
+    return status;
+}
+
+/**
+ * @brief Asynchronous RDMA READ striped across the QPs owned by the calling core,
+ *        see shmemi_rdma_post_send_striped.
+ *
+ * @param destDmaAddr            [in] destination address in local HBM
+ * @param srcDmaAddr             [in] source address in remote HBM
+ * @param srcRankId              [in] source rank ID
+ * @param messageLen             [in] message length in Bytes
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @return 0 on success, otherwise the failed CQE status of shmemi_rdma_post_send_striped.
+ */
+template<typename T>
+SHMEM_DEVICE uint32_t shmemi_roce_read_striped(__gm__ T* destDmaAddr, __gm__ T* srcDmaAddr, uint32_t srcRankId,
+                                               uint64_t messageLen, AscendC::LocalTensor<uint64_t> ubLocal64,
+                                               AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    SHMEMI_TRACE_BEGIN(trace_start);
+    uint32_t status = shmemi_rdma_post_send_striped((__gm__ uint8_t*)srcDmaAddr, (__gm__ uint8_t*)destDmaAddr,
+                                                    srcRankId, SHMEMAIVOPCODE::OP_RDMA_READ, messageLen,
+                                                    ubLocal64, ubLocal32);
+    SHMEMI_TRACE_END(trace_start, SHMEMX_TRACE_ROCE_READ, (int32_t)srcRankId, messageLen);
+    return status;
+}
+
+/**
+ * @brief Asynchronous batched RDMA Write function, posts count messages with a single doorbell.
+ *
+ * @param destDmaAddr            [in] destination address of the first message in remote HBM
+ * @param srcDmaAddr             [in] source address of the first message in local HBM
+ * @param destRankId             [in] destination rank ID
+ * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
+ * @param messageLen             [in] message length of each message in Bytes
+ * @param count                  [in] number of messages
+ * @param destStride             [in] distance between consecutive destination messages in Bytes
+ * @param srcStride              [in] distance between consecutive source messages in Bytes
+ * @param signalInterval         [in] request a CQE every signalInterval messages, 0 only for the last one
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @return 0 on success, otherwise the failed CQE status of shmemi_rdma_post_send_batch.
+ */
+template<typename T>
+SHMEM_DEVICE uint32_t shmemi_roce_write_batch(__gm__ T* destDmaAddr, __gm__ T* srcDmaAddr, uint32_t destRankId,
+                                              uint32_t qpIdx, uint64_t messageLen, uint32_t count,
+                                              uint64_t destStride, uint64_t srcStride, uint32_t signalInterval,
+                                              AscendC::LocalTensor<uint64_t> ubLocal64,
+                                              AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    SHMEMI_TRACE_BEGIN(trace_start);
+    uint32_t status = shmemi_rdma_post_send_batch((__gm__ uint8_t*)destDmaAddr, (__gm__ uint8_t*)srcDmaAddr, destRankId,
+                                                  qpIdx, SHMEMAIVOPCODE::OP_RDMA_WRITE, messageLen, count,
+                                                  destStride, srcStride, signalInterval, ubLocal64, ubLocal32);
+    SHMEMI_TRACE_END(trace_start, SHMEMX_TRACE_ROCE_WRITE, (int32_t)destRankId, messageLen * count);
+    return status;
+}
+
+/**
+ * @brief Asynchronous batched RDMA READ function, posts count messages with a single doorbell.
+ *
+ * @param destDmaAddr            [in] destination address of the first message in local HBM
+ * @param srcDmaAddr             [in] source address of the first message in remote HBM
+ * @param srcRankId              [in] source rank ID
+ * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
+ * @param messageLen             [in] message length of each message in Bytes
+ * @param count                  [in] number of messages
+ * @param destStride             [in] distance between consecutive destination messages in Bytes
+ * @param srcStride              [in] distance between consecutive source messages in Bytes
+ * @param signalInterval         [in] request a CQE every signalInterval messages, 0 only for the last one
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @return 0 on success, otherwise the failed CQE status of shmemi_rdma_post_send_batch.
+ */
+template<typename T>
+SHMEM_DEVICE uint32_t shmemi_roce_read_batch(__gm__ T* destDmaAddr, __gm__ T* srcDmaAddr, uint32_t srcRankId,
+                                             uint32_t qpIdx, uint64_t messageLen, uint32_t count,
+                                             uint64_t destStride, uint64_t srcStride, uint32_t signalInterval,
+                                             AscendC::LocalTensor<uint64_t> ubLocal64,
+                                             AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    SHMEMI_TRACE_BEGIN(trace_start);
+    uint32_t status = shmemi_rdma_post_send_batch((__gm__ uint8_t*)srcDmaAddr, (__gm__ uint8_t*)destDmaAddr, srcRankId,
+                                                  qpIdx, SHMEMAIVOPCODE::OP_RDMA_READ, messageLen, count,
+                                                  srcStride, destStride, signalInterval, ubLocal64, ubLocal32);
+    SHMEMI_TRACE_END(trace_start, SHMEMX_TRACE_ROCE_READ, (int32_t)srcRankId, messageLen * count);
+    return status;
 }
 
 /**
  * @brief RDMA Quiet function. This synchronous function ensures all previous RDMA WQEs are completed
- * (data has arrived at the destination NIC).
+ * (data has arrived at the destination NIC), including the unsignaled WQEs of batched posts.
  *
  * @param remoteRankId           [in] destination rank ID
  * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
@@ -377,6 +947,7 @@ SHMEM_DEVICE void shmemi_roce_quiet(uint32_t remoteRankId, uint32_t qpIdx,
                                     AscendC::LocalTensor<uint64_t> ubLocal64,
                                     AscendC::LocalTensor<uint32_t> ubLocal32)
 {
+    SHMEMI_TRACE_BEGIN(trace_start);
     __gm__ SHMEMHybmDeviceMeta* metaPtr = (__gm__ SHMEMHybmDeviceMeta*)(SMEM_SHM_DEVICE_META_ADDR +
                                                                 SMEM_SHM_DEVICE_GLOBAL_META_SIZE);
     __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(metaPtr->qpInfoAddress);
@@ -387,6 +958,26 @@ SHMEM_DEVICE void shmemi_roce_quiet(uint32_t remoteRankId, uint32_t qpIdx,
     dcci_cachelines((__gm__ uint8_t*)curHardwareHeadAddr, 8);
     uint32_t curHead = *(__gm__ uint32_t*)(curHardwareHeadAddr);
     shmemi_roce_poll_cq(remoteRankId, qpIdx, curHead, ubLocal64, ubLocal32);
+    SHMEMI_TRACE_END(trace_start, SHMEMX_TRACE_ROCE_QUIET, (int32_t)remoteRankId, 0);
+}
+
+/**
+ * @brief RDMA Quiet on the QPs to the remote rank owned by the calling core, waits for every stripe it posted.
+ *        QPs of other cores are left alone, their owners reap the completions and move the WQ tail. A kernel
+ *        launched with a single core owns, and waits for, every QP.
+ *
+ * @param remoteRankId           [in] destination rank ID
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ */
+SHMEM_DEVICE void shmemi_roce_quiet_owned(uint32_t remoteRankId, AscendC::LocalTensor<uint64_t> ubLocal64,
+                                          AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    uint32_t qpNum = shmemi_roce_qp_num();
+    uint32_t step = shmemi_roce_owned_qp_step();
+    for (uint32_t qpIdx = shmemi_roce_first_owned_qp(); qpIdx < qpNum; qpIdx += step) {
+        shmemi_roce_quiet(remoteRankId, qpIdx, ubLocal64, ubLocal32);
+    }
 }
 
 SHMEM_DEVICE void shmemi_roce_qpinfo_test(__gm__ uint8_t* gva, uint32_t destRankId, uint32_t qpIdx)
@@ -82,4 +82,167 @@ SHMEM_TYPE_FUNC_ATOMIC_INT(SHMEM_ATOMIC_ADD_TYPENAME);
     }
 
 SHMEM_TYPE_FUNC_ATOMIC_FLOAT(SHMEM_ATOMIC_ADD_TYPENAME_FLOAT);
+
+#define SHMEM_ATOMIC_ADD_NBI_TYPENAME(NAME, TYPE, ATOMIC_TYPE)                                                     \
+    /**                                                                                                            \
+     * @brief Asynchronous interface. Issue an atomic add to the symmetric element on the specified PE without     \
+     *        waiting for it. The update is complete after the next shmem_quiet, shmem_fence or barrier.           \
+     *                                                                                                             \
+     * @param dst               [in] Pointer on local device of the destination data.                              \
+     * @param value             [in] Value atomic add to destination.                                              \
+     * @param pe                [in] PE number of the remote PE.                                                   \
+     */                                                                                                            \
+    SHMEM_DEVICE void shmem_##NAME##_atomic_add_nbi(__gm__ TYPE *dst, TYPE value, int32_t pe)                      \
+    {                                                                                                              \
+        /* ROCE */                                                                                                 \
+        /* RDMA */                                                                                                 \
+        /* MTE  */                                                                                                 \
+        set_st_atomic_cfg(ATOMIC_TYPE, ATOMIC_SUM);                                                                \
+        st_atomic(value, (__gm__ TYPE *)shmemi_ptr(dst, pe));                                                      \
+    }
+
+SHMEM_TYPE_FUNC_ATOMIC_INT(SHMEM_ATOMIC_ADD_NBI_TYPENAME);
+SHMEM_TYPE_FUNC_ATOMIC_FLOAT(SHMEM_ATOMIC_ADD_NBI_TYPENAME);
+
+// Distinct PEs one shmemx_<type>_atomic_add_vec call sums up before it issues the atomics.
+constexpr uint32_t SHMEMI_ATOMIC_ADD_VEC_BUCKETS = 32;
+
+#define SHMEMX_ATOMIC_ADD_VEC_TYPENAME(NAME, TYPE, ATOMIC_TYPE)                                                    \
+    /**                                                                                                            \
+     * @brief Asynchronous interface. Atomically add values[i] to dst on PE pes[i] for i in [0, n).                \
+     *        Entries are summed per PE in SHMEMI_ATOMIC_ADD_VEC_BUCKETS buckets and every bucket is issued        \
+     *        as one atomic add, entries need not be sorted. Complete after the next shmem_quiet.                  \
+     *                                                                                                             \
+     * @param dst               [in] Pointer on local device of the destination data.                              \
+     * @param values            [in] Values atomic add to destination.                                             \
+     * @param pes               [in] PE number of each value.                                                      \
+     * @param n                 [in] Number of entries.                                                            \
+     */                                                                                                            \
+    SHMEM_DEVICE void shmemx_##NAME##_atomic_add_vec(__gm__ TYPE *dst, __gm__ TYPE *values, __gm__ int32_t *pes,   \
+                                                      uint32_t n)                                                  \
+    {                                                                                                              \
+        int32_t bucket_pe[SHMEMI_ATOMIC_ADD_VEC_BUCKETS];                                                          \
+        TYPE bucket_sum[SHMEMI_ATOMIC_ADD_VEC_BUCKETS];                                                            \
+        uint32_t used = 0;                                                                                         \
+        for (uint32_t i = 0; i < n; i++) {                                                                         \
+            int32_t pe = pes[i];                                                                                   \
+            uint32_t b = 0;                                                                                        \
+            while (b < used && bucket_pe[b] != pe) {                                                               \
+                b++;                                                                                               \
+            }                                                                                                      \
+            if (b == used) {                                                                                       \
+                /* more distinct PEs than buckets: drain them and start over */                                    \
+                if (used == SHMEMI_ATOMIC_ADD_VEC_BUCKETS) {                                                       \
+                    for (uint32_t k = 0; k < used; k++) {                                                          \
+                        shmem_##NAME##_atomic_add_nbi(dst, bucket_sum[k], bucket_pe[k]);                           \
+                    }                                                                                              \
+                    used = 0;                                                                                      \
+                    b = 0;                                                                                         \
+                }                                                                                                  \
+                bucket_pe[b] = pe;                                                                                 \
+                bucket_sum[b] = values[i];                                                                         \
+                used++;                                                                                            \
+                continue;                                                                                          \
+            }                                                                                                      \
+            bucket_sum[b] += values[i];                                                                            \
+        }                                                                                                          \
+        for (uint32_t k = 0; k < used; k++) {                                                                      \
+            shmem_##NAME##_atomic_add_nbi(dst, bucket_sum[k], bucket_pe[k]);                                       \
+        }                                                                                                          \
+    }
+
+SHMEM_TYPE_FUNC_ATOMIC_INT(SHMEMX_ATOMIC_ADD_VEC_TYPENAME);
+SHMEM_TYPE_FUNC_ATOMIC_FLOAT(SHMEMX_ATOMIC_ADD_VEC_TYPENAME);
+
+#define SHMEM_ATOMIC_FETCH_TYPENAME(NAME, TYPE)                                                                    \
+    /**                                                                                                            \
+     * @brief Synchronous interface. Atomically add value to the symmetric element on the specified PE             \
+     *        and return its previous content.                                                                     \
+     *                                                                                                             \
+     * @param dst               [in] Symmetric address of the destination element on local PE.                     \
+     * @param value             [in] Value atomic add to destination.                                              \
+     * @param pe                [in] PE number of the remote PE.                                                   \
+     * @return The content of dst on PE before the add. Traps when pe is not reachable over MTE, see               \
+     *         SHMEMX_DIAG_ERR_NO_ROUTE.                                                                           \
+     */                                                                                                            \
+    SHMEM_DEVICE TYPE shmem_##NAME##_atomic_fetch_add(__gm__ TYPE *dst, TYPE value, int32_t pe)                    \
+    {                                                                                                              \
+        /* RoCE has no remote atomics here, there is no old value to return */                                     \
+        if (shmemi_get_route(pe) != SHMEM_TRANSPORT_MTE) {                                                         \
+            shmemi_diag_fatal(SHMEMX_DIAG_ERR_NO_ROUTE, dst, pe);                                                  \
+        }                                                                                                          \
+        dcci_atomic();                                                                                             \
+        dsb_all();                                                                                                 \
+        TYPE old = AscendC::AtomicAdd((__gm__ TYPE *)shmemi_ptr(dst, pe), value);                                  \
+        dcci_atomic();                                                                                             \
+        return old;                                                                                                \
+    }                                                                                                              \
+                                                                                                                   \
+    /**                                                                                                            \
+     * @brief Synchronous interface. Atomically replace the symmetric element on the specified PE with value       \
+     *        if it equals cond.                                                                                   \
+     *                                                                                                             \
+     * @param dst               [in] Symmetric address of the destination element on local PE.                     \
+     * @param cond              [in] Value compared with destination.                                              \
+     * @param value             [in] Value written to destination when the comparison succeeds.                    \
+     * @param pe                [in] PE number of the remote PE.                                                   \
+     * @return The content of dst on PE before the operation, equal to cond when the swap happened. Traps when     \
+     *         pe is not reachable over MTE, see SHMEMX_DIAG_ERR_NO_ROUTE.                                         \
+     */                                                                                                            \
+    SHMEM_DEVICE TYPE shmem_##NAME##_atomic_compare_swap(__gm__ TYPE *dst, TYPE cond, TYPE value, int32_t pe)      \
+    {                                                                                                              \
+        /* RoCE has no remote atomics here, there is no old value to return */                                     \
+        if (shmemi_get_route(pe) != SHMEM_TRANSPORT_MTE) {                                                         \
+            shmemi_diag_fatal(SHMEMX_DIAG_ERR_NO_ROUTE, dst, pe);                                                  \
+        }                                                                                                          \
+        dcci_atomic();                                                                                             \
+        dsb_all();                                                                                                 \
+        TYPE old = AscendC::AtomicCas((__gm__ TYPE *)shmemi_ptr(dst, pe), cond, value);                            \
+        dcci_atomic();                                                                                             \
+        return old;                                                                                                \
+    }                                                                                                              \
+                                                                                                                   \
+    /**                                                                                                            \
+     * @brief Synchronous interface. Atomically write value to the symmetric element on the specified PE           \
+     *        and return its previous content.                                                                     \
+     *                                                                                                             \
+     * @param dst               [in] Symmetric address of the destination element on local PE.                     \
+     * @param value             [in] Value written to destination.                                                 \
+     * @param pe                [in] PE number of the remote PE.                                                   \
+     * @return The content of dst on PE before the swap. Traps when pe is not reachable over MTE, see              \
+     *         SHMEMX_DIAG_ERR_NO_ROUTE.                                                                           \
+     */                                                                                                            \
+    SHMEM_DEVICE TYPE shmem_##NAME##_atomic_swap(__gm__ TYPE *dst, TYPE value, int32_t pe)                         \
+    {                                                                                                              \
+        /* RoCE has no remote atomics here, there is no old value to return */                                     \
+        if (shmemi_get_route(pe) != SHMEM_TRANSPORT_MTE) {                                                         \
+            shmemi_diag_fatal(SHMEMX_DIAG_ERR_NO_ROUTE, dst, pe);                                                  \
+        }                                                                                                          \
+        dcci_atomic();                                                                                             \
+        dsb_all();                                                                                                 \
+        TYPE old = AscendC::AtomicExch((__gm__ TYPE *)shmemi_ptr(dst, pe), value);                                 \
+        dcci_atomic();                                                                                             \
+        return old;                                                                                                \
+    }                                                                                                              \
+                                                                                                                   \
+    /**                                                                                                            \
+     * @brief Synchronous interface. Atomically read the symmetric element on the specified PE.                    \
+     *        Naturally aligned 32/64 bit loads are single-copy atomic, only the cache line is refreshed.          \
+     *                                                                                                             \
+     * @param src               [in] Symmetric address of the source element on local PE.                          \
+     * @param pe                [in] PE number of the remote PE.                                                   \
+     * @return The content of src on PE. Traps when pe is not reachable over MTE, see SHMEMX_DIAG_ERR_NO_ROUTE.    \
+     */                                                                                                            \
+    SHMEM_DEVICE TYPE shmem_##NAME##_atomic_fetch(__gm__ TYPE *src, int32_t pe)                                    \
+    {                                                                                                              \
+        /* RoCE has no remote atomics here, there is no old value to return */                                     \
+        if (shmemi_get_route(pe) != SHMEM_TRANSPORT_MTE) {                                                         \
+            shmemi_diag_fatal(SHMEMX_DIAG_ERR_NO_ROUTE, src, pe);                                                  \
+        }                                                                                                          \
+        __gm__ TYPE *addr_gm = (__gm__ TYPE *)shmemi_ptr(src, pe);                                                 \
+        dcci_cacheline((__gm__ uint8_t *)addr_gm);                                                                 \
+        return *((__gm__ volatile TYPE *)addr_gm);                                                                 \
+    }
+
+SHMEM_TYPE_FUNC_ATOMIC_FETCH(SHMEM_ATOMIC_FETCH_TYPENAME);
 #endif
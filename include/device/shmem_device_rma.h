@@ -65,6 +65,46 @@
     FUNC(uint64, uint64_t);        \
     FUNC(char, char);
 
+/**
+ * @brief Post a contiguous RoCE put or get of bytes between local memory and the symmetric address remote on pe,
+ *        striped over the QPs of the calling core. Serves the RMA routines for peers routed over RoCE.
+ */
+SHMEM_DEVICE void shmemi_roce_rma_nbi(__gm__ uint8_t *remote, __gm__ uint8_t *local, uint64_t bytes, int32_t pe,
+                                      bool is_put)
+{
+    auto ptr = shmem_ptr(remote, pe);
+    if (ptr == nullptr) return;
+    AscendC::LocalTensor<uint32_t> ub_tensor_32;
+    ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_32.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR);
+    ub_tensor_32.address_.dataLen = UB_ALIGN_SIZE;
+    AscendC::LocalTensor<uint64_t> ub_tensor_64;
+    ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR + UB_ALIGN_SIZE);
+    ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
+    if (is_put) {
+        shmemi_roce_write_striped((__gm__ uint8_t *)ptr, local, pe, bytes, ub_tensor_64, ub_tensor_32);
+    } else {
+        shmemi_roce_read_striped(local, (__gm__ uint8_t *)ptr, pe, bytes, ub_tensor_64, ub_tensor_32);
+    }
+}
+
+/**
+ * @brief Wait for every RoCE put and get the calling core posted to pe, the RoCE half of the blocking routines.
+ */
+SHMEM_DEVICE void shmemi_roce_rma_quiet(int32_t pe)
+{
+    AscendC::LocalTensor<uint32_t> ub_tensor_32;
+    ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_32.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR);
+    ub_tensor_32.address_.dataLen = UB_ALIGN_SIZE;
+    AscendC::LocalTensor<uint64_t> ub_tensor_64;
+    ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR + UB_ALIGN_SIZE);
+    ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
+    shmemi_roce_quiet_owned(pe, ub_tensor_64, ub_tensor_32);
+}
+
 #define SHMEM_TYPENAME_P_AICORE(NAME, TYPE)                                                 \
     /**                                                                                     \
      * @brief Provide a low latency put capability for single element of most basic types.  \
@@ -84,6 +124,27 @@
 
 SHMEM_TYPE_FUNC(SHMEM_TYPENAME_P_AICORE);
 
+#define SHMEMX_TYPENAME_P_NBI_AICORE(NAME, TYPE)                                            \
+    /**                                                                                     \
+     * @brief Deferred version of shmem_##NAME##_p. The destination cacheline is written    \
+     *        back by the next shmem_fence, shmemx_quiet_pe, shmem_quiet or barrier, so      \
+     *        consecutive puts into the same cacheline cost a single writeback.              \
+     *                                                                                      \
+     * @param dst               [in] Symmetric address of the destination data on local PE. \
+     * @param value             [in] The element to be put.                                 \
+     * @param pe                [in] The number of the remote PE.                           \
+     */                                                                                     \
+    SHMEM_DEVICE void shmemx_##NAME##_p_nbi(__gm__ TYPE *dst, const TYPE value, int pe)     \
+    {                                                                                       \
+        auto ptr = shmem_ptr(dst, pe);                                                      \
+        __gm__ TYPE *addr_gm = reinterpret_cast<__gm__ TYPE *>(ptr);                        \
+                                                                                            \
+        *addr_gm = value;                                                                   \
+        shmemi_fence_track(addr_gm, pe);                                                    \
+    }
+
+SHMEM_TYPE_FUNC(SHMEMX_TYPENAME_P_NBI_AICORE);
+
 #define SHMEM_TYPENAME_G_AICORE(NAME, TYPE)                                                 \
     /**                                                                                     \
      * @brief Provide a low latency get capability for single element of most basic types.  \
@@ -114,8 +175,11 @@ SHMEM_TYPE_FUNC(SHMEM_TYPENAME_G_AICORE);
  */
 SHMEM_DEVICE void shmem_getmem(__gm__ void *dst, __gm__ void *src, uint32_t elem_size, int32_t pe)
 {
-    /* ROCE */
-    /* RDMA */
+    if (shmemi_get_route(pe) == SHMEM_TRANSPORT_ROCE) {
+        shmemi_roce_rma_nbi((__gm__ uint8_t *)src, (__gm__ uint8_t *)dst, elem_size, pe, false);
+        shmemi_roce_rma_quiet(pe);
+        return;
+    }
     /* MTE  */
     /* Global State Get */
     __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
@@ -140,8 +204,12 @@ SHMEM_DEVICE void shmem_getmem(__gm__ void *dst, __gm__ void *src, uint32_t elem
      */                                                                                                          \
     SHMEM_DEVICE void shmem_get_##NAME##_mem(__gm__ TYPE *dst, __gm__ TYPE *src, uint32_t elem_size, int32_t pe) \
     {                                                                                                            \
-        /* ROCE */                                                                                               \
-        /* RDMA */                                                                                               \
+        if (shmemi_get_route(pe) == SHMEM_TRANSPORT_ROCE) {                                                      \
+            shmemi_roce_rma_nbi((__gm__ uint8_t *)src, (__gm__ uint8_t *)dst, elem_size * sizeof(TYPE), pe,      \
+                                false);                                                                          \
+            shmemi_roce_rma_quiet(pe);                                                                           \
+            return;                                                                                              \
+        }                                                                                                        \
         /* MTE  */                                                                                               \
         /* Global State Get */                                                                                   \
         __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                    \
@@ -166,8 +234,11 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM);
  */
 SHMEM_DEVICE void shmem_putmem(__gm__ void *dst, __gm__ void *src, uint32_t elem_size, int32_t pe)
 {
-    /* ROCE */
-    /* RDMA */
+    if (shmemi_get_route(pe) == SHMEM_TRANSPORT_ROCE) {
+        shmemi_roce_rma_nbi((__gm__ uint8_t *)dst, (__gm__ uint8_t *)src, elem_size, pe, true);
+        shmemi_roce_rma_quiet(pe);
+        return;
+    }
     /* MTE  */
     /* Global State Get */
     __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
@@ -191,8 +262,12 @@ SHMEM_DEVICE void shmem_putmem(__gm__ void *dst, __gm__ void *src, uint32_t elem
      */                                                                                                           \
     SHMEM_DEVICE void shmem_put_##NAME##_mem(__gm__ TYPE *dst, __gm__ TYPE *src, uint32_t elem_size, int32_t pe)  \
     {                                                                                                             \
-        /* ROCE */                                                                                                \
-        /* RDMA */                                                                                                \
+        if (shmemi_get_route(pe) == SHMEM_TRANSPORT_ROCE) {                                                       \
+            shmemi_roce_rma_nbi((__gm__ uint8_t *)dst, (__gm__ uint8_t *)src, elem_size * sizeof(TYPE), pe,       \
+                                true);                                                                            \
+            shmemi_roce_rma_quiet(pe);                                                                            \
+            return;                                                                                               \
+        }                                                                                                         \
         /* MTE  */                                                                                                \
         /* Global State Get */                                                                                    \
         __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                     \
@@ -218,8 +293,10 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM);
  */
 SHMEM_DEVICE void shmem_getmem_nbi(__gm__ void *dst, __gm__ void *src, uint32_t elem_size, int32_t pe)
 {
-    /* ROCE */
-    /* RDMA */
+    if (shmemi_get_route(pe) == SHMEM_TRANSPORT_ROCE) {
+        shmemi_roce_rma_nbi((__gm__ uint8_t *)src, (__gm__ uint8_t *)dst, elem_size, pe, false);
+        return;
+    }
     /* MTE  */
     /* Global State Get */
     __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
@@ -247,7 +324,7 @@ SHMEM_DEVICE void shmem_getmem_nbi(__gm__ void *dst, __gm__ void *src, uint32_t
     {                                                                                                                \
         /* Global State Get */                                                                                       \
         __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                        \
-        if (device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) {                                                     \
+        if (shmemi_get_route(pe) == SHMEM_TRANSPORT_MTE) {                                                           \
             /* MTE  */                                                                                               \
             /* CopyUB Config Set */                                                                                  \
             uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                    \
@@ -255,22 +332,10 @@ SHMEM_DEVICE void shmem_getmem_nbi(__gm__ void *dst, __gm__ void *src, uint32_t
             AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                  \
             shmem_mte_get_mem_nbi(dst, src, reinterpret_cast<__ubuf__ TYPE *>(copy_ub), copy_ub_size, elem_size, pe, \
                                     copy_event_id);                                                                  \
-        } else if (device_state->topo_list[pe] & SHMEM_TRANSPORT_ROCE) {                                             \
+        } else if (shmemi_get_route(pe) == SHMEM_TRANSPORT_ROCE) {                                                   \
             /* RoCE */                                                                                               \
-            auto ptr = shmem_ptr(src, pe);                                                                           \
-            if (ptr == nullptr) return;                                                                              \
-            /* Create LocalTensor */                                                                                 \
-            AscendC::LocalTensor<uint32_t> ub_tensor_32;                                                             \
-            ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);                       \
-            ub_tensor_32.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR);         \
-            ub_tensor_32.address_.dataLen = UB_ALIGN_SIZE;                                                           \
-            AscendC::LocalTensor<uint64_t> ub_tensor_64;                                                             \
-            ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);                       \
-            ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR           \
-                                                                             + UB_ALIGN_SIZE);                       \
-            ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;                                                           \
-            shmemi_roce_read((__gm__ uint8_t*)dst, (__gm__ uint8_t*)ptr, pe, 0, elem_size * sizeof(TYPE),            \
-                                ub_tensor_64, ub_tensor_32);                                                         \
+            shmemi_roce_rma_nbi((__gm__ uint8_t *)src, (__gm__ uint8_t *)dst, elem_size * sizeof(TYPE), pe,          \
+                                false);                                                                              \
         }                                                                                                            \
     }
 
@@ -321,7 +386,7 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_DETAILED_NBI);
     {                                                                                                              \
         /* Global State Get */                                                                                     \
         __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                      \
-        if (device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) {                                                   \
+        if (shmemi_get_route(pe) == SHMEM_TRANSPORT_MTE) {                                                         \
             /* MTE  */                                                                                             \
             /* CopyUB Config Set */                                                                                \
             uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                  \
@@ -332,22 +397,10 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_DETAILED_NBI);
             ub_tensor.address_.dataLen = device_state->mte_config.ub_size;                                         \
             AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                \
             shmem_mte_get_mem_nbi(dst, src, ub_tensor, elem_size, pe, copy_event_id);                              \
-        } else if (device_state->topo_list[pe] & SHMEM_TRANSPORT_ROCE) {                                           \
+        } else if (shmemi_get_route(pe) == SHMEM_TRANSPORT_ROCE) {                                                 \
             /* RoCE */                                                                                             \
-            auto ptr = shmem_ptr((__gm__ void *)src.GetPhyAddr(), pe);                                             \
-            if (ptr == nullptr) return;                                                                            \
-            /* Create LocalTensor */                                                                               \
-            AscendC::LocalTensor<uint32_t> ub_tensor_32;                                                           \
-            ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);                     \
-            ub_tensor_32.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR);       \
-            ub_tensor_32.address_.dataLen = UB_ALIGN_SIZE;                                                         \
-            AscendC::LocalTensor<uint64_t> ub_tensor_64;                                                           \
-            ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);                     \
-            ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR         \
-                                                                            + UB_ALIGN_SIZE);                      \
-            ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;                                                         \
-            shmemi_roce_read((__gm__ uint8_t*)(dst.GetPhyAddr()), (__gm__ uint8_t*)ptr, pe, 0,                     \
-                                elem_size * sizeof(TYPE), ub_tensor_64, ub_tensor_32);                             \
+            shmemi_roce_rma_nbi((__gm__ uint8_t *)src.GetPhyAddr(), (__gm__ uint8_t *)dst.GetPhyAddr(),            \
+                                elem_size * sizeof(TYPE), pe, false);                                              \
         }                                                                                                          \
     }
 
@@ -399,7 +452,7 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_TENSOR_DETAILED_NBI);
     {                                                                                                                \
         /* Global State Get */                                                                                       \
         __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                        \
-        if (device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) {                                                     \
+        if (shmemi_get_route(pe) == SHMEM_TRANSPORT_MTE) {                                                           \
             /* MTE  */                                                                                               \
             /* CopyUB Config Set */                                                                                  \
             uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                    \
@@ -407,22 +460,10 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_TENSOR_DETAILED_NBI);
             AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                  \
             shmem_mte_put_mem_nbi(dst, src, reinterpret_cast<__ubuf__ TYPE *>(copy_ub), copy_ub_size, elem_size, pe, \
                                     copy_event_id);                                                                  \
-        } else if (device_state->topo_list[pe] & SHMEM_TRANSPORT_ROCE) {                                             \
+        } else if (shmemi_get_route(pe) == SHMEM_TRANSPORT_ROCE) {                                                   \
             /* RoCE */                                                                                               \
-            auto ptr = shmem_ptr(dst, pe);                                                                           \
-            if (ptr == nullptr) return;                                                                              \
-            /* Create LocalTensor */                                                                                 \
-            AscendC::LocalTensor<uint32_t> ub_tensor_32;                                                             \
-            ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);                       \
-            ub_tensor_32.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR);         \
-            ub_tensor_32.address_.dataLen = UB_ALIGN_SIZE;                                                           \
-            AscendC::LocalTensor<uint64_t> ub_tensor_64;                                                             \
-            ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);                       \
-            ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR           \
-                                                                            + UB_ALIGN_SIZE);                        \
-            ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;                                                           \
-            shmemi_roce_write((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)src, pe, 0, elem_size * sizeof(TYPE),           \
-                                    ub_tensor_64, ub_tensor_32);                                                     \
+            shmemi_roce_rma_nbi((__gm__ uint8_t *)dst, (__gm__ uint8_t *)src, elem_size * sizeof(TYPE), pe,          \
+                                true);                                                                               \
         }                                                                                                            \
     }
 
@@ -472,7 +513,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_DETAILED_NBI);
     {                                                                                                              \
         /* Global State Get */                                                                                     \
         __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                      \
-        if (device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) {                                                   \
+        if (shmemi_get_route(pe) == SHMEM_TRANSPORT_MTE) {                                                         \
             /* MTE  */                                                                                             \
             /* CopyUB Config Set */                                                                                \
             uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                  \
@@ -483,22 +524,10 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_DETAILED_NBI);
             ub_tensor.address_.dataLen = device_state->mte_config.ub_size;                                         \
             AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                \
             shmem_mte_put_mem_nbi(dst, src, ub_tensor, elem_size, pe, copy_event_id);                              \
-        } else if (device_state->topo_list[pe] & SHMEM_TRANSPORT_ROCE) {                                           \
+        } else if (shmemi_get_route(pe) == SHMEM_TRANSPORT_ROCE) {                                                 \
             /* RoCE */                                                                                             \
-            auto ptr = shmem_ptr((__gm__ void *)dst.GetPhyAddr(), pe);                                             \
-            if (ptr == nullptr) return;                                                                            \
-            /* Create LocalTensor */                                                                               \
-            AscendC::LocalTensor<uint32_t> ub_tensor_32;                                                           \
-            ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);                     \
-            ub_tensor_32.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR);       \
-            ub_tensor_32.address_.dataLen = UB_ALIGN_SIZE;                                                         \
-            AscendC::LocalTensor<uint64_t> ub_tensor_64;                                                           \
-            ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);                     \
-            ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR         \
-                                                                            + UB_ALIGN_SIZE);                      \
-            ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;                                                         \
-            shmemi_roce_write((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)(src.GetPhyAddr()), pe, 0,                    \
-                                                    elem_size * sizeof(TYPE), ub_tensor_64, ub_tensor_32);         \
+            shmemi_roce_rma_nbi((__gm__ uint8_t *)dst.GetPhyAddr(), (__gm__ uint8_t *)src.GetPhyAddr(),            \
+                                elem_size * sizeof(TYPE), pe, true);                                               \
         }                                                                                                          \
     }
 
@@ -632,6 +661,10 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_UB_TENSOR_DETAILED_NBI);
  */
 SHMEM_DEVICE void shmem_putmem_nbi(__gm__ void *dst, __gm__ void *src, uint32_t elem_size, int32_t pe)
 {
+    if (shmemi_get_route(pe) == SHMEM_TRANSPORT_ROCE) {
+        shmemi_roce_rma_nbi((__gm__ uint8_t *)dst, (__gm__ uint8_t *)src, elem_size, pe, true);
+        return;
+    }
     /* MTE  */
     /* Global State Get */
     __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
@@ -730,7 +763,8 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_UB_TENSOR_DETAILED_NBI);
 
 /**
  * @brief Synchronous interface. Copy contiguous data on local PE to symmetric address on the specified PE
- *       then update sig_addr
+ *       then update sig_addr. For a peer reached over RoCE, SHMEM_SIGNAL_SET is posted as a fenced write
+ *       behind the data write under a single doorbell.
  *
  * @param dst               [in] Pointer on local device of the destination data.
  * @param src               [in] Pointer on Symmetric memory of the source data.
@@ -749,6 +783,11 @@ SHMEM_DEVICE void shmem_putmem_signal(__gm__ void *dst, __gm__ void *src, size_t
     /* MTE  */
     /* Global State Set */
     __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    if (shmemi_roce_signal_path(sig_op, pe, sig_addr)) {
+        shmemi_roce_put_signal((__gm__ uint8_t *)dst, (__gm__ uint8_t *)src,
+                               elem_size, sig_addr, signal, pe, true);
+        return;
+    }
     /* CopyUB Config Set */
     uint64_t copy_ub = device_state->mte_config.shmem_ub;
     uint32_t copy_ub_size = device_state->mte_config.ub_size;
@@ -776,6 +815,11 @@ SHMEM_DEVICE void shmem_putmem_signal(__gm__ void *dst, __gm__ void *src, size_t
                                                     __gm__ int32_t *sig_addr, int32_t signal, int sig_op, int pe) \
     { /* ROCE */ /* RDMA */ /* MTE  */ /* Global State Set */                                                     \
         __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                     \
+        if (shmemi_roce_signal_path(sig_op, pe, sig_addr)) {                                                      \
+            shmemi_roce_put_signal((__gm__ uint8_t *)dst, (__gm__ uint8_t *)src,                                  \
+                                   elem_size * sizeof(TYPE), sig_addr, signal, pe, true);                         \
+            return;                                                                                               \
+        }                                                                                                         \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                   \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                     \
         uint32_t copy_ub_size = device_state->mte_config.ub_size;                                                 \
@@ -806,6 +850,11 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL);
                                                     int sig_op, int pe)                                               \
     { /* ROCE */ /* RDMA */ /* MTE  */ /* Global State Set */                                                         \
         __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                         \
+        if (shmemi_roce_signal_path(sig_op, pe, sig_addr)) {                                                          \
+            shmemi_roce_put_signal((__gm__ uint8_t *)dst.GetPhyAddr(), (__gm__ uint8_t *)src.GetPhyAddr(),            \
+                                   elem_size * sizeof(TYPE), sig_addr, signal, pe, true);                             \
+            return;                                                                                                   \
+        }                                                                                                             \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                       \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                         \
         AscendC::LocalTensor<TYPE> ub_tensor;                                                                         \
@@ -886,7 +935,8 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_TENSOR_DETAILED);
 
 /**
  * @brief Asynchronous interface. Copy contiguous data on local PE to symmetric address on the specified PE then update
- * sig_addr
+ * sig_addr. For a peer reached over RoCE, SHMEM_SIGNAL_SET is posted as a fenced write behind the data write under a
+ * single doorbell.
  *
  * @param dst               [in] Pointer on local device of the destination data.
  * @param src               [in] Pointer on Symmetric memory of the source data.
@@ -905,6 +955,11 @@ SHMEM_DEVICE void shmem_putmem_signal_nbi(__gm__ void *dst, __gm__ void *src, si
     /* MTE  */
     /* Global State Set */
     __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    if (shmemi_roce_signal_path(sig_op, pe, sig_addr)) {
+        shmemi_roce_put_signal((__gm__ uint8_t *)dst, (__gm__ uint8_t *)src,
+                               elem_size, sig_addr, signal, pe, false);
+        return;
+    }
     /* CopyUB Config Set */
     uint64_t copy_ub = device_state->mte_config.shmem_ub;
     uint32_t copy_ub_size = device_state->mte_config.ub_size;
@@ -932,6 +987,11 @@ SHMEM_DEVICE void shmem_putmem_signal_nbi(__gm__ void *dst, __gm__ void *src, si
                                                         __gm__ int32_t *sig_addr, int32_t signal, int sig_op, int pe) \
     { /* ROCE */ /* RDMA */ /* MTE  */ /* Global State Set */                                                         \
         __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                         \
+        if (shmemi_roce_signal_path(sig_op, pe, sig_addr)) {                                                          \
+            shmemi_roce_put_signal((__gm__ uint8_t *)dst, (__gm__ uint8_t *)src,                                      \
+                                   elem_size * sizeof(TYPE), sig_addr, signal, pe, false);                            \
+            return;                                                                                                   \
+        }                                                                                                             \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                       \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                         \
         uint32_t copy_ub_size = device_state->mte_config.ub_size;                                                     \
@@ -962,6 +1022,11 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_NBI);
                                                         __gm__ int32_t *sig_addr, int32_t signal, int sig_op, int pe) \
     { /* ROCE */ /* RDMA */ /* MTE  */ /* Global State Set */                                                         \
         __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                         \
+        if (shmemi_roce_signal_path(sig_op, pe, sig_addr)) {                                                          \
+            shmemi_roce_put_signal((__gm__ uint8_t *)dst.GetPhyAddr(), (__gm__ uint8_t *)src.GetPhyAddr(),            \
+                                   elem_size * sizeof(TYPE), sig_addr, signal, pe, false);                            \
+            return;                                                                                                   \
+        }                                                                                                             \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                       \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                         \
         AscendC::LocalTensor<TYPE> ub_tensor;                                                                         \
@@ -1056,4 +1121,81 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_TENSOR_DETAILED_NBI);
     }
 
 SHMEM_TEST_TYPE_FUNC(SHMEM_TEST);
+
+#define SHMEM_WAIT_UNTIL_ANY_SOME(NAME, TYPE)                                                                    \
+    /**                                                                                                          \
+     * @brief Wait until any one entry of the local array ivars satisfies the comparison. Entries are scanned    \
+     *        through UB in bulk, so whichever peer finishes first is consumed first.                            \
+     *                                                                                                           \
+     * @param ivars              [in] Local symmetric array of nelems contiguous entries.                        \
+     * @param nelems             [in] Number of entries.                                                         \
+     * @param status             [in] Entries with status[i] != 0 are excluded, may be NULL.                     \
+     * @param cmp                [in] Comparison operator, same as shmem_signal_wait_until.                      \
+     * @param cmp_value          [in] The value compared with every entry.                                       \
+     * @return Index of a satisfied entry, or SIZE_MAX if every entry is excluded.                               \
+     */                                                                                                          \
+    SHMEM_DEVICE size_t shmem_##NAME##_wait_until_any(__gm__ TYPE *ivars, size_t nelems, const int *status,      \
+                                                      int cmp, TYPE cmp_value)                                   \
+    {                                                                                                            \
+        return shmemi_wait_until_any(ivars, nelems, status, cmp, cmp_value);                                     \
+    }                                                                                                            \
+                                                                                                                 \
+    /**                                                                                                          \
+     * @brief Wait until at least one entry of the local array ivars satisfies the comparison, then report       \
+     *        every entry satisfied by the same scan.                                                            \
+     *                                                                                                           \
+     * @param ivars              [in] Local symmetric array of nelems contiguous entries.                        \
+     * @param nelems             [in] Number of entries.                                                         \
+     * @param indices            [out] Receives the indices of the satisfied entries, up to nelems.              \
+     * @param status             [in] Entries with status[i] != 0 are excluded, may be NULL.                     \
+     * @param cmp                [in] Comparison operator, same as shmem_signal_wait_until.                      \
+     * @param cmp_value          [in] The value compared with every entry.                                       \
+     * @return Number of indices written, 0 if every entry is excluded.                                          \
+     */                                                                                                          \
+    SHMEM_DEVICE size_t shmem_##NAME##_wait_until_some(__gm__ TYPE *ivars, size_t nelems, size_t *indices,       \
+                                                       const int *status, int cmp, TYPE cmp_value)               \
+    {                                                                                                            \
+        return shmemi_wait_until_some(ivars, nelems, indices, status, cmp, cmp_value);                           \
+    }                                                                                                            \
+                                                                                                                 \
+    /**                                                                                                          \
+     * @brief Same as shmem_##NAME##_wait_until_any, entry i is compared with cmp_values[i].                     \
+     */                                                                                                          \
+    SHMEM_DEVICE size_t shmem_##NAME##_wait_until_any_vector(__gm__ TYPE *ivars, size_t nelems,                  \
+                                                             const int *status, int cmp, const TYPE *cmp_values) \
+    {                                                                                                            \
+        return shmemi_wait_until_any(ivars, nelems, status, cmp, (TYPE)0, cmp_values);                           \
+    }                                                                                                            \
+                                                                                                                 \
+    /**                                                                                                          \
+     * @brief Same as shmem_##NAME##_wait_until_some, entry i is compared with cmp_values[i].                    \
+     */                                                                                                          \
+    SHMEM_DEVICE size_t shmem_##NAME##_wait_until_some_vector(__gm__ TYPE *ivars, size_t nelems,                 \
+                                                              size_t *indices, const int *status, int cmp,       \
+                                                              const TYPE *cmp_values)                            \
+    {                                                                                                            \
+        return shmemi_wait_until_some(ivars, nelems, indices, status, cmp, (TYPE)0, cmp_values);                 \
+    }
+
+SHMEM_TEST_TYPE_FUNC(SHMEM_WAIT_UNTIL_ANY_SOME);
+
+#define SHMEMX_WAIT_UNTIL_TIMEOUT(NAME, TYPE)                                                                    \
+    /**                                                                                                          \
+     * @brief Wait until the local ivar satisfies the comparison, giving up after timeout_cycles system cycles.  \
+     *        Polls back off exponentially between cache invalidations, an expired wait is recorded to the wait  \
+     *        diagnostic ring, see shmemx_wait_diag_dump.                                                        \
+     *                                                                                                           \
+     * @param ivar               [in] Local symmetric address of the entry to wait on.                           \
+     * @param cmp                [in] Comparison operator, same as shmem_signal_wait_until.                      \
+     * @param cmp_value          [in] The value compared with ivar.                                              \
+     * @param timeout_cycles     [in] Cycle budget of the system counter (50 per microsecond), 0 never expires.  \
+     * @return 0 once the comparison holds, -1 on timeout or an unknown comparison operator.                      \
+     */                                                                                                          \
+    SHMEM_DEVICE int shmemx_##NAME##_wait_until_timeout(__gm__ TYPE *ivar, int cmp, TYPE cmp_value,              \
+                                                        int64_t timeout_cycles)                                  \
+    {                                                                                                            \
+        return shmemi_wait_until_bounded(ivar, cmp, cmp_value, timeout_cycles, true);                            \
+    }
+
+SHMEM_TEST_TYPE_FUNC(SHMEMX_WAIT_UNTIL_TIMEOUT);
 #endif
@@ -41,6 +41,7 @@
 #include "internal/device/sync/shmemi_device_barrier.h"
 #include "internal/device/sync/shmemi_device_handle.h"
 #include "internal/device/sync/shmemi_device_partial_barrier.h"
+#include "internal/device/sync/shmemi_device_split_barrier.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -132,6 +133,69 @@ SHMEM_DEVICE void shmemx_partial_barrier_vec(shmem_team_t tid, __gm__ uint32_t *
     shmemi_partial_barrier<true>(tid, pes, count);
 }
 
+/**
+ * @brief Split-phase barrier, first half. Publishes the arrival of the calling PE at a barrier over the team and
+ *        returns without waiting for the other PEs, so that independent work can overlap the barrier latency.
+ *        Stores issued before the call are visible to the team once the matching shmemx_barrier_wait returns.
+ *        Every arrive must be completed by shmemx_barrier_wait before the next barrier on the team.
+ *        Teams spanning several hosts complete the whole barrier here.
+ *
+ * @param tid              [in] team to do barrier
+ * @return Token identifying this barrier, to be passed to shmemx_barrier_wait and shmemx_barrier_test.
+ */
+SHMEM_DEVICE int32_t shmemx_barrier_arrive(shmem_team_t tid)
+{
+    return shmemi_barrier_arrive<false>(tid);
+}
+
+/**
+ * @brief Split-phase barrier, second half. Returns after all PEs in the team have called shmemx_barrier_arrive for
+ *        the barrier identified by token.
+ *
+ * @param tid              [in] team to do barrier
+ * @param token            [in] Token returned by shmemx_barrier_arrive.
+ */
+SHMEM_DEVICE void shmemx_barrier_wait(shmem_team_t tid, int32_t token)
+{
+    shmemi_barrier_wait<false>(tid, token);
+}
+
+/**
+ * @brief Similar to shmemx_barrier_arrive except that only vector cores participate.
+ *
+ * @param tid              [in] team to do barrier
+ * @return Token identifying this barrier, to be passed to shmemx_barrier_wait_vec and shmemx_barrier_test.
+ */
+SHMEM_DEVICE int32_t shmemx_barrier_arrive_vec(shmem_team_t tid)
+{
+    return shmemi_barrier_arrive<true>(tid);
+}
+
+/**
+ * @brief Similar to shmemx_barrier_wait except that only vector cores participate.
+ *
+ * @param tid              [in] team to do barrier
+ * @param token            [in] Token returned by shmemx_barrier_arrive_vec.
+ */
+SHMEM_DEVICE void shmemx_barrier_wait_vec(shmem_team_t tid, int32_t token)
+{
+    shmemi_barrier_wait<true>(tid, token);
+}
+
+/**
+ * @brief Non-blocking check of a split-phase barrier, called by a single vector core. Returns 1 once all PEs in the
+ *        team have arrived, after which their stores issued before arriving are visible to the calling core.
+ *        shmemx_barrier_wait must still be called to complete the barrier.
+ *
+ * @param tid              [in] team to do barrier
+ * @param token            [in] Token returned by shmemx_barrier_arrive or shmemx_barrier_arrive_vec.
+ * @return Returns 1 if all PEs have arrived, otherwise 0.
+ */
+SHMEM_DEVICE int shmemx_barrier_test(shmem_team_t tid, int32_t token)
+{
+    return shmemi_barrier_test(tid, token);
+}
+
 /**
  * @brief The shmem_quiet routine ensures completion of all operations on symmetric data objects issued by the
  *        calling PE.
@@ -149,10 +213,11 @@ SHMEM_DEVICE void shmem_quiet()
 }
 
 /**
- * @brief In OpenSHMEM specification, shmem_fence assures ordering of delivery of Put, AMOs, and memory store routines
- *        to symmetric data objects, but does not guarantee the completion of these operations.
- *        However, due to hardware capabilities, we implemented shmem_fence same as shmem_quiet, ensuring both ordering
- *        and completion.
+ * @brief shmem_fence assures ordering of delivery of Put, AMOs, and memory store routines issued through SHMEM
+ *        to symmetric data objects, without guaranteeing their completion. Outstanding MTE puts are waited for,
+ *        non-blocking atomics drained and only the cachelines recorded by deferred stores (shmemx_<type>_p_nbi)
+ *        are written back, instead of the entire data cache as shmem_quiet does. Stores made directly through
+ *        shmem_ptr still require shmem_quiet.
  *        Fence operations issued on the CPU and the NPU only order communication operations that were issued from the
  *        CPU and the NPU, respectively. To ensure completion of GPU-side operations from the CPU,
  *        using aclrtSynchronizeStream/aclrtDeviceSynchronize or stream-based API.
@@ -160,7 +225,30 @@ SHMEM_DEVICE void shmem_quiet()
  */
 SHMEM_DEVICE void shmem_fence()
 {
-    shmemi_quiet();
+    shmemi_fence();
+}
+
+/**
+ * @brief Complete the operations issued by the calling core that target pe. MTE puts and non-blocking atomics are
+ *        completed for every destination, deferred stores only for pe, so stores to other PEs stay coalesced.
+ *
+ * @param pe                    [in] PE number of the remote PE.
+ */
+SHMEM_DEVICE void shmemx_quiet_pe(int pe)
+{
+    shmemi_quiet_pe(pe);
+}
+
+/**
+ * @brief Non-blocking progress of the RoCE transport. Reaps the completions the NIC has already written for the QPs
+ *        owned by the calling core, at most one poll window per QP, and returns their send queue slots, so a
+ *        kernel can retire RDMA work between compute steps instead of stalling in a later post or quiet.
+ *
+ * @return Number of completions reaped, or the negated CQE status of the first failed completion.
+ */
+SHMEM_DEVICE int shmemx_roce_progress()
+{
+    return shmemi_roce_progress();
 }
 
 /**
@@ -195,6 +283,24 @@ SHMEM_DEVICE int32_t shmem_signal_wait_until(__gm__ int32_t *sig_addr, int cmp,
     return shmemi_signal_wait_until(sig_addr, cmp, cmp_val);
 }
 
+/**
+ * @brief Bounded version of shmem_signal_wait_until. Polls back off exponentially between cache invalidations and
+ *        the wait gives up after timeout_cycles system cycles, recording the expiry to the wait diagnostic ring that
+ *        the host reads with shmemx_wait_diag_fetch or shmemx_wait_diag_dump.
+ *
+ * @param sig_addr              [in] Local address of the source signal variable.
+ * @param cmp                   [in] The comparison operator that compares sig_addr with cmp_val, same as
+ *                                   shmem_signal_wait_until.
+ * @param cmp_val               [in] The value against which the object pointed to by sig_addr will be compared.
+ * @param timeout_cycles        [in] Cycle budget of the system counter (50 per microsecond), 0 never expires.
+ * @return Return 0 once the wait condition holds, -1 on timeout or an unknown comparison operator.
+ */
+SHMEM_DEVICE int shmemx_signal_wait_until_timeout(__gm__ int32_t *sig_addr, int cmp, int32_t cmp_val,
+                                                  int64_t timeout_cycles)
+{
+    return shmemi_wait_until_bounded(sig_addr, cmp, cmp_val, timeout_cycles, true);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEM_HOST_ATOMIC_H
+#define SHMEM_HOST_ATOMIC_H
+
+#include "acl/acl.h"
+#include "shmem_host_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SHMEM_TYPE_ATOMIC_FETCH(NAME, TYPE)                                                                           \
+    /**                                                                                                               \
+     * @brief Synchronous interface. Atomically add value to the symmetric element on the specified PE and return     \
+     *        its previous content. Pending shmem_p updates are drained before the operation is issued.               \
+     *                                                                                                                \
+     * @param dst               [in] Symmetric address of the destination element on local PE.                        \
+     * @param value             [in] Value atomic add to destination.                                                 \
+     * @param pe                [in] PE number of the remote PE.                                                      \
+     * @return The content of dst on PE before the add.                                                               \
+     */                                                                                                               \
+    SHMEM_HOST_API TYPE shmem_##NAME##_atomic_fetch_add(TYPE *dst, TYPE value, int pe);                               \
+                                                                                                                      \
+    /**                                                                                                               \
+     * @brief Synchronous interface. Atomically replace the symmetric element on the specified PE with value if it    \
+     *        equals cond.                                                                                            \
+     *                                                                                                                \
+     * @param dst               [in] Symmetric address of the destination element on local PE.                        \
+     * @param cond              [in] Value compared with destination.                                                 \
+     * @param value             [in] Value written to destination when the comparison succeeds.                       \
+     * @param pe                [in] PE number of the remote PE.                                                      \
+     * @return The content of dst on PE before the operation, equal to cond when the swap happened.                   \
+     */                                                                                                               \
+    SHMEM_HOST_API TYPE shmem_##NAME##_atomic_compare_swap(TYPE *dst, TYPE cond, TYPE value, int pe);                 \
+                                                                                                                      \
+    /**                                                                                                               \
+     * @brief Synchronous interface. Atomically write value to the symmetric element on the specified PE and return   \
+     *        its previous content.                                                                                   \
+     *                                                                                                                \
+     * @param dst               [in] Symmetric address of the destination element on local PE.                        \
+     * @param value             [in] Value written to destination.                                                    \
+     * @param pe                [in] PE number of the remote PE.                                                      \
+     * @return The content of dst on PE before the swap.                                                              \
+     */                                                                                                               \
+    SHMEM_HOST_API TYPE shmem_##NAME##_atomic_swap(TYPE *dst, TYPE value, int pe);                                    \
+                                                                                                                      \
+    /**                                                                                                               \
+     * @brief Synchronous interface. Atomically read the symmetric element on the specified PE.                       \
+     *                                                                                                                \
+     * @param src               [in] Symmetric address of the source element on local PE.                             \
+     * @param pe                [in] PE number of the remote PE.                                                      \
+     * @return The content of src on PE.                                                                              \
+     */                                                                                                               \
+    SHMEM_HOST_API TYPE shmem_##NAME##_atomic_fetch(TYPE *src, int pe)
+
+SHMEM_TYPE_FUNC_ATOMIC_FETCH(SHMEM_TYPE_ATOMIC_FETCH);
+#undef SHMEM_TYPE_ATOMIC_FETCH
+
+#define SHMEMX_TYPE_ATOMIC_ADD_VEC(NAME, TYPE)                                                                        \
+    /**                                                                                                               \
+     * @brief Atomically add values[i] to dst on PE pes[i] for i in [0, n) from a single launch. Entries targeting    \
+     *        the same PE are summed on the host first, so each PE receives at most one atomic add. The updates are   \
+     *        complete after the next barrier, shmem_handle_wait or synchronization of the default stream.            \
+     *                                                                                                                \
+     * @param dst               [in] Symmetric address of the destination element on local PE.                        \
+     * @param values            [in] Host array of values atomic add to destination.                                  \
+     * @param pes               [in] Host array holding the PE number of each value.                                  \
+     * @param n                 [in] Number of entries.                                                               \
+     * @return Returns 0 on success or an error code on failure.                                                      \
+     */                                                                                                               \
+    SHMEM_HOST_API int shmemx_##NAME##_atomic_add_vec(TYPE *dst, const TYPE *values, const int *pes, size_t n)
+
+SHMEM_TYPE_FUNC_ATOMIC_ADD_HOST(SHMEMX_TYPE_ATOMIC_ADD_VEC);
+#undef SHMEMX_TYPE_ATOMIC_ADD_VEC
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -45,6 +45,16 @@ extern "C" {
     FUNC(uint32, uint32_t);   \
     FUNC(uint64, uint64_t);   \
     FUNC(char, char)
+
+/**
+ * @brief Atomic Add Types and Names available on host, the device side also provides half.
+ */
+#define SHMEM_TYPE_FUNC_ATOMIC_ADD_HOST(FUNC) \
+    FUNC(int8, int8_t);                      \
+    FUNC(int16, int16_t);                    \
+    FUNC(int32, int32_t);                    \
+    FUNC(float, float)
+
 /**
  * @defgroup group_macros Macros
  * @{
@@ -97,6 +107,7 @@ enum shmem_init_status_t {
 enum shmem_transport_t : uint8_t {
     SHMEM_TRANSPORT_MTE = 1 << 0,    ///< MTE Transport.
     SHMEM_TRANSPORT_ROCE = 1 << 1,   ///< RDMA Transport (RoCE).
+    SHMEM_TRANSPORT_SDMA = 1 << 2,   ///< SDMA Transport.
 };
 
 /**@} */  // end of group_enums
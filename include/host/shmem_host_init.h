@@ -45,6 +45,9 @@ SHMEM_HOST_API int shmem_set_attr(int my_rank, int n_ranks, uint64_t local_mem_s
  *        If this method is not used, the default data_op_engine_type value is SHMEM_DATA_OP_MTE
  *        if method <b>shmem_set_attr()</b> is used after this method, the data_op_engine_type param
  *        will be overwritten by the default value.
+ *        SHMEM_DATA_OP_HOST runs the PEs as processes of one host without NPUs: the symmetric heaps live in a
+ *        POSIX shared memory region and host RMA, atomics and world barriers are CPU loads, stores and futexes.
+ *        Kernels and teams other than SHMEM_TEAM_WORLD are not available with it.
  *
  * @param attributes        [in/out] Pointer to the attributes to modify the data operation engine type
  * @param value             [in] Value of data operation engine type
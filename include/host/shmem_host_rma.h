@@ -102,6 +102,107 @@ SHMEM_TYPE_FUNC(SHMEM_TYPE_GET)
 SHMEM_TYPE_FUNC(SHMEM_TYPE_GET_NBI)
 #undef SHMEM_TYPE_GET_NBI
 
+#define SHMEM_TYPE_IPUT(NAME, TYPE)                                                                                   \
+    /**                                                                                                               \
+    * @brief Synchronous interface. Copy strided data on local PE to strided symmetric address on the specified PE.   \
+    *                                                                                                                 \
+    * @param dest               [in] Pointer on Symmetric memory of the destination data.                             \
+    * @param source             [in] Pointer on local device of the source data.                                      \
+    * @param dst                [in] Stride between consecutive elements of dest, in elements (>= 1).                 \
+    * @param sst                [in] Stride between consecutive elements of source, in elements (>= 1).               \
+    * @param nelems             [in] Number of elements to be copied.                                                 \
+    * @param pe                 [in] PE number of the remote PE.                                                      \
+    */                                                                                                                \
+    SHMEM_HOST_API void shmem_##NAME##_iput(TYPE *dest, TYPE *source, ptrdiff_t dst, ptrdiff_t sst, size_t nelems,    \
+                                            int pe);
+
+SHMEM_TYPE_FUNC(SHMEM_TYPE_IPUT)
+#undef SHMEM_TYPE_IPUT
+
+#define SHMEM_TYPE_IGET(NAME, TYPE)                                                                                   \
+    /**                                                                                                               \
+    * @brief Synchronous interface. Copy strided data on symmetric memory from the specified PE to strided address    \
+    *        on the local PE.                                                                                         \
+    *                                                                                                                 \
+    * @param dest               [in] Pointer on local device of the destination data.                                 \
+    * @param source             [in] Pointer on Symmetric memory of the source data.                                  \
+    * @param dst                [in] Stride between consecutive elements of dest, in elements (>= 1).                 \
+    * @param sst                [in] Stride between consecutive elements of source, in elements (>= 1).               \
+    * @param nelems             [in] Number of elements to be copied.                                                 \
+    * @param pe                 [in] PE number of the remote PE.                                                      \
+    */                                                                                                                \
+    SHMEM_HOST_API void shmem_##NAME##_iget(TYPE *dest, TYPE *source, ptrdiff_t dst, ptrdiff_t sst, size_t nelems,    \
+                                            int pe);
+
+SHMEM_TYPE_FUNC(SHMEM_TYPE_IGET)
+#undef SHMEM_TYPE_IGET
+
+#define SHMEMX_TYPE_PUT_2D(NAME, TYPE)                                                                                \
+    /**                                                                                                               \
+    * @brief Synchronous interface. Copy a 2-D block (rows x cols) on local PE to symmetric address on the specified  \
+    *        PE in a single launch.                                                                                   \
+    *                                                                                                                 \
+    * @param dest               [in] Pointer on Symmetric memory of the first row of the destination block.          \
+    * @param source             [in] Pointer on local device of the first row of the source block.                    \
+    * @param rows               [in] Number of rows.                                                                  \
+    * @param cols               [in] Number of contiguous elements in each row.                                       \
+    * @param dst_ld             [in] Leading dimension of dest, in elements (>= cols).                                \
+    * @param src_ld             [in] Leading dimension of source, in elements (>= cols).                              \
+    * @param pe                 [in] PE number of the remote PE.                                                      \
+    */                                                                                                                \
+    SHMEM_HOST_API void shmemx_##NAME##_put_2d(TYPE *dest, TYPE *source, size_t rows, size_t cols, size_t dst_ld,     \
+                                               size_t src_ld, int pe);
+
+SHMEM_TYPE_FUNC(SHMEMX_TYPE_PUT_2D)
+#undef SHMEMX_TYPE_PUT_2D
+
+#define SHMEMX_TYPE_GET_2D(NAME, TYPE)                                                                                \
+    /**                                                                                                               \
+    * @brief Synchronous interface. Copy a 2-D block (rows x cols) on symmetric memory from the specified PE to       \
+    *        address on the local PE in a single launch.                                                              \
+    *                                                                                                                 \
+    * @param dest               [in] Pointer on local device of the first row of the destination block.               \
+    * @param source             [in] Pointer on Symmetric memory of the first row of the source block.                \
+    * @param rows               [in] Number of rows.                                                                  \
+    * @param cols               [in] Number of contiguous elements in each row.                                       \
+    * @param dst_ld             [in] Leading dimension of dest, in elements (>= cols).                                \
+    * @param src_ld             [in] Leading dimension of source, in elements (>= cols).                              \
+    * @param pe                 [in] PE number of the remote PE.                                                      \
+    */                                                                                                                \
+    SHMEM_HOST_API void shmemx_##NAME##_get_2d(TYPE *dest, TYPE *source, size_t rows, size_t cols, size_t dst_ld,     \
+                                               size_t src_ld, int pe);
+
+SHMEM_TYPE_FUNC(SHMEMX_TYPE_GET_2D)
+#undef SHMEMX_TYPE_GET_2D
+
+/**
+* @brief Synchronous interface. Byte-granular 2-D copy from local PE to symmetric address on the specified PE.
+*
+* @param dst                [in] Pointer on Symmetric memory of the first row of the destination block.
+* @param dst_pitch          [in] Distance in bytes between the starts of two consecutive dst rows (>= width).
+* @param src                [in] Pointer on local device of the first row of the source block.
+* @param src_pitch          [in] Distance in bytes between the starts of two consecutive src rows (>= width).
+* @param width              [in] Number of contiguous bytes in each row.
+* @param height             [in] Number of rows.
+* @param pe                 [in] PE number of the remote PE.
+*/
+SHMEM_HOST_API void shmemx_putmem_2d(void* dst, size_t dst_pitch, void* src, size_t src_pitch,
+                                     size_t width, size_t height, int32_t pe);
+
+/**
+* @brief Synchronous interface. Byte-granular 2-D copy from symmetric memory on the specified PE to the local PE.
+*
+* @param dst                [in] Pointer on local device of the first row of the destination block.
+* @param dst_pitch          [in] Distance in bytes between the starts of two consecutive dst rows (>= width).
+* @param src                [in] Pointer on Symmetric memory of the first row of the source block.
+* @param src_pitch          [in] Distance in bytes between the starts of two consecutive src rows (>= width).
+* @param width              [in] Number of contiguous bytes in each row.
+* @param height             [in] Number of rows.
+* @param pe                 [in] PE number of the remote PE.
+*/
+SHMEM_HOST_API void shmemx_getmem_2d(void* dst, size_t dst_pitch, void* src, size_t src_pitch,
+                                     size_t width, size_t height, int32_t pe);
+
 #define SHMEM_PUT_TYPENAME_MEM_SIGNAL(NAME, TYPE)                                                                     \
     /**                                                                                                               \
     * @brief Synchronous interface. Copy a contiguous data on local UB to symmetric address on the specified PE.      \
@@ -143,6 +244,8 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_NBI)
 #define SHMEM_TYPENAME_P(NAME, TYPE)                                                        \
     /**                                                                                     \
     * @brief Provide a low latency put capability for single element of most basic types.   \
+    *        Puts are aggregated and drained in batches, they are complete after the next   \
+    *        barrier, shmem_handle_wait or shmemx_p_flush.                                  \
     *                                                                                       \
     * @param dst               [in] Symmetric address of the destination data on local PE.  \
     * @param value             [in] The element to be put.                                  \
@@ -166,6 +269,29 @@ SHMEM_TYPE_FUNC(SHMEM_TYPENAME_P)
 SHMEM_TYPE_FUNC(SHMEM_TYPENAME_G)
 #undef SHMEM_TYPENAME_G
 
+#define SHMEMX_TYPENAME_G_VEC(NAME, TYPE)                                                   \
+    /**                                                                                     \
+    * @brief Get n single elements from (srcs[i], pes[i]) pairs with one launch and one     \
+    *        device to host copy.                                                           \
+    *                                                                                       \
+    * @param values            [out] Host array receiving the n elements.                   \
+    * @param srcs              [in] Symmetric addresses of the source elements on local PE. \
+    * @param pes               [in] PE number of each element.                              \
+    * @param n                 [in] Number of elements.                                     \
+    * @return Returns 0 on success or an error code on failure.                             \
+    */                                                                                      \
+    SHMEM_HOST_API int shmemx_##NAME##_g_vec(TYPE* values, TYPE* const* srcs, const int* pes, size_t n);
+
+SHMEM_TYPE_FUNC(SHMEMX_TYPENAME_G_VEC)
+#undef SHMEMX_TYPENAME_G_VEC
+
+/**
+ * @brief Launch all aggregated host shmem_<type>_p calls and wait until they are complete.
+ *
+ * @return Returns 0 on success or an error code on failure.
+ */
+SHMEM_HOST_API int shmemx_p_flush(void);
+
 /**
 * @brief Synchronous interface. Copy contiguous data on symmetric memory from local PE to address on the specified PE.
 *
@@ -190,6 +316,9 @@ SHMEM_HOST_API void shmem_getmem(void* dst, void* src, size_t elem_size, int32_t
 /**
 * @brief Asynchronous interface. Copy contiguous data on symmetric memory from the specified PE to
 *        address on the local PE.
+*        Copies of at least SHMEM_SDMA_MIN_BYTES to an SDMA reachable PE are carried by the SDMA engine and
+*        overlap later compute kernels, which are not ordered behind the copy. It is complete before the next
+*        host RMA or host atomic runs, and at the next shmem_barrier or shmem_handle_wait.
 *
 * @param dst                [in] Pointer on Symmetric addr of local PE.
 * @param src                [in] Pointer on local memory of the source data.
@@ -201,6 +330,9 @@ SHMEM_HOST_API void shmem_putmem_nbi(void* dst, void* src, size_t elem_size, int
 /**
 * @brief Asynchronous interface. Copy contiguous data on symmetric memory from the specified PE to
 *        address on the local PE.
+*        Copies of at least SHMEM_SDMA_MIN_BYTES to an SDMA reachable PE are carried by the SDMA engine and
+*        overlap later compute kernels, which are not ordered behind the copy. It is complete before the next
+*        host RMA or host atomic runs, and at the next shmem_barrier or shmem_handle_wait.
 *
 * @param dst                [in] Pointer on local device of the destination data.
 * @param src                [in] Pointer on Symmetric memory of the source data.
@@ -250,6 +382,18 @@ SHMEM_HOST_API void shmem_putmem_signal(void* dst, void* src, size_t elem_size,
  */
 SHMEM_HOST_API void shmemx_getmem_on_stream(void* dst, void* src, size_t elem_size,
                                             int32_t pe, aclrtStream stream);
+/**
+ * @brief Submit a list of RMA descriptors and run all of them from a single kernel launch. Descriptors are
+ *        distributed across cores, the whole batch is complete when the stream reaches the end of the launch.
+ *        The descriptor array is copied before returning and may be reused by the caller immediately.
+ *
+ * @param desc              [in] Array of descriptors, see shmemx_rma_desc_t.
+ * @param n                 [in] Number of descriptors.
+ * @param stream            [in] Stream used for the launch (use default stream if stream == NULL).
+ * @return Returns 0 on success or an error code on failure. No descriptor is executed if any is invalid.
+ */
+SHMEM_HOST_API int shmemx_rma_batch(const shmemx_rma_desc_t *desc, size_t n, aclrtStream stream);
+
 #ifdef __cplusplus
 }
 #endif
@@ -62,6 +62,58 @@ SHMEM_HOST_API void shmem_handle_wait(shmem_handle_t handle, aclrtStream stream)
  */
 SHMEM_HOST_API void shmemx_barrier_all_on_stream(aclrtStream stream);
 
+/**
+ * @brief Set the budget after which device side barrier and wait_until loops report themselves to the wait
+ *        diagnostic ring. Reported waits keep waiting, the shmemx_*_timeout device routines give up instead.
+ *        The initial budget comes from the SHMEM_WAIT_TIMEOUT_US environment variable, 30s by default.
+ *
+ * @param timeout_us       [in] Budget in microseconds, 0 disables the check. At most INT64_MAX / 50, the
+ *                              budget is counted in 50MHz system counter cycles.
+ * @return Returns 0 on success, SHMEM_INVALID_VALUE when timeout_us is out of range.
+ */
+SHMEM_HOST_API int32_t shmemx_set_wait_timeout(uint64_t timeout_us);
+
+/**
+ * @brief Copy the wait diagnostic ring of the local device, oldest record first. Safe to call while a kernel is
+ *        still stuck in a wait.
+ *
+ * @param records          [out] Host array receiving at most max_records records, the newest ones are kept.
+ * @param max_records      [in] Capacity of records.
+ * @param count            [out] Number of records written.
+ * @return Returns 0 on success or an error code on failure.
+ */
+SHMEM_HOST_API int32_t shmemx_wait_diag_fetch(shmemx_wait_diag_record_t *records, uint32_t max_records,
+                                              uint32_t *count);
+
+/**
+ * @brief Log every record of the wait diagnostic ring of the local device at error level.
+ *
+ * @return Returns the number of records logged, or an error code on failure.
+ */
+SHMEM_HOST_API int32_t shmemx_wait_diag_dump();
+
+/**
+ * @brief Copy and clear the device trace rings of the local device, oldest record first. Records are only written
+ *        when the library and the calling kernels are built with SHMEM_ENABLE_TRACE, call it once the traced
+ *        kernels have completed.
+ *
+ * @param records          [out] Host array receiving at most max_records records, the newest ones are kept.
+ * @param max_records      [in] Capacity of records.
+ * @param count            [out] Number of records written.
+ * @return Returns 0 on success or an error code on failure.
+ */
+SHMEM_HOST_API int32_t shmemx_trace_drain(shmemx_trace_record_t *records, uint32_t max_records, uint32_t *count);
+
+/**
+ * @brief Drain the device trace rings of the local device, see shmemx_trace_drain, and write them to path as a
+ *        Chrome trace event file, loadable in chrome://tracing or Perfetto. Timestamps are in microseconds of the
+ *        device system counter.
+ *
+ * @param path             [in] Output file, truncated when it exists.
+ * @return Returns the number of events written, or an error code on failure.
+ */
+SHMEM_HOST_API int32_t shmemx_trace_export(const char *path);
+
 #ifdef __cplusplus
 }
 #endif
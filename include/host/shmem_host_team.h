@@ -104,6 +104,20 @@ SHMEM_HOST_API int shmem_team_n_pes(shmem_team_t team);
  */
 SHMEM_HOST_API int shmem_team_get_config(shmem_team_t team, shmem_team_config_t *config);
 
+/**
+ * @brief return the device barrier algorithm chosen for the team and its predicted latency.
+ *        The choice is made at team creation from team size, topology and the calibration done in shmem_init_attr,
+ *        and can be forced for all teams with the SHMEM_BARRIER_ALGO (auto, dissem, tg_dissem, central, switch, hier)
+ *        and SHMEM_BARRIER_RADIX (2 to 8) environment variables.
+ *
+ * @param team [IN] team handle
+ * @param algo [OUT] the chosen algorithm, see shmemx_barrier_algo_t
+ * @param k [OUT] radix of group dissemination, or number of flags read at a time by centralized pull
+ * @param predicted_us [OUT] latency predicted by the cost model, in microseconds
+ * @return 0 on success, SHMEM_INVALID_PARAM if the team is invalid or an output is null.
+ */
+SHMEM_HOST_API int shmemx_team_barrier_info(shmem_team_t team, int *algo, int *k, double *predicted_us);
+
 #ifdef __cplusplus
 }
 #endif
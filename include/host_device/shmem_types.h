@@ -10,6 +10,8 @@
 #ifndef SHMEM_TYPES_H
 #define SHMEM_TYPES_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -22,6 +24,22 @@ extern "C" {
 /// \brief A macro that identifies a function on the device side.
 #define SHMEM_DEVICE __attribute__((always_inline)) __aicore__ __inline__
 
+/**
+ * @brief Standard Fetching Atomic Types and Names, shared by the host and device fetching atomics.
+ *
+ * |NAME       | TYPE      |
+ * |-----------|-----------|
+ * |int32      | int32     |
+ * |uint32     | uint32    |
+ * |int64      | int64     |
+ * |uint64     | uint64    |
+ */
+#define SHMEM_TYPE_FUNC_ATOMIC_FETCH(FUNC) \
+    FUNC(int32, int32_t);                  \
+    FUNC(uint32, uint32_t);                \
+    FUNC(int64, int64_t);                  \
+    FUNC(uint64, uint64_t)
+
 /**
  * @addtogroup group_enums
  * @{
@@ -57,6 +75,7 @@ enum data_op_engine_type_t {
     SHMEM_DATA_OP_MTE = 0x01,
     SHMEM_DATA_OP_SDMA = 0x02,
     SHMEM_DATA_OP_ROCE = 0x04,
+    SHMEM_DATA_OP_HOST = 0x08,
 };
 
 /**
@@ -79,6 +98,27 @@ enum {
     SHMEM_CMP_LE
 };
 
+/**
+ * @brief Device barrier algorithms, selected per team at creation, see shmemx_team_barrier_info.
+ */
+enum shmemx_barrier_algo_t {
+    SHMEMX_BARRIER_AUTO = 0,    ///< Chosen from team size, topology and calibration.
+    SHMEMX_BARRIER_DISSEM,      ///< Dissemination, log2(N) rounds.
+    SHMEMX_BARRIER_TG_DISSEM,   ///< Group dissemination, log_k(N) rounds of k - 1 signals.
+    SHMEMX_BARRIER_CENTRAL,     ///< Centralized pull, every PE reads all others k at a time.
+    SHMEMX_BARRIER_SWITCH,      ///< Switch offload, centralized pull when unsupported.
+    SHMEMX_BARRIER_HIER,        ///< Gather per host over MTE, dissemination among host leaders.
+};
+
+/**
+ * @brief Operation of a shmemx_rma_desc_t, see shmemx_rma_batch.
+ */
+enum shmemx_rma_op_t {
+    SHMEMX_RMA_PUT = SHMEMI_OP_PUT,                 ///< Put bytes from src to the symmetric dst on pe.
+    SHMEMX_RMA_PUT_SIGNAL = SHMEMI_OP_PUT_SIGNAL,   ///< Put, then update the signal word sig_addr on pe.
+    SHMEMX_RMA_GET = SHMEMI_OP_GET,                 ///< Get bytes from the symmetric src on pe to dst.
+};
+
 /**
  * @brief Reserved for future use.
  */
@@ -114,6 +154,104 @@ struct shmem_handle_t {
     shmem_team_t team_id;
 };
 
+/**
+ * @struct shmemx_rma_desc_t
+ * @brief Descriptor of one RMA operation submitted through shmemx_rma_batch.
+ *
+ * - uint32_t op: SHMEMX_RMA_PUT, SHMEMX_RMA_GET or SHMEMX_RMA_PUT_SIGNAL, see shmemx_rma_op_t.
+ * - int32_t pe: PE number of the remote PE.
+ * - uint64_t dst: Destination address, must be symmetric for put and put-signal.
+ * - uint64_t src: Source address, must be symmetric for get.
+ * - uint64_t bytes: Number of bytes to be transferred.
+ * - uint64_t sig_addr: Symmetric address of the int32_t signal word, put-signal only.
+ * - int32_t signal: The value used to update sig_addr, put-signal only.
+ * - int32_t sig_op: SHMEM_SIGNAL_SET or SHMEM_SIGNAL_ADD, put-signal only.
+*/
+typedef struct {
+    uint32_t op;
+    int32_t pe;
+    uint64_t dst;
+    uint64_t src;
+    uint64_t bytes;
+    uint64_t sig_addr;
+    int32_t signal;
+    int32_t sig_op;
+} shmemx_rma_desc_t;
+
+/**
+ * @brief Failed device operations recorded in the wait diagnostic ring, in the cmp field of the record.
+ */
+enum shmemx_diag_error_t {
+    SHMEMX_DIAG_ERR_NO_ROUTE = -1,   ///< Not supported over the transport reaching pe, the kernel is stopped.
+    SHMEMX_DIAG_ERR_ROCE_QP = -2,    ///< RoCE WQE dropped, the QP to pe is in error. observed is the CQE status.
+};
+
+/**
+ * @struct shmemx_wait_diag_record_t
+ * @brief One entry of the device wait diagnostic ring, written when a wait exceeds its cycle budget or a device
+ *        operation fails.
+ *
+ * - int32_t mype: PE that was waiting.
+ * - int32_t core: Block index of the waiting core.
+ * - int32_t team: Team index of the barrier, SHMEM_TEAM_INVALID for point-to-point waits.
+ * - int32_t round: Barrier round being waited for, 0 for point-to-point waits.
+ * - int32_t pe: PE whose signal was awaited, -1 when unknown.
+ * - int32_t cmp: Comparison operator of the wait, see SHMEM_CMP_EQ. A negative shmemx_diag_error_t when the
+ *   record reports a failed operation instead of a wait, pe is then its target PE.
+ * - int64_t observed: Last value observed at addr.
+ * - int64_t expected: Comparison value of the wait.
+ * - uint64_t addr: Address that was polled.
+ * - int64_t elapsed: System cycles spent waiting when the budget expired.
+ * - int64_t timestamp: System cycle counter when the record was written.
+*/
+typedef struct {
+    int32_t mype;
+    int32_t core;
+    int32_t team;
+    int32_t round;
+    int32_t pe;
+    int32_t cmp;
+    int64_t observed;
+    int64_t expected;
+    uint64_t addr;
+    int64_t elapsed;
+    int64_t timestamp;
+} shmemx_wait_diag_record_t;
+
+/**
+ * @brief Operations recorded by the device trace rings, see shmemx_trace_record_t.
+*/
+enum shmemx_trace_op_t : uint16_t {
+    SHMEMX_TRACE_PUT = 1,       ///< MTE put of contiguous data.
+    SHMEMX_TRACE_GET,           ///< MTE get of contiguous data.
+    SHMEMX_TRACE_ROCE_WRITE,    ///< RDMA write posted to the send queue.
+    SHMEMX_TRACE_ROCE_READ,     ///< RDMA read posted to the send queue.
+    SHMEMX_TRACE_ROCE_QUIET,    ///< Wait for the RDMA completions of one peer.
+    SHMEMX_TRACE_SIGNAL,        ///< Signal set or add.
+    SHMEMX_TRACE_WAIT,          ///< Point-to-point wait_until.
+    SHMEMX_TRACE_BARRIER,       ///< Team barrier, pe holds the team index.
+};
+
+/**
+ * @struct shmemx_trace_record_t
+ * @brief One entry of a per-core device trace ring, written when SHMEM_ENABLE_TRACE is defined at build time.
+ *
+ * - uint16_t op: Operation, see shmemx_trace_op_t.
+ * - uint16_t core: Trace slot of the core, vector cores first and cube cores after SHMEM_MAX_AIV_PER_NPU.
+ * - int32_t pe: Peer PE of the operation, team index for barriers, -1 when unknown.
+ * - uint64_t bytes: Payload size in bytes, 0 for synchronization.
+ * - int64_t start: System cycle counter when the operation was entered.
+ * - int64_t end: System cycle counter when the operation returned.
+*/
+typedef struct {
+    uint16_t op;
+    uint16_t core;
+    int32_t pe;
+    uint64_t bytes;
+    int64_t start;
+    int64_t end;
+} shmemx_trace_record_t;
+
 /**@} */ // end of group_structs
 #ifdef __cplusplus
 }
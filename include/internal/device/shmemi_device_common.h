@@ -37,6 +37,12 @@ SHMEM_DEVICE uint64_t shmemi_get_heap_size()
     return shmemi_get_state()->heap_size;
 }
 
+// Transport the high-level RMA routines use to reach pe, see route_list.
+SHMEM_DEVICE uint8_t shmemi_get_route(int pe)
+{
+    return shmemi_get_state()->route_list[pe];
+}
+
 template<typename T>
 SHMEM_DEVICE void shmemi_store(__gm__ T *addr, T val)
 {
@@ -49,6 +55,115 @@ SHMEM_DEVICE T shmemi_load(__gm__ T *cache)
     return *((__gm__ T *)cache);
 }
 
+/**
+ * Publish the synchronization site this vector core is at to the progress watchdog. Callers mark a site only once
+ * a wait outlasts its spin phase and mark SHMEMI_SITE_IDLE when it ends, a no-op while the watchdog is disabled.
+ */
+SHMEM_DEVICE void shmemi_watchdog_mark(int32_t site, int32_t team, int32_t pe)
+{
+    uint64_t region = shmemi_get_state()->watchdog_region;
+    if (region == 0) {
+        return;
+    }
+    if ASCEND_IS_AIV {
+        int32_t core = AscendC::GetBlockIdx() % SHMEM_MAX_AIV_PER_NPU;
+        __gm__ shmemi_watchdog_record_t *rec = (__gm__ shmemi_watchdog_record_t *)(region +
+            core * SHMEM_WATCHDOG_RECORD_SIZE);
+        // a previous kernel may have run this block index on another physical core
+        dcci_cacheline((__gm__ uint8_t *)rec);
+        rec->progress = rec->progress + 1;
+        rec->site = site;
+        rec->team = team;
+        rec->pe = pe;
+        rec->core = core;
+        rec->timestamp = AscendC::GetSystemCycle();
+        dcci_cacheline((__gm__ uint8_t *)rec);
+    }
+}
+
+SHMEM_DEVICE void shmemi_wait_diag_record(__gm__ void *addr, int cmp, int64_t observed, int64_t expected,
+                                          int32_t team, int32_t round, int32_t pe, int64_t elapsed)
+{
+    __gm__ shmemi_device_host_state_t *state = shmemi_get_state();
+    if (state->wait_diag_ring == 0) {
+        return;
+    }
+
+    // claim a slot, the host decodes slots modulo the ring size
+    __gm__ uint64_t *head = (__gm__ uint64_t *)state->wait_diag_ring;
+    dcci_atomic();
+    dsb_all();
+    uint64_t slot = AscendC::AtomicAdd(head, (uint64_t)1);
+    dcci_atomic();
+
+    __gm__ shmemx_wait_diag_record_t *rec = (__gm__ shmemx_wait_diag_record_t *)(state->wait_diag_ring +
+        SHMEM_WAIT_DIAG_HEAD_SIZE + (slot % SHMEM_WAIT_DIAG_RING_ENTRIES) * SHMEM_WAIT_DIAG_RECORD_SIZE);
+    rec->mype = state->mype;
+    rec->core = AscendC::GetBlockIdx();
+    rec->team = team;
+    rec->round = round;
+    rec->pe = pe;
+    rec->cmp = cmp;
+    rec->observed = observed;
+    rec->expected = expected;
+    rec->addr = reinterpret_cast<uint64_t>(addr);
+    rec->elapsed = elapsed;
+    rec->timestamp = AscendC::GetSystemCycle();
+    dcci_cacheline((__gm__ uint8_t *)rec);
+}
+
+/**
+ * Record a failed operation to the wait diagnostic ring with err (see shmemx_diag_error_t) in place of the
+ * comparison, then stop the kernel. For operations that have no honest result to return.
+ */
+SHMEM_DEVICE void shmemi_diag_fatal(int32_t err, __gm__ void *addr, int32_t pe)
+{
+    shmemi_wait_diag_record(addr, err, 0, 0, SHMEM_TEAM_INVALID, 0, pe, 0);
+    trap();
+}
+
+#ifdef SHMEM_ENABLE_TRACE
+/**
+ * Append one record to the trace ring of this core. Only the owning core writes a ring, so the head is advanced
+ * without atomics; the host keeps the newest SHMEM_TRACE_RING_ENTRIES records per core.
+ */
+SHMEM_DEVICE void shmemi_trace_record(uint16_t op, int32_t pe, uint64_t bytes, int64_t start)
+{
+    int64_t end = AscendC::GetSystemCycle();
+    uint64_t region = shmemi_get_state()->trace_region;
+    if (region == 0) {
+        return;
+    }
+    uint16_t core = 0;
+    if ASCEND_IS_AIV {
+        core = AscendC::GetBlockIdx() % SHMEM_MAX_AIV_PER_NPU;
+    } else {
+        core = SHMEM_MAX_AIV_PER_NPU + AscendC::GetBlockIdx() % (SHMEM_TRACE_MAX_CORES - SHMEM_MAX_AIV_PER_NPU);
+    }
+    uint64_t ring = region + core * SHMEM_TRACE_CORE_RING_SIZE;
+    __gm__ uint64_t *head = (__gm__ uint64_t *)ring;
+    dcci_cacheline((__gm__ uint8_t *)head);
+    uint64_t slot = *head;
+    __gm__ shmemx_trace_record_t *rec = (__gm__ shmemx_trace_record_t *)(ring + SHMEM_TRACE_HEAD_SIZE +
+        (slot % SHMEM_TRACE_RING_ENTRIES) * SHMEM_TRACE_RECORD_SIZE);
+    rec->op = op;
+    rec->core = core;
+    rec->pe = pe;
+    rec->bytes = bytes;
+    rec->start = start;
+    rec->end = end;
+    dcci_cacheline((__gm__ uint8_t *)rec);
+    *head = slot + 1;
+    dcci_cacheline((__gm__ uint8_t *)head);
+}
+
+#define SHMEMI_TRACE_BEGIN(name) int64_t name = AscendC::GetSystemCycle()
+#define SHMEMI_TRACE_END(name, op, pe, bytes) shmemi_trace_record((op), (pe), (bytes), (name))
+#else
+#define SHMEMI_TRACE_BEGIN(name)
+#define SHMEMI_TRACE_END(name, op, pe, bytes)
+#endif
+
 template<typename T>
 SHMEM_DEVICE __gm__ T *shmemi_ptr(__gm__ T *local, int pe)
 {
@@ -76,6 +76,12 @@ SHMEM_DEVICE void shmemi_barrier_core()
 #endif
 }
 
+// Sync array slots are laid out for SHMEM_BARRIER_TG_DISSEM_KVAL, so smaller radices fit as well.
+SHMEM_DEVICE int shmemi_barrier_radix(int k)
+{
+    return (k < 2 || k > SHMEM_BARRIER_TG_DISSEM_KVAL) ? SHMEM_BARRIER_TG_DISSEM_KVAL : k;
+}
+
 SHMEM_DEVICE
 __gm__ shmemi_sync_bit *shmemi_get_team_sync_array(shmem_team_t team_idx)
 {
@@ -162,8 +168,7 @@ The temporal and spatial complexity of this implementation are O(logN) and O(N),
 
 3. Futher development
   a. Hierarchical synchronization.
-    Sync within the host first, then sync between host. May achieve better
-    performance by utilizing low-latency in-host network better.
+    Implemented by shmemi_barrier_sys, selected per team in shmem_team.cpp.
 
   b. Group dissemination.
     Group the ranks so that each rank could issue multiple signals and waits concurrently,
@@ -198,7 +203,9 @@ SHMEM_DEVICE void shmemi_barrier_npu_v1(shmemi_team_t *team)
         shmemi_signal_set((__gm__ int32_t *)(sync_array + offset), next_pe, count);
 
         // wait pre pe
-        shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)(sync_array + offset), count);
+        int pre_pe = start + ((my_pe_in_team - shift % size + size) % size) * stride;
+        shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)(sync_array + offset), count, team->team_idx,
+                                                pre_pe);
 
         shift *= multiplier;
         offset++;
@@ -211,7 +218,7 @@ SHMEM_DEVICE void shmemi_barrier_npu_v1(shmemi_team_t *team)
  *
  *  An optimized version of shmemi_barrier_npu_v1, with temporal complexity reduced to O(log_{k}^{N}).
  */
-SHMEM_DEVICE void shmemi_barrier_npu_v2(shmemi_team_t *team)
+SHMEM_DEVICE void shmemi_barrier_npu_v2(shmemi_team_t *team, int k = SHMEM_BARRIER_TG_DISSEM_KVAL)
 {
     int vec_id = AscendC::GetBlockIdx();
     int vec_size = AscendC::GetBlockNum() * AscendC::GetTaskRation();
@@ -224,7 +231,7 @@ SHMEM_DEVICE void shmemi_barrier_npu_v2(shmemi_team_t *team)
     auto sync_counter = shmemi_get_team_sync_counter(team->team_idx);
 
     int shift = 1;
-    int k = SHMEM_BARRIER_TG_DISSEM_KVAL;
+    k = shmemi_barrier_radix(k);
     k = k < size ? k : size;
     k = k < vec_size ? k : vec_size;
     int my_pe_in_team = (my_pe - start) / stride;
@@ -242,7 +249,9 @@ SHMEM_DEVICE void shmemi_barrier_npu_v2(shmemi_team_t *team)
 
         for (int i = vec_id + 1; i < k; i += vec_size) {
             // wait pre pe
-            shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)(sync_array + offset + i), count);
+            int pre_pe = start + ((my_pe_in_team - (i * shift) % size + size) % size) * stride;
+            shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)(sync_array + offset + i), count,
+                                                    team->team_idx, pre_pe);
         }
 
         shift *= k;
@@ -257,7 +266,7 @@ SHMEM_DEVICE void shmemi_barrier_npu_v2(shmemi_team_t *team)
  *  The temporal and spatial complexity of this implementation are O(N/K) and O(1), respectively.
  *  Performs better than Group Dissemination Barrier at small scale (eg. 8 ranks).
  */
-SHMEM_DEVICE void shmemi_barrier_npu_v3(shmemi_team_t *team)
+SHMEM_DEVICE void shmemi_barrier_npu_v3(shmemi_team_t *team, int k = SHMEM_BARRIER_TG_DISSEM_KVAL)
 {
     int vec_id = AscendC::GetBlockIdx();
     int vec_size = AscendC::GetBlockNum() * AscendC::GetTaskRation();
@@ -269,7 +278,7 @@ SHMEM_DEVICE void shmemi_barrier_npu_v3(shmemi_team_t *team)
     auto sync_array = shmemi_get_team_sync_array(team->team_idx);
     auto sync_counter = shmemi_get_team_sync_counter(team->team_idx);
 
-    int k = SHMEM_BARRIER_TG_DISSEM_KVAL;
+    k = shmemi_barrier_radix(k);
     k = k < size ? k : size;
     k = k < vec_size ? k : vec_size;
     int my_pe_in_team = (my_pe - start) / stride;
@@ -282,7 +291,8 @@ SHMEM_DEVICE void shmemi_barrier_npu_v3(shmemi_team_t *team)
         } else {
             // read remote
             int remote_pe = start + i * stride;
-            shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)shmemi_ptr(sync_array, remote_pe), count);
+            shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)shmemi_ptr(sync_array, remote_pe), count,
+                                                    team->team_idx, remote_pe);
         }
     }
 
@@ -296,7 +306,7 @@ SHMEM_DEVICE void shmemi_barrier_npu_v3(shmemi_team_t *team)
 SHMEM_DEVICE void shmemi_barrier_npu_v4(shmemi_team_t *team)
 {
     if (!team->use_switch_barrier) {
-        shmemi_barrier_npu_v3(team);
+        shmemi_barrier_npu_v3(team, team->barrier_k);
         return;
     }
 
@@ -313,12 +323,108 @@ SHMEM_DEVICE void shmemi_barrier_npu_v4(shmemi_team_t *team)
     shmemi_store((__gm__ uint64_t *)team->switch_trigger_addr, payload);
     dcci_cacheline((__gm__ uint8_t *)team->switch_trigger_addr);
 
-    shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)sync_counter, count);
+    shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)sync_counter, count, team->team_idx);
 }
 
-/* Level 3: barrier between hosts, TO BE IMPLEMENTED. */
-SHMEM_DEVICE void shmemi_barrier_sys()
+/* Level 3: barrier between hosts
+
+Hierarchical Barrier
+
+Requires every host to hold an equal contiguous block of host_local_size team members (see shmemi_team_t).
+The first member of each block is the host leader.
+
+1. Gather: each member publishes count in its slot 0, the leader pulls the slots of its block over MTE.
+2. Leaders run a dissemination barrier among themselves, one slot per round starting from slot 2.
+   Signals go over MTE when the next leader is reachable and over RoCE otherwise.
+3. Release: the leader publishes count in its slot 1, members of its block pull it over MTE.
+
+Only log2(hosts) rounds cross the slow link, instead of log2(N) for shmemi_barrier_npu_v1.
+*/
+const int SHMEMI_HIER_BARRIER_RELEASE_SLOT = 1;
+const int SHMEMI_HIER_BARRIER_ROUND_SLOT = 2;
+
+SHMEM_DEVICE void shmemi_barrier_sys(shmemi_team_t *team)
 {
+    if (AscendC::GetBlockIdx() != 0)
+        return;
+
+    int my_pe = shmemi_get_state()->team_pools[SHMEM_TEAM_WORLD]->mype;
+    int start = team->start;
+    int stride = team->stride;
+    int size = team->size;
+    int local_size = team->host_local_size;
+    auto sync_array = shmemi_get_team_sync_array(team->team_idx);
+    auto sync_counter = shmemi_get_team_sync_counter(team->team_idx);
+
+    int my_pe_in_team = (my_pe - start) / stride;
+    int leader_in_team = my_pe_in_team / local_size * local_size;
+    int leader_pe = start + leader_in_team * stride;
+    int32_t count = shmemi_load((__gm__ int32_t *)sync_counter) + 1;
+
+    // RoCE signals are sent from sync_counter, so it must hold count before the first round
+    shmemi_store((__gm__ int32_t *)sync_counter, count);
+    dcci_cacheline((__gm__ uint8_t *)sync_counter);
+
+    if (my_pe_in_team != leader_in_team) {
+        shmemi_signal_set((__gm__ int32_t *)sync_array, count);
+        shmemi_signal_wait_until_eq_for_barrier(
+            (__gm__ int32_t *)shmemi_ptr(sync_array + SHMEMI_HIER_BARRIER_RELEASE_SLOT, leader_pe), count,
+            team->team_idx, leader_pe);
+        return;
+    }
+
+    // gather the block
+    for (int i = leader_in_team + 1; i < leader_in_team + local_size; i++) {
+        int remote_pe = start + i * stride;
+        shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)shmemi_ptr(sync_array, remote_pe), count,
+                                                team->team_idx, remote_pe);
+    }
+
+    // dissemination among leaders
+    int n_hosts = size / local_size;
+    int my_host = my_pe_in_team / local_size;
+    int shift = 1;
+    int32_t offset = SHMEMI_HIER_BARRIER_ROUND_SLOT;
+    while (shift < n_hosts) {
+        int next_pe = start + ((my_host + shift) % n_hosts) * local_size * stride;
+        int pre_pe = start + ((my_host - shift + n_hosts) % n_hosts) * local_size * stride;
+        auto round_sig = (__gm__ int32_t *)(sync_array + offset);
+
+        if (shmemi_get_state()->topo_list[next_pe] & SHMEM_TRANSPORT_MTE) {
+            shmemi_signal_set(round_sig, next_pe, count);
+        } else {
+            shmemi_highlevel_signal_set(round_sig, (__gm__ int32_t *)sync_counter, next_pe);
+        }
+        shmemi_signal_wait_until_eq_for_barrier(round_sig, count, team->team_idx, pre_pe);
+
+        shift *= SHIFT_MULTIPLIER;
+        offset++;
+    }
+
+    // release the block
+    shmemi_signal_set((__gm__ int32_t *)(sync_array + SHMEMI_HIER_BARRIER_RELEASE_SLOT), count);
+}
+
+/* Runs the algorithm chosen for the team at creation, see shmemx_barrier_algo_t. */
+SHMEM_DEVICE void shmemi_barrier_npu(shmemi_team_t *team, int algo, int k)
+{
+    switch (algo) {
+        case SHMEMX_BARRIER_DISSEM:
+            shmemi_barrier_npu_v1(team);
+            break;
+        case SHMEMX_BARRIER_TG_DISSEM:
+            shmemi_barrier_npu_v2(team, k);
+            break;
+        case SHMEMX_BARRIER_CENTRAL:
+            shmemi_barrier_npu_v3(team, k);
+            break;
+        case SHMEMX_BARRIER_HIER:
+            shmemi_barrier_sys(team);
+            break;
+        default:
+            shmemi_barrier_npu_v4(team);
+            break;
+    }
 }
 
 template<bool is_aiv_only = true>
@@ -336,13 +442,17 @@ SHMEM_DEVICE void shmemi_barrier(shmem_team_t tid)
         return;
     }
 
+    SHMEMI_TRACE_BEGIN(trace_start);
+    // deferred stores of this core must be visible once the barrier completes
+    shmemi_fence_flush_lines(-1);
     shmemi_barrier_core<is_aiv_only>();
 
     if ASCEND_IS_AIV {
-        shmemi_barrier_npu_v4(team);
+        shmemi_barrier_npu(team, team->barrier_algo, team->barrier_k);
     }
 
     shmemi_barrier_core<is_aiv_only>();
+    SHMEMI_TRACE_END(trace_start, SHMEMX_TRACE_BARRIER, team->team_idx, 0);
 }
 
 #endif
\ No newline at end of file
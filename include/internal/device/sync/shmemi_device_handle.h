@@ -43,12 +43,47 @@ SHMEM_DEVICE void shmemi_barrier_cross_host(shmemi_team_t *team)
         shmemi_highlevel_signal_set((__gm__ int32_t *)(sync_array + my_pe), (__gm__ int32_t *)sync_counter, next_pe);
 
         // wait pre pe
-        shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)(sync_array + pre_pe), count);
+        shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)(sync_array + pre_pe), count,
+                                                team->team_idx, pre_pe);
 
         shift *= SHIFT_MULTIPLIER;
     }
 }
 
+// Reap the RoCE completions already available on the QPs the calling core owns, one poll window per QP.
+SHMEM_DEVICE int shmemi_roce_progress()
+{
+    AscendC::LocalTensor<uint32_t> ub_tensor_32;
+    ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_32.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR);
+    ub_tensor_32.address_.dataLen = UB_ALIGN_SIZE;
+    AscendC::LocalTensor<uint64_t> ub_tensor_64;
+    ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR
+                                                                        + UB_ALIGN_SIZE);
+    ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
+
+    __gm__ shmemi_device_host_state_t *state = shmemi_get_state();
+    uint32_t qp_num = shmemi_roce_qp_num();
+    uint32_t core_num = AscendC::GetBlockNum() * AscendC::GetTaskRation();
+    uint32_t step = core_num == 0 ? 1 : core_num;
+    int reaped = 0;
+    for (int pe = 0; pe < state->npes; pe++) {
+        if (pe == state->mype || !(state->topo_list[pe] & SHMEM_TRANSPORT_ROCE)) {
+            continue;
+        }
+        // same QP ownership as shmemi_rdma_post_send_striped
+        for (uint32_t qp_idx = AscendC::GetBlockIdx() % qp_num; qp_idx < qp_num; qp_idx += step) {
+            uint32_t status = 0;
+            reaped += static_cast<int>(shmemi_roce_reap_cq(pe, qp_idx, 1, status, ub_tensor_64, ub_tensor_32));
+            if (status != 0) {
+                return -static_cast<int>(status);
+            }
+        }
+    }
+    return reaped;
+}
+
 SHMEM_DEVICE void shmemi_handle(shmem_team_t tid)
 {
     shmemi_team_t *team = shmemi_get_state()->team_pools[tid];
@@ -78,7 +113,7 @@ SHMEM_DEVICE void shmemi_handle(shmem_team_t tid)
         if (peer == mype) {
             continue;
         }
-        shmemi_roce_quiet(peer, 0, ub_tensor_64, ub_tensor_32);
+        shmemi_roce_quiet_owned(peer, ub_tensor_64, ub_tensor_32);
     }
 
     if ASCEND_IS_AIV {
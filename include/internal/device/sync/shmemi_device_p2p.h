@@ -36,9 +36,51 @@ SHMEM_DEVICE void shmemi_highlevel_signal_set(__gm__ int32_t *dst, __gm__ int32_
     ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR
                                                                         + UB_ALIGN_SIZE);
     ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
-    shmemi_roce_write((__gm__ uint8_t*)shmem_ptr(dst, pe), (__gm__ uint8_t*)src, pe, 0, sizeof(int32_t),
+    // data striped over the other QPs of this core is not ordered against the signal QP, drain it first
+    uint32_t qpIdx = shmemi_roce_first_owned_qp();
+    if (shmemi_roce_qp_num() > 1) {
+        shmemi_roce_quiet_owned(pe, ub_tensor_64, ub_tensor_32);
+    }
+    shmemi_roce_write((__gm__ uint8_t*)shmem_ptr(dst, pe), (__gm__ uint8_t*)src, pe, qpIdx, sizeof(int32_t),
         ub_tensor_64, ub_tensor_32);
-    shmemi_roce_quiet(pe, 0, ub_tensor_64, ub_tensor_32);
+    shmemi_roce_quiet(pe, qpIdx, ub_tensor_64, ub_tensor_32);
+}
+
+// Put with signal rides the RoCE write-signal doorbell when the peer is routed over RoCE. The signal add has no
+// RDMA counterpart here and MTE cannot reach such a peer, so it stops the kernel, see SHMEMX_DIAG_ERR_NO_ROUTE.
+SHMEM_DEVICE bool shmemi_roce_signal_path(int sig_op, int pe, __gm__ int32_t *sig_addr)
+{
+    uint8_t route = shmemi_get_route(pe);
+    if (route == SHMEM_TRANSPORT_MTE) {
+        return false;
+    }
+    if (sig_op != SHMEM_SIGNAL_SET || route != SHMEM_TRANSPORT_ROCE) {
+        shmemi_diag_fatal(SHMEMX_DIAG_ERR_NO_ROUTE, sig_addr, pe);
+    }
+    return true;
+}
+
+SHMEM_DEVICE void shmemi_roce_put_signal(__gm__ uint8_t *dst, __gm__ uint8_t *src, uint64_t bytes,
+                                         __gm__ int32_t *sig_addr, int32_t signal, int pe, bool blocking)
+{
+    AscendC::LocalTensor<uint32_t> ub_tensor_32;
+    ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_32.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR);
+    ub_tensor_32.address_.dataLen = UB_ALIGN_SIZE;
+    AscendC::LocalTensor<uint64_t> ub_tensor_64;
+    ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR
+                                                                        + UB_ALIGN_SIZE);
+    ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
+
+    uint32_t core = AscendC::GetBlockIdx() % SHMEM_MAX_AIV_PER_NPU;
+    __gm__ uint8_t *ring = (__gm__ uint8_t *)shmemi_get_state()->roce_signal_pool +
+                           core * SHMEM_ROCE_SIGNAL_SLOTS * SHMEMI_SYNCBIT_SIZE;
+    // the payload and the signal share one QP, so the fence orders them
+    uint32_t qp_idx = shmemi_roce_first_owned_qp();
+    shmemi_roce_put_signal_staged(ring, (__gm__ uint8_t *)shmem_ptr(dst, pe), src, bytes,
+                                  (__gm__ uint8_t *)shmem_ptr(sig_addr, pe), signal, (uint32_t)pe, qp_idx, blocking,
+                                  ub_tensor_64, ub_tensor_32);
 }
 
 SHMEM_DEVICE void shmemi_signal_add(__gm__ int32_t *addr, int pe, int32_t val)
@@ -53,18 +95,139 @@ SHMEM_DEVICE void shmemi_signal_add(__gm__ int32_t *addr, int pe, int32_t val)
     dcci_atomic();
 }
 
-SHMEM_DEVICE int32_t shmemi_signal_wait_until_eq_for_barrier(__gm__ int32_t *sig_addr, int32_t cmp_val)
+template <typename T>
+SHMEM_DEVICE bool shmemi_compare(T value, int cmp, T cmp_val)
+{
+    switch (cmp) {
+        case SHMEM_CMP_EQ:
+            return value == cmp_val;
+        case SHMEM_CMP_NE:
+            return value != cmp_val;
+        case SHMEM_CMP_GT:
+            return value > cmp_val;
+        case SHMEM_CMP_GE:
+            return value >= cmp_val;
+        case SHMEM_CMP_LT:
+            return value < cmp_val;
+        case SHMEM_CMP_LE:
+            return value <= cmp_val;
+    }
+    return false;
+}
+
+// Polls issued back to back before a wait starts to back off, keeps the latency of short waits unchanged. Barrier
+// waits never back off, every idle cycle there would add to the latency of each barrier round.
+constexpr uint32_t SHMEMI_WAIT_SPIN_POLLS = 64;
+constexpr int64_t SHMEMI_WAIT_BACKOFF_MIN_CYCLES = 4;
+constexpr int64_t SHMEMI_WAIT_BACKOFF_MAX_CYCLES = 256;
+
+typedef struct {
+    int64_t start;
+    int64_t budget;
+    int64_t backoff;
+    uint32_t polls;
+    bool reported;
+    // watchdog site of the wait, published once the spin phase is over
+    int32_t site;
+    int32_t team;
+    int32_t pe;
+} shmemi_wait_budget_t;
+
+SHMEM_DEVICE void shmemi_wait_budget_init(shmemi_wait_budget_t &wb, int64_t budget, int32_t site = SHMEMI_SITE_WAIT,
+                                          int32_t team = SHMEM_TEAM_INVALID, int32_t pe = -1)
+{
+    wb.start = AscendC::GetSystemCycle();
+    wb.budget = budget;
+    wb.backoff = site == SHMEMI_SITE_BARRIER ? 0 : SHMEMI_WAIT_BACKOFF_MIN_CYCLES;
+    wb.polls = 0;
+    wb.reported = false;
+    wb.site = site;
+    wb.team = team;
+    wb.pe = pe;
+}
+
+/**
+ * Called after every unsuccessful poll. Once the spin phase is over, idles for an exponentially growing number of
+ * cycles so the next cache invalidation does not hammer the cacheline the peer is about to write. Barrier waits
+ * keep spinning.
+ * Returns true when the cycle budget has expired.
+ */
+SHMEM_DEVICE bool shmemi_wait_budget_step(shmemi_wait_budget_t &wb)
+{
+    int64_t now = AscendC::GetSystemCycle();
+    if (wb.polls == SHMEMI_WAIT_SPIN_POLLS) {
+        shmemi_watchdog_mark(wb.site, wb.team, wb.pe);
+    }
+    if (++wb.polls > SHMEMI_WAIT_SPIN_POLLS && wb.backoff > 0) {
+        int64_t until = now + wb.backoff;
+        while (AscendC::GetSystemCycle() < until) {
+        }
+        wb.backoff = wb.backoff * 2 < SHMEMI_WAIT_BACKOFF_MAX_CYCLES ? wb.backoff * 2 : SHMEMI_WAIT_BACKOFF_MAX_CYCLES;
+    }
+    return wb.budget > 0 && now - wb.start >= wb.budget;
+}
+
+// Called once the wait is over, clears the watchdog site published by shmemi_wait_budget_step.
+SHMEM_DEVICE void shmemi_wait_budget_done(shmemi_wait_budget_t &wb)
+{
+    if (wb.polls > SHMEMI_WAIT_SPIN_POLLS) {
+        shmemi_watchdog_mark(SHMEMI_SITE_IDLE, wb.team, wb.pe);
+    }
+}
+
+/**
+ * Wait until *sig_addr == cmp_val. A peer may already have entered the next barrier, so cmp_val + 1 is accepted too.
+ * When the wait outlives the configured budget it is reported once to the diagnostic ring (team, round = cmp_val,
+ * awaited pe) and keeps waiting, a barrier cannot be abandoned halfway.
+ */
+SHMEM_DEVICE int32_t shmemi_signal_wait_until_eq_for_barrier(__gm__ int32_t *sig_addr, int32_t cmp_val,
+                                                             int32_t team = SHMEM_TEAM_INVALID, int32_t pe = -1)
 {
+    shmemi_wait_budget_t wb;
+    shmemi_wait_budget_init(wb, shmemi_get_state()->wait_timeout_cycles, SHMEMI_SITE_BARRIER, team, pe);
     do {
         dcci_cacheline((__gm__ uint8_t *)sig_addr);
 
-        if (*sig_addr == cmp_val) {
-            return *sig_addr;
+        // cmp_val + 1 in case when peer pe enters next barrier
+        int32_t val = *sig_addr;
+        if (val == cmp_val || val == cmp_val + 1) {
+            shmemi_wait_budget_done(wb);
+            return val;
         }
 
-        // in case when peer pe enters next barrier
-        if (*sig_addr == cmp_val + 1) {
-            return *sig_addr;
+        if (shmemi_wait_budget_step(wb) && !wb.reported) {
+            shmemi_wait_diag_record(sig_addr, SHMEM_CMP_EQ, val, cmp_val, team, cmp_val, pe,
+                                    AscendC::GetSystemCycle() - wb.start);
+            wb.reported = true;
+        }
+    } while (true);
+
+    // never reach
+    return -1;
+}
+
+/**
+ * Wait until *sig_addr >= cmp_val, for barriers whose signals only grow. Reported to the diagnostic ring like
+ * shmemi_signal_wait_until_eq_for_barrier, with round = cmp_val.
+ */
+SHMEM_DEVICE int32_t shmemi_signal_wait_until_ge_for_barrier(__gm__ int32_t *sig_addr, int32_t cmp_val,
+                                                             int32_t team = SHMEM_TEAM_INVALID, int32_t pe = -1)
+{
+    shmemi_wait_budget_t wb;
+    shmemi_wait_budget_init(wb, shmemi_get_state()->wait_timeout_cycles, SHMEMI_SITE_BARRIER, team, pe);
+    do {
+        dcci_cacheline((__gm__ uint8_t *)sig_addr);
+
+        int32_t val = *sig_addr;
+        if (val >= cmp_val) {
+            shmemi_wait_budget_done(wb);
+            return val;
+        }
+
+        if (shmemi_wait_budget_step(wb) && !wb.reported) {
+            shmemi_wait_diag_record(sig_addr, SHMEM_CMP_GE, val, cmp_val, team, cmp_val, pe,
+                                    AscendC::GetSystemCycle() - wb.start);
+            wb.reported = true;
         }
     } while (true);
 
@@ -75,6 +238,7 @@ SHMEM_DEVICE int32_t shmemi_signal_wait_until_eq_for_barrier(__gm__ int32_t *sig
 // Atomicity of SHMEM_SIGNAL_SET not guaranteed
 SHMEM_DEVICE void shmemix_signal_op(__gm__ int32_t *sig_addr, int32_t signal, int sig_op, int pe)
 {
+    SHMEMI_TRACE_BEGIN(trace_start);
     switch (sig_op) {
         case SHMEM_SIGNAL_SET:
             shmemi_signal_set(sig_addr, pe, signal);
@@ -83,6 +247,7 @@ SHMEM_DEVICE void shmemix_signal_op(__gm__ int32_t *sig_addr, int32_t signal, in
             shmemi_signal_add(sig_addr, pe, signal);
             break;
     }
+    SHMEMI_TRACE_END(trace_start, SHMEMX_TRACE_SIGNAL, pe, 0);
 }
 
 SHMEM_DEVICE int32_t shmemi_signal_wait_until_eq(__gm__ int32_t *sig_addr, int32_t cmp_val)
@@ -170,41 +335,47 @@ SHMEM_DEVICE int32_t shmemi_signal_fetch(__gm__ int32_t *sig_addr)
     return *sig_addr;
 }
 
+/**
+ * Wait until *sig_addr satisfies cmp against cmp_val. A wait longer than budget cycles is reported once to the
+ * diagnostic ring, after which it either keeps waiting or gives up when give_up is set.
+ * Returns 0 once satisfied, -1 on give up. A budget of 0 never expires.
+ */
 template <typename T>
-SHMEM_DEVICE void shmemi_wait_until(__gm__ T *sig_addr, int cmp, T cmp_val)
+SHMEM_DEVICE int shmemi_wait_until_bounded(__gm__ T *sig_addr, int cmp, T cmp_val, int64_t budget, bool give_up)
 {
-    switch (cmp) {
-        case SHMEM_CMP_EQ:
-            do {
-                dcci_cacheline((__gm__ uint8_t *)sig_addr);
-            } while (!(*sig_addr == cmp_val));
-            break;
-        case SHMEM_CMP_NE:
-            do {
-                dcci_cacheline((__gm__ uint8_t *)sig_addr);
-            } while (!(*sig_addr != cmp_val));
-            break;
-        case SHMEM_CMP_GT:
-            do {
-                dcci_cacheline((__gm__ uint8_t *)sig_addr);
-            } while (!(*sig_addr > cmp_val));
-            break;
-        case SHMEM_CMP_GE:
-            do {
-                dcci_cacheline((__gm__ uint8_t *)sig_addr);
-            } while (!(*sig_addr >= cmp_val));
-            break;
-        case SHMEM_CMP_LT:
-            do {
-                dcci_cacheline((__gm__ uint8_t *)sig_addr);
-            } while (!(*sig_addr < cmp_val));
-            break;
-        case SHMEM_CMP_LE:
-            do {
-                dcci_cacheline((__gm__ uint8_t *)sig_addr);
-            } while (!(*sig_addr <= cmp_val));
-            break;
+    if (cmp < SHMEM_CMP_EQ || cmp > SHMEM_CMP_LE) {
+        return -1;
     }
+
+    SHMEMI_TRACE_BEGIN(trace_start);
+    shmemi_wait_budget_t wb;
+    shmemi_wait_budget_init(wb, budget);
+    do {
+        dcci_cacheline((__gm__ uint8_t *)sig_addr);
+
+        T val = *sig_addr;
+        if (shmemi_compare(val, cmp, cmp_val)) {
+            shmemi_wait_budget_done(wb);
+            SHMEMI_TRACE_END(trace_start, SHMEMX_TRACE_WAIT, -1, 0);
+            return 0;
+        }
+
+        if (shmemi_wait_budget_step(wb) && !wb.reported) {
+            shmemi_wait_diag_record(sig_addr, cmp, (int64_t)val, (int64_t)cmp_val, SHMEM_TEAM_INVALID, 0, -1,
+                                    AscendC::GetSystemCycle() - wb.start);
+            wb.reported = true;
+            if (give_up) {
+                shmemi_wait_budget_done(wb);
+                return -1;
+            }
+        }
+    } while (true);
+}
+
+template <typename T>
+SHMEM_DEVICE void shmemi_wait_until(__gm__ T *sig_addr, int cmp, T cmp_val)
+{
+    shmemi_wait_until_bounded(sig_addr, cmp, cmp_val, shmemi_get_state()->wait_timeout_cycles, false);
 }
 
 template <typename T>
@@ -278,4 +449,90 @@ SHMEM_DEVICE int shmemi_test_all(__gm__ T *sig_addr, size_t nelems, const int *s
     return ret;
 }
 
-#endif
\ No newline at end of file
+/**
+ * Scan contiguous ivars[0, nelems) once. Each UB sized chunk is fetched by a single MTE2 read, which always observes
+ * GM, instead of a dcci_cacheline and a scalar load per element. Entries with status[i] != 0 are skipped, cmp_values
+ * selects a per-entry comparison value when not null. Satisfied indices are written to indices (if not null), the
+ * scan stops at the first hit when first_only is set. Returns the number of satisfied entries.
+ */
+template <typename T>
+SHMEM_DEVICE size_t shmemi_scan_ivars(__gm__ T *ivars, size_t nelems, const int *status, int cmp, T cmp_val,
+                                      const T *cmp_values, size_t *indices, bool first_only)
+{
+    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    __ubuf__ T *buf = reinterpret_cast<__ubuf__ T *>(device_state->mte_config.shmem_ub);
+    size_t chunk = device_state->mte_config.ub_size / sizeof(T);
+    AscendC::TEventID event_id = (AscendC::TEventID)device_state->mte_config.event_id;
+
+    // the buffer is the shared RMA staging UB, an earlier put_nbi may still be draining it through MTE3
+    AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(event_id);
+    AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(event_id);
+
+    size_t found = 0;
+    for (size_t base = 0; base < nelems; base += chunk) {
+        size_t len = (nelems - base) < chunk ? (nelems - base) : chunk;
+
+        // scalar reads of the previous chunk must finish before MTE2 overwrites the buffer
+        AscendC::SetFlag<AscendC::HardEvent::S_MTE2>(event_id);
+        AscendC::WaitFlag<AscendC::HardEvent::S_MTE2>(event_id);
+        smem_shm_copy_gm2ub(buf, ivars + base, len * sizeof(T));
+        AscendC::SetFlag<AscendC::HardEvent::MTE2_S>(event_id);
+        AscendC::WaitFlag<AscendC::HardEvent::MTE2_S>(event_id);
+
+        for (size_t i = 0; i < len; i++) {
+            size_t idx = base + i;
+            if (status && status[idx] != 0) {
+                continue;
+            }
+            if (!shmemi_compare(buf[i], cmp, cmp_values ? cmp_values[idx] : cmp_val)) {
+                continue;
+            }
+            if (indices) {
+                indices[found] = idx;
+            }
+            found++;
+            if (first_only) {
+                return found;
+            }
+        }
+    }
+    return found;
+}
+
+template <typename T>
+SHMEM_DEVICE size_t shmemi_wait_until_any(__gm__ T *ivars, size_t nelems, const int *status, int cmp, T cmp_val,
+                                          const T *cmp_values = nullptr)
+{
+    size_t active = 0;
+    for (size_t i = 0; i < nelems; i++) {
+        active += (status && status[i] != 0) ? 0 : 1;
+    }
+    if (active == 0) {
+        return SIZE_MAX;
+    }
+
+    size_t idx = SIZE_MAX;
+    while (shmemi_scan_ivars(ivars, nelems, status, cmp, cmp_val, cmp_values, &idx, true) == 0) {
+    }
+    return idx;
+}
+
+template <typename T>
+SHMEM_DEVICE size_t shmemi_wait_until_some(__gm__ T *ivars, size_t nelems, size_t *indices, const int *status,
+                                           int cmp, T cmp_val, const T *cmp_values = nullptr)
+{
+    size_t active = 0;
+    for (size_t i = 0; i < nelems; i++) {
+        active += (status && status[i] != 0) ? 0 : 1;
+    }
+    if (active == 0) {
+        return 0;
+    }
+
+    size_t found;
+    while ((found = shmemi_scan_ivars(ivars, nelems, status, cmp, cmp_val, cmp_values, indices, false)) == 0) {
+    }
+    return found;
+}
+
+#endif
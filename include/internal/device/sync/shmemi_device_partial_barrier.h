@@ -23,10 +23,10 @@ __gm__ shmemi_sync_bit *shmemi_get_team_partial_barrier_slot(shmem_team_t team_i
     return (__gm__ shmemi_sync_bit *)addr;
 }
 
-SHMEM_DEVICE uint32_t* get_partial_barrier_idx()
+// Number of partial barriers called on the team by this PE, kept after the slots so that it survives kernel launches.
+SHMEM_DEVICE __gm__ int32_t *shmemi_get_team_partial_barrier_counter(shmem_team_t team_idx)
 {
-    static uint32_t g_partial_barrier_idx = 0;
-    return &g_partial_barrier_idx;
+    return (__gm__ int32_t *)shmemi_get_team_partial_barrier_slot(team_idx, SHMEM_PARTIAL_BARRIER_MAX_SLOTS);
 }
 
 SHMEM_DEVICE bool in_pes(__gm__ uint32_t *pes, int my_pe, uint32_t count)
@@ -39,10 +39,14 @@ SHMEM_DEVICE bool in_pes(__gm__ uint32_t *pes, int my_pe, uint32_t count)
     return false;
 }
 
+/* Centralized pull over the listed PEs. Each PE publishes the epoch of the slot, i.e. how many times the slot has
+   been used including this one. A slot only ever grows, so a value of at least epoch means the peer has arrived and
+   slots never need clearing. */
 SHMEM_DEVICE void shmemi_partial_barrier_npu_v3(shmemi_team_t *team,
                                                 __gm__ int32_t *slot_base,
                                                 __gm__ uint32_t *pes,
-                                                uint32_t count)
+                                                uint32_t count,
+                                                int32_t epoch)
 {
     if (count == 0 || pes == nullptr) {
         return;
@@ -65,10 +69,11 @@ SHMEM_DEVICE void shmemi_partial_barrier_npu_v3(shmemi_team_t *team,
     for (uint32_t i = (uint32_t)vec_id; i < count; i += (uint32_t)k) {
         uint32_t remote_pe = pes[i];
         if ((int)remote_pe == my_pe_in_team) {
-            shmemi_signal_set(slot_base, 1);
+            shmemi_signal_set(slot_base, epoch);
         } else {
-            shmemi_signal_wait_until_eq_for_barrier(
-                (__gm__ int32_t *)shmemi_ptr(slot_base, (int)(remote_pe * stride + start)), 1);
+            int global_pe = (int)(remote_pe * stride + start);
+            shmemi_signal_wait_until_ge_for_barrier((__gm__ int32_t *)shmemi_ptr(slot_base, global_pe), epoch,
+                                                    team->team_idx, global_pe);
         }
     }
 }
@@ -92,51 +97,32 @@ SHMEM_DEVICE void shmemi_partial_barrier(shmem_team_t tid, __gm__ uint32_t *pes,
         // not in this team
         return;
     }
-    uint32_t *g_partial_barrier_idx = get_partial_barrier_idx();
-    uint32_t idx_snapshot = *g_partial_barrier_idx;
-    uint32_t slot = idx_snapshot % SHMEM_PARTIAL_BARRIER_MAX_SLOTS;
+    // every team member advances the counter on each call, so all of them agree on slot and epoch
+    auto counter = shmemi_get_team_partial_barrier_counter(team->team_idx);
+    dcci_cacheline((__gm__ uint8_t *)counter);
+    uint32_t idx = (uint32_t)shmemi_load(counter);
+    uint32_t slot = idx % SHMEM_PARTIAL_BARRIER_MAX_SLOTS;
+    int32_t epoch = (int32_t)(idx / SHMEM_PARTIAL_BARRIER_MAX_SLOTS) + 1;
 
     auto slot_sync = shmemi_get_team_partial_barrier_slot(team->team_idx, slot);
     auto slot_base = (__gm__ int32_t *)slot_sync;
 
-    int vec_id   = AscendC::GetBlockIdx();
-    int vec_size = AscendC::GetBlockNum() * AscendC::GetTaskRation();
-    
+    shmemi_fence_flush_lines(-1);
     shmemi_barrier_core<is_aiv_only>();
-    if (vec_id == 0) {
-        uint32_t new_idx = *g_partial_barrier_idx + 1;
-        if (new_idx >= SHMEM_PARTIAL_BARRIER_MAX_SLOTS) {
-            auto s_sync = shmemi_get_team_partial_barrier_slot(team->team_idx, 0);
-            auto s_base = (__gm__ int32_t *)s_sync;
-            constexpr uint32_t clear_count = SHMEM_PARTIAL_BARRIER_PER_TEAM_SIZE / sizeof(int32_t);
-            AscendC::LocalTensor<int32_t> ub_tensor_32;
-            ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
-            ub_tensor_32.address_.bufferAddr = SHMEM_INTERNAL_UB_BUF_START_ADDR;
-            ub_tensor_32.address_.dataLen = clear_count;
-            AscendC::Duplicate(ub_tensor_32, 0, clear_count);
-            AscendC::GlobalTensor<int32_t> s_gm;
-            s_gm.SetGlobalBuffer(s_base, clear_count * sizeof(int32_t));
-            AscendC::DataCopy(s_gm, ub_tensor_32, clear_count);
-            new_idx = 0;
+    if ASCEND_IS_AIV {
+        if (AscendC::GetBlockIdx() == 0) {
+            shmemi_store(counter, (int32_t)(idx + 1));
+            dcci_cacheline((__gm__ uint8_t *)counter);
         }
-        *g_partial_barrier_idx = new_idx;
-        dcci_cacheline(reinterpret_cast<__gm__ uint8_t *>(reinterpret_cast<uint64_t>(g_partial_barrier_idx)));
     }
-
     shmemi_barrier_core<is_aiv_only>();
-    dcci_cacheline(reinterpret_cast<__gm__ uint8_t *>(reinterpret_cast<uint64_t>(g_partial_barrier_idx)));
-    if (*g_partial_barrier_idx == 0) {
-        shmemi_barrier<is_aiv_only>(tid);
-    }
-    
+
     if (!in_pes(pes, my_pe_in_team, count)) {
         return;
     }
 
-    shmemi_barrier_core<is_aiv_only>();
-
     if ASCEND_IS_AIV {
-        shmemi_partial_barrier_npu_v3(team, slot_base, pes, count);
+        shmemi_partial_barrier_npu_v3(team, slot_base, pes, count, epoch);
     }
     shmemi_barrier_core<is_aiv_only>();
 }
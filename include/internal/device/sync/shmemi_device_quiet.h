@@ -12,13 +12,124 @@
 
 #include "internal/device/shmemi_device_common.h"
 
+/*
+Fence tracking
+
+Deferred scalar stores (shmemx_<type>_p_nbi) leave their destination cacheline dirty in the data cache and record it
+here instead of writing it back immediately. shmemx_quiet_pe then writes back only the recorded lines of one PE,
+rather than the entire data cache, and repeated stores into the same line cost a single writeback. shmem_fence
+writes back the recorded lines of every PE. Every core owns one cacheline aligned table, vector cores first and cube
+cores after them. A store that does not fit marks the table overflowed, the next writeback then falls back to the
+entire data cache.
+*/
+constexpr uint32_t SHMEMI_FENCE_TRACK_LINES = 16;
+constexpr uint32_t SHMEMI_FENCE_TRACK_CORES = SHMEM_MAX_AIV_PER_NPU + SHMEM_MAX_AIV_PER_NPU / 2;
+
+typedef struct alignas(SHMEM_DATA_CACHE_LINE_SIZE) {
+    uint64_t lines[SHMEMI_FENCE_TRACK_LINES];
+    int32_t pes[SHMEMI_FENCE_TRACK_LINES];
+    uint32_t count;
+    uint32_t overflow;
+} shmemi_fence_tracker_t;
+
+SHMEM_DEVICE shmemi_fence_tracker_t *shmemi_get_fence_tracker()
+{
+    static shmemi_fence_tracker_t g_fence_tracker[SHMEMI_FENCE_TRACK_CORES] = {};
+    uint32_t core = 0;
+    if ASCEND_IS_AIV {
+        core = AscendC::GetBlockIdx() % SHMEM_MAX_AIV_PER_NPU;
+    } else {
+        core = SHMEM_MAX_AIV_PER_NPU + AscendC::GetBlockIdx() % (SHMEMI_FENCE_TRACK_CORES - SHMEM_MAX_AIV_PER_NPU);
+    }
+    return &g_fence_tracker[core];
+}
+
+// Write back the recorded lines destined to pe, or every recorded line when pe < 0.
+SHMEM_DEVICE void shmemi_fence_flush_lines(int pe)
+{
+    shmemi_fence_tracker_t *tracker = shmemi_get_fence_tracker();
+    if (tracker->overflow) {
+        dcci_entire_cache();
+        tracker->count = 0;
+        tracker->overflow = 0;
+        return;
+    }
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < tracker->count; i++) {
+        if (pe >= 0 && tracker->pes[i] != pe) {
+            tracker->lines[kept] = tracker->lines[i];
+            tracker->pes[kept] = tracker->pes[i];
+            kept++;
+            continue;
+        }
+        dcci_cacheline((__gm__ uint8_t *)tracker->lines[i]);
+    }
+    tracker->count = kept;
+}
+
+SHMEM_DEVICE void shmemi_fence_track(__gm__ void *addr, int pe)
+{
+    shmemi_fence_tracker_t *tracker = shmemi_get_fence_tracker();
+    uint64_t line = reinterpret_cast<uint64_t>(addr) / SHMEM_DATA_CACHE_LINE_SIZE * SHMEM_DATA_CACHE_LINE_SIZE;
+    for (uint32_t i = 0; i < tracker->count; i++) {
+        if (tracker->lines[i] == line) {
+            return;
+        }
+    }
+    if (tracker->count == SHMEMI_FENCE_TRACK_LINES) {
+        tracker->overflow = 1;
+        return;
+    }
+    tracker->lines[tracker->count] = line;
+    tracker->pes[tracker->count] = pe;
+    tracker->count++;
+}
+
+// Wait for every MTE3 transfer issued so far, cheaper than draining all pipes.
+SHMEM_DEVICE void shmemi_wait_mte3()
+{
+    AscendC::TEventID event_id = (AscendC::TEventID)shmemi_get_state()->mte_config.event_id;
+    AscendC::SetFlag<AscendC::HardEvent::MTE3_S>(event_id);
+    AscendC::WaitFlag<AscendC::HardEvent::MTE3_S>(event_id);
+}
+
 SHMEM_DEVICE void shmemi_quiet()
 {
     // clear instruction pipes
     AscendC::PipeBarrier<PIPE_ALL>();
 
-    // flush data cache to GM
+    // complete outstanding non-blocking atomics
+    dcci_atomic();
+
+    // flush data cache to GM, covers every tracked line
     dcci_entire_cache();
+    shmemi_fence_tracker_t *tracker = shmemi_get_fence_tracker();
+    tracker->count = 0;
+    tracker->overflow = 0;
+}
+
+/**
+ * Order without draining every pipe or flushing the entire data cache: MTE3 puts issued so far have landed,
+ * non-blocking atomics are drained and the tracked cachelines are written back before anything issued afterwards.
+ */
+SHMEM_DEVICE void shmemi_fence()
+{
+    shmemi_wait_mte3();
+    dcci_atomic();
+    shmemi_fence_flush_lines(-1);
+    dsb_all();
+}
+
+/**
+ * Complete the operations targeting pe. MTE3 and atomics cannot be told apart per destination, so only the tracked
+ * cachelines of other PEs are left pending.
+ */
+SHMEM_DEVICE void shmemi_quiet_pe(int pe)
+{
+    shmemi_wait_mte3();
+    dcci_atomic();
+    shmemi_fence_flush_lines(pe);
+    dsb_all();
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+/*
+Split-phase barrier
+
+shmemi_barrier_arrive publishes the arrival of this PE and returns the barrier count as token.
+shmemi_barrier_wait pulls the arrival of every other member, the same way as shmemi_barrier_npu_v3, and
+shmemi_barrier_test checks it without blocking. Work placed between arrive and wait overlaps the barrier latency.
+
+Arrival is published in slot 0 of the team sync array and counted by the team sync counter, so split-phase and
+regular barriers of a team may be interleaved, as long as every arrive is completed by a wait before the next barrier.
+Remote slots are read over MTE. Teams spanning several hosts complete the whole barrier in arrive instead.
+*/
+
+#ifndef SHEMEI_SPLIT_BARRIER_H
+#define SHEMEI_SPLIT_BARRIER_H
+
+#include "kernel_operator.h"
+#include "shmemi_device_barrier.h"
+
+SHMEM_DEVICE bool shmemi_barrier_split_supported(shmemi_team_t *team)
+{
+    // every member lives in this PE's MTE domain
+    return team->host_local_size == team->size;
+}
+
+template<bool is_aiv_only = true>
+SHMEM_DEVICE int32_t shmemi_barrier_arrive(shmem_team_t tid)
+{
+    shmemi_team_t *team = shmemi_get_state()->team_pools[tid];
+
+    int mype = shmemi_get_state()->team_pools[SHMEM_TEAM_WORLD]->mype;
+    if ((mype - team->start) % team->stride != 0) {
+        // not in this team
+        return 0;
+    }
+
+    // the counter is advanced by a single core, drop stale copies before reading it
+    auto sync_counter = shmemi_get_team_sync_counter(team->team_idx);
+    if (!shmemi_barrier_split_supported(team)) {
+        shmemi_barrier<is_aiv_only>(tid);
+        dcci_cacheline((__gm__ uint8_t *)sync_counter);
+        return shmemi_load((__gm__ int32_t *)sync_counter);
+    }
+
+    // every core reads the counter before block 0 advances it
+    dcci_cacheline((__gm__ uint8_t *)sync_counter);
+    int32_t count = shmemi_load((__gm__ int32_t *)sync_counter) + 1;
+
+    // deferred stores of all cores must be visible before the arrival is published
+    shmemi_fence_flush_lines(-1);
+    shmemi_barrier_core<is_aiv_only>();
+
+    if ASCEND_IS_AIV {
+        if (AscendC::GetBlockIdx() == 0) {
+            shmemi_store((__gm__ int32_t *)sync_counter, count);
+            dcci_cacheline((__gm__ uint8_t *)sync_counter);
+            shmemi_signal_set((__gm__ int32_t *)shmemi_get_team_sync_array(team->team_idx), count);
+        }
+    }
+    return count;
+}
+
+template<bool is_aiv_only = true>
+SHMEM_DEVICE void shmemi_barrier_wait(shmem_team_t tid, int32_t token)
+{
+    shmemi_team_t *team = shmemi_get_state()->team_pools[tid];
+
+    int mype = shmemi_get_state()->team_pools[SHMEM_TEAM_WORLD]->mype;
+    int start = team->start;
+    int stride = team->stride;
+    int size = team->size;
+    if ((mype - start) % stride != 0 || !shmemi_barrier_split_supported(team)) {
+        return;
+    }
+
+    if ASCEND_IS_AIV {
+        int vec_id = AscendC::GetBlockIdx();
+        int vec_size = AscendC::GetBlockNum() * AscendC::GetTaskRation();
+        int my_pe_in_team = (mype - start) / stride;
+        auto sync_array = shmemi_get_team_sync_array(team->team_idx);
+
+        for (int i = vec_id; i < size; i += vec_size) {
+            if (i == my_pe_in_team) {
+                continue;
+            }
+            int remote_pe = start + i * stride;
+            shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)shmemi_ptr(sync_array, remote_pe), token,
+                                                    team->team_idx, remote_pe);
+        }
+    }
+
+    shmemi_barrier_core<is_aiv_only>();
+}
+
+SHMEM_DEVICE int shmemi_barrier_test(shmem_team_t tid, int32_t token)
+{
+    shmemi_team_t *team = shmemi_get_state()->team_pools[tid];
+
+    int mype = shmemi_get_state()->team_pools[SHMEM_TEAM_WORLD]->mype;
+    int start = team->start;
+    int stride = team->stride;
+    int size = team->size;
+    if ((mype - start) % stride != 0 || !shmemi_barrier_split_supported(team)) {
+        return 1;
+    }
+
+    int my_pe_in_team = (mype - start) / stride;
+    auto sync_array = shmemi_get_team_sync_array(team->team_idx);
+    for (int i = 0; i < size; i++) {
+        if (i == my_pe_in_team) {
+            continue;
+        }
+        auto sig_addr = (__gm__ int32_t *)shmemi_ptr(sync_array, start + i * stride);
+        dcci_cacheline((__gm__ uint8_t *)sig_addr);
+
+        // token + 1 in case when peer pe enters next barrier
+        int32_t val = *sig_addr;
+        if (val != token && val != token + 1) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#endif
@@ -48,11 +48,42 @@ extern "C" {
 
 // partial barrier
 #define SHMEM_PARTIAL_BARRIER_MAX_SLOTS 64
-#define SHMEM_PARTIAL_BARRIER_PER_TEAM_SIZE (SHMEMI_SYNCBIT_SIZE * SHMEM_PARTIAL_BARRIER_MAX_SLOTS)
+// epoch-counted slots followed by the team's partial barrier counter
+#define SHMEM_PARTIAL_BARRIER_PER_TEAM_SIZE (SHMEMI_SYNCBIT_SIZE * (SHMEM_PARTIAL_BARRIER_MAX_SLOTS + 1))
 #define SHMEM_PARTIAL_BARRIER_POOL_SIZE (SHMEM_PARTIAL_BARRIER_PER_TEAM_SIZE * SHMEM_MAX_TEAMS)
 
+// wait diagnostics, a device local ring of shmemx_wait_diag_record_t behind a cacheline sized head counter
+#define SHMEM_WAIT_DIAG_RECORD_SIZE 64
+#define SHMEM_WAIT_DIAG_RING_ENTRIES 256
+#define SHMEM_WAIT_DIAG_HEAD_SIZE SCALAR_DATA_CACHELINE_SIZE
+#define SHMEM_WAIT_DIAG_RING_SIZE (SHMEM_WAIT_DIAG_HEAD_SIZE + SHMEM_WAIT_DIAG_RECORD_SIZE * SHMEM_WAIT_DIAG_RING_ENTRIES)
+#define SHMEM_SYS_CYCLES_PER_US 50      // system counter runs at 50MHz
+#define SHMEM_DEFAULT_WAIT_TIMEOUT_US (30UL * 1000 * 1000)
+#define SHMEM_MAX_WAIT_TIMEOUT_US (INT64_MAX / SHMEM_SYS_CYCLES_PER_US)  // larger budgets overflow the cycle count
+
+// Host nbi put/get size from which the copy is handed to the SDMA engine
+#define SHMEM_SDMA_DEFAULT_MIN_BYTES (1UL << 20)
+
+// device trace, per-core rings of shmemx_trace_record_t behind a cacheline sized head counter, vector cores first
+#define SHMEM_TRACE_RECORD_SIZE 32
+#define SHMEM_TRACE_RING_ENTRIES 1024
+#define SHMEM_TRACE_HEAD_SIZE SCALAR_DATA_CACHELINE_SIZE
+#define SHMEM_TRACE_CORE_RING_SIZE (SHMEM_TRACE_HEAD_SIZE + SHMEM_TRACE_RECORD_SIZE * SHMEM_TRACE_RING_ENTRIES)
+#define SHMEM_TRACE_MAX_CORES (SHMEM_MAX_AIV_PER_NPU + SHMEM_MAX_AIV_PER_NPU / 2)
+#define SHMEM_TRACE_REGION_SIZE (SHMEM_TRACE_CORE_RING_SIZE * SHMEM_TRACE_MAX_CORES)
+
+// progress watchdog, one cacheline sized shmemi_watchdog_record_t per vector core, sampled by a host thread
+#define SHMEM_WATCHDOG_RECORD_SIZE SCALAR_DATA_CACHELINE_SIZE
+#define SHMEM_WATCHDOG_REGION_SIZE (SHMEM_WATCHDOG_RECORD_SIZE * SHMEM_MAX_AIV_PER_NPU)
+
+// RoCE put with signal, per vector core ring of cacheline sized slots holding the signal value the NIC reads,
+// slot 0 of each ring keeps the ring cursor
+#define SHMEM_ROCE_SIGNAL_SLOTS 16
+#define SHMEM_ROCE_SIGNAL_POOL_SIZE (SHMEMI_SYNCBIT_SIZE * SHMEM_ROCE_SIGNAL_SLOTS * SHMEM_MAX_AIV_PER_NPU)
+
 // Total extra
-#define SHMEM_EXTRA_SIZE_UNALIGHED (SYNC_POOL_SIZE + SYNC_COUNTERS_SIZE + SHMEM_PARTIAL_BARRIER_POOL_SIZE)
+#define SHMEM_EXTRA_SIZE_UNALIGHED (SYNC_POOL_SIZE + SYNC_COUNTERS_SIZE + SHMEM_PARTIAL_BARRIER_POOL_SIZE + \
+                                    SHMEM_ROCE_SIGNAL_POOL_SIZE)
 #define SHMEM_EXTRA_SIZE ALIGH_TO(SHMEM_EXTRA_SIZE_UNALIGHED, SHMEM_PAGE_SIZE)
 
 // synchronization
@@ -78,8 +109,34 @@ typedef struct {
     uint64_t switch_trigger_addr;
     uint32_t switch_rkey;
     uint64_t switch_handle; // Handle to the switch barrier object
+
+    // Hierarchical Barrier Fields
+    int host_local_size;    // team members per host when hosts hold equal contiguous blocks, 0 otherwise
+
+    // Barrier selection, see shmemx_barrier_algo_t
+    int barrier_algo;
+    int barrier_k;          // radix of group dissemination, reads in flight of centralized pull
 } shmemi_team_t;
 
+// Synchronization site a core is blocked at, SHMEMI_SITE_IDLE once it left the wait.
+enum shmemi_sync_site_t : int32_t {
+    SHMEMI_SITE_IDLE = 0,
+    SHMEMI_SITE_BARRIER,        // barrier round, team and awaited pe are known
+    SHMEMI_SITE_WAIT,           // point-to-point wait_until on a symmetric word
+    SHMEMI_SITE_ROCE_QUIET,     // polling the RoCE completion queue of the awaited pe
+    SHMEMI_SITE_MAX,
+};
+
+// Watchdog record, only the owning core writes it.
+typedef struct {
+    uint64_t progress;  // bumped on every site change, a stalled core stops bumping it
+    int32_t site;
+    int32_t team;
+    int32_t pe;         // awaited pe, -1 when unknown
+    int32_t core;
+    int64_t timestamp;  // system cycle counter of the last change
+} shmemi_watchdog_record_t;
+
 // mte_config
 typedef struct {
     int64_t shmem_ub;        // __ubuf__ Ptr, Shmem memcpy needed.
@@ -101,6 +158,8 @@ typedef struct {
     void **sdma_heap_device_base;
     void **roce_heap_device_base;
     uint8_t topo_list[SHMEM_MAX_RANKS];
+    // Transport carrying RMA to rank i, a single SHMEM_TRANSPORT_* bit picked from topo_list, 0 when unreachable.
+    uint8_t route_list[SHMEM_MAX_RANKS];
     
     // Capability of the device connected to rank i: 1 if connected to switch with barrier offload
     uint8_t device_barrier_cap[SHMEM_MAX_RANKS];
@@ -119,6 +178,16 @@ typedef struct {
     uint64_t core_sync_counter;
 
     uint64_t partial_barrier_pool;
+    // Symmetric staging slots of RoCE put with signal, see SHMEM_ROCE_SIGNAL_POOL_SIZE.
+    uint64_t roce_signal_pool;
+
+    // Cycle budget of internal waits before they are reported to wait_diag_ring, 0 disables the check.
+    int64_t wait_timeout_cycles;
+    uint64_t wait_diag_ring;
+    // shmemi_watchdog_record_t per vector core, 0 unless SHMEM_WATCHDOG_MS enables the watchdog.
+    uint64_t watchdog_region;
+    // SHMEM_TRACE_MAX_CORES trace rings, 0 unless the library is built with SHMEM_ENABLE_TRACE.
+    uint64_t trace_region;
 
     bool is_shmem_initialized;
     bool is_shmem_created;
@@ -132,6 +201,15 @@ typedef struct {
     void *default_stream;
     int8_t default_event_id;
     uint32_t default_block_num;
+    // SHMEM_BARRIER_ALGO and SHMEM_BARRIER_RADIX overrides, 0 when unset
+    int32_t barrier_algo;
+    int32_t barrier_k;
+    // SHMEM_WATCHDOG_MS, stall threshold of the progress watchdog, 0 when disabled
+    uint32_t watchdog_ms;
+    // SHMEM_ROCE_QP_NUM, AI core RDMA QPs created to each remote PE, 1 when unset
+    uint32_t roce_qp_num;
+    // SHMEM_SDMA_MIN_BYTES, host nbi put/get of at least this size go through SDMA, 0 disables the SDMA path
+    uint64_t sdma_min_bytes;
 } shmemi_host_state_t;
 
 #ifdef __cplusplus
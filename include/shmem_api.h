@@ -25,5 +25,6 @@
 #include "host/shmem_host_rma.h"
 #include "host/shmem_host_sync.h"
 #include "host/shmem_host_team.h"
+#include "host/shmem_host_atomic.h"
 
 #endif // SHMEM_API_H
@@ -337,6 +337,10 @@ while [[ $# -gt 0 ]]; do
             COMPILE_OPTIONS="${COMPILE_OPTIONS} -DENABLE_ASCENDC_DUMP=ON"
             shift
             ;;
+        -enable_trace)
+            COMPILE_OPTIONS="${COMPILE_OPTIONS} -DENABLE_SHMEM_TRACE=ON"
+            shift
+            ;;
         -package)
             PACKAGE=ON
             PYEXPAND_TYPE=ON
@@ -130,6 +130,7 @@ export LD_LIBRARY_PATH=${PROJECT_ROOT}/build/lib:${PROJECT_ROOT}/install/memfabr
 
 # Run unit test
 cd "$BUILD_PATH"
+./bin/shmem_roce_model_test --gtest_output=xml:roce_model_detail.xml
 ./bin/shmem_unittest "$RANK_SIZE" "$IPPORT" "$GNPU_NUM" "$FIRST_RANK" "$FIRST_NPU"  --gtest_output=xml:test_detail.xml --gtest_filter=${TEST_FILTER}
 
 # Collect coverage
@@ -18,10 +18,41 @@ SHMEM_GLOBAL void k_shmem_barrier(int32_t tid)
     shmemi_barrier<false>(tid);
 }
 
+SHMEM_GLOBAL void k_shmem_barrier_calibrate(int32_t tid, int32_t algo, int32_t k, int32_t iters, GM_ADDR cycles)
+{
+    shmemi_team_t *team = shmemi_get_state()->team_pools[tid];
+
+    shmemi_barrier_core<false>();
+    int64_t start = AscendC::GetSystemCycle();
+    for (int32_t i = 0; i < iters; i++) {
+        if ASCEND_IS_AIV {
+            shmemi_barrier_npu(team, algo, k);
+        }
+        shmemi_barrier_core<false>();
+    }
+    int64_t elapsed = AscendC::GetSystemCycle() - start;
+
+    if ASCEND_IS_AIV {
+        if (AscendC::GetBlockIdx() == 0) {
+            *(__gm__ int64_t *)cycles = elapsed;
+            dcci_cacheline(cycles);
+        }
+    }
+}
+
 // interfaces
 int32_t shmemi_barrier_on_stream(shmem_team_t tid, aclrtStream stream)
 {
     // call barrier kernel
     k_shmem_barrier<<<1, nullptr, stream>>>((int32_t)tid);
     return aclrtSynchronizeStream(stream);
-}
\ No newline at end of file
+}
+
+int32_t shmemi_barrier_calibrate_on_stream(shmem_team_t tid, int32_t algo, int32_t k, int32_t iters,
+                                           int64_t *cycles, aclrtStream stream)
+{
+    // enough cores for centralized pull to keep k reads in flight
+    k_shmem_barrier_calibrate<<<SHMEM_BARRIER_TG_DISSEM_KVAL, nullptr, stream>>>((int32_t)tid, algo, k, iters,
+                                                                               (uint8_t *)cycles);
+    return aclrtSynchronizeStream(stream);
+}
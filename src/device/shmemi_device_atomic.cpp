@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "acl/acl.h"
+#include "kernel_operator.h"
+#include "shmemi_device_atomic.h"
+
+// kernels
+#define SHMEMI_TYPENAME_AMO(NAME, TYPE)                                                                           \
+    SHMEM_GLOBAL void shmemi_##NAME##_amo(uint32_t op, GM_ADDR dst, TYPE cond, TYPE value, int32_t pe,            \
+                                          GM_ADDR fetch_addr)                                                     \
+    {                                                                                                             \
+        if ASCEND_IS_AIV {                                                                                        \
+            /* the operation must be issued exactly once */                                                       \
+            if (AscendC::GetBlockIdx() != 0) {                                                                    \
+                return;                                                                                           \
+            }                                                                                                     \
+            __gm__ TYPE *dst_addr = (__gm__ TYPE *)dst;                                                           \
+            TYPE old;                                                                                             \
+            switch (op) {                                                                                         \
+                case SHMEMI_AMO_FETCH_ADD:                                                                        \
+                    old = shmem_##NAME##_atomic_fetch_add(dst_addr, value, pe);                                   \
+                    break;                                                                                        \
+                case SHMEMI_AMO_COMPARE_SWAP:                                                                     \
+                    old = shmem_##NAME##_atomic_compare_swap(dst_addr, cond, value, pe);                          \
+                    break;                                                                                        \
+                case SHMEMI_AMO_SWAP:                                                                             \
+                    old = shmem_##NAME##_atomic_swap(dst_addr, value, pe);                                        \
+                    break;                                                                                        \
+                default:                                                                                          \
+                    old = shmem_##NAME##_atomic_fetch(dst_addr, pe);                                              \
+                    break;                                                                                        \
+            }                                                                                                     \
+            *((__gm__ TYPE *)fetch_addr) = old;                                                                   \
+            dcci_cacheline(fetch_addr);                                                                           \
+        }                                                                                                         \
+    }
+
+SHMEM_TYPE_FUNC_ATOMIC_FETCH(SHMEMI_TYPENAME_AMO)
+#undef SHMEMI_TYPENAME_AMO
+
+#define SHMEMI_TYPENAME_ATOMIC_ADD_VEC(NAME, TYPE)                                                                \
+    SHMEM_GLOBAL void shmemi_##NAME##_atomic_add_vec(GM_ADDR dst, GM_ADDR values, GM_ADDR pes, uint32_t n)        \
+    {                                                                                                             \
+        if ASCEND_IS_AIV {                                                                                        \
+            if (AscendC::GetBlockIdx() != 0) {                                                                    \
+                return;                                                                                           \
+            }                                                                                                     \
+            /* values and pes were just copied from host, drop stale lines of the previous launch */              \
+            dcci_entire_cache();                                                                                  \
+            shmemx_##NAME##_atomic_add_vec((__gm__ TYPE *)dst, (__gm__ TYPE *)values, (__gm__ int32_t *)pes, n);  \
+            shmem_quiet();                                                                                        \
+        }                                                                                                         \
+    }
+
+SHMEM_TYPE_FUNC_ATOMIC_ADD_HOST(SHMEMI_TYPENAME_ATOMIC_ADD_VEC)
+#undef SHMEMI_TYPENAME_ATOMIC_ADD_VEC
+
+// interfaces
+#define SHMEMI_TYPENAME_AMO_ON_STREAM(NAME, TYPE)                                                                 \
+    int32_t shmemi_##NAME##_amo_on_stream(uint32_t op, uint8_t *dst, TYPE cond, TYPE value, int pe,               \
+                                          uint8_t *fetch_addr, aclrtStream acl_strm)                              \
+    {                                                                                                             \
+        shmemi_##NAME##_amo<<<1, 0, acl_strm>>>(op, dst, cond, value, pe, fetch_addr);                            \
+        return 0;                                                                                                 \
+    }
+
+SHMEM_TYPE_FUNC_ATOMIC_FETCH(SHMEMI_TYPENAME_AMO_ON_STREAM)
+#undef SHMEMI_TYPENAME_AMO_ON_STREAM
+
+#define SHMEMI_TYPENAME_ATOMIC_ADD_VEC_ON_STREAM(NAME, TYPE)                                                      \
+    int32_t shmemi_##NAME##_atomic_add_vec_on_stream(uint8_t *dst, uint8_t *values, uint8_t *pes, uint32_t n,     \
+                                                     aclrtStream acl_strm)                                        \
+    {                                                                                                             \
+        shmemi_##NAME##_atomic_add_vec<<<1, 0, acl_strm>>>(dst, values, pes, n);                                  \
+        return 0;                                                                                                 \
+    }
+
+SHMEM_TYPE_FUNC_ATOMIC_ADD_HOST(SHMEMI_TYPENAME_ATOMIC_ADD_VEC_ON_STREAM)
+#undef SHMEMI_TYPENAME_ATOMIC_ADD_VEC_ON_STREAM
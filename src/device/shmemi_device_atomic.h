@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_DEVICE_ATOMIC_H
+#define SHMEMI_DEVICE_ATOMIC_H
+
+#include <cstdint>
+#include <cstddef>
+#include <acl/acl.h>
+#include "shmem_api.h"
+
+enum shmemi_amo_op_t {
+    SHMEMI_AMO_FETCH_ADD = 0,
+    SHMEMI_AMO_COMPARE_SWAP,
+    SHMEMI_AMO_SWAP,
+    SHMEMI_AMO_FETCH,
+};
+
+// run one fetching atomic on (dst, pe) and store the previous value to the device address fetch_addr
+#define SHMEMI_TYPENAME_AMO_ON_STREAM(NAME, TYPE)                                                                   \
+    int32_t shmemi_##NAME##_amo_on_stream(uint32_t op, uint8_t *dst, TYPE cond, TYPE value, int pe,                 \
+                                          uint8_t *fetch_addr, aclrtStream acl_strm);
+
+SHMEM_TYPE_FUNC_ATOMIC_FETCH(SHMEMI_TYPENAME_AMO_ON_STREAM)
+#undef SHMEMI_TYPENAME_AMO_ON_STREAM
+
+// issue n coalesced atomic adds (values[i] to dst on pes[i]) from one core and quiet
+#define SHMEMI_TYPENAME_ATOMIC_ADD_VEC_ON_STREAM(NAME, TYPE)                                                        \
+    int32_t shmemi_##NAME##_atomic_add_vec_on_stream(uint8_t *dst, uint8_t *values, uint8_t *pes, uint32_t n,       \
+                                                     aclrtStream acl_strm);
+
+SHMEM_TYPE_FUNC_ATOMIC_ADD_HOST(SHMEMI_TYPENAME_ATOMIC_ADD_VEC_ON_STREAM)
+#undef SHMEMI_TYPENAME_ATOMIC_ADD_VEC_ON_STREAM
+
+#endif
@@ -18,6 +18,10 @@ int32_t shmemi_memset(int32_t *array, int32_t len, int32_t val, int32_t count);
 
 int32_t shmemi_barrier_on_stream(shmem_team_t tid, void *stream);
 
+// runs iters barriers of the given algorithm on the team, the cycles spent are written to cycles (device memory)
+int32_t shmemi_barrier_calibrate_on_stream(shmem_team_t tid, int32_t algo, int32_t k, int32_t iters,
+                                           int64_t *cycles, void *stream);
+
 void shmemi_handle_wait_on_stream(shmem_handle_t handle, aclrtStream stream);
 
 #endif
\ No newline at end of file
@@ -53,6 +53,122 @@ SHMEM_GLOBAL void k_shmem_getmem(GM_ADDR dst, GM_ADDR src, size_t elem_size, int
     shmem_getmem(dst, src, elem_size, pe);
 }
 
+// Max repeat accepted by a single DataCopyExtParams descriptor.
+constexpr uint32_t SHMEMI_MEM_2D_MAX_REPEAT = 4095;
+
+// Copy n_rows rows of row_bytes each, rows are dst_ld / src_ld bytes apart. Rows are split evenly across blocks.
+// On MTE peers several rows are packed into one strided DataCopyExt descriptor as long as they fit in the copy UB,
+// otherwise (RoCE peers or rows larger than the copy UB) each row is sent as a contiguous transfer.
+SHMEM_DEVICE void shmemi_mem_2d_nbi(bool is_put, GM_ADDR dst, GM_ADDR src, uint32_t n_rows, uint32_t row_bytes,
+                                    uint32_t dst_ld, uint32_t src_ld, int32_t pe)
+{
+    uint32_t block_idx = AscendC::GetBlockIdx();
+    uint32_t block_num = AscendC::GetBlockNum();
+    uint32_t rows_per_block = (n_rows + block_num - 1) / block_num;
+    uint32_t row_start = block_idx * rows_per_block;
+    if (row_start >= n_rows) {
+        return;
+    }
+    uint32_t row_end = (row_start + rows_per_block < n_rows) ? (row_start + rows_per_block) : n_rows;
+
+    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;
+    uint32_t ub_row_bytes = ALIGN_UP(row_bytes, UB_ALIGN_SIZE);
+    uint32_t rows_per_copy = device_state->mte_config.ub_size / ub_row_bytes;
+    if (rows_per_copy > SHMEMI_MEM_2D_MAX_REPEAT) {
+        rows_per_copy = SHMEMI_MEM_2D_MAX_REPEAT;
+    }
+    bool use_descriptor = (device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) && (rows_per_copy > 0);
+    uint32_t step = use_descriptor ? rows_per_copy : 1;
+
+    for (uint32_t row = row_start; row < row_end; row += step) {
+        if (row != row_start) {
+            AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(copy_event_id);
+            AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(copy_event_id);
+        }
+        __gm__ uint8_t *row_dst = dst + static_cast<uint64_t>(row) * dst_ld;
+        __gm__ uint8_t *row_src = src + static_cast<uint64_t>(row) * src_ld;
+        if (!use_descriptor) {
+            if (is_put) {
+                shmem_put_uint8_mem_nbi(row_dst, row_src, row_bytes, pe);
+            } else {
+                shmem_get_uint8_mem_nbi(row_dst, row_src, row_bytes, pe);
+            }
+            continue;
+        }
+        uint32_t rows = (row_end - row < rows_per_copy) ? (row_end - row) : rows_per_copy;
+        non_contiguous_copy_param copy_params = {rows, row_bytes, src_ld, dst_ld};
+        if (is_put) {
+            shmem_put_uint8_mem_nbi(row_dst, row_src, copy_params, pe);
+        } else {
+            shmem_get_uint8_mem_nbi(row_dst, row_src, copy_params, pe);
+        }
+    }
+}
+
+SHMEM_GLOBAL void shmemi_putmem_2d_nbi(GM_ADDR lptr, GM_ADDR rptr, uint32_t n_rows, uint32_t row_bytes,
+                                       uint32_t dst_ld, uint32_t src_ld, int32_t pe)
+{
+    shmemi_mem_2d_nbi(true, lptr, rptr, n_rows, row_bytes, dst_ld, src_ld, pe);
+}
+
+SHMEM_GLOBAL void shmemi_putmem_2d(GM_ADDR lptr, GM_ADDR rptr, uint32_t n_rows, uint32_t row_bytes,
+                                   uint32_t dst_ld, uint32_t src_ld, int32_t pe)
+{
+    shmemi_mem_2d_nbi(true, lptr, rptr, n_rows, row_bytes, dst_ld, src_ld, pe);
+    shmem_quiet();
+}
+
+SHMEM_GLOBAL void shmemi_getmem_2d_nbi(GM_ADDR lptr, GM_ADDR rptr, uint32_t n_rows, uint32_t row_bytes,
+                                       uint32_t dst_ld, uint32_t src_ld, int32_t pe)
+{
+    shmemi_mem_2d_nbi(false, lptr, rptr, n_rows, row_bytes, dst_ld, src_ld, pe);
+}
+
+SHMEM_GLOBAL void shmemi_getmem_2d(GM_ADDR lptr, GM_ADDR rptr, uint32_t n_rows, uint32_t row_bytes,
+                                   uint32_t dst_ld, uint32_t src_ld, int32_t pe)
+{
+    shmemi_mem_2d_nbi(false, lptr, rptr, n_rows, row_bytes, dst_ld, src_ld, pe);
+    shmem_quiet();
+}
+
+// Descriptors are strided across blocks, each block drains its share with nbi transfers and quiets once at the end.
+SHMEM_GLOBAL void shmemi_rma_batch(GM_ADDR desc_addr, uint32_t n)
+{
+    __gm__ shmemx_rma_desc_t *descs = reinterpret_cast<__gm__ shmemx_rma_desc_t *>(desc_addr);
+    uint32_t block_idx = AscendC::GetBlockIdx();
+    uint32_t block_num = AscendC::GetBlockNum();
+    AscendC::TEventID copy_event_id = (AscendC::TEventID)shmemi_get_state()->mte_config.event_id;
+
+    for (uint32_t i = block_idx; i < n; i += block_num) {
+        if (i != block_idx) {
+            AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(copy_event_id);
+            AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(copy_event_id);
+        }
+        __gm__ shmemx_rma_desc_t *desc = descs + i;
+        dcci_cachelines(reinterpret_cast<__gm__ uint8_t *>(desc), sizeof(shmemx_rma_desc_t));
+        __gm__ uint8_t *dst = reinterpret_cast<__gm__ uint8_t *>(desc->dst);
+        __gm__ uint8_t *src = reinterpret_cast<__gm__ uint8_t *>(desc->src);
+        uint32_t bytes = static_cast<uint32_t>(desc->bytes);
+        int32_t pe = desc->pe;
+        switch (desc->op) {
+            case SHMEMX_RMA_PUT:
+                shmem_put_uint8_mem_nbi(dst, src, bytes, pe);
+                break;
+            case SHMEMX_RMA_GET:
+                shmem_get_uint8_mem_nbi(dst, src, bytes, pe);
+                break;
+            case SHMEMX_RMA_PUT_SIGNAL:
+                shmem_put_uint8_mem_signal_nbi(dst, src, bytes, reinterpret_cast<__gm__ int32_t *>(desc->sig_addr),
+                                               desc->signal, desc->sig_op, pe);
+                break;
+            default:
+                break;
+        }
+    }
+    shmem_quiet();
+}
+
 // kernel function calling entrance
 int32_t shmemi_prepare_and_post_rma(const char *api_name, shmemi_op_t desc, bool is_nbi, uint8_t *lptr, uint8_t *rptr,
                                     size_t n_elems, size_t elem_bytes, int pe, uint8_t *sig_addr, int32_t signal,
@@ -60,7 +176,12 @@ int32_t shmemi_prepare_and_post_rma(const char *api_name, shmemi_op_t desc, bool
                                     size_t block_size)
 {
     if ((lstride > 1) || (rstride > 1)) {
-        return -1;
+        // strided transfer: n_elems rows of a single element each
+        if (desc != SHMEMI_OP_PUT && desc != SHMEMI_OP_GET) {
+            return -1;
+        }
+        return shmemi_prepare_and_post_rma_2d(api_name, desc, is_nbi, lptr, rptr, n_elems, 1, elem_bytes, pe,
+                                              lstride, rstride, acl_strm, block_size);
     }
 
     if (is_nbi) {
@@ -95,22 +216,56 @@ int32_t shmemi_prepare_and_post_rma(const char *api_name, shmemi_op_t desc, bool
     return 0;
 }
 
-int32_t shmemi_getmem_on_stream(uint8_t *dst, uint8_t *src, size_t elem_size, int32_t pe, aclrtStream stream)
+int32_t shmemi_prepare_and_post_rma_2d(const char *api_name, shmemi_op_t desc, bool is_nbi, uint8_t *lptr,
+                                       uint8_t *rptr, size_t n_rows, size_t row_elems, size_t elem_bytes, int pe,
+                                       ptrdiff_t lstride, ptrdiff_t rstride, aclrtStream acl_strm, size_t block_size)
 {
-    k_shmem_getmem<<<1, nullptr, stream>>>(dst, src, elem_size, pe);
-    return aclrtSynchronizeStream(stream);
-}
+    if (n_rows == 0 || row_elems == 0) {
+        return 0;
+    }
+    // strides are in elements and rows must not overlap
+    if (lstride < static_cast<ptrdiff_t>(row_elems) || rstride < static_cast<ptrdiff_t>(row_elems)) {
+        return -1;
+    }
+    uint64_t row_bytes = row_elems * elem_bytes;
+    uint64_t dst_ld = static_cast<uint64_t>(lstride) * elem_bytes;
+    uint64_t src_ld = static_cast<uint64_t>(rstride) * elem_bytes;
+    if (n_rows > UINT32_MAX || dst_ld > UINT32_MAX || src_ld > UINT32_MAX) {
+        return -1;
+    }
 
-#define SHMEMI_TYPENAME_P(NAME, TYPE)                                                \
-    SHMEM_GLOBAL void shmemi_##NAME##_p(GM_ADDR dest_addr, const TYPE value, int pe) \
-    {                                                                                \
-        __gm__ TYPE *dst = (__gm__ TYPE *)dest_addr;                                 \
-        shmem_##NAME##_p(dst, value, pe);                                            \
+    switch (desc) {
+        case SHMEMI_OP_PUT:
+            if (is_nbi) {
+                shmemi_putmem_2d_nbi<<<block_size, 0, acl_strm>>>(lptr, rptr, n_rows, row_bytes, dst_ld, src_ld, pe);
+            } else {
+                shmemi_putmem_2d<<<block_size, 0, acl_strm>>>(lptr, rptr, n_rows, row_bytes, dst_ld, src_ld, pe);
+            }
+            break;
+        case SHMEMI_OP_GET:
+            if (is_nbi) {
+                shmemi_getmem_2d_nbi<<<block_size, 0, acl_strm>>>(lptr, rptr, n_rows, row_bytes, dst_ld, src_ld, pe);
+            } else {
+                shmemi_getmem_2d<<<block_size, 0, acl_strm>>>(lptr, rptr, n_rows, row_bytes, dst_ld, src_ld, pe);
+            }
+            break;
+        default:
+            return -1;
     }
+    return 0;
+}
 
-SHMEM_TYPE_FUNC(SHMEMI_TYPENAME_P)
+int32_t shmemi_rma_batch_on_stream(uint8_t *desc, uint32_t n, aclrtStream acl_strm, size_t block_size)
+{
+    shmemi_rma_batch<<<block_size, 0, acl_strm>>>(desc, n);
+    return 0;
+}
 
-#undef SHMEMI_TYPENAME_P
+int32_t shmemi_getmem_on_stream(uint8_t *dst, uint8_t *src, size_t elem_size, int32_t pe, aclrtStream stream)
+{
+    k_shmem_getmem<<<1, nullptr, stream>>>(dst, src, elem_size, pe);
+    return aclrtSynchronizeStream(stream);
+}
 
 // shmem_g
 #define SHMEMI_TYPENAME_G(NAME, TYPE)                                            \
@@ -123,13 +278,3 @@ SHMEM_TYPE_FUNC(SHMEMI_TYPENAME_P)
 
 SHMEM_TYPE_FUNC(SHMEMI_TYPENAME_G)
 #undef SHMEMI_TYPENAME_G
-
-#define SHMEMI_TYPENAME_PREPARE_RMA_P(NAME, TYPE)                                                           \
-    void shmemi_prepare_and_post_rma_##NAME##_p(const char *api_name, uint8_t *dst_ptr, TYPE value, int pe, \
-                                                aclrtStream acl_strm, size_t block_size)                    \
-    {                                                                                                       \
-        shmemi_##NAME##_p<<<block_size, 0, acl_strm>>>(dst_ptr, value, pe);                                 \
-    }
-
-SHMEM_TYPE_FUNC(SHMEMI_TYPENAME_PREPARE_RMA_P)
-#undef SHMEMI_TYPENAME_PREPARE_RMA_P
@@ -16,19 +16,21 @@
 #include "shmem_api.h"
 #include "host_device/shmem_types.h"
 
-#define SHMEMI_TYPENAME_PREPARE_RMA_P(NAME, TYPE)                                                           \
-    void shmemi_prepare_and_post_rma_##NAME##_p(const char *api_name, uint8_t *dst_ptr, TYPE value, int pe, \
-                                                aclrtStream acl_strm, size_t block_size);
-
-SHMEM_TYPE_FUNC(SHMEMI_TYPENAME_PREPARE_RMA_P)
-#undef SHMEMI_TYPENAME_PREPARE_RMA_P
-
 // internal kernels calling
 int32_t shmemi_prepare_and_post_rma(const char *api_name, shmemi_op_t desc, bool is_nbi, uint8_t *lptr, uint8_t *rptr,
                                     size_t n_elems, size_t elem_bytes, int pe, uint8_t *sig_addr, int32_t signal,
                                     int sig_op, ptrdiff_t lstride = 1, ptrdiff_t rstride = 1,
                                     aclrtStream acl_strm = nullptr, size_t block_size = 1);
 
+// strided copy of n_rows rows with row_elems elements each, lstride / rstride are row pitches in elements
+int32_t shmemi_prepare_and_post_rma_2d(const char *api_name, shmemi_op_t desc, bool is_nbi, uint8_t *lptr,
+                                       uint8_t *rptr, size_t n_rows, size_t row_elems, size_t elem_bytes, int pe,
+                                       ptrdiff_t lstride, ptrdiff_t rstride, aclrtStream acl_strm = nullptr,
+                                       size_t block_size = 1);
+
+// run n device resident shmemx_rma_desc_t descriptors in a single launch
+int32_t shmemi_rma_batch_on_stream(uint8_t *desc, uint32_t n, aclrtStream acl_strm, size_t block_size);
+
 int32_t shmemi_getmem_on_stream(uint8_t *dst, uint8_t *src, size_t elem_size, int32_t pe, aclrtStream stream);
 
 #endif
\ No newline at end of file
@@ -34,6 +34,161 @@ static bool get_log_to_stdout_from_env_cfg()
            strcmp(env_log_to_stdout, "1") == 0;
 }
 
+static bool get_log_async_from_env_cfg()
+{
+    const char *env_log_async = std::getenv("SHMEM_LOG_ASYNC");
+    return env_log_async != nullptr && strlen(env_log_async) <= MAX_ENV_STRING_LEN &&
+           strcmp(env_log_async, "1") == 0;
+}
+
+bool log_ring::push(std::string &&line)
+{
+    uint64_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= LOG_ASYNC_RING_SIZE) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    slots[h % LOG_ASYNC_RING_SIZE] = std::move(line);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+size_t log_ring::drain(std::string &batch)
+{
+    uint64_t t = tail.load(std::memory_order_relaxed);
+    uint64_t h = head.load(std::memory_order_acquire);
+    for (uint64_t i = t; i < h; i++) {
+        std::string &slot = slots[i % LOG_ASYNC_RING_SIZE];
+        batch += slot;
+        slot.clear();
+    }
+    tail.store(h, std::memory_order_release);
+    return static_cast<size_t>(h - t);
+}
+
+namespace {
+// 线程退出时把自己的缓冲标记为orphaned，由写线程排空后回收
+struct log_ring_holder {
+    std::vector<std::pair<uint64_t, std::shared_ptr<log_ring>>> rings;
+    ~log_ring_holder()
+    {
+        for (auto &entry : rings) {
+            entry.second->orphaned.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local log_ring_holder g_log_ring_holder;
+std::atomic<uint64_t> g_log_async_sink_id{0};
+}
+
+log_async_sink::log_async_sink(batch_writer writer)
+    : shmem_id(g_log_async_sink_id.fetch_add(1) + 1), shmem_writer(std::move(writer))
+{
+    shmem_thread = std::thread([this]() { run(); });
+}
+
+log_async_sink::~log_async_sink()
+{
+    {
+        std::lock_guard<std::mutex> lock(shmem_wake_mutex);
+        shmem_stop = true;
+    }
+    shmem_wake_cv.notify_one();
+    if (shmem_thread.joinable()) {
+        shmem_thread.join();
+    }
+}
+
+log_ring *log_async_sink::local_ring()
+{
+    for (auto &entry : g_log_ring_holder.rings) {
+        if (entry.first == shmem_id) {
+            return entry.second.get();
+        }
+    }
+    auto ring = std::make_shared<log_ring>();
+    {
+        std::lock_guard<std::mutex> lock(shmem_ring_mutex);
+        shmem_rings.push_back(ring);
+    }
+    g_log_ring_holder.rings.emplace_back(shmem_id, ring);
+    return ring.get();
+}
+
+void log_async_sink::write_log(std::string &&log_content)
+{
+    log_ring *ring = local_ring();
+    if (!ring->push(std::move(log_content))) {
+        return;
+    }
+    uint64_t used = ring->head.load(std::memory_order_relaxed) - ring->tail.load(std::memory_order_relaxed);
+    if (used >= LOG_ASYNC_RING_SIZE / 2) {
+        shmem_wake_cv.notify_one();
+    }
+}
+
+void log_async_sink::flush()
+{
+    std::unique_lock<std::mutex> lock(shmem_wake_mutex);
+    uint64_t req = ++shmem_flush_req;
+    shmem_wake_cv.notify_one();
+    shmem_wake_cv.wait(lock, [this, req]() { return shmem_flush_done >= req || shmem_stop; });
+}
+
+uint64_t log_async_sink::dropped_count() const
+{
+    return shmem_dropped_total.load(std::memory_order_relaxed);
+}
+
+void log_async_sink::drain_once()
+{
+    std::vector<std::shared_ptr<log_ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(shmem_ring_mutex);
+        rings = shmem_rings;
+    }
+
+    std::string batch;
+    uint64_t dropped = 0;
+    for (auto &ring : rings) {
+        ring->drain(batch);
+        dropped += ring->dropped.exchange(0, std::memory_order_relaxed);
+    }
+    if (dropped > 0) {
+        shmem_dropped_total.fetch_add(dropped, std::memory_order_relaxed);
+        batch += "shmem_log: " + std::to_string(dropped) + " log messages dropped, async ring full\n";
+    }
+    if (!batch.empty()) {
+        shmem_writer(batch);
+    }
+
+    std::lock_guard<std::mutex> lock(shmem_ring_mutex);
+    shmem_rings.erase(std::remove_if(shmem_rings.begin(), shmem_rings.end(),
+        [](const std::shared_ptr<log_ring> &ring) {
+            return ring->orphaned.load(std::memory_order_acquire) &&
+                   ring->head.load(std::memory_order_acquire) == ring->tail.load(std::memory_order_relaxed);
+        }), shmem_rings.end());
+}
+
+void log_async_sink::run()
+{
+    std::unique_lock<std::mutex> lock(shmem_wake_mutex);
+    while (true) {
+        shmem_wake_cv.wait_for(lock, std::chrono::milliseconds(LOG_ASYNC_FLUSH_INTERVAL_MS));
+        bool stop = shmem_stop;
+        uint64_t req = shmem_flush_req;
+        lock.unlock();
+        drain_once();
+        lock.lock();
+        shmem_flush_done = req;
+        shmem_wake_cv.notify_all();
+        if (stop) {
+            break;
+        }
+    }
+}
+
 log_file_sink::log_file_sink() 
 {
     init_log_dir();
@@ -328,11 +483,18 @@ void shm_out_logger::log(int32_t level, const std::ostringstream &oss)
     std::string log_content = build_log_content(level, oss);
     if (is_log_stdout){
         std::cout << log_content;
+    } else if (shmem_async_sink) {
+        shmem_async_sink->write_log(std::move(log_content));
     } else if (shmem_file_sink) {
         shmem_file_sink->write_log(log_content);
     }
 }
 
+uint64_t shm_out_logger::dropped_count() const
+{
+    return shmem_async_sink != nullptr ? shmem_async_sink->dropped_count() : 0;
+}
+
 void shmem_log_bridge(int level, const char* log_msg)
 {
     if (log_msg == nullptr) {
@@ -352,6 +514,11 @@ shm_out_logger::shm_out_logger()
         std::cout << "New log_file_sink failed, logs cannot be stored in files." << std::endl; 
         }   
     }
+    if (shmem_file_sink != nullptr && get_log_async_from_env_cfg()) {
+        log_file_sink *file_sink = shmem_file_sink;
+        shmem_async_sink = new (std::nothrow) log_async_sink(
+            [file_sink](const std::string &batch) { file_sink->write_log(batch); });
+    }
     
     smem_set_extern_logger(shmem_log_bridge);
 }
@@ -359,6 +526,10 @@ shm_out_logger::shm_out_logger()
 shm_out_logger::~shm_out_logger()
 {
     shmem_log_func = nullptr;
+    if (shmem_async_sink) {
+        delete shmem_async_sink;
+        shmem_async_sink = nullptr;
+    }
     if (shmem_file_sink) {
         delete shmem_file_sink;
         shmem_file_sink = nullptr;
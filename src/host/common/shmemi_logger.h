@@ -10,12 +10,19 @@
 #ifndef SHMEM_SHM_OUT_LOGGER_H
 #define SHMEM_SHM_OUT_LOGGER_H
 
+#include <atomic>
 #include <ctime>
 #include <climits>
+#include <condition_variable>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iomanip>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include <unistd.h>
 #include <sstream>
 #include <sys/time.h>
@@ -34,6 +41,8 @@ constexpr size_t MAX_FILE_NAME_LEN = 255;                               // 文
 constexpr uint64_t MAX_FILE_SIZE_THRESHOLD = 1024 * 1024 * 1024;        // 单个日志文件最大1GB
 constexpr uint64_t DISK_AVAILABLE_LIMIT = 10 * MAX_FILE_SIZE_THRESHOLD; // 磁盘剩余空间门限10GB
 constexpr size_t MAX_ENV_STRING_LEN = 12800;
+constexpr size_t LOG_ASYNC_RING_SIZE = 1024;                            // 异步日志每线程环形缓冲条数
+constexpr uint32_t LOG_ASYNC_FLUSH_INTERVAL_MS = 20;                    // 后台写线程最长刷新间隔
 
 // 内部辅助函数声明（仅在cpp中使用）
 std::string get_home_dir();
@@ -66,6 +75,51 @@ private:
     std::mutex shmem_file_mutex;
 };
 
+// 单生产者单消费者环形缓冲，生产者为一个日志线程，消费者为后台写线程
+struct log_ring {
+    std::atomic<uint64_t> head{0};          // 生产者下一个写入位置
+    std::atomic<uint64_t> tail{0};          // 写线程下一个读取位置
+    std::atomic<uint64_t> dropped{0};       // 缓冲满时丢弃的条数，写线程读取后清零
+    std::atomic<bool> orphaned{false};      // 生产者线程已退出，排空后回收
+    std::string slots[LOG_ASYNC_RING_SIZE];
+
+    // 缓冲满时丢弃并计数，返回false
+    bool push(std::string &&line);
+    // 追加所有已发布的条目到batch，返回条数
+    size_t drain(std::string &batch);
+};
+
+// 异步日志：各线程写入各自的log_ring，不加锁；后台线程批量取出后一次写入
+class log_async_sink {
+public:
+    using batch_writer = std::function<void(const std::string &)>;
+
+    explicit log_async_sink(batch_writer writer);
+    ~log_async_sink();
+    void write_log(std::string &&log_content);
+    // 停止前已提交的日志全部写出后返回
+    void flush();
+    uint64_t dropped_count() const;
+
+private:
+    log_ring *local_ring();
+    void run();
+    void drain_once();
+
+private:
+    uint64_t shmem_id;                      // 区分线程局部缓冲所属的sink
+    batch_writer shmem_writer;
+    std::mutex shmem_ring_mutex;            // 仅保护线程注册与回收
+    std::vector<std::shared_ptr<log_ring>> shmem_rings;
+    std::mutex shmem_wake_mutex;
+    std::condition_variable shmem_wake_cv;
+    bool shmem_stop = false;
+    uint64_t shmem_flush_req = 0;
+    uint64_t shmem_flush_done = 0;
+    std::atomic<uint64_t> shmem_dropped_total{0};
+    std::thread shmem_thread;
+};
+
 using external_log = void (*)(int32_t, const char *);
 
 enum log_level : int32_t {
@@ -83,6 +137,12 @@ public:
     shmem_error_code_t set_log_level(log_level level);
     void set_extern_log_func(external_log func, bool force_update = false);
     void log(int32_t level, const std::ostringstream &oss);
+    // 宏在格式化之前调用，外部日志函数接管时全部级别都转发
+    bool enabled(int32_t level) const
+    {
+        return shmem_log_func != nullptr || level >= shmem_log_level;
+    }
+    uint64_t dropped_count() const;
 
     shm_out_logger(const shm_out_logger &) = delete;
     shm_out_logger(shm_out_logger &&) = delete;
@@ -101,7 +161,8 @@ private:
     const std::string shmem_log_level_desc[BUTT_LEVEL] = {"debug", "info", "warn", "error", "fatal"};
     log_level shmem_log_level = WARN_LEVEL;
     external_log shmem_log_func = nullptr;
-    log_file_sink* shmem_file_sink;
+    log_file_sink* shmem_file_sink = nullptr;
+    log_async_sink* shmem_async_sink = nullptr;
     bool is_log_stdout = false;
 };
 
@@ -112,9 +173,13 @@ private:
 #endif
 #define SHM_OUT_LOG(LEVEL, ARGS)                                                       \
     do {                                                                               \
+        shm::shm_out_logger &shm_logger = shm::shm_out_logger::Instance();             \
+        if (!shm_logger.enabled(LEVEL)) {                                              \
+            break;                                                                     \
+        }                                                                              \
         std::ostringstream oss;                                                        \
         oss << "[SHM_SHMEM " << SHM_LOG_FILENAME_SHORT << ":" << __LINE__ << "] " << ARGS; \
-        shm::shm_out_logger::Instance().log(LEVEL, oss);                               \
+        shm_logger.log(LEVEL, oss);                                                    \
     } while (0)
 
 #define SHM_LOG_DEBUG(ARGS) SHM_OUT_LOG(shm::DEBUG_LEVEL, ARGS)
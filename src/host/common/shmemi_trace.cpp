@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+
+namespace shm {
+
+int32_t shmemi_trace_init()
+{
+#ifdef SHMEM_ENABLE_TRACE
+    void *region = nullptr;
+    SHMEM_CHECK_RET(aclrtMalloc(&region, SHMEM_TRACE_REGION_SIZE, ACL_MEM_MALLOC_HUGE_FIRST), aclrtMalloc);
+    auto ret = aclrtMemset(region, SHMEM_TRACE_REGION_SIZE, 0, SHMEM_TRACE_REGION_SIZE);
+    if (ret != 0) {
+        aclrtFree(region);
+        SHM_LOG_ERROR("memset trace region failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    g_state.trace_region = reinterpret_cast<uint64_t>(region);
+#endif
+    return SHMEM_SUCCESS;
+}
+
+void shmemi_trace_finalize()
+{
+    if (g_state.trace_region != 0) {
+        aclrtFree(reinterpret_cast<void *>(g_state.trace_region));
+        g_state.trace_region = 0;
+    }
+}
+
+const char *trace_op_name(uint16_t op)
+{
+    switch (op) {
+        case SHMEMX_TRACE_PUT:
+            return "put";
+        case SHMEMX_TRACE_GET:
+            return "get";
+        case SHMEMX_TRACE_ROCE_WRITE:
+            return "roce_write";
+        case SHMEMX_TRACE_ROCE_READ:
+            return "roce_read";
+        case SHMEMX_TRACE_ROCE_QUIET:
+            return "roce_quiet";
+        case SHMEMX_TRACE_SIGNAL:
+            return "signal";
+        case SHMEMX_TRACE_WAIT:
+            return "wait_until";
+        case SHMEMX_TRACE_BARRIER:
+            return "barrier";
+        default:
+            return "unknown";
+    }
+}
+
+uint64_t trace_decode(const uint8_t *region, std::vector<shmemx_trace_record_t> &records)
+{
+    static_assert(sizeof(shmemx_trace_record_t) == SHMEM_TRACE_RECORD_SIZE, "trace record layout");
+    records.clear();
+    uint64_t lost = 0;
+    for (uint32_t core = 0; core < SHMEM_TRACE_MAX_CORES; core++) {
+        const uint8_t *ring = region + static_cast<uint64_t>(core) * SHMEM_TRACE_CORE_RING_SIZE;
+        uint64_t head;
+        memcpy(&head, ring, sizeof(head));
+        uint64_t kept = head < SHMEM_TRACE_RING_ENTRIES ? head : SHMEM_TRACE_RING_ENTRIES;
+        for (uint64_t i = head - kept; i < head; i++) {
+            shmemx_trace_record_t rec;
+            memcpy(&rec, ring + SHMEM_TRACE_HEAD_SIZE + (i % SHMEM_TRACE_RING_ENTRIES) * SHMEM_TRACE_RECORD_SIZE,
+                   sizeof(rec));
+            records.push_back(rec);
+        }
+        lost += head - kept;
+    }
+    std::stable_sort(records.begin(), records.end(),
+        [](const shmemx_trace_record_t &a, const shmemx_trace_record_t &b) { return a.start < b.start; });
+    return lost;
+}
+
+std::string trace_to_chrome_json(const std::vector<shmemx_trace_record_t> &records, int32_t mype)
+{
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (size_t i = 0; i < records.size(); i++) {
+        const shmemx_trace_record_t &rec = records[i];
+        double ts = static_cast<double>(rec.start) / SHMEM_SYS_CYCLES_PER_US;
+        double dur = static_cast<double>(rec.end - rec.start) / SHMEM_SYS_CYCLES_PER_US;
+        out << (i == 0 ? "" : ",") << "\n{\"name\":\"" << trace_op_name(rec.op) << "\",\"cat\":\""
+            << (rec.op == SHMEMX_TRACE_BARRIER || rec.op == SHMEMX_TRACE_WAIT || rec.op == SHMEMX_TRACE_SIGNAL ?
+                "sync" : "rma")
+            << "\",\"ph\":\"X\",\"pid\":" << mype << ",\"tid\":" << rec.core << ",\"ts\":" << ts
+            << ",\"dur\":" << dur << ",\"args\":{\"" << (rec.op == SHMEMX_TRACE_BARRIER ? "team" : "pe")
+            << "\":" << rec.pe << ",\"bytes\":" << rec.bytes << "}}";
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+static int32_t trace_read(std::vector<shmemx_trace_record_t> &records, uint64_t &lost)
+{
+    if (!g_state.is_shmem_initialized) {
+        SHM_LOG_ERROR("shmem not initialized");
+        return SHMEM_NOT_INITED;
+    }
+    if (g_state.trace_region == 0) {
+        SHM_LOG_ERROR("device trace unavailable, build with SHMEM_ENABLE_TRACE");
+        return SHMEM_INVALID_VALUE;
+    }
+    std::vector<uint8_t> image(SHMEM_TRACE_REGION_SIZE);
+    void *region = reinterpret_cast<void *>(g_state.trace_region);
+    SHMEM_CHECK_RET(aclrtMemcpy(image.data(), image.size(), region, SHMEM_TRACE_REGION_SIZE,
+        ACL_MEMCPY_DEVICE_TO_HOST), aclrtMemcpy);
+    // records only live in the image from here on, restart every ring
+    SHMEM_CHECK_RET(aclrtMemset(region, SHMEM_TRACE_REGION_SIZE, 0, SHMEM_TRACE_REGION_SIZE), aclrtMemset);
+    lost = trace_decode(image.data(), records);
+    if (lost != 0) {
+        SHM_LOG_WARN("device trace: " << lost << " older records overwritten");
+    }
+    return SHMEM_SUCCESS;
+}
+
+} // namespace shm
+
+int32_t shmemx_trace_drain(shmemx_trace_record_t *records, uint32_t max_records, uint32_t *count)
+{
+    SHM_ASSERT_RETURN(count != nullptr, SHMEM_INVALID_PARAM);
+    SHM_ASSERT_RETURN(records != nullptr || max_records == 0, SHMEM_INVALID_PARAM);
+    std::vector<shmemx_trace_record_t> all;
+    uint64_t lost = 0;
+    SHMEM_CHECK_RET(shm::trace_read(all, lost));
+    // keep the newest records when the caller buffer is smaller than the rings
+    size_t n = all.size() < max_records ? all.size() : max_records;
+    std::copy(all.end() - n, all.end(), records);
+    *count = static_cast<uint32_t>(n);
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemx_trace_export(const char *path)
+{
+    SHM_ASSERT_RETURN(path != nullptr && path[0] != '\0', SHMEM_INVALID_PARAM);
+    std::vector<shmemx_trace_record_t> records;
+    uint64_t lost = 0;
+    SHMEM_CHECK_RET(shm::trace_read(records, lost));
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        SHM_LOG_ERROR("open trace file failed: " << path);
+        return SHMEM_INVALID_PARAM;
+    }
+    file << shm::trace_to_chrome_json(records, shm::g_state.mype);
+    if (!file.good()) {
+        SHM_LOG_ERROR("write trace file failed: " << path);
+        return SHMEM_INNER_ERROR;
+    }
+    return static_cast<int32_t>(records.size());
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_TRACE_H
+#define SHMEMI_TRACE_H
+
+#include <string>
+#include <vector>
+
+#include "host_device/shmem_types.h"
+
+namespace shm {
+
+// Allocates the device trace rings when the library is built with SHMEM_ENABLE_TRACE, a no-op otherwise.
+int32_t shmemi_trace_init();
+void shmemi_trace_finalize();
+
+// Decode a raw image of SHMEM_TRACE_REGION_SIZE bytes into the surviving records of all cores, ordered by start.
+// Returns the number of records lost to wrap-around.
+uint64_t trace_decode(const uint8_t *region, std::vector<shmemx_trace_record_t> &records);
+
+// Render records as a Chrome trace event file, one process per PE and one thread per core.
+std::string trace_to_chrome_json(const std::vector<shmemx_trace_record_t> &records, int32_t mype);
+
+const char *trace_op_name(uint16_t op);
+
+}
+
+#endif  // SHMEMI_TRACE_H
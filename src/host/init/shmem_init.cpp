@@ -55,6 +55,8 @@ constexpr int DEFAULT_IFNAME_LNEGTH = 4;
             NULL,                                  /* sdma_heap_device_base */       \
             NULL,                                  /* roce_heap_device_base */       \
             {},                                     /* topo_list */                     \
+            {},                                     /* route_list */                    \
+            {},                                     /* device_barrier_cap */            \
             SIZE_MAX,                                /* heap_size */                   \
             {NULL},                                  /* team_pools */                  \
             0,                                       /* sync_pool */                  \
@@ -62,6 +64,11 @@ constexpr int DEFAULT_IFNAME_LNEGTH = 4;
             0,                                      /* core_sync_pool */             \
             0,                                      /* core_sync_counter */          \
             0,                                        /* partial_barrier_pool */      \
+            0,                                        /* roce_signal_pool */          \
+            0,                                        /* wait_timeout_cycles */       \
+            0,                                        /* wait_diag_ring */            \
+            0,                                        /* watchdog_region */           \
+            0,                                        /* trace_region */              \
             false,                                   /* shmem_is_shmem_initialized */ \
             false,                                   /* shmem_is_shmem_created */     \
             {0, 16 * 1024, 0},                       /* shmem_mte_config */           \
@@ -133,6 +140,72 @@ int32_t bind_tcp_port_v6(int &sockfd, int port, shmem_uniqueid_inner_t *innerUId
 int32_t shmemi_options_init()
 {
     int32_t status = SHMEM_SUCCESS;
+    uint64_t timeout_us = SHMEM_DEFAULT_WAIT_TIMEOUT_US;
+    const char *env_timeout = std::getenv("SHMEM_WAIT_TIMEOUT_US");
+    if (env_timeout != nullptr) {
+        char *end = nullptr;
+        timeout_us = std::strtoull(env_timeout, &end, 10);
+        if (end == env_timeout || *end != '\0' || timeout_us > SHMEM_MAX_WAIT_TIMEOUT_US) {
+            SHM_LOG_ERROR("invalid SHMEM_WAIT_TIMEOUT_US: " << env_timeout);
+            return SHMEM_INVALID_VALUE;
+        }
+    }
+    g_state.wait_timeout_cycles = static_cast<int64_t>(timeout_us * SHMEM_SYS_CYCLES_PER_US);
+
+    const char *env_algo = std::getenv("SHMEM_BARRIER_ALGO");
+    g_state_host.barrier_algo = SHMEMX_BARRIER_AUTO;
+    if (env_algo != nullptr) {
+        g_state_host.barrier_algo = barrier_algo_from_name(env_algo);
+        if (g_state_host.barrier_algo < 0) {
+            SHM_LOG_ERROR("invalid SHMEM_BARRIER_ALGO: " << env_algo);
+            return SHMEM_INVALID_VALUE;
+        }
+    }
+    const char *env_radix = std::getenv("SHMEM_BARRIER_RADIX");
+    g_state_host.barrier_k = 0;
+    if (env_radix != nullptr) {
+        char *end = nullptr;
+        long radix = std::strtol(env_radix, &end, 10);
+        if (end == env_radix || *end != '\0' || radix < 2 || radix > SHMEM_BARRIER_TG_DISSEM_KVAL) {
+            SHM_LOG_ERROR("invalid SHMEM_BARRIER_RADIX: " << env_radix << ", expected 2 to "
+                          << SHMEM_BARRIER_TG_DISSEM_KVAL);
+            return SHMEM_INVALID_VALUE;
+        }
+        g_state_host.barrier_k = static_cast<int32_t>(radix);
+    }
+    const char *env_watchdog = std::getenv("SHMEM_WATCHDOG_MS");
+    g_state_host.watchdog_ms = 0;
+    if (env_watchdog != nullptr) {
+        char *end = nullptr;
+        unsigned long watchdog_ms = std::strtoul(env_watchdog, &end, 10);
+        if (end == env_watchdog || *end != '\0' || watchdog_ms > UINT32_MAX) {
+            SHM_LOG_ERROR("invalid SHMEM_WATCHDOG_MS: " << env_watchdog);
+            return SHMEM_INVALID_VALUE;
+        }
+        g_state_host.watchdog_ms = static_cast<uint32_t>(watchdog_ms);
+    }
+    const char *env_qp_num = std::getenv("SHMEM_ROCE_QP_NUM");
+    g_state_host.roce_qp_num = 1;
+    if (env_qp_num != nullptr) {
+        char *end = nullptr;
+        unsigned long qp_num = std::strtoul(env_qp_num, &end, 10);
+        if (end == env_qp_num || *end != '\0' || qp_num == 0 || qp_num > SMEM_SHM_RDMA_QP_NUM_MAX) {
+            SHM_LOG_ERROR("invalid SHMEM_ROCE_QP_NUM: " << env_qp_num << ", expected 1 to "
+                          << SMEM_SHM_RDMA_QP_NUM_MAX);
+            return SHMEM_INVALID_VALUE;
+        }
+        g_state_host.roce_qp_num = static_cast<uint32_t>(qp_num);
+    }
+    const char *env_sdma_min = std::getenv("SHMEM_SDMA_MIN_BYTES");
+    g_state_host.sdma_min_bytes = SHMEM_SDMA_DEFAULT_MIN_BYTES;
+    if (env_sdma_min != nullptr) {
+        char *end = nullptr;
+        g_state_host.sdma_min_bytes = std::strtoull(env_sdma_min, &end, 10);
+        if (end == env_sdma_min || *end != '\0') {
+            SHM_LOG_ERROR("invalid SHMEM_SDMA_MIN_BYTES: " << env_sdma_min);
+            return SHMEM_INVALID_VALUE;
+        }
+    }
     return status;
 }
 
@@ -165,6 +238,7 @@ void shmemi_reach_info_init(void *&gva)
             g_state.topo_list[i] |= SHMEM_TRANSPORT_MTE;
         }
         if (reach_info & SMEMS_DATA_OP_SDMA) {
+            g_state.topo_list[i] |= SHMEM_TRANSPORT_SDMA;
             g_state.sdma_heap_host_base[i] = (void *)((uintptr_t)gva + g_state.heap_size * static_cast<uint32_t>(i));
         } else {
             g_state.sdma_heap_host_base[i] = NULL;
@@ -175,6 +249,47 @@ void shmemi_reach_info_init(void *&gva)
     }
 }
 
+// Pick the device RMA transport of every peer: MTE inside the host, RoCE across hosts.
+void shmemi_route_init()
+{
+    int32_t mte_peers = 0;
+    int32_t roce_peers = 0;
+    for (int32_t i = 0; i < g_state.npes; i++) {
+        if (g_state.topo_list[i] & SHMEM_TRANSPORT_MTE) {
+            g_state.route_list[i] = SHMEM_TRANSPORT_MTE;
+            mte_peers++;
+        } else if (g_state.topo_list[i] & SHMEM_TRANSPORT_ROCE) {
+            g_state.route_list[i] = SHMEM_TRANSPORT_ROCE;
+            roce_peers++;
+        } else {
+            g_state.route_list[i] = 0;
+            SHM_LOG_WARN("pe " << g_state.mype << " has no transport to pe " << i);
+        }
+    }
+    SHM_LOG_INFO("pe " << g_state.mype << " routes " << mte_peers << " pes over MTE and " << roce_peers
+                 << " pes over RoCE");
+}
+
+// PEs sharing one MTE domain form a host, identified by the lowest PE of that domain.
+static int32_t g_pe_host_id[SHMEM_MAX_RANKS];
+
+int32_t shmemi_host_id_init()
+{
+    int32_t my_host_id = g_state.mype;
+    for (int32_t i = 0; i < g_state.mype; i++) {
+        if (g_state.topo_list[i] & SHMEM_TRANSPORT_MTE) {
+            my_host_id = i;
+            break;
+        }
+    }
+    return shmemi_control_allgather(&my_host_id, sizeof(int32_t), g_pe_host_id, g_state.npes * sizeof(int32_t));
+}
+
+const int32_t *shmemi_host_ids()
+{
+    return g_pe_host_id;
+}
+
 int32_t shmemi_heap_init(shmem_init_attr_t *attributes)
 {
     void *gva = nullptr;
@@ -195,6 +310,7 @@ int32_t shmemi_heap_init(shmem_init_attr_t *attributes)
     }
     // set config.sockFd value
     config.sockFd = attributes->option_attr.sockFd;
+    config.rdmaQpNum = g_state_host.roce_qp_num;
     status = smem_shm_init(attributes->ip_port, attributes->n_ranks, attributes->my_rank, device_id, &config);
     if (status != SHMEM_SUCCESS) {
         SHM_LOG_ERROR("smem_shm_init Failed");
@@ -231,6 +347,7 @@ int32_t shmemi_heap_init(shmem_init_attr_t *attributes)
     g_state.heap_size = alignedSize;
 
     shmemi_reach_info_init(gva);
+    shmemi_route_init();
     if (shm::g_ipport[0] != '\0') {
         g_ipport[0] = '\0';
         bzero(attributes->ip_port, sizeof(attributes->ip_port));
@@ -244,6 +361,9 @@ int32_t shmemi_heap_init(shmem_init_attr_t *attributes)
 
 int32_t shmemi_control_barrier_all()
 {
+    if (loopback_active()) {
+        return loopback().barrier();
+    }
     SHM_ASSERT_RETURN(g_smem_handle != nullptr, SHMEM_INVALID_PARAM);
     auto ret = smem_shm_control_barrier(g_smem_handle);
     if (ret != SHMEM_SUCCESS) {
@@ -253,6 +373,22 @@ int32_t shmemi_control_barrier_all()
     return SHMEM_SUCCESS;
 }
 
+int32_t shmemi_control_allgather(const void *send_buf, uint32_t send_size, void *recv_buf, uint32_t recv_size)
+{
+    if (loopback_active()) {
+        SHM_ASSERT_RETURN(static_cast<uint64_t>(send_size) * g_state.npes <= recv_size, SHMEM_INVALID_PARAM);
+        return loopback().allgather(send_buf, send_size, recv_buf);
+    }
+    SHM_ASSERT_RETURN(g_smem_handle != nullptr, SHMEM_INVALID_PARAM);
+    auto ret = smem_shm_control_allgather(g_smem_handle, (const char *)send_buf, send_size, (char *)recv_buf,
+                                          recv_size);
+    if (ret != SHMEM_SUCCESS) {
+        SHM_LOG_ERROR("Allgather failed, ret: " << ret);
+        return SHMEM_SMEM_ERROR;
+    }
+    return SHMEM_SUCCESS;
+}
+
 int32_t update_device_state()
 {
     if (!g_state.is_shmem_created) {
@@ -273,6 +409,23 @@ int32_t update_device_state()
     return SHMEM_SUCCESS;
 }
 
+// Host emulation backend: the heaps come from the loopback domain, no device or smem state is created and the team
+// pool holds SHMEM_TEAM_WORLD only
+int32_t shmemi_loopback_init_attr(shmem_init_attr_t *attributes)
+{
+    g_state.mype = attributes->my_rank;
+    g_state.npes = attributes->n_ranks;
+    g_state.heap_size = attributes->local_mem_size + SHMEM_EXTRA_SIZE;
+    SHMEM_CHECK_RET(loopback_init(attributes), loopback_init);
+    SHMEM_CHECK_RET(memory_manager_initialize(g_state.heap_base, attributes->local_mem_size + SHMEM_EXTRA_SIZE),
+                    memory_manager_initialize);
+    SHMEM_CHECK_RET(shmemi_host_id_init(), shmemi_host_id_init);
+    SHMEM_CHECK_RET(shmemi_team_init_host(g_state.mype, g_state.npes), shmemi_team_init_host);
+    g_state.is_shmem_initialized = true;
+    SHMEM_CHECK_RET(shmemi_control_barrier_all(), shmemi_control_barrier_all);
+    return SHMEM_SUCCESS;
+}
+
 int32_t check_attr(shmem_init_attr_t *attributes)
 {
     if ((attributes->my_rank < 0) || (attributes->n_ranks <= 0)) {
@@ -747,6 +900,19 @@ void shmem_rank_exit(int status)
     exit(status);
 }
 
+// Init steps that run once the progress watchdog thread is started
+static int32_t shmemi_init_after_watchdog()
+{
+    SHMEM_CHECK_RET(shm::shmemi_trace_init(), shmemi_trace_init);
+    SHMEM_CHECK_RET(shm::update_device_state(), update_device_state);
+    SHMEM_CHECK_RET(shm::shmemi_team_barrier_calibrate(), shmemi_team_barrier_calibrate);
+    SHMEM_CHECK_RET(shm::shmemi_sync_init(), shmemi_sync_init);
+    SHMEM_CHECK_RET(smem_shm_register_exit(shm::g_smem_handle, &shmem_rank_exit), smem_shm_register_exit);
+    shm::g_state.is_shmem_initialized = true;
+    SHMEM_CHECK_RET(shm::shmemi_control_barrier_all(), shmemi_control_barrier_all);
+    return SHMEM_SUCCESS;
+}
+
 int32_t shmem_init_attr(shmem_init_attr_t *attributes)
 {
     int32_t ret;
@@ -756,6 +922,9 @@ int32_t shmem_init_attr(shmem_init_attr_t *attributes)
     SHMEM_CHECK_RET(shm::check_attr(attributes), check_attr);
     SHMEM_CHECK_RET(shm::version_compatible(), version_compatible);
     SHMEM_CHECK_RET(shm::shmemi_options_init(), shmemi_options_init);
+    if (attributes->option_attr.data_op_engine_type == SHMEM_DATA_OP_HOST) {
+        return shm::shmemi_loopback_init_attr(attributes);
+    }
 
     SHMEM_CHECK_RET(shm::shmemi_state_init_attr(attributes), shmemi_state_init_attr);
     SHMEM_CHECK_RET(shm::shmemi_heap_init(attributes), shmemi_heap_init);
@@ -764,12 +933,18 @@ int32_t shmem_init_attr(shmem_init_attr_t *attributes)
     // heap_size is aligned, use actual local_mem_size to init mm
     SHMEM_CHECK_RET(shm::memory_manager_initialize(shm::g_state.heap_base, attributes->local_mem_size + SHMEM_EXTRA_SIZE),
                     memory_manager_initialize);
+    SHMEM_CHECK_RET(shm::shmemi_host_id_init(), shmemi_host_id_init);
     SHMEM_CHECK_RET(shm::shmemi_team_init(shm::g_state.mype, shm::g_state.npes), shmemi_team_init);
-    SHMEM_CHECK_RET(shm::update_device_state(), update_device_state);
-    SHMEM_CHECK_RET(shm::shmemi_sync_init(), shmemi_sync_init);
-    SHMEM_CHECK_RET(smem_shm_register_exit(shm::g_smem_handle, &shmem_rank_exit), smem_shm_register_exit);
-    shm::g_state.is_shmem_initialized = true;
-    SHMEM_CHECK_RET(shm::shmemi_control_barrier_all(), shmemi_control_barrier_all);
+    SHMEM_CHECK_RET(shm::shmemi_wait_diag_init(), shmemi_wait_diag_init);
+    SHMEM_CHECK_RET(shm::shmemi_roce_signal_init(), shmemi_roce_signal_init);
+    SHMEM_CHECK_RET(shm::shmemi_watchdog_init(), shmemi_watchdog_init);
+    ret = shmemi_init_after_watchdog();
+    if (ret != SHMEM_SUCCESS) {
+        // the watchdog thread must not outlive a failed init
+        shm::shmemi_watchdog_finalize();
+        shm::g_state.is_shmem_initialized = false;
+        return ret;
+    }
     return SHMEM_SUCCESS;
 }
 
@@ -818,7 +993,20 @@ int32_t shmem_set_conf_store_tls(bool enable, const char *tls_info, const uint32
 
 int32_t shmem_finalize(void)
 {
+    if (shm::loopback_active()) {
+        shm::shmemi_team_finalize();
+        shm::loopback_finalize();
+        return SHMEM_SUCCESS;
+    }
+    shm::p_aggregate_finalize();
+    shm::sdma_finalize();
     SHMEM_CHECK_RET(shm::shmemi_team_finalize());
+    shm::rma_batch_finalize();
+    shm::atomic_finalize();
+    shm::shmemi_watchdog_finalize();
+    shm::shmemi_trace_finalize();
+    shm::shmemi_wait_diag_finalize();
+    shm::shmemi_roce_signal_finalize();
 
     if (shm::g_state.p2p_heap_host_base != nullptr) {
         aclrtFree(shm::g_state.p2p_heap_host_base);
@@ -21,6 +21,13 @@ int32_t update_device_state(void);
 
 int32_t shmemi_control_barrier_all();
 
+int32_t shmemi_control_allgather(const void *send_buf, uint32_t send_size, void *recv_buf, uint32_t recv_size);
+
+// Fill route_list from topo_list, MTE is preferred over RoCE
+void shmemi_route_init();
+
+const int32_t *shmemi_host_ids();
+
 }  // namespace shm
 
 #endif  // SHMEMI_INIT_H
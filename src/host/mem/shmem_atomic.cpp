@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+#include "shmemi_device_atomic.h"
+
+namespace shm {
+namespace {
+// Previous values are returned through one device word and one pinned host word, allocated on first use.
+struct amo_fetch_slot {
+    std::mutex mutex;
+    void *host_buf = nullptr;
+    void *device_buf = nullptr;
+};
+
+amo_fetch_slot g_amo_slot;
+
+int32_t amo_check(const void *dst, size_t elem_bytes, int pe)
+{
+    SHM_ASSERT_RETURN(g_state.is_shmem_initialized, SHMEM_NOT_INITED);
+    if (pe < 0 || pe >= g_state.npes) {
+        SHM_LOG_ERROR("atomic pe: " << pe << " out of range, npes: " << g_state.npes);
+        return SHMEM_INVALID_VALUE;
+    }
+    // the kernel updates the word with a load/store atomic, RoCE has no remote atomics
+    if (!loopback_active() && g_state.route_list[pe] != SHMEM_TRANSPORT_MTE) {
+        SHM_LOG_ERROR("atomic pe: " << pe << " is not reachable over MTE, route: " << +g_state.route_list[pe]);
+        return SHMEM_INVALID_VALUE;
+    }
+    uint64_t addr = reinterpret_cast<uint64_t>(dst);
+    uint64_t base = reinterpret_cast<uint64_t>(g_state.heap_base);
+    if (addr < base || addr - base > g_state.heap_size - elem_bytes || addr % elem_bytes != 0) {
+        SHM_LOG_ERROR("atomic dst: " << dst << " is not an aligned symmetric address");
+        return SHMEM_INVALID_PARAM;
+    }
+    // keep program order with host shmem_p still sitting in the aggregation ring and with SDMA nbi copies
+    SHMEM_CHECK_RET(p_aggregate_flush(), p_aggregate_flush);
+    SHMEM_CHECK_RET(sdma_flush(g_state_host.default_stream), sdma_flush);
+    return SHMEM_SUCCESS;
+}
+
+// Loopback backend: the word on pe is updated in place by a CPU atomic
+template <typename T>
+int32_t loopback_amo(uint32_t op, T *dst, T cond, T value, int32_t pe, T *old)
+{
+    switch (op) {
+        case SHMEMI_AMO_FETCH_ADD:
+            return loopback().fetch_add(dst, value, pe, old);
+        case SHMEMI_AMO_COMPARE_SWAP:
+            return loopback().compare_swap(dst, cond, value, pe, old);
+        case SHMEMI_AMO_SWAP:
+            return loopback().swap(dst, value, pe, old);
+        case SHMEMI_AMO_FETCH:
+            return loopback().fetch(dst, pe, old);
+        default:
+            return SHMEM_INVALID_VALUE;
+    }
+}
+
+int32_t amo_slot_reserve()
+{
+    if (g_amo_slot.device_buf != nullptr) {
+        return SHMEM_SUCCESS;
+    }
+    SHMEM_CHECK_RET(aclrtMallocHost(&g_amo_slot.host_buf, sizeof(uint64_t)), aclrtMallocHost);
+    SHMEM_CHECK_RET(aclrtMalloc(&g_amo_slot.device_buf, sizeof(uint64_t), ACL_MEM_MALLOC_HUGE_FIRST), aclrtMalloc);
+    return SHMEM_SUCCESS;
+}
+
+int32_t amo_fetch_result(void *old, size_t elem_bytes, aclrtStream stream)
+{
+    SHMEM_CHECK_RET(aclrtMemcpyAsync(g_amo_slot.host_buf, sizeof(uint64_t), g_amo_slot.device_buf, sizeof(uint64_t),
+                                     ACL_MEMCPY_DEVICE_TO_HOST, stream), aclrtMemcpyAsync);
+    SHMEM_CHECK_RET(aclrtSynchronizeStream(stream), aclrtSynchronizeStream);
+    std::memcpy(old, g_amo_slot.host_buf, elem_bytes);
+    return SHMEM_SUCCESS;
+}
+
+// Coalesced atomic add vectors hold at most one entry per PE: [values, 8 bytes each][pes, int32 each].
+// Two halves are used in turn, a call only waits for the launch that last read the half it refills.
+constexpr uint32_t AMO_VEC_HALVES = 2;
+
+struct amo_vec_half {
+    uint8_t *host_buf = nullptr;
+    void *device_buf = nullptr;
+    aclrtEvent done = nullptr;  // recorded behind the launch that reads this half
+    bool in_flight = false;
+};
+
+struct amo_vec_staging {
+    std::mutex mutex;
+    amo_vec_half halves[AMO_VEC_HALVES];
+    uint32_t current = 0;
+    int32_t capacity = 0;
+};
+
+amo_vec_staging g_amo_vec;
+
+int32_t amo_vec_reserve(int32_t npes)
+{
+    if (g_amo_vec.capacity >= npes) {
+        return SHMEM_SUCCESS;
+    }
+    size_t bytes = static_cast<size_t>(npes) * (sizeof(uint64_t) + sizeof(int32_t));
+    for (auto &half : g_amo_vec.halves) {
+        SHMEM_CHECK_RET(aclrtMallocHost((void **)&half.host_buf, bytes), aclrtMallocHost);
+        SHMEM_CHECK_RET(aclrtMalloc(&half.device_buf, bytes, ACL_MEM_MALLOC_HUGE_FIRST), aclrtMalloc);
+        SHMEM_CHECK_RET(aclrtCreateEvent(&half.done), aclrtCreateEvent);
+    }
+    g_amo_vec.capacity = npes;
+    return SHMEM_SUCCESS;
+}
+
+using amo_vec_launch = int32_t (*)(uint8_t *, uint8_t *, uint8_t *, uint32_t, aclrtStream);
+}  // namespace
+
+template <typename T>
+int32_t atomic_add_vec(T *dst, const T *values, const int *pes, size_t n, amo_vec_launch launch)
+{
+    if (n == 0) {
+        return SHMEM_SUCCESS;
+    }
+    SHM_ASSERT_RETURN(values != nullptr && pes != nullptr, SHMEM_INVALID_PARAM);
+    SHMEM_CHECK_RET(amo_check(dst, sizeof(T), g_state.mype));
+    for (size_t i = 0; i < n; i++) {
+        SHM_ASSERT_RETURN(pes[i] >= 0 && pes[i] < g_state.npes, SHMEM_INVALID_VALUE);
+        SHM_ASSERT_RETURN(loopback_active() || g_state.route_list[pes[i]] == SHMEM_TRANSPORT_MTE, SHMEM_INVALID_VALUE);
+    }
+
+    // sum per PE, keeping the PE order of first appearance
+    std::vector<T> sums(g_state.npes);
+    std::vector<int32_t> order;
+    std::vector<bool> seen(g_state.npes, false);
+    for (size_t i = 0; i < n; i++) {
+        int32_t pe = pes[i];
+        if (!seen[pe]) {
+            seen[pe] = true;
+            sums[pe] = values[i];
+            order.push_back(pe);
+        } else {
+            sums[pe] += values[i];
+        }
+    }
+    if (loopback_active()) {
+        for (int32_t pe : order) {
+            SHMEM_CHECK_RET(loopback().add(dst, sums[pe], pe));
+        }
+        return SHMEM_SUCCESS;
+    }
+
+    std::lock_guard<std::mutex> lock(g_amo_vec.mutex);
+    SHMEM_CHECK_RET(amo_vec_reserve(g_state.npes), amo_vec_reserve);
+    amo_vec_half &half = g_amo_vec.halves[g_amo_vec.current];
+    // this half may still be read by the launch before the previous one
+    if (half.in_flight) {
+        SHMEM_CHECK_RET(aclrtSynchronizeEvent(half.done), aclrtSynchronizeEvent);
+        half.in_flight = false;
+    }
+
+    uint32_t count = static_cast<uint32_t>(order.size());
+    T *host_values = reinterpret_cast<T *>(half.host_buf);
+    int32_t *host_pes = reinterpret_cast<int32_t *>(half.host_buf + g_amo_vec.capacity * sizeof(uint64_t));
+    for (uint32_t i = 0; i < count; i++) {
+        host_values[i] = sums[order[i]];
+        host_pes[i] = order[i];
+    }
+    aclrtStream stream = g_state_host.default_stream;
+    uint8_t *device_values = reinterpret_cast<uint8_t *>(half.device_buf);
+    uint8_t *device_pes = device_values + g_amo_vec.capacity * sizeof(uint64_t);
+    SHMEM_CHECK_RET(aclrtMemcpyAsync(device_values, count * sizeof(T), host_values, count * sizeof(T),
+                                     ACL_MEMCPY_HOST_TO_DEVICE, stream), aclrtMemcpyAsync);
+    SHMEM_CHECK_RET(aclrtMemcpyAsync(device_pes, count * sizeof(int32_t), host_pes, count * sizeof(int32_t),
+                                     ACL_MEMCPY_HOST_TO_DEVICE, stream), aclrtMemcpyAsync);
+    SHMEM_CHECK_RET(launch((uint8_t *)dst, device_values, device_pes, count, stream));
+    SHMEM_CHECK_RET(aclrtRecordEvent(half.done, stream), aclrtRecordEvent);
+    half.in_flight = true;
+    g_amo_vec.current = (g_amo_vec.current + 1) % AMO_VEC_HALVES;
+    return SHMEM_SUCCESS;
+}
+
+void atomic_finalize()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_amo_slot.mutex);
+        if (g_amo_slot.host_buf != nullptr) {
+            aclrtFreeHost(g_amo_slot.host_buf);
+            g_amo_slot.host_buf = nullptr;
+        }
+        if (g_amo_slot.device_buf != nullptr) {
+            aclrtFree(g_amo_slot.device_buf);
+            g_amo_slot.device_buf = nullptr;
+        }
+    }
+    std::lock_guard<std::mutex> lock(g_amo_vec.mutex);
+    for (auto &half : g_amo_vec.halves) {
+        if (half.in_flight) {
+            aclrtSynchronizeEvent(half.done);
+            half.in_flight = false;
+        }
+        if (half.done != nullptr) {
+            aclrtDestroyEvent(half.done);
+            half.done = nullptr;
+        }
+        if (half.host_buf != nullptr) {
+            aclrtFreeHost(half.host_buf);
+            half.host_buf = nullptr;
+        }
+        if (half.device_buf != nullptr) {
+            aclrtFree(half.device_buf);
+            half.device_buf = nullptr;
+        }
+    }
+    g_amo_vec.current = 0;
+    g_amo_vec.capacity = 0;
+}
+}  // namespace shm
+
+#define SHMEM_AMO_TYPENAME_RUN(NAME, TYPE)                                                                             \
+    static int32_t shmemi_##NAME##_amo_run(uint32_t op, TYPE *dst, TYPE cond, TYPE value, int pe, TYPE *old)           \
+    {                                                                                                                  \
+        SHMEM_CHECK_RET(shm::amo_check(dst, sizeof(TYPE), pe));                                                        \
+        if (shm::loopback_active()) {                                                                                  \
+            return shm::loopback_amo(op, dst, cond, value, pe, old);                                                   \
+        }                                                                                                              \
+        std::lock_guard<std::mutex> lock(shm::g_amo_slot.mutex);                                                       \
+        SHMEM_CHECK_RET(shm::amo_slot_reserve());                                                                      \
+        aclrtStream stream = shm::g_state_host.default_stream;                                                         \
+        SHMEM_CHECK_RET(shmemi_##NAME##_amo_on_stream(op, (uint8_t *)dst, cond, value, pe,                             \
+                                                      (uint8_t *)shm::g_amo_slot.device_buf, stream));                 \
+        return shm::amo_fetch_result(old, sizeof(TYPE), stream);                                                       \
+    }
+
+SHMEM_TYPE_FUNC_ATOMIC_FETCH(SHMEM_AMO_TYPENAME_RUN)
+#undef SHMEM_AMO_TYPENAME_RUN
+
+#define SHMEM_ATOMIC_FETCH_TYPENAME_HOST(NAME, TYPE)                                                                   \
+    TYPE shmem_##NAME##_atomic_fetch_add(TYPE *dst, TYPE value, int pe)                                                \
+    {                                                                                                                  \
+        TYPE old {};                                                                                                   \
+        int32_t ret = shmemi_##NAME##_amo_run(SHMEMI_AMO_FETCH_ADD, dst, 0, value, pe, &old);                          \
+        if (ret != 0) {                                                                                                \
+            SHM_LOG_ERROR("shmem_" #NAME "_atomic_fetch_add failed, ret: " << ret);                                    \
+        }                                                                                                              \
+        return old;                                                                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    TYPE shmem_##NAME##_atomic_compare_swap(TYPE *dst, TYPE cond, TYPE value, int pe)                                  \
+    {                                                                                                                  \
+        TYPE old {};                                                                                                   \
+        int32_t ret = shmemi_##NAME##_amo_run(SHMEMI_AMO_COMPARE_SWAP, dst, cond, value, pe, &old);                    \
+        if (ret != 0) {                                                                                                \
+            SHM_LOG_ERROR("shmem_" #NAME "_atomic_compare_swap failed, ret: " << ret);                                 \
+        }                                                                                                              \
+        return old;                                                                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    TYPE shmem_##NAME##_atomic_swap(TYPE *dst, TYPE value, int pe)                                                     \
+    {                                                                                                                  \
+        TYPE old {};                                                                                                   \
+        int32_t ret = shmemi_##NAME##_amo_run(SHMEMI_AMO_SWAP, dst, 0, value, pe, &old);                               \
+        if (ret != 0) {                                                                                                \
+            SHM_LOG_ERROR("shmem_" #NAME "_atomic_swap failed, ret: " << ret);                                         \
+        }                                                                                                              \
+        return old;                                                                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    TYPE shmem_##NAME##_atomic_fetch(TYPE *src, int pe)                                                                \
+    {                                                                                                                  \
+        TYPE old {};                                                                                                   \
+        int32_t ret = shmemi_##NAME##_amo_run(SHMEMI_AMO_FETCH, src, 0, 0, pe, &old);                                  \
+        if (ret != 0) {                                                                                                \
+            SHM_LOG_ERROR("shmem_" #NAME "_atomic_fetch failed, ret: " << ret);                                        \
+        }                                                                                                              \
+        return old;                                                                                                    \
+    }
+
+SHMEM_TYPE_FUNC_ATOMIC_FETCH(SHMEM_ATOMIC_FETCH_TYPENAME_HOST)
+#undef SHMEM_ATOMIC_FETCH_TYPENAME_HOST
+
+#define SHMEMX_ATOMIC_ADD_VEC_TYPENAME_HOST(NAME, TYPE)                                                                \
+    int shmemx_##NAME##_atomic_add_vec(TYPE *dst, const TYPE *values, const int *pes, size_t n)                        \
+    {                                                                                                                  \
+        int32_t ret = shm::atomic_add_vec(dst, values, pes, n, shmemi_##NAME##_atomic_add_vec_on_stream);              \
+        if (ret != 0) {                                                                                                \
+            SHM_LOG_ERROR("shmemx_" #NAME "_atomic_add_vec failed, ret: " << ret);                                     \
+        }                                                                                                              \
+        return ret;                                                                                                    \
+    }
+
+SHMEM_TYPE_FUNC_ATOMIC_ADD_HOST(SHMEMX_ATOMIC_ADD_VEC_TYPENAME_HOST)
+#undef SHMEMX_ATOMIC_ADD_VEC_TYPENAME_HOST
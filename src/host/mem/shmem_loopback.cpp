@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <cctype>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "shmemi_host_common.h"
+
+/*
+    Host emulation backend, selected with data_op_engine_type SHMEM_DATA_OP_HOST.
+
+    The PEs are processes of one host without NPUs. Instead of smem creating the GVA, every PE maps the loopback
+    domain of shmemi_loopback.h and the heap of each PE takes the place of its p2p heap, so shmem_ptr and the
+    memory manager work unchanged. Host RMA, shmem_p/g, the fetching atomics and the world barrier become loads,
+    stores and CPU atomics on the mapped heaps and complete before the call returns. Control barrier and allgather
+    of init run over the domain as well.
+
+    Nothing here reaches the device: kernels, device state and streams are not available with this backend. The
+    team pool holds SHMEM_TEAM_WORLD with its barrier selection, splitting it and barriers on other teams fail. The shared memory object is named after ip_port unless SHMEM_LOOPBACK_NAME is set,
+    PEs of concurrent jobs on one host need different names.
+*/
+
+namespace shm {
+namespace {
+constexpr uint64_t LOOPBACK_MS_PER_SECOND = 1000;
+
+loopback_domain g_loopback;
+std::vector<void *> g_loopback_bases;
+bool g_loopback_active = false;
+
+std::string loopback_name(const char *ip_port)
+{
+    const char *env_name = std::getenv("SHMEM_LOOPBACK_NAME");
+    if (env_name != nullptr) {
+        return env_name;
+    }
+    std::string name = "/shmem_loopback_";
+    for (const char *c = ip_port; *c != '\0'; c++) {
+        name += std::isalnum(static_cast<unsigned char>(*c)) ? *c : '_';
+    }
+    return name;
+}
+
+int32_t loopback_signal(int32_t *sig_addr, int32_t signal, int32_t sig_op, int32_t pe)
+{
+    int32_t old = 0;
+    if (sig_op == SHMEM_SIGNAL_ADD) {
+        return g_loopback.fetch_add<int32_t>(sig_addr, signal, pe, &old);
+    }
+    return g_loopback.swap<int32_t>(sig_addr, signal, pe, &old);
+}
+}  // namespace
+
+bool loopback_active()
+{
+    return g_loopback_active;
+}
+
+loopback_domain &loopback()
+{
+    return g_loopback;
+}
+
+int32_t loopback_init(shmem_init_attr_t *attributes)
+{
+    std::string name = loopback_name(attributes->ip_port);
+    uint64_t timeout_ms = static_cast<uint64_t>(attributes->option_attr.shm_init_timeout) * LOOPBACK_MS_PER_SECOND;
+    auto ret = g_loopback.attach(name, attributes->my_rank, attributes->n_ranks, g_state.heap_size, timeout_ms);
+    if (ret != SHMEM_SUCCESS) {
+        SHM_LOG_ERROR("attach loopback domain " << name << " failed, ret: " << ret);
+        return ret;
+    }
+    g_loopback_bases.assign(g_state.npes, nullptr);
+    for (int32_t pe = 0; pe < g_state.npes; pe++) {
+        g_loopback_bases[pe] = g_loopback.heap(pe);
+        // every heap is load/store reachable, as over MTE
+        g_state.topo_list[pe] = SHMEM_TRANSPORT_MTE;
+    }
+    g_state.heap_base = g_loopback.heap(g_state.mype);
+    g_state.heap_size = g_loopback.heap_size();
+    g_state.p2p_heap_host_base = g_loopback_bases.data();
+    g_state.is_shmem_created = true;
+    g_loopback_active = true;
+    bzero(attributes->ip_port, sizeof(attributes->ip_port));
+    SHM_LOG_INFO("my_rank:" << g_state.mype << " attached loopback domain " << name << " of " << g_state.npes
+                 << " PEs");
+    return SHMEM_SUCCESS;
+}
+
+void loopback_finalize()
+{
+    // collective like every finalize, puts still in flight to this PE land before it unmaps
+    if (g_loopback.barrier() != SHMEM_SUCCESS) {
+        SHM_LOG_ERROR("loopback barrier failed in finalize");
+    }
+    g_loopback.detach();
+    g_loopback_bases.clear();
+    g_state.heap_base = nullptr;
+    g_state.p2p_heap_host_base = nullptr;
+    g_state.is_shmem_initialized = false;
+    g_state.is_shmem_created = false;
+    g_loopback_active = false;
+}
+
+int32_t loopback_rma(shmemi_op_t desc, uint8_t *lptr, uint8_t *rptr, size_t n_rows, size_t row_elems,
+                     size_t elem_bytes, int32_t pe, ptrdiff_t lstride, ptrdiff_t rstride, uint8_t *sig_addr,
+                     int32_t signal, int32_t sig_op)
+{
+    SHM_ASSERT_RETURN(g_state.is_shmem_initialized, SHMEM_NOT_INITED);
+    // same row rules as the kernel path: strides in elements, rows do not overlap
+    if (n_rows > 1 && (lstride < static_cast<ptrdiff_t>(row_elems) || rstride < static_cast<ptrdiff_t>(row_elems))) {
+        return SHMEM_INVALID_PARAM;
+    }
+    uint64_t row_bytes = row_elems * elem_bytes;
+    for (size_t row = 0; row < n_rows; row++) {
+        uint8_t *local = lptr + row * static_cast<uint64_t>(lstride) * elem_bytes;
+        uint8_t *remote = rptr + row * static_cast<uint64_t>(rstride) * elem_bytes;
+        auto ret = desc == SHMEMI_OP_GET ? g_loopback.get(local, remote, row_bytes, pe)
+                                         : g_loopback.put(local, remote, row_bytes, pe);
+        if (ret != SHMEM_SUCCESS) {
+            SHM_LOG_ERROR("loopback rma op: " << desc << " pe: " << pe << " bytes: " << row_bytes << " failed");
+            return ret;
+        }
+    }
+    if (desc == SHMEMI_OP_PUT_SIGNAL) {
+        SHMEM_CHECK_RET(loopback_signal(reinterpret_cast<int32_t *>(sig_addr), signal, sig_op, pe));
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t loopback_rma_batch(const shmemx_rma_desc_t *desc, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        auto *dst = reinterpret_cast<uint8_t *>(desc[i].dst);
+        auto *src = reinterpret_cast<uint8_t *>(desc[i].src);
+        if (desc[i].op == SHMEMX_RMA_GET) {
+            SHMEM_CHECK_RET(g_loopback.get(dst, src, desc[i].bytes, desc[i].pe));
+            continue;
+        }
+        SHMEM_CHECK_RET(g_loopback.put(dst, src, desc[i].bytes, desc[i].pe));
+        if (desc[i].op == SHMEMX_RMA_PUT_SIGNAL) {
+            SHMEM_CHECK_RET(loopback_signal(reinterpret_cast<int32_t *>(desc[i].sig_addr), desc[i].signal,
+                                            desc[i].sig_op, desc[i].pe));
+        }
+    }
+    return SHMEM_SUCCESS;
+}
+}  // namespace shm
@@ -7,6 +7,7 @@
  * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
  * See LICENSE in the root of the software repository for the full text of the License.
  */
+#include <algorithm>
 #include <memory>
 #include "acl/acl.h"
 #include "shmemi_host_common.h"
@@ -63,7 +64,9 @@ void *shmem_calloc(size_t nmemb, size_t size)
 
     auto total_size = nmemb * size;
     auto ptr = shm::shm_memory_heap->allocate(total_size);
-    if (ptr != nullptr) {
+    if (ptr != nullptr && shm::loopback_active()) {
+        std::fill_n(static_cast<uint8_t *>(ptr), total_size, 0);
+    } else if (ptr != nullptr) {
         auto ret = aclrtMemset(ptr, size, 0, size);
         if (ret != 0) {
             SHM_LOG_ERROR("shmem_calloc(" << nmemb << ", " << size << ") memset failed: " << ret);
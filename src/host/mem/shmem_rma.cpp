@@ -49,6 +49,54 @@ int32_t shmem_mte_set_ub_params(uint64_t offset, uint32_t ub_size, uint32_t even
     return SHMEM_SUCCESS;
 }
 
+// Every host RMA goes through here, the loopback backend copies between the mapped heaps instead of a kernel.
+// Host shmem_p still sitting in the aggregation ring is drained first and the stream waits behind pending SDMA
+// nbi copies, so that program order is kept.
+static int32_t shmemi_host_rma(const char *api_name, shmemi_op_t desc, bool is_nbi, uint8_t *lptr, uint8_t *rptr,
+                               size_t n_elems, size_t elem_bytes, int pe, uint8_t *sig_addr, int32_t signal,
+                               int sig_op, ptrdiff_t lstride, ptrdiff_t rstride, aclrtStream acl_strm,
+                               size_t block_size)
+{
+    if (shm::loopback_active()) {
+        bool strided = lstride > 1 || rstride > 1;
+        return shm::loopback_rma(desc, lptr, rptr, strided ? n_elems : 1, strided ? 1 : n_elems, elem_bytes, pe,
+                                 lstride, rstride, sig_addr, signal, sig_op);
+    }
+    SHMEM_CHECK_RET(shm::p_aggregate_flush(), p_aggregate_flush);
+    SHMEM_CHECK_RET(shm::sdma_flush(acl_strm), sdma_flush);
+    return shmemi_prepare_and_post_rma(api_name, desc, is_nbi, lptr, rptr, n_elems, elem_bytes, pe, sig_addr, signal,
+                                       sig_op, lstride, rstride, acl_strm, block_size);
+}
+
+static int32_t shmemi_host_rma_2d(const char *api_name, shmemi_op_t desc, bool is_nbi, uint8_t *lptr, uint8_t *rptr,
+                                  size_t n_rows, size_t row_elems, size_t elem_bytes, int pe, ptrdiff_t lstride,
+                                  ptrdiff_t rstride, aclrtStream acl_strm, size_t block_size)
+{
+    if (shm::loopback_active()) {
+        return shm::loopback_rma(desc, lptr, rptr, n_rows, row_elems, elem_bytes, pe, lstride, rstride, nullptr, 0,
+                                 0);
+    }
+    SHMEM_CHECK_RET(shm::p_aggregate_flush(), p_aggregate_flush);
+    SHMEM_CHECK_RET(shm::sdma_flush(acl_strm), sdma_flush);
+    return shmemi_prepare_and_post_rma_2d(api_name, desc, is_nbi, lptr, rptr, n_rows, row_elems, elem_bytes, pe,
+                                          lstride, rstride, acl_strm, block_size);
+}
+
+// Contiguous host nbi put/get, bulk copies to SDMA reachable PEs go to the SDMA engine instead of a kernel.
+static int32_t shmemi_post_rma_nbi(const char *api_name, shmemi_op_t desc, uint8_t *lptr, uint8_t *rptr,
+                                   size_t n_elems, size_t elem_bytes, int pe)
+{
+    bool is_put = desc == SHMEMI_OP_PUT;
+    uint8_t *sym = is_put ? lptr : rptr;
+    uint8_t *local = is_put ? rptr : lptr;
+    if (shm::sdma_eligible(sym, n_elems * elem_bytes, pe)) {
+        SHMEM_CHECK_RET(shm::p_aggregate_flush(), p_aggregate_flush);
+        return shm::sdma_post(is_put, sym, local, n_elems * elem_bytes, pe);
+    }
+    return shmemi_host_rma(api_name, desc, NBI, lptr, rptr, n_elems, elem_bytes, pe, nullptr, 0, 0, 1, 1,
+                           shm::g_state_host.default_stream, shm::g_state_host.default_block_num);
+}
+
 #define SHMEM_TYPE_PUT(NAME, TYPE)                                                                                    \
     /**                                                                                                               \
      * @brief Synchronous interface. Copy a contiguous data on local PE to symmetric address on the specified PE.     \
@@ -60,9 +108,9 @@ int32_t shmem_mte_set_ub_params(uint64_t offset, uint32_t ub_size, uint32_t even
      */                                                                                                               \
     SHMEM_HOST_API void shmem_put_##NAME##_mem(TYPE *dest, TYPE *source, size_t nelems, int pe)                       \
     {                                                                                                                 \
-        int ret = shmemi_prepare_and_post_rma("shmem_put_" #NAME "_mem", SHMEMI_OP_PUT, NO_NBI, (uint8_t *)dest,      \
-                                              (uint8_t *)source, nelems, sizeof(TYPE), pe, nullptr, 0, 0, 1, 1,       \
-                                              shm::g_state_host.default_stream, shm::g_state_host.default_block_num); \
+        int ret = shmemi_host_rma("shmem_put_" #NAME "_mem", SHMEMI_OP_PUT, NO_NBI, (uint8_t *)dest,                  \
+                                  (uint8_t *)source, nelems, sizeof(TYPE), pe, nullptr, 0, 0, 1, 1,                   \
+                                  shm::g_state_host.default_stream, shm::g_state_host.default_block_num);             \
         if (ret < 0) {                                                                                                \
             SHM_LOG_ERROR("device calling transfer failed");                                                          \
         }                                                                                                             \
@@ -82,9 +130,8 @@ SHMEM_TYPE_FUNC(SHMEM_TYPE_PUT)
      */                                                                                                               \
     SHMEM_HOST_API void shmem_put_##NAME##_mem_nbi(TYPE *dest, TYPE *source, size_t nelems, int pe)                   \
     {                                                                                                                 \
-        int ret = shmemi_prepare_and_post_rma("shmem_put_" #NAME "_mem_nbi", SHMEMI_OP_PUT, NBI, (uint8_t *)dest,     \
-                                              (uint8_t *)source, nelems, sizeof(TYPE), pe, nullptr, 0, 0, 1, 1,       \
-                                              shm::g_state_host.default_stream, shm::g_state_host.default_block_num); \
+        int ret = shmemi_post_rma_nbi("shmem_put_" #NAME "_mem_nbi", SHMEMI_OP_PUT, (uint8_t *)dest,                  \
+                                      (uint8_t *)source, nelems, sizeof(TYPE), pe);                                   \
         if (ret < 0) {                                                                                                \
             SHM_LOG_ERROR("device calling transfer failed");                                                          \
         }                                                                                                             \
@@ -105,9 +152,9 @@ SHMEM_TYPE_FUNC(SHMEM_TYPE_PUT_NBI)
      */                                                                                                               \
     SHMEM_HOST_API void shmem_get_##NAME##_mem(TYPE *dest, TYPE *source, size_t nelems, int pe)                       \
     {                                                                                                                 \
-        int ret = shmemi_prepare_and_post_rma("shmem_get_" #NAME "_mem", SHMEMI_OP_GET, NO_NBI, (uint8_t *)dest,      \
-                                              (uint8_t *)source, nelems, sizeof(TYPE), pe, nullptr, 0, 0, 1, 1,       \
-                                              shm::g_state_host.default_stream, shm::g_state_host.default_block_num); \
+        int ret = shmemi_host_rma("shmem_get_" #NAME "_mem", SHMEMI_OP_GET, NO_NBI, (uint8_t *)dest,                  \
+                                  (uint8_t *)source, nelems, sizeof(TYPE), pe, nullptr, 0, 0, 1, 1,                   \
+                                  shm::g_state_host.default_stream, shm::g_state_host.default_block_num);             \
         if (ret < 0) {                                                                                                \
             SHM_LOG_ERROR("device calling transfer failed");                                                          \
         }                                                                                                             \
@@ -128,9 +175,8 @@ SHMEM_TYPE_FUNC(SHMEM_TYPE_GET)
      */                                                                                                                \
     SHMEM_HOST_API void shmem_get_##NAME##_mem_nbi(TYPE *dest, TYPE *source, size_t nelems, int pe)                    \
     {                                                                                                                  \
-        int ret = shmemi_prepare_and_post_rma("shmem_get_" #NAME "_mem_nbi", SHMEMI_OP_GET, NBI, (uint8_t *)dest,      \
-                                              (uint8_t *)source, nelems, sizeof(TYPE), pe, nullptr, 0, 0, 1, 1,        \
-                                              shm::g_state_host.default_stream, shm::g_state_host.default_block_num);  \
+        int ret = shmemi_post_rma_nbi("shmem_get_" #NAME "_mem_nbi", SHMEMI_OP_GET, (uint8_t *)dest,                   \
+                                      (uint8_t *)source, nelems, sizeof(TYPE), pe);                                    \
         if (ret < 0) {                                                                                                 \
             SHM_LOG_ERROR("device calling transfer failed");                                                           \
         }                                                                                                              \
@@ -139,6 +185,117 @@ SHMEM_TYPE_FUNC(SHMEM_TYPE_GET)
 SHMEM_TYPE_FUNC(SHMEM_TYPE_GET_NBI)
 #undef SHMEM_TYPE_GET_NBI
 
+#define SHMEM_TYPE_IPUT(NAME, TYPE)                                                                                   \
+    /**                                                                                                               \
+     * @brief Synchronous interface. Copy strided data on local PE to strided symmetric address on the specified PE.  \
+     *                                                                                                                \
+     * @param dest               [in] Pointer on Symmetric memory of the destination data.                            \
+     * @param source             [in] Pointer on local device of the source data.                                     \
+     * @param dst                [in] Stride between consecutive elements of dest, in elements (>= 1).                \
+     * @param sst                [in] Stride between consecutive elements of source, in elements (>= 1).              \
+     * @param nelems             [in] Number of elements to be copied.                                                \
+     * @param pe                 [in] PE number of the remote PE.                                                     \
+     */                                                                                                               \
+    SHMEM_HOST_API void shmem_##NAME##_iput(TYPE *dest, TYPE *source, ptrdiff_t dst, ptrdiff_t sst, size_t nelems,    \
+                                            int pe)                                                                   \
+    {                                                                                                                 \
+        int ret = shmemi_host_rma_2d("shmem_" #NAME "_iput", SHMEMI_OP_PUT, NO_NBI, (uint8_t *)dest,                  \
+                                     (uint8_t *)source, nelems, 1, sizeof(TYPE), pe, dst, sst,                        \
+                                     shm::g_state_host.default_stream,                                                \
+                                     shm::g_state_host.default_block_num);                                            \
+        if (ret < 0) {                                                                                                \
+            SHM_LOG_ERROR("shmem_" #NAME "_iput failed, dst: " << dst << " sst: " << sst);                            \
+        }                                                                                                             \
+    }
+
+SHMEM_TYPE_FUNC(SHMEM_TYPE_IPUT)
+#undef SHMEM_TYPE_IPUT
+
+#define SHMEM_TYPE_IGET(NAME, TYPE)                                                                                   \
+    /**                                                                                                               \
+     * @brief Synchronous interface. Copy strided data on symmetric memory from the specified PE to strided address   \
+     *        on the local PE.                                                                                        \
+     *                                                                                                                \
+     * @param dest               [in] Pointer on local device of the destination data.                                \
+     * @param source             [in] Pointer on Symmetric memory of the source data.                                 \
+     * @param dst                [in] Stride between consecutive elements of dest, in elements (>= 1).                \
+     * @param sst                [in] Stride between consecutive elements of source, in elements (>= 1).              \
+     * @param nelems             [in] Number of elements to be copied.                                                \
+     * @param pe                 [in] PE number of the remote PE.                                                     \
+     */                                                                                                               \
+    SHMEM_HOST_API void shmem_##NAME##_iget(TYPE *dest, TYPE *source, ptrdiff_t dst, ptrdiff_t sst, size_t nelems,    \
+                                            int pe)                                                                   \
+    {                                                                                                                 \
+        int ret = shmemi_host_rma_2d("shmem_" #NAME "_iget", SHMEMI_OP_GET, NO_NBI, (uint8_t *)dest,                  \
+                                     (uint8_t *)source, nelems, 1, sizeof(TYPE), pe, dst, sst,                        \
+                                     shm::g_state_host.default_stream,                                                \
+                                     shm::g_state_host.default_block_num);                                            \
+        if (ret < 0) {                                                                                                \
+            SHM_LOG_ERROR("shmem_" #NAME "_iget failed, dst: " << dst << " sst: " << sst);                            \
+        }                                                                                                             \
+    }
+
+SHMEM_TYPE_FUNC(SHMEM_TYPE_IGET)
+#undef SHMEM_TYPE_IGET
+
+#define SHMEMX_TYPE_PUT_2D(NAME, TYPE)                                                                                \
+    /**                                                                                                               \
+     * @brief Synchronous interface. Copy a 2-D block (rows x cols) on local PE to symmetric address on the specified \
+     *        PE in a single launch.                                                                                  \
+     *                                                                                                                \
+     * @param dest               [in] Pointer on Symmetric memory of the first row of the destination block.         \
+     * @param source             [in] Pointer on local device of the first row of the source block.                   \
+     * @param rows               [in] Number of rows.                                                                 \
+     * @param cols               [in] Number of contiguous elements in each row.                                      \
+     * @param dst_ld             [in] Leading dimension of dest, in elements (>= cols).                               \
+     * @param src_ld             [in] Leading dimension of source, in elements (>= cols).                             \
+     * @param pe                 [in] PE number of the remote PE.                                                     \
+     */                                                                                                               \
+    SHMEM_HOST_API void shmemx_##NAME##_put_2d(TYPE *dest, TYPE *source, size_t rows, size_t cols, size_t dst_ld,     \
+                                               size_t src_ld, int pe)                                                 \
+    {                                                                                                                 \
+        int ret = shmemi_host_rma_2d("shmemx_" #NAME "_put_2d", SHMEMI_OP_PUT, NO_NBI, (uint8_t *)dest,               \
+                                     (uint8_t *)source, rows, cols, sizeof(TYPE), pe, dst_ld, src_ld,                 \
+                                     shm::g_state_host.default_stream,                                                \
+                                     shm::g_state_host.default_block_num);                                            \
+        if (ret < 0) {                                                                                                \
+            SHM_LOG_ERROR("shmemx_" #NAME "_put_2d failed, cols: " << cols << " dst_ld: " << dst_ld                   \
+                          << " src_ld: " << src_ld);                                                                  \
+        }                                                                                                             \
+    }
+
+SHMEM_TYPE_FUNC(SHMEMX_TYPE_PUT_2D)
+#undef SHMEMX_TYPE_PUT_2D
+
+#define SHMEMX_TYPE_GET_2D(NAME, TYPE)                                                                                \
+    /**                                                                                                               \
+     * @brief Synchronous interface. Copy a 2-D block (rows x cols) on symmetric memory from the specified PE to      \
+     *        address on the local PE in a single launch.                                                             \
+     *                                                                                                                \
+     * @param dest               [in] Pointer on local device of the first row of the destination block.              \
+     * @param source             [in] Pointer on Symmetric memory of the first row of the source block.               \
+     * @param rows               [in] Number of rows.                                                                 \
+     * @param cols               [in] Number of contiguous elements in each row.                                      \
+     * @param dst_ld             [in] Leading dimension of dest, in elements (>= cols).                               \
+     * @param src_ld             [in] Leading dimension of source, in elements (>= cols).                             \
+     * @param pe                 [in] PE number of the remote PE.                                                     \
+     */                                                                                                               \
+    SHMEM_HOST_API void shmemx_##NAME##_get_2d(TYPE *dest, TYPE *source, size_t rows, size_t cols, size_t dst_ld,     \
+                                               size_t src_ld, int pe)                                                 \
+    {                                                                                                                 \
+        int ret = shmemi_host_rma_2d("shmemx_" #NAME "_get_2d", SHMEMI_OP_GET, NO_NBI, (uint8_t *)dest,               \
+                                     (uint8_t *)source, rows, cols, sizeof(TYPE), pe, dst_ld, src_ld,                 \
+                                     shm::g_state_host.default_stream,                                                \
+                                     shm::g_state_host.default_block_num);                                            \
+        if (ret < 0) {                                                                                                \
+            SHM_LOG_ERROR("shmemx_" #NAME "_get_2d failed, cols: " << cols << " dst_ld: " << dst_ld                   \
+                          << " src_ld: " << src_ld);                                                                  \
+        }                                                                                                             \
+    }
+
+SHMEM_TYPE_FUNC(SHMEMX_TYPE_GET_2D)
+#undef SHMEMX_TYPE_GET_2D
+
 #define SHMEM_PUT_TYPENAME_MEM_SIGNAL(NAME, TYPE)                                                                    \
     /**                                                                                                              \
      * @brief Synchronous interface. Copy a contiguous data on local UB to symmetric address on the specified PE.    \
@@ -155,10 +312,10 @@ SHMEM_TYPE_FUNC(SHMEM_TYPE_GET_NBI)
     SHMEM_HOST_API void shmem_put_##NAME##_mem_signal(TYPE *dst, TYPE *src, size_t elem_size, uint8_t *sig_addr,     \
                                                       int32_t signal, int sig_op, int pe)                            \
     {                                                                                                                \
-        int ret = shmemi_prepare_and_post_rma("shmem_put_" #NAME "_mem_signal", SHMEMI_OP_PUT_SIGNAL, NO_NBI,        \
-                                              (uint8_t *)dst, (uint8_t *)src, elem_size, sizeof(TYPE), pe, sig_addr, \
-                                              signal, sig_op, 1, 1, shm::g_state_host.default_stream,                \
-                                              shm::g_state_host.default_block_num);                                  \
+        int ret = shmemi_host_rma("shmem_put_" #NAME "_mem_signal", SHMEMI_OP_PUT_SIGNAL, NO_NBI,                    \
+                                  (uint8_t *)dst, (uint8_t *)src, elem_size, sizeof(TYPE), pe, sig_addr,             \
+                                  signal, sig_op, 1, 1, shm::g_state_host.default_stream,                            \
+                                  shm::g_state_host.default_block_num);                                              \
         if (ret < 0) {                                                                                               \
             SHM_LOG_ERROR("device calling transfer failed");                                                         \
         }                                                                                                            \
@@ -183,10 +340,10 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL)
     SHMEM_HOST_API void shmem_put_##NAME##_mem_signal_nbi(TYPE *dst, TYPE *src, size_t elem_size, uint8_t *sig_addr, \
                                                           int32_t signal, int sig_op, int pe)                        \
     {                                                                                                                \
-        int ret = shmemi_prepare_and_post_rma("shmem_put_" #NAME "_mem_signal_nbi", SHMEMI_OP_PUT_SIGNAL, NBI,       \
-                                              (uint8_t *)dst, (uint8_t *)src, elem_size, sizeof(TYPE), pe, sig_addr, \
-                                              signal, sig_op, 1, 1, shm::g_state_host.default_stream,                \
-                                              shm::g_state_host.default_block_num);                                  \
+        int ret = shmemi_host_rma("shmem_put_" #NAME "_mem_signal_nbi", SHMEMI_OP_PUT_SIGNAL, NBI,                   \
+                                  (uint8_t *)dst, (uint8_t *)src, elem_size, sizeof(TYPE), pe, sig_addr,             \
+                                  signal, sig_op, 1, 1, shm::g_state_host.default_stream,                            \
+                                  shm::g_state_host.default_block_num);                                              \
         if (ret < 0) {                                                                                               \
             SHM_LOG_ERROR("device calling transfer failed");                                                         \
         }                                                                                                            \
@@ -198,6 +355,8 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_NBI)
 #define SHMEM_TYPENAME_P(NAME, TYPE)                                                                                   \
     /**                                                                                                                \
      * @brief Provide a low latency put capability for single element of most basic types.                             \
+     *        Puts are aggregated and drained in batches, they are complete after the next barrier,                   \
+     *        shmem_handle_wait or shmemx_p_flush.                                                                     \
      *                                                                                                                 \
      * @param dst               [in] Symmetric address of the destination data on local PE.                            \
      * @param value             [in] The element to be put.                                                            \
@@ -205,8 +364,10 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_NBI)
      */                                                                                                                \
     SHMEM_HOST_API void shmem_##NAME##_p(TYPE *dst, const TYPE value, int pe)                                          \
     {                                                                                                                  \
-        shmemi_prepare_and_post_rma_##NAME##_p("shmem_" #NAME "_p", (uint8_t *)dst, value, pe,                         \
-                                               shm::g_state_host.default_stream, shm::g_state_host.default_block_num); \
+        int ret = shm::p_aggregate_append(dst, &value, sizeof(TYPE), pe);                                              \
+        if (ret != 0) {                                                                                                \
+            SHM_LOG_ERROR("shmem_" #NAME "_p failed, ret: " << ret);                                                   \
+        }                                                                                                              \
     }
 
 SHMEM_TYPE_FUNC(SHMEM_TYPENAME_P)
@@ -223,11 +384,18 @@ SHMEM_TYPE_FUNC(SHMEM_TYPENAME_P)
     SHMEM_HOST_API TYPE shmem_##NAME##_g(TYPE *src, int32_t pe)                                                        \
     {                                                                                                                  \
         TYPE value {};                                                                                                 \
+        /* a flag check only, the ring is drained when this PE has shmem_p pending */                                  \
+        if (shm::p_aggregate_flush() != 0) {                                                                           \
+            SHM_LOG_ERROR("shmem_g failed to flush pending shmem_p");                                                  \
+        }                                                                                                              \
         auto ptr = shmem_ptr(src, pe);                                                                                 \
         if (ptr == nullptr) {                                                                                          \
             SHM_LOG_ERROR("shmem_g failed");                                                                           \
             return value;                                                                                              \
         }                                                                                                              \
+        if (shm::loopback_active()) {                                                                                  \
+            return *reinterpret_cast<volatile TYPE *>(ptr);                                                            \
+        }                                                                                                              \
         int ret =                                                                                                      \
             aclrtMemcpy(&value, sizeof(TYPE), reinterpret_cast<void *>(ptr), sizeof(TYPE), ACL_MEMCPY_DEVICE_TO_HOST); \
         if (ret != 0) {                                                                                                \
@@ -239,11 +407,29 @@ SHMEM_TYPE_FUNC(SHMEM_TYPENAME_P)
 SHMEM_TYPE_FUNC(SHMEM_TYPENAME_G)
 #undef SHMEM_TYPENAME_G
 
+#define SHMEMX_TYPENAME_G_VEC(NAME, TYPE)                                                                              \
+    /**                                                                                                                \
+     * @brief Get n single elements from (srcs[i], pes[i]) pairs with one launch and one device to host copy.          \
+     *                                                                                                                 \
+     * @param values            [out] Host array receiving the n elements.                                             \
+     * @param srcs              [in] Symmetric addresses of the source elements on local PE.                           \
+     * @param pes               [in] PE number of each element.                                                        \
+     * @param n                 [in] Number of elements.                                                               \
+     * @return Returns 0 on success or an error code on failure.                                                       \
+     */                                                                                                                \
+    SHMEM_HOST_API int shmemx_##NAME##_g_vec(TYPE *values, TYPE *const *srcs, const int *pes, size_t n)                \
+    {                                                                                                                  \
+        return shm::p_aggregate_gather(values, reinterpret_cast<void *const *>(srcs), pes, n, sizeof(TYPE));           \
+    }
+
+SHMEM_TYPE_FUNC(SHMEMX_TYPENAME_G_VEC)
+#undef SHMEMX_TYPENAME_G_VEC
+
 void shmem_putmem(void *dst, void *src, size_t elem_size, int32_t pe)
 {
-    int ret = shmemi_prepare_and_post_rma("shmem putmem", SHMEMI_OP_PUT, NO_NBI, (uint8_t *)dst, (uint8_t *)src,
-                                          elem_size, 1, pe, nullptr, 0, 0, 1, 1, shm::g_state_host.default_stream,
-                                          shm::g_state_host.default_block_num);
+    int ret = shmemi_host_rma("shmem putmem", SHMEMI_OP_PUT, NO_NBI, (uint8_t *)dst, (uint8_t *)src,
+                              elem_size, 1, pe, nullptr, 0, 0, 1, 1, shm::g_state_host.default_stream,
+                              shm::g_state_host.default_block_num);
     if (ret < 0) {
         SHM_LOG_ERROR("shmem_putmem failed");
     }
@@ -251,9 +437,9 @@ void shmem_putmem(void *dst, void *src, size_t elem_size, int32_t pe)
 
 void shmem_getmem(void *dst, void *src, size_t elem_size, int32_t pe)
 {
-    int ret = shmemi_prepare_and_post_rma("shmem getmem", SHMEMI_OP_GET, NO_NBI, (uint8_t *)dst, (uint8_t *)src,
-                                          elem_size, 1, pe, nullptr, 0, 0, 1, 1, shm::g_state_host.default_stream,
-                                          shm::g_state_host.default_block_num);
+    int ret = shmemi_host_rma("shmem getmem", SHMEMI_OP_GET, NO_NBI, (uint8_t *)dst, (uint8_t *)src,
+                              elem_size, 1, pe, nullptr, 0, 0, 1, 1, shm::g_state_host.default_stream,
+                              shm::g_state_host.default_block_num);
     if (ret < 0) {
         SHM_LOG_ERROR("shmem_getmem failed");
     }
@@ -261,9 +447,7 @@ void shmem_getmem(void *dst, void *src, size_t elem_size, int32_t pe)
 
 void shmem_putmem_nbi(void *dst, void *src, size_t elem_size, int32_t pe)
 {
-    int ret = shmemi_prepare_and_post_rma("shmem_putmem_nbi", SHMEMI_OP_PUT, NBI, (uint8_t *)dst, (uint8_t *)src,
-                                          elem_size, 1, pe, nullptr, 0, 0, 1, 1, shm::g_state_host.default_stream,
-                                          shm::g_state_host.default_block_num);
+    int ret = shmemi_post_rma_nbi("shmem_putmem_nbi", SHMEMI_OP_PUT, (uint8_t *)dst, (uint8_t *)src, elem_size, 1, pe);
     if (ret < 0) {
         SHM_LOG_ERROR("shmem_putmem_nbi failed");
     }
@@ -271,9 +455,7 @@ void shmem_putmem_nbi(void *dst, void *src, size_t elem_size, int32_t pe)
 
 void shmem_getmem_nbi(void *dst, void *src, size_t elem_size, int32_t pe)
 {
-    int ret = shmemi_prepare_and_post_rma("shmem_getmem_nbi", SHMEMI_OP_GET, NBI, (uint8_t *)dst, (uint8_t *)src,
-                                          elem_size, 1, pe, nullptr, 0, 0, 1, 1, shm::g_state_host.default_stream,
-                                          shm::g_state_host.default_block_num);
+    int ret = shmemi_post_rma_nbi("shmem_getmem_nbi", SHMEMI_OP_GET, (uint8_t *)dst, (uint8_t *)src, elem_size, 1, pe);
     if (ret < 0) {
         SHM_LOG_ERROR("shmem_getmem_nbi failed");
     }
@@ -281,9 +463,9 @@ void shmem_getmem_nbi(void *dst, void *src, size_t elem_size, int32_t pe)
 
 void shmem_putmem_signal_nbi(void *dst, void *src, size_t elem_size, void *sig_addr, int32_t signal, int sig_op, int pe)
 {
-    int ret = shmemi_prepare_and_post_rma("shmem_putmem_signal_nbi", SHMEMI_OP_PUT_SIGNAL, NBI, (uint8_t *)dst,
-                                          (uint8_t *)src, elem_size, 1, pe, (uint8_t *)sig_addr, signal, sig_op, 1, 1,
-                                          shm::g_state_host.default_stream, shm::g_state_host.default_block_num);
+    int ret = shmemi_host_rma("shmem_putmem_signal_nbi", SHMEMI_OP_PUT_SIGNAL, NBI, (uint8_t *)dst,
+                              (uint8_t *)src, elem_size, 1, pe, (uint8_t *)sig_addr, signal, sig_op, 1, 1,
+                              shm::g_state_host.default_stream, shm::g_state_host.default_block_num);
     if (ret < 0) {
         SHM_LOG_ERROR("device calling transfer failed");
     }
@@ -291,9 +473,9 @@ void shmem_putmem_signal_nbi(void *dst, void *src, size_t elem_size, void *sig_a
 
 void shmem_putmem_signal(void *dst, void *src, size_t elem_size, void *sig_addr, int32_t signal, int sig_op, int pe)
 {
-    int ret = shmemi_prepare_and_post_rma("shmem_putmem_signal", SHMEMI_OP_PUT_SIGNAL, NO_NBI, (uint8_t *)dst,
-                                          (uint8_t *)src, elem_size, 1, pe, (uint8_t *)sig_addr, signal, sig_op, 1, 1,
-                                          shm::g_state_host.default_stream, shm::g_state_host.default_block_num);
+    int ret = shmemi_host_rma("shmem_putmem_signal", SHMEMI_OP_PUT_SIGNAL, NO_NBI, (uint8_t *)dst,
+                              (uint8_t *)src, elem_size, 1, pe, (uint8_t *)sig_addr, signal, sig_op, 1, 1,
+                              shm::g_state_host.default_stream, shm::g_state_host.default_block_num);
     if (ret < 0) {
         SHM_LOG_ERROR("device calling transfer failed");
     }
@@ -301,8 +483,37 @@ void shmem_putmem_signal(void *dst, void *src, size_t elem_size, void *sig_addr,
 
 void shmemx_getmem_on_stream(void* dst, void* src, size_t elem_size, int32_t pe, aclrtStream stream)
 {
+    if (shm::loopback_active()) {
+        shmem_getmem(dst, src, elem_size, pe);
+        return;
+    }
+    if (shm::p_aggregate_flush() != 0) {
+        SHM_LOG_ERROR("shmemx_getmem_on_stream failed to flush pending shmem_p");
+    }
     int ret = shmemi_getmem_on_stream((uint8_t *)dst, (uint8_t *)src, elem_size, pe, stream);
     if (ret < 0) {
         SHM_LOG_ERROR("shmemi_getmem_on_stream failed");
     }
 }
+
+void shmemx_putmem_2d(void *dst, size_t dst_pitch, void *src, size_t src_pitch, size_t width, size_t height,
+                      int32_t pe)
+{
+    int ret = shmemi_host_rma_2d("shmemx_putmem_2d", SHMEMI_OP_PUT, NO_NBI, (uint8_t *)dst,
+                                 (uint8_t *)src, height, width, 1, pe, dst_pitch, src_pitch,
+                                 shm::g_state_host.default_stream, shm::g_state_host.default_block_num);
+    if (ret < 0) {
+        SHM_LOG_ERROR("shmemx_putmem_2d failed");
+    }
+}
+
+void shmemx_getmem_2d(void *dst, size_t dst_pitch, void *src, size_t src_pitch, size_t width, size_t height,
+                      int32_t pe)
+{
+    int ret = shmemi_host_rma_2d("shmemx_getmem_2d", SHMEMI_OP_GET, NO_NBI, (uint8_t *)dst,
+                                 (uint8_t *)src, height, width, 1, pe, dst_pitch, src_pitch,
+                                 shm::g_state_host.default_stream, shm::g_state_host.default_block_num);
+    if (ret < 0) {
+        SHM_LOG_ERROR("shmemx_getmem_2d failed");
+    }
+}
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+#include "shmemi_device_rma.h"
+
+/*
+    Small message aggregation for host scalar RMA.
+
+    Host shmem_<type>_p appends {descriptor, value} into one half of a pinned ring instead of launching a kernel
+    per element. A half is uploaded with one async copy and drained by one shmemi_rma_batch launch when it is full
+    or when a synchronization point is reached (barrier, handle wait, shmemx_p_flush, finalize), which is exactly
+    when OpenSHMEM requires the puts to be complete. While one half is in flight the other one keeps accumulating.
+
+    Host shmemx_<type>_g_vec gathers many remote scalars through the same path: GET descriptors land in a device
+    scratch and come back with a single device-to-host copy.
+*/
+
+namespace shm {
+namespace {
+constexpr uint32_t P_AGG_HALVES = 2;
+
+struct p_agg_half {
+    shmemx_rma_desc_t *host_desc = nullptr;  // pinned
+    uint64_t *host_value = nullptr;          // pinned
+    uint8_t *device_desc = nullptr;
+    uint64_t *device_value = nullptr;
+    uint32_t count = 0;
+    bool in_flight = false;
+};
+
+struct p_aggregator {
+    std::mutex mutex;
+    p_agg_half halves[P_AGG_HALVES];
+    uint32_t current = 0;
+    bool ready = false;
+    // set while any put sits in a half or is in flight, lets flush skip the mutex on the hot RMA and _g paths
+    std::atomic<bool> dirty{false};
+};
+
+p_aggregator g_p_agg;
+
+void p_aggregate_release_in_lock()
+{
+    for (auto &half : g_p_agg.halves) {
+        if (half.host_desc != nullptr) {
+            aclrtFreeHost(half.host_desc);
+            half.host_desc = nullptr;
+        }
+        if (half.host_value != nullptr) {
+            aclrtFreeHost(half.host_value);
+            half.host_value = nullptr;
+        }
+        if (half.device_desc != nullptr) {
+            aclrtFree(half.device_desc);
+            half.device_desc = nullptr;
+        }
+        if (half.device_value != nullptr) {
+            aclrtFree(half.device_value);
+            half.device_value = nullptr;
+        }
+        half.count = 0;
+        half.in_flight = false;
+    }
+    g_p_agg.ready = false;
+}
+
+int32_t p_agg_half_alloc(p_agg_half &half)
+{
+    SHMEM_CHECK_RET(aclrtMallocHost((void **)&half.host_desc, P_AGG_RING_SLOTS * sizeof(shmemx_rma_desc_t)),
+                    aclrtMallocHost);
+    SHMEM_CHECK_RET(aclrtMallocHost((void **)&half.host_value, P_AGG_RING_SLOTS * sizeof(uint64_t)),
+                    aclrtMallocHost);
+    SHMEM_CHECK_RET(aclrtMalloc((void **)&half.device_desc, P_AGG_RING_SLOTS * sizeof(shmemx_rma_desc_t),
+                                ACL_MEM_MALLOC_HUGE_FIRST), aclrtMalloc);
+    SHMEM_CHECK_RET(aclrtMalloc((void **)&half.device_value, P_AGG_RING_SLOTS * sizeof(uint64_t),
+                                ACL_MEM_MALLOC_HUGE_FIRST), aclrtMalloc);
+    half.count = 0;
+    half.in_flight = false;
+    return SHMEM_SUCCESS;
+}
+
+int32_t p_aggregate_prepare()
+{
+    if (g_p_agg.ready) {
+        return SHMEM_SUCCESS;
+    }
+    for (auto &half : g_p_agg.halves) {
+        auto ret = p_agg_half_alloc(half);
+        if (ret != SHMEM_SUCCESS) {
+            // buffers of the halves allocated so far would leak, the next call starts over
+            p_aggregate_release_in_lock();
+            return ret;
+        }
+    }
+    g_p_agg.current = 0;
+    g_p_agg.ready = true;
+    return SHMEM_SUCCESS;
+}
+
+// Launch the current half and switch to the other one, waiting for it if it is still in flight.
+int32_t p_aggregate_launch_in_lock()
+{
+    aclrtStream stream = g_state_host.default_stream;
+    p_agg_half &half = g_p_agg.halves[g_p_agg.current];
+    if (half.count == 0) {
+        return SHMEM_SUCCESS;
+    }
+    SHMEM_CHECK_RET(aclrtMemcpyAsync(half.device_value, half.count * sizeof(uint64_t), half.host_value,
+                                     half.count * sizeof(uint64_t), ACL_MEMCPY_HOST_TO_DEVICE, stream),
+                    aclrtMemcpyAsync);
+    SHMEM_CHECK_RET(aclrtMemcpyAsync(half.device_desc, half.count * sizeof(shmemx_rma_desc_t), half.host_desc,
+                                     half.count * sizeof(shmemx_rma_desc_t), ACL_MEMCPY_HOST_TO_DEVICE, stream),
+                    aclrtMemcpyAsync);
+    size_t block_num = std::min<size_t>(half.count, RMA_BATCH_MAX_BLOCKS);
+    SHMEM_CHECK_RET(shmemi_rma_batch_on_stream(half.device_desc, half.count, stream, block_num),
+                    shmemi_rma_batch_on_stream);
+    half.in_flight = true;
+
+    g_p_agg.current = (g_p_agg.current + 1) % P_AGG_HALVES;
+    p_agg_half &next = g_p_agg.halves[g_p_agg.current];
+    if (next.in_flight) {
+        SHMEM_CHECK_RET(aclrtSynchronizeStream(stream), aclrtSynchronizeStream);
+        for (auto &h : g_p_agg.halves) {
+            h.in_flight = false;
+        }
+    }
+    next.count = 0;
+    return SHMEM_SUCCESS;
+}
+}  // namespace
+
+int32_t p_aggregate_append(void *dst, const void *value, uint32_t bytes, int32_t pe)
+{
+    SHM_ASSERT_RETURN(g_state.is_shmem_initialized, SHMEM_NOT_INITED);
+    SHM_ASSERT_RETURN(bytes <= sizeof(uint64_t), SHMEM_INVALID_VALUE);
+    if (loopback_active()) {
+        shmemx_rma_desc_t desc = {SHMEMX_RMA_PUT, pe, reinterpret_cast<uint64_t>(dst),
+                                  reinterpret_cast<uint64_t>(value), bytes, 0, 0, 0};
+        SHMEM_CHECK_RET(rma_desc_validate(desc, g_state.heap_base, g_state.heap_size, g_state.npes));
+        return loopback_rma_batch(&desc, 1);
+    }
+    std::lock_guard<std::mutex> lock(g_p_agg.mutex);
+    SHMEM_CHECK_RET(p_aggregate_prepare(), p_aggregate_prepare);
+
+    p_agg_half &half = g_p_agg.halves[g_p_agg.current];
+    uint32_t slot = half.count;
+    shmemx_rma_desc_t desc = {SHMEMX_RMA_PUT, pe, reinterpret_cast<uint64_t>(dst),
+                              reinterpret_cast<uint64_t>(half.device_value + slot), bytes, 0, 0, 0};
+    // the source lives in the aggregation buffer, only the destination side needs checking
+    SHMEM_CHECK_RET(rma_desc_validate(desc, g_state.heap_base, g_state.heap_size, g_state.npes));
+    half.host_value[slot] = 0;
+    std::copy_n(static_cast<const uint8_t *>(value), bytes, reinterpret_cast<uint8_t *>(half.host_value + slot));
+    half.host_desc[slot] = desc;
+    half.count++;
+    g_p_agg.dirty.store(true, std::memory_order_release);
+    if (half.count == P_AGG_RING_SLOTS) {
+        SHMEM_CHECK_RET(p_aggregate_launch_in_lock(), p_aggregate_launch_in_lock);
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t p_aggregate_flush()
+{
+    if (!g_p_agg.dirty.load(std::memory_order_acquire)) {
+        return SHMEM_SUCCESS;
+    }
+    std::lock_guard<std::mutex> lock(g_p_agg.mutex);
+    if (!g_p_agg.ready) {
+        return SHMEM_SUCCESS;
+    }
+    bool pending = g_p_agg.halves[g_p_agg.current].count > 0;
+    for (auto &half : g_p_agg.halves) {
+        pending = pending || half.in_flight;
+    }
+    if (pending) {
+        SHMEM_CHECK_RET(p_aggregate_launch_in_lock(), p_aggregate_launch_in_lock);
+        SHMEM_CHECK_RET(aclrtSynchronizeStream(g_state_host.default_stream), aclrtSynchronizeStream);
+        for (auto &half : g_p_agg.halves) {
+            half.in_flight = false;
+        }
+    }
+    g_p_agg.dirty.store(false, std::memory_order_release);
+    return SHMEM_SUCCESS;
+}
+
+int32_t p_aggregate_gather(void *values, void *const *srcs, const int32_t *pes, size_t n, uint32_t bytes)
+{
+    SHM_ASSERT_RETURN(g_state.is_shmem_initialized, SHMEM_NOT_INITED);
+    SHM_ASSERT_RETURN(values != nullptr && srcs != nullptr && pes != nullptr, SHMEM_INVALID_PARAM);
+    SHM_ASSERT_RETURN(bytes <= sizeof(uint64_t), SHMEM_INVALID_VALUE);
+    uint8_t *out = static_cast<uint8_t *>(values);
+    if (loopback_active()) {
+        for (size_t i = 0; i < n; i++) {
+            shmemx_rma_desc_t desc = {SHMEMX_RMA_GET, pes[i], reinterpret_cast<uint64_t>(out + i * bytes),
+                                      reinterpret_cast<uint64_t>(srcs[i]), bytes, 0, 0, 0};
+            SHMEM_CHECK_RET(rma_desc_validate(desc, g_state.heap_base, g_state.heap_size, g_state.npes));
+            SHMEM_CHECK_RET(loopback_rma_batch(&desc, 1));
+        }
+        return SHMEM_SUCCESS;
+    }
+    std::lock_guard<std::mutex> lock(g_p_agg.mutex);
+    SHMEM_CHECK_RET(p_aggregate_prepare(), p_aggregate_prepare);
+    aclrtStream stream = g_state_host.default_stream;
+    // pending puts from this PE are launched first, the stream orders them before the gather
+    SHMEM_CHECK_RET(p_aggregate_launch_in_lock(), p_aggregate_launch_in_lock);
+    p_agg_half &half = g_p_agg.halves[g_p_agg.current];
+    for (size_t done = 0; done < n;) {
+        uint32_t count = static_cast<uint32_t>(std::min<size_t>(n - done, P_AGG_RING_SLOTS));
+        for (uint32_t i = 0; i < count; i++) {
+            shmemx_rma_desc_t desc = {SHMEMX_RMA_GET, pes[done + i], reinterpret_cast<uint64_t>(half.device_value + i),
+                                      reinterpret_cast<uint64_t>(srcs[done + i]), bytes, 0, 0, 0};
+            SHMEM_CHECK_RET(rma_desc_validate(desc, g_state.heap_base, g_state.heap_size, g_state.npes));
+            half.host_desc[i] = desc;
+        }
+        SHMEM_CHECK_RET(aclrtMemcpyAsync(half.device_desc, count * sizeof(shmemx_rma_desc_t), half.host_desc,
+                                         count * sizeof(shmemx_rma_desc_t), ACL_MEMCPY_HOST_TO_DEVICE, stream),
+                        aclrtMemcpyAsync);
+        size_t block_num = std::min<size_t>(count, RMA_BATCH_MAX_BLOCKS);
+        SHMEM_CHECK_RET(shmemi_rma_batch_on_stream(half.device_desc, count, stream, block_num),
+                        shmemi_rma_batch_on_stream);
+        SHMEM_CHECK_RET(aclrtSynchronizeStream(stream), aclrtSynchronizeStream);
+        for (auto &h : g_p_agg.halves) {
+            h.in_flight = false;
+        }
+        g_p_agg.dirty.store(false, std::memory_order_release);
+        SHMEM_CHECK_RET(aclrtMemcpy(half.host_value, count * sizeof(uint64_t), half.device_value,
+                                    count * sizeof(uint64_t), ACL_MEMCPY_DEVICE_TO_HOST), aclrtMemcpy);
+        for (uint32_t i = 0; i < count; i++) {
+            std::copy_n(reinterpret_cast<uint8_t *>(half.host_value + i), bytes, out + (done + i) * bytes);
+        }
+        done += count;
+    }
+    return SHMEM_SUCCESS;
+}
+
+void p_aggregate_finalize()
+{
+    if (p_aggregate_flush() != SHMEM_SUCCESS) {
+        SHM_LOG_ERROR("flush pending shmem_p failed in finalize");
+    }
+    std::lock_guard<std::mutex> lock(g_p_agg.mutex);
+    p_aggregate_release_in_lock();
+    g_p_agg.dirty.store(false, std::memory_order_release);
+}
+}  // namespace shm
+
+int32_t shmemx_p_flush(void)
+{
+    return shm::p_aggregate_flush();
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+#include "shmemi_device_rma.h"
+
+namespace shm {
+namespace {
+bool in_heap(uint64_t addr, uint64_t bytes, uint64_t heap_base, uint64_t heap_size)
+{
+    return addr >= heap_base && bytes <= heap_size && addr - heap_base <= heap_size - bytes;
+}
+
+constexpr uint32_t RMA_BATCH_STAGING_HALVES = 2;
+
+// Descriptors are staged through a pinned host buffer and a device buffer which are reused across batches. The
+// halves are used in turn, so a batch only waits for the one submitted two batches before it.
+struct rma_batch_half {
+    shmemx_rma_desc_t *host_buf = nullptr;
+    void *device_buf = nullptr;
+    size_t capacity = 0;
+    aclrtStream last_stream = nullptr;
+    bool in_flight = false;
+};
+
+struct rma_batch_staging {
+    std::mutex mutex;
+    rma_batch_half halves[RMA_BATCH_STAGING_HALVES];
+    uint32_t current = 0;
+};
+
+rma_batch_staging g_staging;
+
+void staging_release(rma_batch_half &half)
+{
+    if (half.host_buf != nullptr) {
+        aclrtFreeHost(half.host_buf);
+        half.host_buf = nullptr;
+    }
+    if (half.device_buf != nullptr) {
+        aclrtFree(half.device_buf);
+        half.device_buf = nullptr;
+    }
+    half.capacity = 0;
+}
+
+int32_t staging_reserve(rma_batch_half &half, size_t n)
+{
+    if (n <= half.capacity) {
+        return SHMEM_SUCCESS;
+    }
+    size_t capacity = std::max(n, half.capacity * 2);
+    staging_release(half);
+    SHMEM_CHECK_RET(aclrtMallocHost((void **)&half.host_buf, capacity * sizeof(shmemx_rma_desc_t)), aclrtMallocHost);
+    SHMEM_CHECK_RET(aclrtMalloc(&half.device_buf, capacity * sizeof(shmemx_rma_desc_t), ACL_MEM_MALLOC_HUGE_FIRST),
+                    aclrtMalloc);
+    half.capacity = capacity;
+    return SHMEM_SUCCESS;
+}
+}  // namespace
+
+int32_t rma_desc_validate(const shmemx_rma_desc_t &desc, const void *heap_base, uint64_t heap_size, int32_t npes)
+{
+    if (desc.pe < 0 || desc.pe >= npes) {
+        SHM_LOG_ERROR("rma desc pe: " << desc.pe << " out of range, npes: " << npes);
+        return SHMEM_INVALID_VALUE;
+    }
+    if (desc.bytes == 0 || desc.bytes > UINT32_MAX) {
+        SHM_LOG_ERROR("rma desc bytes: " << desc.bytes << " must be in (0, " << UINT32_MAX << "]");
+        return SHMEM_INVALID_VALUE;
+    }
+    if (desc.dst == 0 || desc.src == 0) {
+        SHM_LOG_ERROR("rma desc dst or src is nullptr");
+        return SHMEM_INVALID_PARAM;
+    }
+
+    uint64_t base = reinterpret_cast<uint64_t>(heap_base);
+    switch (desc.op) {
+        case SHMEMX_RMA_PUT:
+            SHM_ASSERT_RETURN(in_heap(desc.dst, desc.bytes, base, heap_size), SHMEM_INVALID_PARAM);
+            break;
+        case SHMEMX_RMA_GET:
+            SHM_ASSERT_RETURN(in_heap(desc.src, desc.bytes, base, heap_size), SHMEM_INVALID_PARAM);
+            break;
+        case SHMEMX_RMA_PUT_SIGNAL:
+            SHM_ASSERT_RETURN(in_heap(desc.dst, desc.bytes, base, heap_size), SHMEM_INVALID_PARAM);
+            SHM_ASSERT_RETURN(in_heap(desc.sig_addr, sizeof(int32_t), base, heap_size), SHMEM_INVALID_PARAM);
+            SHM_ASSERT_RETURN(desc.sig_op == SHMEM_SIGNAL_SET || desc.sig_op == SHMEM_SIGNAL_ADD,
+                              SHMEM_INVALID_VALUE);
+            break;
+        default:
+            SHM_LOG_ERROR("rma desc op: " << desc.op << " is not supported in batch");
+            return SHMEM_INVALID_VALUE;
+    }
+    return SHMEM_SUCCESS;
+}
+
+rma_batch_builder::rma_batch_builder(const void *heap_base, uint64_t heap_size, int32_t npes) noexcept
+    : heap_base_{heap_base}, heap_size_{heap_size}, npes_{npes}
+{
+}
+
+int32_t rma_batch_builder::add(const shmemx_rma_desc_t &desc)
+{
+    SHMEM_CHECK_RET(rma_desc_validate(desc, heap_base_, heap_size_, npes_));
+    descs_.push_back(desc);
+    return SHMEM_SUCCESS;
+}
+
+int32_t rma_batch_builder::add_put(void *dst, const void *src, uint64_t bytes, int32_t pe)
+{
+    shmemx_rma_desc_t desc = {SHMEMX_RMA_PUT, pe, reinterpret_cast<uint64_t>(dst), reinterpret_cast<uint64_t>(src),
+                              bytes, 0, 0, 0};
+    return add(desc);
+}
+
+int32_t rma_batch_builder::add_get(void *dst, const void *src, uint64_t bytes, int32_t pe)
+{
+    shmemx_rma_desc_t desc = {SHMEMX_RMA_GET, pe, reinterpret_cast<uint64_t>(dst), reinterpret_cast<uint64_t>(src),
+                              bytes, 0, 0, 0};
+    return add(desc);
+}
+
+int32_t rma_batch_builder::add_put_signal(void *dst, const void *src, uint64_t bytes, int32_t *sig_addr,
+                                          int32_t signal, int32_t sig_op, int32_t pe)
+{
+    shmemx_rma_desc_t desc = {SHMEMX_RMA_PUT_SIGNAL, pe, reinterpret_cast<uint64_t>(dst),
+                              reinterpret_cast<uint64_t>(src), bytes, reinterpret_cast<uint64_t>(sig_addr), signal,
+                              sig_op};
+    return add(desc);
+}
+
+const shmemx_rma_desc_t *rma_batch_builder::data() const noexcept
+{
+    return descs_.data();
+}
+
+size_t rma_batch_builder::size() const noexcept
+{
+    return descs_.size();
+}
+
+void rma_batch_builder::clear() noexcept
+{
+    descs_.clear();
+}
+
+void rma_batch_finalize()
+{
+    std::lock_guard<std::mutex> lock(g_staging.mutex);
+    for (auto &half : g_staging.halves) {
+        if (half.in_flight) {
+            aclrtSynchronizeStream(half.last_stream);
+            half.in_flight = false;
+        }
+        staging_release(half);
+    }
+    g_staging.current = 0;
+}
+}  // namespace shm
+
+int32_t shmemx_rma_batch(const shmemx_rma_desc_t *desc, size_t n, aclrtStream stream)
+{
+    SHM_ASSERT_RETURN(shm::g_state.is_shmem_initialized, SHMEM_NOT_INITED);
+    if (n == 0) {
+        return SHMEM_SUCCESS;
+    }
+    SHM_ASSERT_RETURN(desc != nullptr, SHMEM_INVALID_PARAM);
+    SHM_ASSERT_RETURN(n <= UINT32_MAX, SHMEM_INVALID_VALUE);
+    for (size_t i = 0; i < n; i++) {
+        auto ret = shm::rma_desc_validate(desc[i], shm::g_state.heap_base, shm::g_state.heap_size, shm::g_state.npes);
+        if (ret != SHMEM_SUCCESS) {
+            SHM_LOG_ERROR("shmemx_rma_batch got invalid descriptor at index " << i);
+            return ret;
+        }
+    }
+    if (shm::loopback_active()) {
+        return shm::loopback_rma_batch(desc, n);
+    }
+    if (stream == nullptr) {
+        stream = shm::g_state_host.default_stream;
+    }
+    // host shmem_p issued before the batch lands first
+    SHMEM_CHECK_RET(shm::p_aggregate_flush(), p_aggregate_flush);
+
+    std::lock_guard<std::mutex> lock(shm::g_staging.mutex);
+    shm::rma_batch_half &half = shm::g_staging.halves[shm::g_staging.current];
+    // this half may still be read by the batch before the previous one
+    if (half.in_flight) {
+        SHMEM_CHECK_RET(aclrtSynchronizeStream(half.last_stream), aclrtSynchronizeStream);
+        half.in_flight = false;
+    }
+    SHMEM_CHECK_RET(shm::staging_reserve(half, n), staging_reserve);
+
+    size_t bytes = n * sizeof(shmemx_rma_desc_t);
+    std::copy_n(desc, n, half.host_buf);
+    SHMEM_CHECK_RET(aclrtMemcpyAsync(half.device_buf, bytes, half.host_buf, bytes, ACL_MEMCPY_HOST_TO_DEVICE, stream),
+                    aclrtMemcpyAsync);
+    size_t block_num = std::min<size_t>(n, shm::RMA_BATCH_MAX_BLOCKS);
+    SHMEM_CHECK_RET(shmemi_rma_batch_on_stream((uint8_t *)half.device_buf, static_cast<uint32_t>(n), stream,
+                                               block_num), shmemi_rma_batch_on_stream);
+    half.last_stream = stream;
+    half.in_flight = true;
+    shm::g_staging.current = (shm::g_staging.current + 1) % shm::RMA_BATCH_STAGING_HALVES;
+    return SHMEM_SUCCESS;
+}
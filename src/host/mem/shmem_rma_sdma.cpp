@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <mutex>
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+
+/*
+    SDMA data path for bulk host nbi put/get.
+
+    The AI core only drives MTE (through UB) and RoCE, so a large intra-host copy issued as a kernel keeps vector
+    cores and UB busy for its whole duration. Host shmem_put/get_mem_nbi of at least SHMEM_SDMA_MIN_BYTES to a PE
+    that hybm reports as SDMA reachable are instead queued as a device to device async copy on a dedicated stream,
+    which the runtime executes on the SDMA engine while the default stream stays free for compute kernels.
+
+    Each copy is ordered after the work already on the default stream by an event, so the source written by an
+    earlier kernel is complete. Nothing waits for the copy when it is posted, so compute kernels launched after it
+    overlap it. The first dependent operation, a later host RMA or host atomic, or a host synchronization point
+    (barrier, handle wait), flushes: its stream waits on a second event behind the last copy. Finalize drains the
+    SDMA stream.
+*/
+
+namespace shm {
+namespace {
+struct sdma_engine {
+    std::mutex mutex;
+    aclrtStream stream = nullptr;
+    aclrtEvent order_event = nullptr;  // default stream -> SDMA stream
+    aclrtEvent done_event = nullptr;   // SDMA stream -> stream of the synchronization point
+    bool pending = false;
+    bool ready = false;
+};
+
+sdma_engine g_sdma;
+
+int32_t sdma_prepare()
+{
+    if (g_sdma.ready) {
+        return SHMEM_SUCCESS;
+    }
+    SHMEM_CHECK_RET(aclrtCreateStream(&g_sdma.stream), aclrtCreateStream);
+    SHMEM_CHECK_RET(aclrtCreateEvent(&g_sdma.order_event), aclrtCreateEvent);
+    SHMEM_CHECK_RET(aclrtCreateEvent(&g_sdma.done_event), aclrtCreateEvent);
+    g_sdma.pending = false;
+    g_sdma.ready = true;
+    return SHMEM_SUCCESS;
+}
+}  // namespace
+
+bool sdma_eligible(const void *sym, uint64_t bytes, int32_t pe)
+{
+    if (g_state_host.sdma_min_bytes == 0 || bytes < g_state_host.sdma_min_bytes) {
+        return false;
+    }
+    if (pe < 0 || pe >= g_state.npes || (g_state.topo_list[pe] & SHMEM_TRANSPORT_SDMA) == 0 ||
+        g_state.sdma_heap_host_base == nullptr || g_state.sdma_heap_host_base[pe] == nullptr) {
+        return false;
+    }
+    uint64_t base = reinterpret_cast<uint64_t>(g_state.heap_base);
+    uint64_t addr = reinterpret_cast<uint64_t>(sym);
+    return addr >= base && bytes <= g_state.heap_size && addr - base <= g_state.heap_size - bytes;
+}
+
+int32_t sdma_post(bool is_put, void *sym, void *local, uint64_t bytes, int32_t pe)
+{
+    SHM_ASSERT_RETURN(g_state.is_shmem_initialized, SHMEM_NOT_INITED);
+    SHM_ASSERT_RETURN(sdma_eligible(sym, bytes, pe), SHMEM_INVALID_PARAM);
+    std::lock_guard<std::mutex> lock(g_sdma.mutex);
+    SHMEM_CHECK_RET(sdma_prepare(), sdma_prepare);
+
+    uint64_t offset = reinterpret_cast<uint64_t>(sym) - reinterpret_cast<uint64_t>(g_state.heap_base);
+    void *remote = reinterpret_cast<uint8_t *>(g_state.sdma_heap_host_base[pe]) + offset;
+    aclrtStream stream = g_state_host.default_stream;
+    SHMEM_CHECK_RET(aclrtRecordEvent(g_sdma.order_event, stream), aclrtRecordEvent);
+    SHMEM_CHECK_RET(aclrtStreamWaitEvent(g_sdma.stream, g_sdma.order_event), aclrtStreamWaitEvent);
+    SHMEM_CHECK_RET(aclrtResetEvent(g_sdma.order_event, g_sdma.stream), aclrtResetEvent);
+    if (is_put) {
+        SHMEM_CHECK_RET(aclrtMemcpyAsync(remote, bytes, local, bytes, ACL_MEMCPY_DEVICE_TO_DEVICE, g_sdma.stream),
+                        aclrtMemcpyAsync);
+    } else {
+        SHMEM_CHECK_RET(aclrtMemcpyAsync(local, bytes, remote, bytes, ACL_MEMCPY_DEVICE_TO_DEVICE, g_sdma.stream),
+                        aclrtMemcpyAsync);
+    }
+    // no wait back on the default stream here, compute kernels keep overlapping the copy until sdma_flush
+    g_sdma.pending = true;
+    return SHMEM_SUCCESS;
+}
+
+int32_t sdma_flush(void *stream)
+{
+    std::lock_guard<std::mutex> lock(g_sdma.mutex);
+    if (!g_sdma.ready || !g_sdma.pending) {
+        return SHMEM_SUCCESS;
+    }
+    aclrtStream target = static_cast<aclrtStream>(stream);
+    SHMEM_CHECK_RET(aclrtRecordEvent(g_sdma.done_event, g_sdma.stream), aclrtRecordEvent);
+    SHMEM_CHECK_RET(aclrtStreamWaitEvent(target, g_sdma.done_event), aclrtStreamWaitEvent);
+    SHMEM_CHECK_RET(aclrtResetEvent(g_sdma.done_event, target), aclrtResetEvent);
+    g_sdma.pending = false;
+    return SHMEM_SUCCESS;
+}
+
+void sdma_finalize()
+{
+    std::lock_guard<std::mutex> lock(g_sdma.mutex);
+    if (!g_sdma.ready) {
+        return;
+    }
+    if (aclrtSynchronizeStream(g_sdma.stream) != 0) {
+        SHM_LOG_ERROR("wait pending SDMA copies failed in finalize");
+    }
+    aclrtDestroyEvent(g_sdma.order_event);
+    aclrtDestroyEvent(g_sdma.done_event);
+    aclrtDestroyStream(g_sdma.stream);
+    g_sdma.order_event = nullptr;
+    g_sdma.done_event = nullptr;
+    g_sdma.stream = nullptr;
+    g_sdma.pending = false;
+    g_sdma.ready = false;
+}
+}  // namespace shm
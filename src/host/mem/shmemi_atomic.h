@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_ATOMIC_H
+#define SHMEMI_ATOMIC_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace shm {
+void atomic_finalize();
+
+/**
+ * CPU reference of the fetching atomics on one symmetric word per PE. Operations follow the same semantics as
+ * shmem_<type>_atomic_fetch_add / compare_swap / swap / fetch, so tests can replay a sequence and compare.
+ */
+template <typename T>
+class atomic_reference {
+public:
+    explicit atomic_reference(int32_t npes, T init = 0) : words_(static_cast<size_t>(npes))
+    {
+        for (auto &word : words_) {
+            word.store(init);
+        }
+    }
+
+    T fetch_add(int32_t pe, T value)
+    {
+        return words_[pe].fetch_add(value);
+    }
+
+    T compare_swap(int32_t pe, T cond, T value)
+    {
+        words_[pe].compare_exchange_strong(cond, value);
+        return cond;
+    }
+
+    T swap(int32_t pe, T value)
+    {
+        return words_[pe].exchange(value);
+    }
+
+    T fetch(int32_t pe) const
+    {
+        return words_[pe].load();
+    }
+
+private:
+    std::vector<std::atomic<T>> words_;
+};
+}  // namespace shm
+
+#endif  // SHMEMI_ATOMIC_H
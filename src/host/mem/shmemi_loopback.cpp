@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "shmemi_loopback.h"
+
+/*
+    Shared memory loopback domain, the data plane of the host emulation backend.
+
+    Region layout, every part starting on its own boundary:
+        header      magic and geometry written by PE 0, barrier arrival count and futex generation word
+        gather      one LOOPBACK_GATHER_SLOT per PE, staging area of allgather
+        heaps       npes heaps of heap_size bytes, PE i at heaps + i * heap_size
+
+    The barrier counts arrivals, the last PE to arrive resets the count and bumps the generation, everyone else
+    spins briefly and then sleeps on the generation with FUTEX_WAIT. The futex is not private, so it is keyed by
+    the shared object and works between processes as well as between threads that mapped the object separately.
+    The atomic increment of the count is a full barrier, so stores issued before a barrier are
+    visible to every PE after it.
+*/
+
+namespace shm {
+struct loopback_header {
+    uint64_t magic;
+    uint64_t heap_size;
+    int32_t npes;
+    alignas(64) uint32_t arrived;
+    alignas(64) uint32_t generation;
+};
+
+namespace {
+constexpr uint64_t LOOPBACK_MAGIC = 0x42504f4f4c4d4853ULL;  // "SHMLOOPB" in memory order
+constexpr uint64_t LOOPBACK_CACHELINE = 64;
+constexpr uint64_t LOOPBACK_PAGE = 4096;
+constexpr uint32_t LOOPBACK_GATHER_SLOT = 256;
+constexpr uint32_t LOOPBACK_SPIN = 256;
+constexpr int64_t LOOPBACK_ATTACH_POLL_MS = 1;
+constexpr int64_t LOOPBACK_FUTEX_SLICE_NS = 10 * 1000 * 1000;
+
+uint64_t align_up(uint64_t value, uint64_t align)
+{
+    return (value + align - 1) / align * align;
+}
+
+uint64_t gather_offset()
+{
+    return align_up(sizeof(loopback_header), LOOPBACK_CACHELINE);
+}
+
+uint64_t heaps_offset(int32_t npes)
+{
+    return align_up(gather_offset() + static_cast<uint64_t>(npes) * LOOPBACK_GATHER_SLOT, LOOPBACK_PAGE);
+}
+
+long futex(uint32_t *word, int op, uint32_t value, const struct timespec *timeout)
+{
+    return syscall(SYS_futex, word, op, value, timeout, nullptr, 0);
+}
+}  // namespace
+
+loopback_domain::~loopback_domain()
+{
+    detach();
+}
+
+int32_t loopback_domain::map(int fd, uint64_t total)
+{
+    void *base = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        return SHMEM_INNER_ERROR;
+    }
+    map_size_ = total;
+    hdr_ = static_cast<loopback_header *>(base);
+    gather_ = static_cast<uint8_t *>(base) + gather_offset();
+    heaps_ = static_cast<uint8_t *>(base) + heaps_offset(npes_);
+    return SHMEM_SUCCESS;
+}
+
+int32_t loopback_domain::attach(const std::string &name, int32_t my_pe, int32_t npes, uint64_t heap_size,
+                                uint64_t timeout_ms)
+{
+    if (attached() || name.size() < 2 || name[0] != '/' || name.find('/', 1) != std::string::npos || npes <= 0 ||
+        my_pe < 0 || my_pe >= npes || heap_size == 0) {
+        return SHMEM_INVALID_PARAM;
+    }
+    my_pe_ = my_pe;
+    npes_ = npes;
+    heap_size_ = align_up(heap_size, LOOPBACK_PAGE);
+    timeout_ms_ = timeout_ms;
+    uint64_t total = heaps_offset(npes) + static_cast<uint64_t>(npes) * heap_size_;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+    if (my_pe == 0) {
+        // a leftover of an aborted run would otherwise be attached by the other PEs
+        shm_unlink(name.c_str());
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+        if (fd < 0) {
+            detach();
+            return SHMEM_INNER_ERROR;
+        }
+        int32_t ret = ftruncate(fd, static_cast<off_t>(total)) == 0 ? map(fd, total) : SHMEM_INNER_ERROR;
+        close(fd);
+        if (ret != SHMEM_SUCCESS) {
+            shm_unlink(name.c_str());
+            detach();
+            return ret;
+        }
+        hdr_->heap_size = heap_size_;
+        hdr_->npes = npes;
+        __atomic_store_n(&hdr_->magic, LOOPBACK_MAGIC, __ATOMIC_RELEASE);
+    } else {
+        while (!attached()) {
+            int fd = shm_open(name.c_str(), O_RDWR, 0);
+            if (fd >= 0) {
+                struct stat st {};
+                // PE 0 may still be between shm_open and ftruncate
+                if (fstat(fd, &st) == 0 && static_cast<uint64_t>(st.st_size) == total) {
+                    map(fd, total);
+                }
+                close(fd);
+            }
+            if (attached() && __atomic_load_n(&hdr_->magic, __ATOMIC_ACQUIRE) != LOOPBACK_MAGIC) {
+                munmap(hdr_, map_size_);
+                hdr_ = nullptr;
+            }
+            if (attached()) {
+                break;
+            }
+            if (std::chrono::steady_clock::now() > deadline) {
+                detach();
+                return SHMEM_INNER_ERROR;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(LOOPBACK_ATTACH_POLL_MS));
+        }
+        if (hdr_->npes != npes || hdr_->heap_size != heap_size_) {
+            detach();
+            return SHMEM_INVALID_PARAM;
+        }
+    }
+
+    int32_t ret = barrier();
+    if (my_pe == 0) {
+        shm_unlink(name.c_str());
+    }
+    if (ret != SHMEM_SUCCESS) {
+        detach();
+    }
+    return ret;
+}
+
+void loopback_domain::detach()
+{
+    if (hdr_ != nullptr) {
+        munmap(hdr_, map_size_);
+    }
+    hdr_ = nullptr;
+    heaps_ = nullptr;
+    gather_ = nullptr;
+    map_size_ = 0;
+    heap_size_ = 0;
+    my_pe_ = -1;
+    npes_ = 0;
+}
+
+void *loopback_domain::ptr(const void *sym, int32_t pe, uint64_t bytes) const
+{
+    if (!attached() || pe < 0 || pe >= npes_) {
+        return nullptr;
+    }
+    uintptr_t base = reinterpret_cast<uintptr_t>(heap(my_pe_));
+    uintptr_t addr = reinterpret_cast<uintptr_t>(sym);
+    if (addr < base || addr - base >= heap_size_ || bytes > heap_size_ - (addr - base)) {
+        return nullptr;
+    }
+    return heap(pe) + (addr - base);
+}
+
+int32_t loopback_domain::put(void *dst, const void *src, uint64_t bytes, int32_t pe)
+{
+    if (bytes == 0) {
+        return SHMEM_SUCCESS;
+    }
+    void *remote = ptr(dst, pe, bytes);
+    if (remote == nullptr || src == nullptr) {
+        return SHMEM_INVALID_PARAM;
+    }
+    std::memmove(remote, src, bytes);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    return SHMEM_SUCCESS;
+}
+
+int32_t loopback_domain::get(void *dst, const void *src, uint64_t bytes, int32_t pe)
+{
+    if (bytes == 0) {
+        return SHMEM_SUCCESS;
+    }
+    const void *remote = ptr(src, pe, bytes);
+    if (remote == nullptr || dst == nullptr) {
+        return SHMEM_INVALID_PARAM;
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    std::memmove(dst, remote, bytes);
+    return SHMEM_SUCCESS;
+}
+
+int32_t loopback_domain::wait_generation(uint32_t seen)
+{
+    for (uint32_t i = 0; i < LOOPBACK_SPIN; i++) {
+        if (__atomic_load_n(&hdr_->generation, __ATOMIC_ACQUIRE) != seen) {
+            return SHMEM_SUCCESS;
+        }
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms_);
+    while (__atomic_load_n(&hdr_->generation, __ATOMIC_ACQUIRE) == seen) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return SHMEM_INNER_ERROR;
+        }
+        // returns at once when the generation moved on after the load above
+        struct timespec slice = {0, LOOPBACK_FUTEX_SLICE_NS};
+        futex(&hdr_->generation, FUTEX_WAIT, seen, &slice);
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t loopback_domain::barrier()
+{
+    if (!attached()) {
+        return SHMEM_NOT_INITED;
+    }
+    // sampled before arriving, the generation cannot move on until this PE has arrived
+    uint32_t seen = __atomic_load_n(&hdr_->generation, __ATOMIC_ACQUIRE);
+    if (__atomic_add_fetch(&hdr_->arrived, 1, __ATOMIC_ACQ_REL) == static_cast<uint32_t>(npes_)) {
+        __atomic_store_n(&hdr_->arrived, 0, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&hdr_->generation, 1, __ATOMIC_RELEASE);
+        futex(&hdr_->generation, FUTEX_WAKE, INT_MAX, nullptr);
+        return SHMEM_SUCCESS;
+    }
+    return wait_generation(seen);
+}
+
+int32_t loopback_domain::allgather(const void *send, uint32_t size, void *recv)
+{
+    if (!attached()) {
+        return SHMEM_NOT_INITED;
+    }
+    if (size != 0 && (send == nullptr || recv == nullptr)) {
+        return SHMEM_INVALID_PARAM;
+    }
+    const uint8_t *src = static_cast<const uint8_t *>(send);
+    uint8_t *dst = static_cast<uint8_t *>(recv);
+    for (uint32_t done = 0; done < size; done += LOOPBACK_GATHER_SLOT) {
+        uint32_t chunk = std::min(size - done, LOOPBACK_GATHER_SLOT);
+        std::memcpy(gather_ + static_cast<uint64_t>(my_pe_) * LOOPBACK_GATHER_SLOT, src + done, chunk);
+        int32_t ret = barrier();
+        if (ret != SHMEM_SUCCESS) {
+            return ret;
+        }
+        for (int32_t pe = 0; pe < npes_; pe++) {
+            std::memcpy(dst + static_cast<uint64_t>(pe) * size + done,
+                        gather_ + static_cast<uint64_t>(pe) * LOOPBACK_GATHER_SLOT, chunk);
+        }
+        // nobody refills its slot before every PE has read the chunk
+        ret = barrier();
+        if (ret != SHMEM_SUCCESS) {
+            return ret;
+        }
+    }
+    return SHMEM_SUCCESS;
+}
+}  // namespace shm
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_LOOPBACK_H
+#define SHMEMI_LOOPBACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "host/shmem_host_def.h"
+
+namespace shm {
+struct loopback_header;
+
+/**
+ * One PE of a loopback domain: npes PEs, threads or processes of one host, map the same POSIX shared memory object
+ * named name. After a header page it holds the npes heaps back to back, so a symmetric address is translated by its
+ * offset into the calling PE heap. PE 0 creates the object and unlinks it once every PE has attached, the others
+ * wait up to timeout_ms for it to appear. Transfers are plain copies, atomics are CPU atomics on the mapped word,
+ * barriers count arrivals and sleep on a process shared futex. Every PE of a domain uses its own instance.
+ */
+class loopback_domain {
+public:
+    loopback_domain() = default;
+    ~loopback_domain();
+
+    loopback_domain(const loopback_domain &) = delete;
+    loopback_domain &operator=(const loopback_domain &) = delete;
+
+    int32_t attach(const std::string &name, int32_t my_pe, int32_t npes, uint64_t heap_size, uint64_t timeout_ms);
+    void detach();
+
+    bool attached() const
+    {
+        return hdr_ != nullptr;
+    }
+
+    int32_t my_pe() const
+    {
+        return my_pe_;
+    }
+
+    int32_t npes() const
+    {
+        return npes_;
+    }
+
+    uint64_t heap_size() const
+    {
+        return heap_size_;
+    }
+
+    uint8_t *heap(int32_t pe) const
+    {
+        return heaps_ + static_cast<uint64_t>(pe) * heap_size_;
+    }
+
+    // Address of bytes at symmetric address sym on pe, nullptr when pe or the range is outside the domain
+    void *ptr(const void *sym, int32_t pe, uint64_t bytes = 1) const;
+
+    // dst on pe receives bytes from the private or symmetric src of the calling PE
+    int32_t put(void *dst, const void *src, uint64_t bytes, int32_t pe);
+    // dst of the calling PE receives bytes from src on pe
+    int32_t get(void *dst, const void *src, uint64_t bytes, int32_t pe);
+
+    // Every PE of the domain has arrived, all transfers issued before it are visible after it
+    int32_t barrier();
+
+    // recv receives size bytes from every PE, ordered by PE
+    int32_t allgather(const void *send, uint32_t size, void *recv);
+
+    template <typename T>
+    int32_t fetch_add(T *dst, T value, int32_t pe, T *old)
+    {
+        T *word = word_ptr(dst, pe);
+        if (word == nullptr) {
+            return SHMEM_INVALID_PARAM;
+        }
+        *old = __atomic_fetch_add(word, value, __ATOMIC_SEQ_CST);
+        return SHMEM_SUCCESS;
+    }
+
+    template <typename T>
+    int32_t compare_swap(T *dst, T cond, T value, int32_t pe, T *old)
+    {
+        T *word = word_ptr(dst, pe);
+        if (word == nullptr) {
+            return SHMEM_INVALID_PARAM;
+        }
+        __atomic_compare_exchange_n(word, &cond, value, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        *old = cond;
+        return SHMEM_SUCCESS;
+    }
+
+    template <typename T>
+    int32_t swap(T *dst, T value, int32_t pe, T *old)
+    {
+        T *word = word_ptr(dst, pe);
+        if (word == nullptr) {
+            return SHMEM_INVALID_PARAM;
+        }
+        *old = __atomic_exchange_n(word, value, __ATOMIC_SEQ_CST);
+        return SHMEM_SUCCESS;
+    }
+
+    template <typename T>
+    int32_t fetch(T *dst, int32_t pe, T *old)
+    {
+        T *word = word_ptr(dst, pe);
+        if (word == nullptr) {
+            return SHMEM_INVALID_PARAM;
+        }
+        *old = __atomic_load_n(word, __ATOMIC_SEQ_CST);
+        return SHMEM_SUCCESS;
+    }
+
+    // Non fetching add, floating point words are updated with a compare and swap loop
+    template <typename T>
+    int32_t add(T *dst, T value, int32_t pe)
+    {
+        T *word = word_ptr(dst, pe);
+        if (word == nullptr) {
+            return SHMEM_INVALID_PARAM;
+        }
+        if constexpr (std::is_integral<T>::value) {
+            __atomic_fetch_add(word, value, __ATOMIC_SEQ_CST);
+        } else {
+            T expected;
+            T desired;
+            __atomic_load(word, &expected, __ATOMIC_RELAXED);
+            do {
+                desired = expected + value;
+            } while (!__atomic_compare_exchange(word, &expected, &desired, false, __ATOMIC_SEQ_CST,
+                                                __ATOMIC_RELAXED));
+        }
+        return SHMEM_SUCCESS;
+    }
+
+private:
+    template <typename T>
+    T *word_ptr(T *sym, int32_t pe) const
+    {
+        T *word = static_cast<T *>(ptr(sym, pe, sizeof(T)));
+        if (word == nullptr || reinterpret_cast<uintptr_t>(word) % sizeof(T) != 0) {
+            return nullptr;
+        }
+        return word;
+    }
+
+    int32_t map(int fd, uint64_t total);
+    int32_t wait_generation(uint32_t seen);
+
+    loopback_header *hdr_ = nullptr;
+    uint8_t *heaps_ = nullptr;
+    uint8_t *gather_ = nullptr;
+    uint64_t map_size_ = 0;
+    uint64_t heap_size_ = 0;
+    uint64_t timeout_ms_ = 0;
+    int32_t my_pe_ = -1;
+    int32_t npes_ = 0;
+};
+
+// Whether shmem_init_attr selected the loopback backend, see SHMEM_DATA_OP_HOST
+bool loopback_active();
+
+int32_t loopback_init(shmem_init_attr_t *attributes);
+void loopback_finalize();
+loopback_domain &loopback();
+
+// Host RMA of the loopback backend, arguments as shmemi_prepare_and_post_rma_2d plus the put-signal fields
+int32_t loopback_rma(shmemi_op_t desc, uint8_t *lptr, uint8_t *rptr, size_t n_rows, size_t row_elems,
+                     size_t elem_bytes, int32_t pe, ptrdiff_t lstride, ptrdiff_t rstride, uint8_t *sig_addr,
+                     int32_t signal, int32_t sig_op);
+
+// Run already validated descriptors in order, see shmemx_rma_batch
+int32_t loopback_rma_batch(const shmemx_rma_desc_t *desc, size_t n);
+}  // namespace shm
+
+#endif  // SHMEMI_LOOPBACK_H
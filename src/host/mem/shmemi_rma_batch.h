@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_RMA_BATCH_H
+#define SHMEMI_RMA_BATCH_H
+
+#include <cstdint>
+#include <vector>
+#include "host_device/shmem_types.h"
+
+namespace shm {
+// Upper bound of blocks used by one shmemx_rma_batch launch, one AI core per block on dav-c220.
+constexpr uint32_t RMA_BATCH_MAX_BLOCKS = 24;
+
+/**
+ * Check one descriptor against the symmetric heap [heap_base, heap_base + heap_size) and the number of PEs.
+ * Pure host logic, does not touch the device.
+ */
+int32_t rma_desc_validate(const shmemx_rma_desc_t &desc, const void *heap_base, uint64_t heap_size, int32_t npes);
+
+class rma_batch_builder {
+public:
+    rma_batch_builder(const void *heap_base, uint64_t heap_size, int32_t npes) noexcept;
+
+public:
+    int32_t add(const shmemx_rma_desc_t &desc);
+    int32_t add_put(void *dst, const void *src, uint64_t bytes, int32_t pe);
+    int32_t add_get(void *dst, const void *src, uint64_t bytes, int32_t pe);
+    int32_t add_put_signal(void *dst, const void *src, uint64_t bytes, int32_t *sig_addr, int32_t signal,
+                           int32_t sig_op, int32_t pe);
+
+    const shmemx_rma_desc_t *data() const noexcept;
+    size_t size() const noexcept;
+    void clear() noexcept;
+
+private:
+    const void *heap_base_;
+    const uint64_t heap_size_;
+    const int32_t npes_;
+    std::vector<shmemx_rma_desc_t> descs_;
+};
+
+void rma_batch_finalize();
+
+// Number of host shmem_p calls aggregated into one launch.
+constexpr uint32_t P_AGG_RING_SLOTS = 1024;
+
+int32_t p_aggregate_append(void *dst, const void *value, uint32_t bytes, int32_t pe);
+int32_t p_aggregate_flush();
+int32_t p_aggregate_gather(void *values, void *const *srcs, const int32_t *pes, size_t n, uint32_t bytes);
+void p_aggregate_finalize();
+}  // namespace shm
+
+#endif  // SHMEMI_RMA_BATCH_H
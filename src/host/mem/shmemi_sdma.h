@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_SDMA_H
+#define SHMEMI_SDMA_H
+
+#include <cstdint>
+
+namespace shm {
+/**
+ * Whether a host nbi transfer of bytes at symmetric address sym on pe is handed to the SDMA engine: the peer is
+ * SDMA reachable, the range lies inside the symmetric heap and bytes reaches SHMEM_SDMA_MIN_BYTES.
+ */
+bool sdma_eligible(const void *sym, uint64_t bytes, int32_t pe);
+
+// Queue one copy between the symmetric range sym on pe and local on the SDMA stream. The copy starts after the work
+// already on the default stream, later work waits for it only once sdma_flush is called on its stream.
+int32_t sdma_post(bool is_put, void *sym, void *local, uint64_t bytes, int32_t pe);
+
+// Make stream wait for every SDMA copy posted so far, nullptr is the ACL default stream.
+int32_t sdma_flush(void *stream);
+
+void sdma_finalize();
+}  // namespace shm
+
+#endif  // SHMEMI_SDMA_H
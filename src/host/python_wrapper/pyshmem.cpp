@@ -191,7 +191,8 @@ void DefineShmemAttr(py::module_ &m)
     py::enum_<data_op_engine_type_t>(m, "OpEngineType")
         .value("MTE", SHMEM_DATA_OP_MTE)
         .value("SDMA", SHMEM_DATA_OP_SDMA)
-        .value("ROCE", SHMEM_DATA_OP_ROCE);
+        .value("ROCE", SHMEM_DATA_OP_ROCE)
+        .value("HOST", SHMEM_DATA_OP_HOST);
 
     py::class_<shmem_init_optional_attr_t>(m, "OptionalAttr")
         .def(py::init([]() {
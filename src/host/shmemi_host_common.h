@@ -13,9 +13,14 @@
 #include "shmem_api.h"
 
 #include "common/shmemi_logger.h"
+#include "common/shmemi_trace.h"
 #include "init/shmemi_init.h"
 #include "team/shmemi_team.h"
 #include "mem/shmemi_mm.h"
+#include "mem/shmemi_rma_batch.h"
+#include "mem/shmemi_sdma.h"
+#include "mem/shmemi_loopback.h"
+#include "mem/shmemi_atomic.h"
 #include "sync/shmemi_sync.h"
 
 // smem api
@@ -13,6 +13,7 @@
 #include <string.h>
 #include <vector>
 #include <iostream>
+#include <algorithm>
 
 #include "acl/acl.h"
 #include "shmemi_host_common.h"
@@ -29,6 +30,114 @@ int32_t shmemi_sync_init()
     return rtGetC2cCtrlAddr(&ffts_config, &len);
 }
 
+int32_t shmemi_wait_diag_init()
+{
+    void *ring = nullptr;
+    SHMEM_CHECK_RET(aclrtMalloc(&ring, SHMEM_WAIT_DIAG_RING_SIZE, ACL_MEM_MALLOC_HUGE_FIRST), aclrtMalloc);
+    auto ret = aclrtMemset(ring, SHMEM_WAIT_DIAG_RING_SIZE, 0, SHMEM_WAIT_DIAG_RING_SIZE);
+    if (ret != 0) {
+        aclrtFree(ring);
+        SHM_LOG_ERROR("memset wait diagnostic ring failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    g_state.wait_diag_ring = reinterpret_cast<uint64_t>(ring);
+    return SHMEM_SUCCESS;
+}
+
+void shmemi_wait_diag_finalize()
+{
+    if (g_state.wait_diag_ring != 0) {
+        aclrtFree(reinterpret_cast<void *>(g_state.wait_diag_ring));
+        g_state.wait_diag_ring = 0;
+    }
+}
+
+int32_t shmemi_roce_signal_init()
+{
+    // the NIC reads the signal value through the heap memory region, so the slots live in the symmetric heap
+    void *pool = shmem_malloc(SHMEM_ROCE_SIGNAL_POOL_SIZE);
+    if (pool == nullptr) {
+        SHM_LOG_ERROR("malloc roce signal pool failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    auto ret = aclrtMemset(pool, SHMEM_ROCE_SIGNAL_POOL_SIZE, 0, SHMEM_ROCE_SIGNAL_POOL_SIZE);
+    if (ret != 0) {
+        shmem_free(pool);
+        SHM_LOG_ERROR("memset roce signal pool failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    g_state.roce_signal_pool = reinterpret_cast<uint64_t>(pool);
+    return SHMEM_SUCCESS;
+}
+
+void shmemi_roce_signal_finalize()
+{
+    if (g_state.roce_signal_pool != 0) {
+        shmem_free(reinterpret_cast<void *>(g_state.roce_signal_pool));
+        g_state.roce_signal_pool = 0;
+    }
+}
+
+uint64_t wait_diag_decode(const uint8_t *ring, std::vector<shmemx_wait_diag_record_t> &records)
+{
+    static_assert(sizeof(shmemx_wait_diag_record_t) == SHMEM_WAIT_DIAG_RECORD_SIZE, "wait diag record layout");
+    records.clear();
+    uint64_t head;
+    memcpy(&head, ring, sizeof(head));
+    uint64_t kept = head < SHMEM_WAIT_DIAG_RING_ENTRIES ? head : SHMEM_WAIT_DIAG_RING_ENTRIES;
+    const uint8_t *base = ring + SHMEM_WAIT_DIAG_HEAD_SIZE;
+    for (uint64_t i = head - kept; i < head; i++) {
+        shmemx_wait_diag_record_t rec;
+        memcpy(&rec, base + (i % SHMEM_WAIT_DIAG_RING_ENTRIES) * SHMEM_WAIT_DIAG_RECORD_SIZE, sizeof(rec));
+        // the slot is claimed before it is written, skip records still in flight
+        if (rec.timestamp == 0) {
+            continue;
+        }
+        records.push_back(rec);
+    }
+    return head - kept;
+}
+
+static int32_t wait_diag_read(std::vector<shmemx_wait_diag_record_t> &records, uint64_t &lost)
+{
+    if (!g_state.is_shmem_initialized || g_state.wait_diag_ring == 0) {
+        SHM_LOG_ERROR("shmem not initialized, no wait diagnostic ring");
+        return SHMEM_NOT_INITED;
+    }
+    std::vector<uint8_t> image(SHMEM_WAIT_DIAG_RING_SIZE);
+    // synchronous copy, not ordered behind kernels that may be stuck in a wait
+    SHMEM_CHECK_RET(aclrtMemcpy(image.data(), image.size(), reinterpret_cast<void *>(g_state.wait_diag_ring),
+        SHMEM_WAIT_DIAG_RING_SIZE, ACL_MEMCPY_DEVICE_TO_HOST), aclrtMemcpy);
+    lost = wait_diag_decode(image.data(), records);
+    return SHMEM_SUCCESS;
+}
+
+// Aggregated host shmem_p calls and SDMA nbi copies have to be complete before any synchronization point.
+static void shmemi_flush_host_p(aclrtStream stream)
+{
+    if (p_aggregate_flush() != SHMEM_SUCCESS) {
+        SHM_LOG_ERROR("flush aggregated shmem_p failed");
+    }
+    if (sdma_flush(stream) != SHMEM_SUCCESS) {
+        SHM_LOG_ERROR("flush SDMA nbi copies failed");
+    }
+}
+
+// Loopback backend: every transfer is already complete, the world barrier runs on the shared memory domain. No
+// other team can be split off with this backend, so any other tid is rejected rather than treated as synchronized.
+static int32_t shmemi_loopback_barrier(shmem_team_t tid)
+{
+    if (tid != SHMEM_TEAM_WORLD) {
+        SHM_LOG_ERROR("barrier on team " << tid << " is not supported by the loopback backend");
+        return SHMEM_INVALID_PARAM;
+    }
+    auto ret = loopback().barrier();
+    if (ret != SHMEM_SUCCESS) {
+        SHM_LOG_ERROR("loopback barrier failed, ret: " << ret);
+    }
+    return ret;
+}
+
 } // namespace
 
 uint64_t shmemx_get_ffts_config()
@@ -38,6 +147,11 @@ uint64_t shmemx_get_ffts_config()
 
 void shmem_barrier(shmem_team_t tid)
 {
+    if (shm::loopback_active()) {
+        shm::shmemi_loopback_barrier(tid);
+        return;
+    }
+    shm::shmemi_flush_host_p(nullptr);
     // using default stream to do barrier
     shmemi_barrier_on_stream(tid, nullptr);
 }
@@ -49,15 +163,79 @@ void shmem_barrier_all()
 
 void shmemx_barrier_on_stream(shmem_team_t tid, aclrtStream stream)
 {
+    if (shm::loopback_active()) {
+        shm::shmemi_loopback_barrier(tid);
+        return;
+    }
+    shm::shmemi_flush_host_p(stream);
     shmemi_barrier_on_stream(tid, stream);
 }
 
 void shmemx_barrier_all_on_stream(aclrtStream stream)
 {
+    if (shm::loopback_active()) {
+        shm::shmemi_loopback_barrier(SHMEM_TEAM_WORLD);
+        return;
+    }
+    shm::shmemi_flush_host_p(stream);
     shmemi_barrier_on_stream(SHMEM_TEAM_WORLD, stream);
 }
 
+int32_t shmemx_set_wait_timeout(uint64_t timeout_us)
+{
+    if (!shm::g_state.is_shmem_initialized) {
+        SHM_LOG_ERROR("shmem not initialized");
+        return SHMEM_NOT_INITED;
+    }
+    if (timeout_us > SHMEM_MAX_WAIT_TIMEOUT_US) {
+        SHM_LOG_ERROR("wait timeout " << timeout_us << "us exceeds the maximum " << SHMEM_MAX_WAIT_TIMEOUT_US << "us");
+        return SHMEM_INVALID_VALUE;
+    }
+    shm::g_state.wait_timeout_cycles = static_cast<int64_t>(timeout_us * SHMEM_SYS_CYCLES_PER_US);
+    return shm::update_device_state();
+}
+
+int32_t shmemx_wait_diag_fetch(shmemx_wait_diag_record_t *records, uint32_t max_records, uint32_t *count)
+{
+    SHM_ASSERT_RETURN(count != nullptr, SHMEM_INVALID_PARAM);
+    SHM_ASSERT_RETURN(records != nullptr || max_records == 0, SHMEM_INVALID_PARAM);
+    std::vector<shmemx_wait_diag_record_t> all;
+    uint64_t lost = 0;
+    SHMEM_CHECK_RET(shm::wait_diag_read(all, lost));
+    // keep the newest records when the caller buffer is smaller than the ring
+    size_t n = all.size() < max_records ? all.size() : max_records;
+    std::copy(all.end() - n, all.end(), records);
+    *count = static_cast<uint32_t>(n);
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemx_wait_diag_dump()
+{
+    std::vector<shmemx_wait_diag_record_t> records;
+    uint64_t lost = 0;
+    SHMEM_CHECK_RET(shm::wait_diag_read(records, lost));
+    if (lost != 0) {
+        SHM_LOG_ERROR("wait diagnostics: " << lost << " older records overwritten");
+    }
+    for (const auto &rec : records) {
+        if (rec.cmp < 0) {
+            SHM_LOG_ERROR("device error " << rec.cmp << ": pe " << rec.mype << " core " << rec.core << " target pe "
+                << rec.pe << " observed " << rec.observed << " addr 0x" << std::hex << rec.addr << std::dec);
+            continue;
+        }
+        SHM_LOG_ERROR("wait timeout: pe " << rec.mype << " core " << rec.core << " team " << rec.team
+            << " round " << rec.round << " awaited pe " << rec.pe << " cmp " << rec.cmp << " observed "
+            << rec.observed << " expected " << rec.expected << " addr 0x" << std::hex << rec.addr << std::dec
+            << " elapsed " << rec.elapsed / SHMEM_SYS_CYCLES_PER_US << "us");
+    }
+    return static_cast<int32_t>(records.size());
+}
+
 void shmem_handle_wait(shmem_handle_t handle, aclrtStream stream)
 {
+    if (shm::loopback_active()) {
+        return;
+    }
+    shm::shmemi_flush_host_p(stream);
     shmemi_handle_wait_on_stream(handle, stream);
 }
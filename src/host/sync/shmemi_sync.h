@@ -10,10 +10,42 @@
 #ifndef SHMEMI_SYNC_H
 #define SHMEMI_SYNC_H
 
+#include <vector>
+
+#include "host_device/shmem_types.h"
+#include "internal/host_device/shmemi_types.h"
+
 namespace shm {
 
 int32_t shmemi_sync_init();
 
+int32_t shmemi_wait_diag_init();
+void shmemi_wait_diag_finalize();
+
+int32_t shmemi_roce_signal_init();
+void shmemi_roce_signal_finalize();
+
+// Decode a raw wait diagnostic ring image of SHMEM_WAIT_DIAG_RING_SIZE bytes, oldest surviving record first.
+// Returns the number of records lost to wrap-around.
+uint64_t wait_diag_decode(const uint8_t *ring, std::vector<shmemx_wait_diag_record_t> &records);
+
+int32_t shmemi_watchdog_init();
+void shmemi_watchdog_finalize();
+
+// Host view of one core between two samples of the watchdog region.
+struct watchdog_core_state {
+    uint64_t progress = 0;
+    uint64_t since_ms = 0;     // host time the progress counter last changed
+    bool reported = false;
+};
+
+// Compare a raw watchdog region image of SHMEM_WATCHDOG_REGION_SIZE bytes against the previous sample in cores.
+// Appends the records of cores that sit at a sync site without progress for stall_ms, once per stall.
+void watchdog_scan(const uint8_t *region, uint64_t now_ms, uint64_t stall_ms, std::vector<watchdog_core_state> &cores,
+                   std::vector<shmemi_watchdog_record_t> &stalled);
+
+const char *watchdog_site_name(int32_t site);
+
 }
 
 #endif  // SHMEMI_TEAM_H
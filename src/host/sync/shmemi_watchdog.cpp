@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+
+namespace shm {
+namespace {
+constexpr uint64_t WATCHDOG_MIN_PERIOD_MS = 10;
+
+std::thread g_watchdog_thread;
+std::mutex g_watchdog_mutex;
+std::condition_variable g_watchdog_cv;
+bool g_watchdog_stop = false;
+
+uint64_t watchdog_now_ms()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void watchdog_loop(int32_t device_id, void *region, uint64_t stall_ms)
+{
+    // the sampling thread needs its own device context for the copies
+    auto ret = aclrtSetDevice(device_id);
+    if (ret != 0) {
+        SHM_LOG_ERROR("watchdog set device " << device_id << " failed, ret: " << ret);
+        return;
+    }
+    uint64_t period_ms = stall_ms / 4 > WATCHDOG_MIN_PERIOD_MS ? stall_ms / 4 : WATCHDOG_MIN_PERIOD_MS;
+    std::vector<uint8_t> image(SHMEM_WATCHDOG_REGION_SIZE);
+    std::vector<watchdog_core_state> cores;
+    std::vector<shmemi_watchdog_record_t> stalled;
+
+    std::unique_lock<std::mutex> lock(g_watchdog_mutex);
+    while (!g_watchdog_cv.wait_for(lock, std::chrono::milliseconds(period_ms), [] { return g_watchdog_stop; })) {
+        // synchronous copy, not ordered behind kernels that may be stuck in a wait
+        ret = aclrtMemcpy(image.data(), image.size(), region, SHMEM_WATCHDOG_REGION_SIZE, ACL_MEMCPY_DEVICE_TO_HOST);
+        if (ret != 0) {
+            SHM_LOG_WARN("watchdog sample failed, ret: " << ret);
+            continue;
+        }
+        uint64_t now = watchdog_now_ms();
+        stalled.clear();
+        watchdog_scan(image.data(), now, stall_ms, cores, stalled);
+        for (const auto &rec : stalled) {
+            SHM_LOG_ERROR("watchdog: pe " << g_state.mype << " core " << rec.core << " no progress for "
+                << now - cores[rec.core].since_ms << "ms at " << watchdog_site_name(rec.site) << ", team "
+                << rec.team << " awaited pe " << rec.pe);
+        }
+    }
+}
+} // namespace
+
+const char *watchdog_site_name(int32_t site)
+{
+    switch (site) {
+        case SHMEMI_SITE_IDLE:
+            return "idle";
+        case SHMEMI_SITE_BARRIER:
+            return "barrier";
+        case SHMEMI_SITE_WAIT:
+            return "wait_until";
+        case SHMEMI_SITE_ROCE_QUIET:
+            return "roce_quiet";
+        default:
+            return "unknown";
+    }
+}
+
+void watchdog_scan(const uint8_t *region, uint64_t now_ms, uint64_t stall_ms, std::vector<watchdog_core_state> &cores,
+                   std::vector<shmemi_watchdog_record_t> &stalled)
+{
+    static_assert(sizeof(shmemi_watchdog_record_t) <= SHMEM_WATCHDOG_RECORD_SIZE, "watchdog record layout");
+    if (cores.size() != SHMEM_MAX_AIV_PER_NPU) {
+        cores.assign(SHMEM_MAX_AIV_PER_NPU, watchdog_core_state());
+        for (auto &core : cores) {
+            core.since_ms = now_ms;
+        }
+    }
+    for (uint32_t i = 0; i < SHMEM_MAX_AIV_PER_NPU; i++) {
+        shmemi_watchdog_record_t rec;
+        memcpy(&rec, region + i * SHMEM_WATCHDOG_RECORD_SIZE, sizeof(rec));
+        watchdog_core_state &core = cores[i];
+        if (rec.progress != core.progress) {
+            if (core.reported) {
+                SHM_LOG_WARN("watchdog: pe " << g_state.mype << " core " << i << " resumed after "
+                    << now_ms - core.since_ms << "ms");
+            }
+            core.progress = rec.progress;
+            core.since_ms = now_ms;
+            core.reported = false;
+            continue;
+        }
+        if (rec.site == SHMEMI_SITE_IDLE || core.reported || now_ms - core.since_ms < stall_ms) {
+            continue;
+        }
+        rec.core = static_cast<int32_t>(i);
+        stalled.push_back(rec);
+        core.reported = true;
+    }
+}
+
+int32_t shmemi_watchdog_init()
+{
+    if (g_state_host.watchdog_ms == 0) {
+        return SHMEM_SUCCESS;
+    }
+    int32_t device_id = 0;
+    SHMEM_CHECK_RET(aclrtGetDevice(&device_id), aclrtGetDevice);
+    void *region = nullptr;
+    SHMEM_CHECK_RET(aclrtMalloc(&region, SHMEM_WATCHDOG_REGION_SIZE, ACL_MEM_MALLOC_HUGE_FIRST), aclrtMalloc);
+    auto ret = aclrtMemset(region, SHMEM_WATCHDOG_REGION_SIZE, 0, SHMEM_WATCHDOG_REGION_SIZE);
+    if (ret != 0) {
+        aclrtFree(region);
+        SHM_LOG_ERROR("memset watchdog region failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    g_state.watchdog_region = reinterpret_cast<uint64_t>(region);
+    g_watchdog_stop = false;
+    g_watchdog_thread = std::thread(watchdog_loop, device_id, region, static_cast<uint64_t>(g_state_host.watchdog_ms));
+    SHM_LOG_INFO("progress watchdog started, stall threshold " << g_state_host.watchdog_ms << "ms");
+    return SHMEM_SUCCESS;
+}
+
+void shmemi_watchdog_finalize()
+{
+    if (g_watchdog_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(g_watchdog_mutex);
+            g_watchdog_stop = true;
+        }
+        g_watchdog_cv.notify_all();
+        g_watchdog_thread.join();
+    }
+    if (g_state.watchdog_region != 0) {
+        aclrtFree(reinterpret_cast<void *>(g_state.watchdog_region));
+        g_state.watchdog_region = 0;
+    }
+}
+
+} // namespace shm
@@ -14,6 +14,7 @@
 #include <vector>
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 #include "acl/acl.h"
 #include "shmemi_host_common.h"
@@ -119,6 +120,162 @@ static void setup_switch_barrier(shmemi_team_t *team) {
 }
 // ------------------------------------
 
+// --- Barrier Algorithm Selection ---
+
+int32_t team_host_local_size(const shmemi_team_t *team, const int32_t *host_ids)
+{
+    int32_t local_size = 1;
+    while (local_size < team->size &&
+           host_ids[team->start + local_size * team->stride] == host_ids[team->start]) {
+        local_size++;
+    }
+    if (team->size % local_size != 0) {
+        return 0;
+    }
+    for (int32_t i = local_size; i < team->size; i++) {
+        int32_t pe = team->start + i * team->stride;
+        int32_t leader = team->start + (i / local_size) * local_size * team->stride;
+        if (host_ids[pe] != host_ids[leader]) {
+            return 0;
+        }
+    }
+    return local_size;
+}
+
+static const char *g_barrier_algo_names[] = {"auto", "dissem", "tg_dissem", "central", "switch", "hier"};
+static const int32_t BARRIER_ALGO_NUM = sizeof(g_barrier_algo_names) / sizeof(g_barrier_algo_names[0]);
+
+int32_t barrier_algo_from_name(const char *name)
+{
+    for (int32_t i = 0; i < BARRIER_ALGO_NUM; i++) {
+        if (strcmp(name, g_barrier_algo_names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static const char *barrier_algo_name(int32_t algo)
+{
+    return (algo >= 0 && algo < BARRIER_ALGO_NUM) ? g_barrier_algo_names[algo] : "unknown";
+}
+
+// Defaults of the latency model, round_us and poll_us are replaced by the calibration on SHMEM_TEAM_WORLD.
+constexpr double BARRIER_DEFAULT_ROUND_US = 2.0;
+constexpr double BARRIER_DEFAULT_POLL_US = 0.5;
+constexpr double BARRIER_DEFAULT_ROCE_ROUND_US = 10.0;
+constexpr int32_t BARRIER_CALIBRATE_ITERS = 100;
+
+static barrier_cost_model g_barrier_cost = {BARRIER_DEFAULT_ROUND_US, BARRIER_DEFAULT_POLL_US,
+                                            BARRIER_DEFAULT_ROCE_ROUND_US};
+
+static int32_t ceil_log(int32_t n, int32_t k)
+{
+    int32_t rounds = 0;
+    int64_t span = 1;
+    while (span < n) {
+        span *= k;
+        rounds++;
+    }
+    return rounds;
+}
+
+double barrier_predict_us(const barrier_cost_model &model, int32_t size, int32_t host_local_size, bool all_mte,
+                          int32_t algo, int32_t k)
+{
+    double remote_round_us = all_mte ? model.round_us : model.roce_round_us;
+    switch (algo) {
+        case SHMEMX_BARRIER_DISSEM:
+            return ceil_log(size, 2) * remote_round_us;
+        case SHMEMX_BARRIER_TG_DISSEM:
+            return ceil_log(size, k) * (remote_round_us + (k - 2) * model.poll_us);
+        case SHMEMX_BARRIER_CENTRAL:
+        case SHMEMX_BARRIER_SWITCH:
+            return size > 1 ? remote_round_us + ((size - 2) / k) * model.poll_us : 0.0;
+        case SHMEMX_BARRIER_HIER: {
+            if (host_local_size == 0) {
+                return -1.0;
+            }
+            // gather and release inside the host, dissemination among host leaders
+            double local_us = host_local_size > 1 ? 2 * model.round_us + (host_local_size - 2) * model.poll_us : 0.0;
+            return local_us + ceil_log(size / host_local_size, 2) * remote_round_us;
+        }
+        default:
+            return -1.0;
+    }
+}
+
+void barrier_select(const barrier_cost_model &model, int32_t size, int32_t host_local_size, bool all_mte,
+                    int32_t *algo, int32_t *k)
+{
+    // only the hierarchical barrier signals over RoCE, the others need every member reachable over MTE
+    if (!all_mte) {
+        if (host_local_size != 0) {
+            *algo = SHMEMX_BARRIER_HIER;
+            *k = SHMEM_BARRIER_TG_DISSEM_KVAL;
+            return;
+        }
+        SHM_LOG_WARN("team of " << size << " PEs is neither reachable over MTE nor made of equal host blocks, "
+                     "falling back to the centralized barrier.");
+        *algo = SHMEMX_BARRIER_CENTRAL;
+        *k = SHMEM_BARRIER_TG_DISSEM_KVAL;
+        return;
+    }
+
+    // the switch barrier is never chosen here, its capability is only known to the team root
+    *algo = SHMEMX_BARRIER_CENTRAL;
+    *k = SHMEM_BARRIER_TG_DISSEM_KVAL;
+    double best_us = barrier_predict_us(model, size, host_local_size, all_mte, *algo, *k);
+    auto consider = [&](int32_t cand_algo, int32_t cand_k) {
+        double us = barrier_predict_us(model, size, host_local_size, all_mte, cand_algo, cand_k);
+        if (us >= 0 && us < best_us) {
+            best_us = us;
+            *algo = cand_algo;
+            *k = cand_k;
+        }
+    };
+    consider(SHMEMX_BARRIER_DISSEM, 2);
+    for (int32_t cand_k = 3; cand_k <= SHMEM_BARRIER_TG_DISSEM_KVAL; cand_k++) {
+        consider(SHMEMX_BARRIER_TG_DISSEM, cand_k);
+    }
+    consider(SHMEMX_BARRIER_HIER, SHMEM_BARRIER_TG_DISSEM_KVAL);
+}
+
+static bool team_all_mte(const shmemi_team_t *team)
+{
+    for (int32_t i = 0; i < team->size; i++) {
+        if (!(g_state.topo_list[team->start + i * team->stride] & SHMEM_TRANSPORT_MTE)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void setup_barrier_algo(shmemi_team_t *team)
+{
+    team->host_local_size = team_host_local_size(team, shmemi_host_ids());
+    bool all_mte = team_all_mte(team);
+    barrier_select(g_barrier_cost, team->size, team->host_local_size, all_mte, &team->barrier_algo,
+                   &team->barrier_k);
+
+    int32_t env_algo = g_state_host.barrier_algo;
+    if (env_algo != SHMEMX_BARRIER_AUTO) {
+        if (env_algo == SHMEMX_BARRIER_HIER && team->host_local_size == 0) {
+            SHM_LOG_WARN("SHMEM_BARRIER_ALGO=hier ignored for team " << team->team_idx
+                         << ", its hosts do not hold equal contiguous blocks.");
+        } else {
+            team->barrier_algo = env_algo;
+        }
+    }
+    if (g_state_host.barrier_k != 0) {
+        team->barrier_k = g_state_host.barrier_k;
+    }
+    SHM_LOG_INFO("[Barrier] Team " << team->team_idx << " uses " << barrier_algo_name(team->barrier_algo)
+                 << " k=" << team->barrier_k << ", predicted "
+                 << barrier_predict_us(g_barrier_cost, team->size, team->host_local_size, all_mte,
+                                       team->barrier_algo, team->barrier_k) << " us.");
+}
+
 uint64_t g_team_mask = 0;
 shmemi_team_t *g_shmem_team_pool = nullptr;
 
@@ -257,7 +414,20 @@ int32_t shmemi_team_init_partial_barrier_pool()
     return SHMEM_SUCCESS;
 }
 
-int32_t shmemi_team_init(int32_t rank, int32_t size)
+// A team index may be reused, so the epochs and counter left by its previous owner are dropped.
+inline int32_t team_partial_barrier_reset(int32_t team_idx)
+{
+    void *team_region = reinterpret_cast<void *>(g_state.partial_barrier_pool +
+                                                 team_idx * SHMEM_PARTIAL_BARRIER_PER_TEAM_SIZE);
+    auto ret = aclrtMemset(team_region, SHMEM_PARTIAL_BARRIER_PER_TEAM_SIZE, 0, SHMEM_PARTIAL_BARRIER_PER_TEAM_SIZE);
+    if (ret != 0) {
+        SHM_LOG_ERROR("memset partial barrier slots of team " << team_idx << " failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemi_team_init_host(int32_t rank, int32_t size)
 {
     /* Initialize SHMEM_TEAM_WORLD */
     g_shmem_team_pool = (shmemi_team_t *)calloc(SHMEM_MAX_TEAMS, sizeof(shmemi_team_t));
@@ -279,8 +449,14 @@ int32_t shmemi_team_init(int32_t rank, int32_t size)
     
     // Initialize Switch Barrier if enabled
     setup_switch_barrier(&shmem_team_world);
+    setup_barrier_algo(&shmem_team_world);
+    return SHMEM_SUCCESS;
+}
 
-    SHMEM_CHECK_RET(device_team_update(SHMEM_TEAM_WORLD, &shmem_team_world));
+int32_t shmemi_team_init(int32_t rank, int32_t size)
+{
+    SHMEM_CHECK_RET(shmemi_team_init_host(rank, size), shmemi_team_init_host);
+    SHMEM_CHECK_RET(device_team_update(SHMEM_TEAM_WORLD, &g_shmem_team_pool[SHMEM_TEAM_WORLD]));
 
     /* Initialize TEAM SYNC */
     auto ret = shmemi_team_init_sync_pool();
@@ -318,6 +494,67 @@ int32_t first_free_idx_fetch()
     return -1;
 }
 
+static int32_t barrier_calibrate_one(int32_t algo, int32_t k, int64_t *cycles_dev, double *us)
+{
+    aclrtStream stream = g_state_host.default_stream;
+    SHMEM_CHECK_RET(shmemi_barrier_calibrate_on_stream(SHMEM_TEAM_WORLD, algo, k, BARRIER_CALIBRATE_ITERS,
+                                                       cycles_dev, stream), shmemi_barrier_calibrate_on_stream);
+    int64_t cycles = 0;
+    SHMEM_CHECK_RET(aclrtMemcpy(&cycles, sizeof(int64_t), cycles_dev, sizeof(int64_t), ACL_MEMCPY_DEVICE_TO_HOST),
+                    aclrtMemcpy);
+    *us = static_cast<double>(cycles) / SHMEM_SYS_CYCLES_PER_US / BARRIER_CALIBRATE_ITERS;
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemi_team_barrier_calibrate()
+{
+    shmemi_team_t *world = &g_shmem_team_pool[SHMEM_TEAM_WORLD];
+    if (world->size < 2 || !team_all_mte(world)) {
+        // the calibration kernels signal over MTE only, keep the default model
+        return SHMEM_SUCCESS;
+    }
+
+    int64_t *cycles_dev = nullptr;
+    SHMEM_CHECK_RET(aclrtMalloc((void **)&cycles_dev, sizeof(int64_t), ACL_MEM_MALLOC_NORMAL_ONLY), aclrtMalloc);
+    double dissem_us = 0;
+    double central_us = 0;
+    int32_t ret = barrier_calibrate_one(SHMEMX_BARRIER_DISSEM, 2, cycles_dev, &dissem_us);
+    if (ret == SHMEM_SUCCESS) {
+        ret = barrier_calibrate_one(SHMEMX_BARRIER_CENTRAL, SHMEM_BARRIER_TG_DISSEM_KVAL, cycles_dev, &central_us);
+    }
+    SHMEM_CHECK_RET(aclrtFree(cycles_dev), aclrtFree);
+    if (ret != SHMEM_SUCCESS) {
+        return ret;
+    }
+
+    // dissemination gives the round latency, the extra sequential reads of centralized pull give the poll latency
+    double model[2];
+    model[0] = dissem_us / ceil_log(world->size, 2);
+    model[1] = model[0] * BARRIER_DEFAULT_POLL_US / BARRIER_DEFAULT_ROUND_US;
+    int32_t extra_reads = (world->size - 2) / SHMEM_BARRIER_TG_DISSEM_KVAL;
+    if (extra_reads > 0) {
+        model[1] = std::min(std::max((central_us - model[0]) / extra_reads, model[0] / 8), model[0]);
+    }
+
+    // every PE must choose the same algorithms, so all of them use the slowest measurement
+    std::vector<double> all_models(world->size * 2);
+    SHMEM_CHECK_RET(shmemi_control_allgather(model, sizeof(model), all_models.data(),
+                                             all_models.size() * sizeof(double)), shmemi_control_allgather);
+    g_barrier_cost.round_us = 0;
+    g_barrier_cost.poll_us = 0;
+    for (int32_t i = 0; i < world->size; i++) {
+        g_barrier_cost.round_us = std::max(g_barrier_cost.round_us, all_models[i * 2]);
+        g_barrier_cost.poll_us = std::max(g_barrier_cost.poll_us, all_models[i * 2 + 1]);
+    }
+    SHM_LOG_INFO("[Barrier] calibrated round " << g_barrier_cost.round_us << " us, poll "
+                 << g_barrier_cost.poll_us << " us.");
+
+    setup_barrier_algo(world);
+    SHMEM_CHECK_RET(aclrtMemcpy(g_state.team_pools[SHMEM_TEAM_WORLD], sizeof(shmemi_team_t), world,
+                                sizeof(shmemi_team_t), ACL_MEMCPY_HOST_TO_DEVICE), aclrtMemcpy);
+    return SHMEM_SUCCESS;
+}
+
 int32_t shmemi_team_finalize()
 {
     /* Destroy all undestroyed teams */
@@ -371,6 +608,10 @@ int32_t shmem_team_split_strided_precheck(shmem_team_t parent_team, int32_t pe_s
         SHM_LOG_ERROR("input parent team is invalid!, team: " << parent_team);
         return SHMEM_INVALID_PARAM;
     }
+    if (shm::loopback_active()) {
+        SHM_LOG_ERROR("team split is not supported by the loopback backend");
+        return SHMEM_INNER_ERROR;
+    }
 
     shmemi_team_t *src_team = &shm::g_shmem_team_pool[parent_team];
     if (pe_start >= SHMEM_MAX_RANKS || pe_stride >= SHMEM_MAX_RANKS || pe_size > SHMEM_MAX_RANKS) {
@@ -427,7 +668,13 @@ int32_t shmem_team_split_strided(shmem_team_t parent_team, int32_t pe_start, int
     }
 
     // Configure Switch Barrier for new team
-    setup_switch_barrier(&my_team);
+    shm::setup_switch_barrier(&my_team);
+    shm::setup_barrier_algo(&my_team);
+
+    if (shm::team_partial_barrier_reset(my_team.team_idx) != 0) {
+        shm::g_team_mask ^= 1ULL << my_team.team_idx;
+        return SHMEM_INNER_ERROR;
+    }
 
     shm::g_shmem_team_pool[my_team.team_idx] = my_team;
     if (shm::device_team_update(my_team.team_idx, &shm::g_shmem_team_pool[my_team.team_idx]) != 0) {
@@ -589,6 +836,9 @@ void shmem_team_destroy(shmem_team_t team)
 
     shm::device_team_destroy(team);
     shm::g_team_mask ^= 1ULL << team;
+    if (shm::loopback_active()) {
+        return;
+    }
     if (shm::update_device_state() != SHMEM_SUCCESS) {
         SHM_LOG_WARN("update state failed when destroy team!");
     }
@@ -632,3 +882,18 @@ int shmem_team_get_config(shmem_team_t team, shmem_team_config_t *config)
         return SHMEM_INVALID_PARAM;
     }
 }
+
+int shmemx_team_barrier_info(shmem_team_t team, int *algo, int *k, double *predicted_us)
+{
+    SHM_ASSERT_RETURN(algo != nullptr && k != nullptr && predicted_us != nullptr, SHMEM_INVALID_PARAM);
+    if (!shm::is_valid_team(team)) {
+        SHM_LOG_ERROR("input team is invalid!, team: " << team);
+        return SHMEM_INVALID_PARAM;
+    }
+    shmemi_team_t *src_team = &shm::g_shmem_team_pool[team];
+    *algo = src_team->barrier_algo;
+    *k = src_team->barrier_k;
+    *predicted_us = shm::barrier_predict_us(shm::g_barrier_cost, src_team->size, src_team->host_local_size,
+                                            shm::team_all_mte(src_team), src_team->barrier_algo, src_team->barrier_k);
+    return SHMEM_SUCCESS;
+}
@@ -11,13 +11,41 @@
 #define SHMEMI_TEAM_H
 
 #include "stdint.h"
+#include "internal/host_device/shmemi_types.h"
 
 namespace shm {
 
 int32_t shmemi_team_init(int32_t rank, int32_t size);
 
+// Host side of shmemi_team_init: the team pool and SHMEM_TEAM_WORLD with its barrier selection, no device state.
+int32_t shmemi_team_init_host(int32_t rank, int32_t size);
+
 int32_t shmemi_team_finalize();
 
+// Runs each candidate barrier on SHMEM_TEAM_WORLD once to fit the latency model used by team creation.
+int32_t shmemi_team_barrier_calibrate();
+
+// Number of team members per host when every host holds an equal contiguous block of the team, 0 otherwise.
+int32_t team_host_local_size(const shmemi_team_t *team, const int32_t *host_ids);
+
+// Latency model of the device barriers, in microseconds.
+struct barrier_cost_model {
+    double round_us;        // one signal written and observed by the peer over MTE
+    double poll_us;         // each further flag handled in the same step
+    double roce_round_us;   // one signal round between hosts over RoCE
+};
+
+// Returns the shmemx_barrier_algo_t value of name, -1 when unknown.
+int32_t barrier_algo_from_name(const char *name);
+
+// Predicted latency of algo on a team, -1 when the algorithm does not apply.
+double barrier_predict_us(const barrier_cost_model &model, int32_t size, int32_t host_local_size, bool all_mte,
+                          int32_t algo, int32_t k);
+
+// Picks the algorithm and radix with the lowest predicted latency among those valid for the team.
+void barrier_select(const barrier_cost_model &model, int32_t size, int32_t host_local_size, bool all_mte,
+                    int32_t *algo, int32_t *k);
+
 }  // namespace shm
 
 #endif  // SHMEMI_TEAM_H
@@ -630,6 +630,7 @@ Result MemEntityDefault::InitTransManager()
     options.protocol = options_.bmDataOpType;
     options.role = options_.role;
     options.nic = options_.nic;
+    options.qpNum = options_.qpNum == 0 ? 1U : options_.qpNum;
     auto ret = transportManager_->OpenDevice(options);
     if (ret != 0) {
         BM_LOG_ERROR("Failed to open device, ret: " << ret);
@@ -85,10 +85,11 @@ Result RdmaTransportManager::OpenDevice(const TransportOptions &options)
     mf_sockaddr deviceAddr;
     InitializeDeviceAddress(deviceAddr);
     if (role_ == HYBM_ROLE_PEER) {
-        qpManager_ = std::make_shared<FixedRanksQpManager>(deviceId_, rankId_, rankCount_, deviceAddr);
+        qpManager_ = std::make_shared<FixedRanksQpManager>(deviceId_, rankId_, rankCount_, deviceAddr,
+                                                           options.qpNum);
     } else {
         qpManager_ = std::make_shared<DynamicRanksQpManager>(deviceId_, rankId_, rankCount_, deviceAddr,
-                                                             role_ == HYBM_ROLE_RECEIVER);
+                                                             role_ == HYBM_ROLE_RECEIVER, options.qpNum);
     }
 
     deviceChipInfo_ = std::make_shared<DeviceChipInfo>(deviceId_);
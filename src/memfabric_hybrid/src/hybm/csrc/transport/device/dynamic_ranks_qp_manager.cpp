@@ -21,9 +21,13 @@ namespace device {
 const int delay = 5;
 static constexpr auto WAIT_DELAY_TIME = std::chrono::seconds(delay);
 DynamicRanksQpManager::DynamicRanksQpManager(uint32_t deviceId, uint32_t rankId, uint32_t rankCount,
-                                             mf_sockaddr devNet, bool server) noexcept
+                                             mf_sockaddr devNet, bool server, uint32_t qpNum) noexcept
     : DeviceQpManager{deviceId, rankId, rankCount, devNet, server ? HYBM_ROLE_RECEIVER : HYBM_ROLE_SENDER}
 {
+    // only host side STARS QPs are created here, one per remote rank, AI core QP striping is not available
+    if (qpNum > 1U) {
+        BM_LOG_WARN(rankId_ << " dynamic ranks use one QP per remote rank, ignore qp count: " << qpNum);
+    }
     connectionView_.resize(rankCount);
 }
 
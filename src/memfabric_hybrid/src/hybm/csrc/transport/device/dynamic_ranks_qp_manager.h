@@ -28,7 +28,7 @@ namespace device {
 class DynamicRanksQpManager : public DeviceQpManager {
 public:
     DynamicRanksQpManager(uint32_t deviceId, uint32_t rankId, uint32_t rankCount, mf_sockaddr devNet,
-                          bool server) noexcept;
+                          bool server, uint32_t qpNum = 1) noexcept;
     ~DynamicRanksQpManager() noexcept override;
 
     int SetRemoteRankInfo(const std::unordered_map<uint32_t, ConnectRankInfo> &ranks) noexcept override;
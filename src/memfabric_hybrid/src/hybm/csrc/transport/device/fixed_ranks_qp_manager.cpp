@@ -23,9 +23,14 @@ static constexpr uint32_t MAX_SEND_WR = 8192;
 static constexpr uint32_t MAX_RECV_WR = 128;
 static constexpr uint32_t QP_MODE = 2;
 FixedRanksQpManager::FixedRanksQpManager(uint32_t deviceId, uint32_t rankId, uint32_t rankCount,
-                                         mf_sockaddr devNet) noexcept
-    : DeviceQpManager(deviceId, rankId, rankCount, devNet, HYBM_ROLE_PEER)
+                                         mf_sockaddr devNet, uint32_t qpNum) noexcept
+    : DeviceQpManager(deviceId, rankId, rankCount, devNet, HYBM_ROLE_PEER),
+      qpNum_{qpNum == 0 ? 1U : (qpNum > AI_QP_NUM_MAX ? AI_QP_NUM_MAX : qpNum)}
 {
+    if (qpNum_ != qpNum) {
+        BM_LOG_WARN(rankId_ << " AI QP count " << qpNum << " out of range [1, " << AI_QP_NUM_MAX << "], use "
+                            << qpNum_);
+    }
 }
 
 FixedRanksQpManager::~FixedRanksQpManager() noexcept
@@ -154,8 +159,8 @@ bool FixedRanksQpManager::ReserveQpInfoSpace() noexcept
     }
 
     void *ptr = nullptr;
-    auto oneQpSize = 2U * (sizeof(AiQpRMAWQ) + sizeof(AiQpRMACQ)) + sizeof(RdmaMemRegionInfo);
-    qpInfoSize_ = sizeof(AiQpRMAQueueInfo) + oneQpSize * rankCount_;
+    auto oneRankSize = 2U * (sizeof(AiQpRMAWQ) + sizeof(AiQpRMACQ)) * qpNum_ + sizeof(RdmaMemRegionInfo);
+    qpInfoSize_ = sizeof(AiQpRMAQueueInfo) + oneRankSize * rankCount_;
     auto ret = DlAclApi::AclrtMalloc(&ptr, qpInfoSize_, 0);
     if (ret != 0) {
         BM_LOG_ERROR(rankId_ << " allocate device size: " << qpInfoSize_ << ", failed: " << ret);
@@ -443,33 +448,37 @@ int FixedRanksQpManager::CreateQpWaitingReady(std::unordered_map<uint32_t, Conne
     const int accessLevel = 7;
     std::string sideName = (side == CONN_CLIENT_SIDE) ? "client" : "server";
     BM_LOG_DEBUG(rankId_ << ":" << sideName << " begin create qp and register mr");
+    const uint32_t qpCount = QpCountOfType(qpType);
     for (auto it = connections.begin(); it != connections.end(); ++it) {
-        auto ret = CreateOneQp(qpType, it->second);
-        if (ret != 0) {
-            BM_LOG_ERROR(rankId_ << ":" << sideName << " create QP type:" << qpType <<
-                " to " << it->first << " failed: " << ret);
-            return BM_DL_FUNCTION_FAILED;
-        }
+        for (uint32_t qpIdx = 0; qpIdx < qpCount; qpIdx++) {
+            auto ret = CreateOneQp(qpType, qpIdx, it->second);
+            if (ret != 0) {
+                BM_LOG_ERROR(rankId_ << ":" << sideName << " create QP type:" << qpType << " index:" << qpIdx <<
+                    " to " << it->first << " failed: " << ret);
+                return BM_DL_FUNCTION_FAILED;
+            }
 
-        BM_LOG_DEBUG(rankId_ << ":" << sideName << " create qp success, qptype=" << qpType);
+            BM_LOG_DEBUG(rankId_ << ":" << sideName << " create qp success, qptype=" << qpType << ", index=" << qpIdx);
+
+            for (auto pos = currentLocalMrs_.begin(); pos != currentLocalMrs_.end(); ++pos) {
+                HccpMrInfo info{};
+                info.addr = (void *)(ptrdiff_t)pos->second.address;
+                info.size = pos->second.size;
+                info.access = accessLevel;
+                ret = DlHccpApi::RaMrReg(it->second.QpHandle(qpType, qpIdx), info);
+                if (ret != 0) {
+                    BM_LOG_ERROR(rankId_ << ":" << sideName << " register MR failed: " << ret);
+                    return BM_DL_FUNCTION_FAILED;
+                }
+                BM_LOG_DEBUG(rankId_ << ":" << sideName << " register mr size:" << pos->second.size << " success");
+            }
 
-        for (auto pos = currentLocalMrs_.begin(); pos != currentLocalMrs_.end(); ++pos) {
-            HccpMrInfo info{};
-            info.addr = (void *)(ptrdiff_t)pos->second.address;
-            info.size = pos->second.size;
-            info.access = accessLevel;
-            ret = DlHccpApi::RaMrReg(it->second.qpHandles[qpType], info);
+            ret = DlHccpApi::RaQpConnectAsync(it->second.QpHandle(qpType, qpIdx), it->second.socketFd);
             if (ret != 0) {
-                BM_LOG_ERROR(rankId_ << ":" << sideName << " register MR failed: " << ret);
+                BM_LOG_ERROR(rankId_ << ":" << sideName << " connect AI QP " << qpIdx << " to " << it->first <<
+                    " failed: " << ret);
                 return BM_DL_FUNCTION_FAILED;
             }
-            BM_LOG_DEBUG(rankId_ << ":" << sideName << " register mr size:" << pos->second.size << " success");
-        }
-
-        ret = DlHccpApi::RaQpConnectAsync(it->second.qpHandles[qpType], it->second.socketFd);
-        if (ret != 0) {
-            BM_LOG_ERROR(rankId_ << ":" << sideName << " connect AI QP to " << it->first << " failed: " << ret);
-            return BM_DL_FUNCTION_FAILED;
         }
     }
 
@@ -479,17 +488,21 @@ int FixedRanksQpManager::CreateQpWaitingReady(std::unordered_map<uint32_t, Conne
     while (std::chrono::steady_clock::now() < timeout) {
         int connectingCount = 0;
         for (auto it = connections.begin(); it != connections.end(); ++it) {
-            int status = 0;
-            auto ret = DlHccpApi::RaGetQpStatus(it->second.qpHandles[qpType], status);
-            if (ret != 0) {
-                BM_LOG_ERROR(rankId_ << ":" << sideName << " get AI QP status to " << it->first << " failed: " << ret);
-                return BM_DL_FUNCTION_FAILED;
-            }
-
-            // rs_qp_status: 0-disconnect, 1-connected, 2-timeout, 3-connecting, 4-fd_close, 5-pause
-            BM_LOG_DEBUG(rankId_ << ":" << sideName << " get create qp status to " << it->first << "=" << status);
-            if (status != 1) {
-                connectingCount++;
+            for (uint32_t qpIdx = 0; qpIdx < qpCount; qpIdx++) {
+                int status = 0;
+                auto ret = DlHccpApi::RaGetQpStatus(it->second.QpHandle(qpType, qpIdx), status);
+                if (ret != 0) {
+                    BM_LOG_ERROR(rankId_ << ":" << sideName << " get AI QP " << qpIdx << " status to " << it->first
+                                         << " failed: " << ret);
+                    return BM_DL_FUNCTION_FAILED;
+                }
+
+                // rs_qp_status: 0-disconnect, 1-connected, 2-timeout, 3-connecting, 4-fd_close, 5-pause
+                BM_LOG_DEBUG(rankId_ << ":" << sideName << " get create qp " << qpIdx << " status to " << it->first
+                                     << "=" << status);
+                if (status != 1) {
+                    connectingCount++;
+                }
             }
         }
         if (connectingCount == 0) {
@@ -501,7 +514,12 @@ int FixedRanksQpManager::CreateQpWaitingReady(std::unordered_map<uint32_t, Conne
     return BM_TIMEOUT;
 }
 
-int FixedRanksQpManager::CreateOneQp(ConnQpType qpType, ConnectionChannel &channel) noexcept
+uint32_t FixedRanksQpManager::QpCountOfType(ConnQpType qpType) const noexcept
+{
+    return qpType == CONN_QP_AI_CORE ? qpNum_ : 1U;
+}
+
+int FixedRanksQpManager::CreateOneQp(ConnQpType qpType, uint32_t index, ConnectionChannel &channel) noexcept
 {
     int ret;
     if (qpType == CONN_QP_AI_CORE) {
@@ -516,7 +534,7 @@ int FixedRanksQpManager::CreateOneQp(ConnQpType qpType, ConnectionChannel &chann
         attr.qp_attr.qp_type = IBV_QPT_RC;
         attr.qp_attr.cap.max_send_wr = MAX_SEND_WR;
         attr.data_plane_flag.bs.cq_cstm = 1;
-        ret = DlHccpApi::RaQpAiCreate(rdmaHandle_, attr, channel.aiQpInfo, channel.qpHandles[qpType]);
+        ret = DlHccpApi::RaQpAiCreate(rdmaHandle_, attr, channel.aiQpInfo[index], channel.QpHandle(qpType, index));
     } else {
         ret = DlHccpApi::RaQpCreate(rdmaHandle_, 0, QP_MODE, channel.qpHandles[qpType]);
     }
@@ -525,30 +543,32 @@ int FixedRanksQpManager::CreateOneQp(ConnQpType qpType, ConnectionChannel &chann
 
 void FixedRanksQpManager::FillQpPreSettingCopyInfo(AiQpRMAQueueInfo *&copyInfo)
 {
-    copyInfo->count = 1;
+    const uint32_t qpTotal = rankCount_ * qpNum_;
+    copyInfo->count = qpNum_;
     copyInfo->sq = (AiQpRMAWQ *)(void *)(copyInfo + 1);
-    copyInfo->rq = (AiQpRMAWQ *)(void *)(copyInfo->sq + rankCount_);
-    copyInfo->scq = (AiQpRMACQ *)(void *)(copyInfo->rq + rankCount_);
-    copyInfo->rcq = (AiQpRMACQ *)(void *)(copyInfo->scq + rankCount_);
-    copyInfo->mr = (RdmaMemRegionInfo *)(void *)(copyInfo->rcq + rankCount_);
+    copyInfo->rq = (AiQpRMAWQ *)(void *)(copyInfo->sq + qpTotal);
+    copyInfo->scq = (AiQpRMACQ *)(void *)(copyInfo->rq + qpTotal);
+    copyInfo->rcq = (AiQpRMACQ *)(void *)(copyInfo->scq + qpTotal);
+    copyInfo->mr = (RdmaMemRegionInfo *)(void *)(copyInfo->rcq + qpTotal);
 }
 
 void FixedRanksQpManager::FillQpPostSettingCopyInfo(AiQpRMAQueueInfo *&copyInfo)
 {
+    const uint32_t qpTotal = rankCount_ * qpNum_;
     auto pointer = (ptrdiff_t)(void *)(qpInfo_);
     pointer += sizeof(AiQpRMAQueueInfo);
     copyInfo->sq = (AiQpRMAWQ *)(void *)(pointer);
 
-    pointer += static_cast<ptrdiff_t>(sizeof(AiQpRMAWQ) * rankCount_);
+    pointer += static_cast<ptrdiff_t>(sizeof(AiQpRMAWQ) * qpTotal);
     copyInfo->rq = (AiQpRMAWQ *)(void *)(pointer);
 
-    pointer += static_cast<ptrdiff_t>(sizeof(AiQpRMAWQ) * rankCount_);
+    pointer += static_cast<ptrdiff_t>(sizeof(AiQpRMAWQ) * qpTotal);
     copyInfo->scq = (AiQpRMACQ *)(void *)(pointer);
 
-    pointer += static_cast<ptrdiff_t>(sizeof(AiQpRMACQ) * rankCount_);
+    pointer += static_cast<ptrdiff_t>(sizeof(AiQpRMACQ) * qpTotal);
     copyInfo->rcq = (AiQpRMACQ *)(void *)(pointer);
 
-    pointer += static_cast<ptrdiff_t>(sizeof(AiQpRMACQ) * rankCount_);
+    pointer += static_cast<ptrdiff_t>(sizeof(AiQpRMACQ) * qpTotal);
     copyInfo->mr = (RdmaMemRegionInfo *)(void *)pointer;
 }
 
@@ -588,10 +608,14 @@ int FixedRanksQpManager::FillQpInfo(ConnQpType qpType) noexcept
             return BM_ERROR;
         }
 
-        CopyAiWQInfo(copyInfo->sq[it->first], pos->second.aiQpInfo.data_plane_info.sq, DBMode::HW_DB, slevel);
-        CopyAiWQInfo(copyInfo->rq[it->first], pos->second.aiQpInfo.data_plane_info.rq, DBMode::SW_DB, slevel);
-        CopyAiCQInfo(copyInfo->scq[it->first], pos->second.aiQpInfo.data_plane_info.scq, DBMode::HW_DB);
-        CopyAiCQInfo(copyInfo->rcq[it->first], pos->second.aiQpInfo.data_plane_info.rcq, DBMode::SW_DB);
+        for (uint32_t qpIdx = 0; qpIdx < qpNum_; qpIdx++) {
+            auto &dataPlane = pos->second.aiQpInfo[qpIdx].data_plane_info;
+            const uint32_t idx = it->first * qpNum_ + qpIdx;
+            CopyAiWQInfo(copyInfo->sq[idx], dataPlane.sq, DBMode::HW_DB, slevel);
+            CopyAiWQInfo(copyInfo->rq[idx], dataPlane.rq, DBMode::SW_DB, slevel);
+            CopyAiCQInfo(copyInfo->scq[idx], dataPlane.scq, DBMode::HW_DB);
+            CopyAiCQInfo(copyInfo->rcq[idx], dataPlane.rcq, DBMode::SW_DB);
+        }
     }
 
     FillQpPostSettingCopyInfo(copyInfo);
@@ -674,12 +698,16 @@ void FixedRanksQpManager::CloseConnections(std::unordered_map<uint32_t, Connecti
 {
     std::vector<HccpSocketCloseInfo> socketCloseInfos;
     for (auto it = connections.begin(); it != connections.end(); ++it) {
-        if (it->second.qpHandles[CONN_QP_AI_CORE] != nullptr) {
-            auto ret = DlHccpApi::RaQpDestroy(it->second.qpHandles[CONN_QP_AI_CORE]);
+        for (uint32_t qpIdx = 0; qpIdx < qpNum_; qpIdx++) {
+            void *&qpHandle = it->second.QpHandle(CONN_QP_AI_CORE, qpIdx);
+            if (qpHandle == nullptr) {
+                continue;
+            }
+            auto ret = DlHccpApi::RaQpDestroy(qpHandle);
             if (ret != 0) {
-                BM_LOG_WARN(rankId_ << " destroy AI QP to server: " << it->first << " failed: " << ret);
+                BM_LOG_WARN(rankId_ << " destroy AI QP " << qpIdx << " to server: " << it->first << " failed: " << ret);
             }
-            it->second.qpHandles[CONN_QP_AI_CORE] = nullptr;
+            qpHandle = nullptr;
         }
 
         if (it->second.socketFd != nullptr) {
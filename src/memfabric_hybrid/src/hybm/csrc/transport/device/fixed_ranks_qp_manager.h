@@ -22,7 +22,8 @@ namespace device {
 
 class FixedRanksQpManager : public DeviceQpManager {
 public:
-    FixedRanksQpManager(uint32_t deviceId, uint32_t rankId, uint32_t rankCount, mf_sockaddr devNet) noexcept;
+    FixedRanksQpManager(uint32_t deviceId, uint32_t rankId, uint32_t rankCount, mf_sockaddr devNet,
+                        uint32_t qpNum = 1) noexcept;
     ~FixedRanksQpManager() noexcept override;
 
     int SetRemoteRankInfo(const std::unordered_map<uint32_t, ConnectRankInfo> &ranks) noexcept override;
@@ -45,16 +46,24 @@ private:
         CONN_MAX_SIDE
     };
 
+    static constexpr uint32_t AI_QP_NUM_MAX = 8;
+
     struct ConnectionChannel {
         net_addr_t remoteIp;
         void *socketHandle;
         void *socketFd{nullptr};
         void *qpHandles[CONN_QP_COUNT]{};
-        HccpAiQpInfo aiQpInfo{};
+        void *extraAiQpHandles[AI_QP_NUM_MAX - 1]{};  // AI core QPs 1..qpNum-1, QP 0 is qpHandles[CONN_QP_AI_CORE]
+        HccpAiQpInfo aiQpInfo[AI_QP_NUM_MAX]{};
         int qpStatus{-1};
 
         explicit ConnectionChannel(const net_addr_t ip) : ConnectionChannel{ip, nullptr} {}
         ConnectionChannel(net_addr_t ip, void *sock) : remoteIp{ip}, socketHandle{sock} {}
+
+        void *&QpHandle(ConnQpType type, uint32_t index) noexcept
+        {
+            return (type == CONN_QP_AI_CORE && index > 0) ? extraAiQpHandles[index - 1] : qpHandles[type];
+        }
     };
 
     bool ReserveQpInfoSpace() noexcept;
@@ -63,7 +72,8 @@ private:
     int GenerateWhiteList() noexcept;
     int WaitConnectionsReady(std::unordered_map<uint32_t, ConnectionChannel> &connections) noexcept;
     int CreateQpWaitingReady(std::unordered_map<uint32_t, ConnectionChannel> &connections, ConnQpType qpType, ConnSide side) noexcept;
-    int CreateOneQp(ConnQpType qpType, ConnectionChannel &channel) noexcept;
+    uint32_t QpCountOfType(ConnQpType qpType) const noexcept;
+    int CreateOneQp(ConnQpType qpType, uint32_t index, ConnectionChannel &channel) noexcept;
     int FillQpInfo(ConnQpType qpType) noexcept;
     void CopyAiWQInfo(struct AiQpRMAWQ &dest, const struct ai_data_plane_wq &src, DBMode dbMode, uint32_t sl) noexcept;
     void CopyAiCQInfo(struct AiQpRMACQ &dest, const ai_data_plane_cq &source, DBMode dbMode) noexcept;
@@ -79,6 +89,7 @@ private:
     std::atomic<bool> started_{false};
     std::atomic<int> serverConnectResult{-1};
     std::atomic<int> clientConnectResult{-1};
+    const uint32_t qpNum_;
     uint32_t qpInfoSize_{0};
     void *rdmaHandle_{nullptr};
     std::unordered_map<uint32_t, ConnectRankInfo> currentRanksInfo_;
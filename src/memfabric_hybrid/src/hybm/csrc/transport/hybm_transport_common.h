@@ -43,6 +43,7 @@ struct TransportOptions {
     hybm_role_type role;
     std::string nic;
     IpType type {IpV4};
+    uint32_t qpNum {1};
 
     friend std::ostream& operator<<(std::ostream& output, const TransportOptions& options)
     {
@@ -51,7 +52,8 @@ struct TransportOptions {
                << ", protocol=" << options.protocol
                << ", role=" << options.role
                << ", nid=" << options.nic
-               << ", iptype=" << options.type << ")";
+               << ", iptype=" << options.type
+               << ", qpNum=" << options.qpNum << ")";
         return output;
     }
 };
@@ -78,6 +78,7 @@ typedef struct {
     bool globalUniqueAddress; // 是否使用全局统一内存地址
     hybm_role_type role;
     char nic[64];
+    uint16_t qpNum;           // AI core RDMA QPs to each remote rank, 0 is treated as 1
 } hybm_options;
 
 #ifndef __cplusplus
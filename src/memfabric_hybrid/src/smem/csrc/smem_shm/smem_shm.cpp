@@ -203,6 +203,7 @@ SMEM_API int32_t smem_shm_config_init(smem_shm_config_t *config)
     config->controlOperationTimeout = SMEM_DEFAUT_WAIT_TIME;
     config->startConfigStore = true;
     config->flags = 0;
+    config->rdmaQpNum = 1;
     return SM_OK;
 }
 
@@ -217,6 +218,8 @@ static int32_t SmemShmConfigCheck(const smem_shm_config_t *config)
     SM_VALIDATE_RETURN(config->controlOperationTimeout != 0, "controlOperationTimeout is zero", SM_INVALID_PARAM);
     SM_VALIDATE_RETURN(config->controlOperationTimeout <= SMEM_SHM_TIMEOUT_MAX, "controlOperationTimeout is too large",
                        SM_INVALID_PARAM);
+    SM_VALIDATE_RETURN(config->rdmaQpNum != 0, "rdmaQpNum is zero", SM_INVALID_PARAM);
+    SM_VALIDATE_RETURN(config->rdmaQpNum <= SMEM_SHM_RDMA_QP_NUM_MAX, "rdmaQpNum is too large", SM_INVALID_PARAM);
     return 0;
 }
 
@@ -104,6 +104,7 @@ Result SmemShmEntry::Initialize(hybm_options &options)
     localRank_ = options.rankId;
     SM_LOG_ERROR_RETURN_IT_IF_NOT_OK(CreateGlobalTeam(options.rankCount, options.rankId), "create global team failed");
 
+    options.qpNum = static_cast<uint16_t>(extraConfig_.rdmaQpNum);
     options_ = options;
     for (auto it = initSteps_.begin(); it != initSteps_.end(); ++it) {
         SM_LOG_DEBUG("process init step : " << it->name);
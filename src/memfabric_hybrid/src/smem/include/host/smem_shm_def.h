@@ -18,6 +18,7 @@ extern "C" {
 
 typedef void *smem_shm_t;
 #define SMEM_SHM_TIMEOUT_MAX     UINT32_MAX /* all timeout must <= UINT32_MAX */
+#define SMEM_SHM_RDMA_QP_NUM_MAX 8U         /* max AI core RDMA QPs per remote rank */
 
 /**
  * @brief NPU initiated data operation type, currently only support MTE
@@ -42,6 +43,8 @@ typedef struct {
     bool startConfigStore;            /* whether to start config store, default true */
     uint32_t flags;                   /* other flag, default 0 */
     int32_t sockFd;                   /* apply available port in advance, default -1 */
+    uint32_t rdmaQpNum;               /* AI core RDMA QPs created to each remote rank, default 1
+                                         (min is 1, max is SMEM_SHM_RDMA_QP_NUM_MAX) */
 } smem_shm_config_t;
 
 #ifdef __cplusplus
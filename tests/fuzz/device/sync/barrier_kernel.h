@@ -12,6 +12,7 @@
 
 void increase_do(void* stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size);
 void increase_vec_do(void* stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size);
+void increase_split_do(void* stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size);
 void increase_do_odd_team(void* stream, uint64_t config, uint8_t *addr, int rank_id,
     int rank_size, shmem_team_t team_id);
 void increase_vec_do_odd_team(void* stream, uint64_t config, uint8_t *addr, int rank_id,
@@ -11,5 +11,8 @@
 #define P2P_KERNEL_H
 
 void p2p_chain_do(void *stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size);
+void p2p_wait_any_do(void *stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size);
+void p2p_wait_timeout_do(void *stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size,
+                         int64_t timeout_cycles);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "kernel_operator.h"
+
+#include "shmem_api.h"
+#include "unittest/utils/func_type.h"
+constexpr uint64_t NBI_VEC_VALUES_OFFSET = 64;
+constexpr uint64_t NBI_VEC_PES_OFFSET = 512;
+
+/*
+ * gva layout: [0] word updated by shmem_<type>_atomic_add_nbi, [1] word updated by shmemx_<type>_atomic_add_vec,
+ *             values and pes of the vector at NBI_VEC_VALUES_OFFSET and NBI_VEC_PES_OFFSET.
+ */
+#define ATOMIC_ADD_NBI_TEST_KERNEL(NAME, TYPE)                                                                   \
+    extern "C" __global__ __aicore__ void test_atomic_add_nbi_##NAME##_kernel(GM_ADDR gva, uint64_t config)      \
+    {                                                                                                            \
+        shmemx_set_ffts_config(config);                                                                          \
+        int64_t rank = smem_shm_get_global_rank();                                                               \
+        int64_t rank_size = smem_shm_get_global_rank_size();                                                     \
+        __gm__ TYPE *words = (__gm__ TYPE *)gva;                                                                 \
+        __gm__ TYPE *values = (__gm__ TYPE *)(gva + NBI_VEC_VALUES_OFFSET);                                      \
+        __gm__ int32_t *pes = (__gm__ int32_t *)(gva + NBI_VEC_PES_OFFSET);                                      \
+                                                                                                                 \
+        if ASCEND_IS_AIV {                                                                                       \
+            if (AscendC::GetBlockIdx() == 0) {                                                                   \
+                for (int64_t peer = 0; peer < rank_size; peer++) {                                               \
+                    shmem_##NAME##_atomic_add_nbi(words, (TYPE)(rank + 1), peer);                                \
+                }                                                                                                \
+                /* every PE appears twice and never next to itself, so only bucketing coalesces them */          \
+                for (int64_t i = 0; i < 2 * rank_size; i++) {                                                    \
+                    values[i] = (TYPE)1;                                                                         \
+                    pes[i] = (int32_t)(i % rank_size);                                                           \
+                }                                                                                                \
+                shmemx_##NAME##_atomic_add_vec(words + 1, values, pes, (uint32_t)(2 * rank_size));               \
+                shmem_quiet();                                                                                   \
+            }                                                                                                    \
+        }                                                                                                        \
+        shmem_barrier_all();                                                                                     \
+    }
+ATOMIC_ADD_NBI_TEST_KERNEL(int32, int32_t);
+ATOMIC_ADD_NBI_TEST_KERNEL(float, float);
+
+#define ATOMIC_ADD_NBI_TEST(NAME, TYPE)                                                                   \
+    void test_atomic_add_nbi_##NAME##_do(uint32_t block_dim, void *stream, uint8_t *gva, uint64_t config) \
+    {                                                                                                     \
+        test_atomic_add_nbi_##NAME##_kernel<<<block_dim, nullptr, stream>>>(gva, config);                 \
+    }
+ATOMIC_ADD_NBI_TEST(int32, int32_t);
+ATOMIC_ADD_NBI_TEST(float, float);
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "kernel_operator.h"
+
+#include "shmem_api.h"
+#include "unittest/utils/func_type.h"
+constexpr uint64_t FETCH_TEST_ITERS = 16;
+
+/*
+ * gva layout: [0] ticket counter owned by PE 0, [1] swap word owned by PE 0,
+ *             [2, 2 + FETCH_TEST_ITERS) tickets drawn by this PE, [2 + FETCH_TEST_ITERS] value returned by swap.
+ */
+#define ATOMIC_FETCH_TEST_KERNEL(NAME, TYPE)                                                              \
+    extern "C" __global__ __aicore__ void test_atomic_fetch_##NAME##_kernel(GM_ADDR gva, uint64_t config) \
+    {                                                                                                     \
+        shmemx_set_ffts_config(config);                                                                   \
+        int64_t rank = smem_shm_get_global_rank();                                                        \
+        __gm__ TYPE *words = (__gm__ TYPE *)gva;                                                          \
+                                                                                                          \
+        if ASCEND_IS_AIV {                                                                                \
+            if (AscendC::GetBlockIdx() == 0) {                                                            \
+                for (uint64_t i = 0; i < FETCH_TEST_ITERS; i++) {                                         \
+                    words[2 + i] = shmem_##NAME##_atomic_fetch_add(words, (TYPE)1, 0);                    \
+                    dcci_cacheline((__gm__ uint8_t *)(words + 2 + i));                                    \
+                }                                                                                         \
+                /* only one PE observes the initial 0 and installs its rank + 1 first */                  \
+                TYPE prev = shmem_##NAME##_atomic_compare_swap(words + 1, (TYPE)0, (TYPE)(rank + 1), 0);  \
+                if (prev != 0) {                                                                          \
+                    prev = shmem_##NAME##_atomic_swap(words + 1, (TYPE)(rank + 1), 0);                    \
+                }                                                                                         \
+                words[2 + FETCH_TEST_ITERS] = prev;                                                       \
+                dcci_cacheline((__gm__ uint8_t *)&words[2 + FETCH_TEST_ITERS]);                           \
+            }                                                                                             \
+        }                                                                                                 \
+        shmem_barrier_all();                                                                              \
+    }
+SHMEM_ATOMIC_FETCH_FUNC_TYPE(ATOMIC_FETCH_TEST_KERNEL);
+
+#define ATOMIC_FETCH_TEST(NAME, TYPE)                                                                   \
+    void test_atomic_fetch_##NAME##_do(uint32_t block_dim, void *stream, uint8_t *gva, uint64_t config) \
+    {                                                                                                   \
+        test_atomic_fetch_##NAME##_kernel<<<block_dim, nullptr, stream>>>(gva, config);                 \
+    }
+SHMEM_ATOMIC_FETCH_FUNC_TYPE(ATOMIC_FETCH_TEST);
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "kernel_operator.h"
+
+#include "shmem_api.h"
+#include "unittest/utils/func_type.h"
+constexpr uint32_t P_NBI_TEST_LINES = 20;
+
+/*
+ * gva layout: P_NBI_TEST_LINES cachelines, line i holds i + rank + 1 in its first element and rank + 1 in its second,
+ *             written by the previous PE. More lines than the fence tracker holds, so it overflows once. Drained
+ *             by shmem_fence when use_fence is set, by shmemx_quiet_pe otherwise.
+ */
+#define P_NBI_TEST_KERNEL(NAME, TYPE)                                                                            \
+    extern "C" __global__ __aicore__ void test_p_nbi_##NAME##_kernel(GM_ADDR gva, uint64_t config,               \
+        int use_fence)                                                                                           \
+    {                                                                                                            \
+        shmemx_set_ffts_config(config);                                                                          \
+        int64_t rank = smem_shm_get_global_rank();                                                               \
+        int64_t rank_size = smem_shm_get_global_rank_size();                                                     \
+        int32_t next = (int32_t)((rank + 1) % rank_size);                                                        \
+        __gm__ TYPE *words = (__gm__ TYPE *)gva;                                                                 \
+        constexpr uint32_t stride = SHMEM_DATA_CACHE_LINE_SIZE / sizeof(TYPE);                                   \
+                                                                                                                 \
+        if ASCEND_IS_AIV {                                                                                       \
+            if (AscendC::GetBlockIdx() == 0) {                                                                   \
+                for (uint32_t i = 0; i < P_NBI_TEST_LINES; i++) {                                                \
+                    shmemx_##NAME##_p_nbi(words + i * stride, (TYPE)(i + rank + 1), next);                       \
+                    shmemx_##NAME##_p_nbi(words + i * stride + 1, (TYPE)(rank + 1), next);                       \
+                }                                                                                                \
+                if (use_fence) {                                                                                 \
+                    shmem_fence();                                                                               \
+                } else {                                                                                         \
+                    shmemx_quiet_pe(next);                                                                       \
+                }                                                                                                \
+            }                                                                                                    \
+        }                                                                                                        \
+        shmem_barrier_all();                                                                                     \
+    }
+P_NBI_TEST_KERNEL(int32, int32_t);
+P_NBI_TEST_KERNEL(float, float);
+
+#define P_NBI_TEST(NAME, TYPE)                                                                   \
+    void test_p_nbi_##NAME##_do(uint32_t block_dim, void *stream, uint8_t *gva, uint64_t config, \
+        int use_fence)                                                                           \
+    {                                                                                            \
+        test_p_nbi_##NAME##_kernel<<<block_dim, nullptr, stream>>>(gva, config, use_fence);      \
+    }
+P_NBI_TEST(int32, int32_t);
+P_NBI_TEST(float, float);
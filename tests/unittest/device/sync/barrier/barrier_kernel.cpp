@@ -134,6 +134,29 @@ extern "C" SHMEM_GLOBAL void partial_increase_vec(uint64_t config,
 #endif
 }
 
+extern "C" SHMEM_GLOBAL void increase_split(uint64_t config, GM_ADDR addr, int rank_id, int rank_size) {
+    shmemx_set_ffts_config(config);
+
+#ifdef __DAV_C220_CUBE__
+    // scalar unit of cube core is not affected by barrier
+    shmemx_barrier_wait(SHMEM_TEAM_WORLD, shmemx_barrier_arrive(SHMEM_TEAM_WORLD));
+    shmemx_barrier_wait(SHMEM_TEAM_WORLD, shmemx_barrier_arrive(SHMEM_TEAM_WORLD));
+#endif
+
+#ifdef __DAV_C220_VEC__
+    uint64_t val = shmemi_load((__gm__ uint64_t *)addr);
+
+    int32_t token = shmemx_barrier_arrive(SHMEM_TEAM_WORLD);
+    while (!shmemx_barrier_test(SHMEM_TEAM_WORLD, token)) {
+    }
+    shmemx_barrier_wait(SHMEM_TEAM_WORLD, token);
+    GM_ADDR remote = shmemi_ptr(addr, (rank_id + 1) % rank_size);
+    shmemi_store((__gm__ uint64_t *)remote, val + 1);
+    token = shmemx_barrier_arrive(SHMEM_TEAM_WORLD);
+    shmemx_barrier_wait(SHMEM_TEAM_WORLD, token);
+#endif
+}
+
 void increase_do(void* stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size)
 {
     increase<<<16, nullptr, stream>>>(config, addr, rank_id, rank_size);
@@ -166,4 +189,9 @@ void partial_increase_vec_do(void *stream, uint64_t config,
     uint8_t *addr, uint8_t *pes_addr, uint32_t count, int rank_id, int rank_size, shmem_team_t team_id)
 {
     partial_increase_vec<<<16, nullptr, stream>>>(config, addr, pes_addr, count, rank_id, rank_size, team_id);
-}
\ No newline at end of file
+}
+
+void increase_split_do(void* stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size)
+{
+    increase_split<<<16, nullptr, stream>>>(config, addr, rank_id, rank_size);
+}
@@ -46,4 +46,86 @@ extern "C" SHMEM_GLOBAL void p2p_chain(uint64_t config, GM_ADDR addr, int rank_i
 void p2p_chain_do(void *stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size)
 {
     p2p_chain<<<1, nullptr, stream>>>(config, addr, rank_id, rank_size);
-}
\ No newline at end of file
+}
+
+constexpr int P2P_ANY_MAX_RANKS = 64;
+
+// every rank raises its own slot on PE 0, PE 0 consumes the slots in whatever order they arrive
+extern "C" SHMEM_GLOBAL void p2p_wait_any(uint64_t config, GM_ADDR addr, int rank_id, int rank_size)
+{
+    shmemx_set_ffts_config(config);
+    auto sig_addr = (__gm__ int32_t *)addr;
+
+    shmem_barrier_all();
+
+#ifdef __DAV_C220_VEC__
+    if (AscendC::GetBlockIdx() == 0) {
+        shmemx_signal_op(sig_addr + rank_id, rank_id + 1, SHMEM_SIGNAL_SET, 0);
+        if (rank_id == 0) {
+            int status[P2P_ANY_MAX_RANKS] = {0};
+            size_t indices[P2P_ANY_MAX_RANKS];
+            int32_t expect[P2P_ANY_MAX_RANKS];
+            for (int i = 0; i < rank_size; i++) {
+                expect[i] = i + 1;
+            }
+            int32_t consumed = 0;
+            // first slot with any, the rest in batches with some / some_vector
+            size_t idx = shmem_int32_wait_until_any(sig_addr, rank_size, status, SHMEM_CMP_NE, 0);
+            status[idx] = 1;
+            consumed++;
+            while (consumed < rank_size) {
+                size_t n = (consumed % 2) ?
+                    shmem_int32_wait_until_some(sig_addr, rank_size, indices, status, SHMEM_CMP_NE, 0) :
+                    shmem_int32_wait_until_some_vector(sig_addr, rank_size, indices, status, SHMEM_CMP_EQ, expect);
+                for (size_t i = 0; i < n; i++) {
+                    status[indices[i]] = 1;
+                    consumed++;
+                }
+            }
+            // every slot is excluded now
+            idx = shmem_int32_wait_until_any(sig_addr, rank_size, status, SHMEM_CMP_NE, 0);
+            sig_addr[rank_size] = (idx == SIZE_MAX) ? consumed : -1;
+            dcci_cacheline((__gm__ uint8_t *)(sig_addr + rank_size));
+        }
+    }
+#endif
+
+    shmem_barrier_all();
+}
+
+void p2p_wait_any_do(void *stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size)
+{
+    p2p_wait_any<<<1, nullptr, stream>>>(config, addr, rank_id, rank_size);
+}
+
+extern "C" SHMEM_GLOBAL void p2p_wait_timeout(uint64_t config, GM_ADDR addr, int rank_id, int rank_size,
+                                              int64_t timeout_cycles)
+{
+    shmemx_set_ffts_config(config);
+    auto sig_addr = (__gm__ int32_t *)addr;
+
+    shmem_barrier_all();
+
+#ifdef __DAV_C220_VEC__
+    if (AscendC::GetBlockIdx() == 0) {
+        // one cacheline per word, peers write the signal word while the results are stored locally
+        const int line = SCALAR_DATA_CACHELINE_SIZE / sizeof(int32_t);
+        // nobody ever sets sig_addr[0], the bounded wait has to give up
+        sig_addr[line] = shmemx_signal_wait_until_timeout(sig_addr, SHMEM_CMP_EQ, 1, timeout_cycles);
+        dcci_cacheline((__gm__ uint8_t *)(sig_addr + line));
+
+        int next = (rank_id + 1) % rank_size;
+        shmemx_signal_op(sig_addr + 2 * line, next + 1, SHMEM_SIGNAL_SET, next);
+        sig_addr[3 * line] = shmemx_int32_wait_until_timeout(sig_addr + 2 * line, SHMEM_CMP_EQ, rank_id + 1, 0);
+        dcci_cacheline((__gm__ uint8_t *)(sig_addr + 3 * line));
+    }
+#endif
+
+    shmem_barrier_all();
+}
+
+void p2p_wait_timeout_do(void *stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size,
+                         int64_t timeout_cycles)
+{
+    p2p_wait_timeout<<<1, nullptr, stream>>>(config, addr, rank_id, rank_size, timeout_cycles);
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "shmem_api.h"
+#include "shmemi_host_common.h"
+
+TEST(TestLogRing, DropsWhenFull)
+{
+    shm::log_ring ring;
+    for (size_t i = 0; i < shm::LOG_ASYNC_RING_SIZE; i++) {
+        EXPECT_TRUE(ring.push(std::to_string(i) + "\n"));
+    }
+    EXPECT_FALSE(ring.push("overflow\n"));
+    EXPECT_FALSE(ring.push("overflow\n"));
+    EXPECT_EQ(ring.dropped.load(), 2U);
+
+    std::string batch;
+    EXPECT_EQ(ring.drain(batch), shm::LOG_ASYNC_RING_SIZE);
+    EXPECT_EQ(batch.compare(0, 4, "0\n1\n"), 0);
+    EXPECT_EQ(batch.find("overflow"), std::string::npos);
+    EXPECT_TRUE(ring.push("again\n"));
+    batch.clear();
+    EXPECT_EQ(ring.drain(batch), 1U);
+    EXPECT_EQ(batch, "again\n");
+}
+
+TEST(TestLogAsyncSink, DeliversAllThreads)
+{
+    const int thread_num = 4;
+    const int line_num = 200;
+    std::mutex out_mutex;
+    std::string out;
+    {
+        shm::log_async_sink sink([&out_mutex, &out](const std::string &batch) {
+            std::lock_guard<std::mutex> lock(out_mutex);
+            out += batch;
+        });
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_num; t++) {
+            threads.emplace_back([&sink, t]() {
+                for (int i = 0; i < line_num; i++) {
+                    sink.write_log("t" + std::to_string(t) + "_" + std::to_string(i) + "\n");
+                }
+            });
+        }
+        for (auto &th : threads) {
+            th.join();
+        }
+        sink.flush();
+        EXPECT_EQ(sink.dropped_count(), 0U);
+    }
+    for (int t = 0; t < thread_num; t++) {
+        for (int i = 0; i < line_num; i++) {
+            std::string line = "t" + std::to_string(t) + "_" + std::to_string(i) + "\n";
+            ASSERT_NE(out.find(line), std::string::npos) << line;
+        }
+    }
+}
+
+TEST(TestLogAsyncSink, ReportsDroppedCount)
+{
+    std::mutex out_mutex;
+    std::condition_variable entered_cv;
+    bool entered = false;
+    std::string out;
+    std::mutex gate;
+    std::unique_lock<std::mutex> hold(gate);
+    {
+        // the writer blocks on the first batch so the ring overflows behind it
+        shm::log_async_sink sink([&out_mutex, &entered_cv, &entered, &out, &gate](const std::string &batch) {
+            {
+                std::lock_guard<std::mutex> lock(out_mutex);
+                entered = true;
+            }
+            entered_cv.notify_all();
+            std::lock_guard<std::mutex> wait_gate(gate);
+            std::lock_guard<std::mutex> lock(out_mutex);
+            out += batch;
+        });
+        sink.write_log("first\n");
+        {
+            std::unique_lock<std::mutex> lock(out_mutex);
+            entered_cv.wait(lock, [&entered]() { return entered; });
+        }
+        for (size_t i = 0; i < shm::LOG_ASYNC_RING_SIZE + 10; i++) {
+            sink.write_log("x\n");
+        }
+        hold.unlock();
+        sink.flush();
+        sink.flush();
+        EXPECT_EQ(sink.dropped_count(), 10U);
+    }
+    EXPECT_NE(out.find("10 log messages dropped"), std::string::npos);
+}
+
+TEST(TestLogMacro, SkipsFormattingBelowLevel)
+{
+    auto &logger = shm::shm_out_logger::Instance();
+    int evaluated = 0;
+    auto count = [&evaluated]() { return ++evaluated; };
+    ASSERT_EQ(logger.set_log_level(shm::FATAL_LEVEL), SHMEM_SUCCESS);
+    // an external log function takes every level, otherwise the arguments must not be formatted at all
+    int expect = logger.enabled(shm::DEBUG_LEVEL) ? 1 : 0;
+    SHM_LOG_DEBUG("value " << count());
+    EXPECT_EQ(evaluated, expect);
+    ASSERT_EQ(logger.set_log_level(shm::WARN_LEVEL), SHMEM_SUCCESS);
+}
@@ -1,9 +1,12 @@
 /*
  * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
  */
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <sstream>
+#include <vector>
 #include <unistd.h>
 #include <acl/acl.h>
 #include <netinet/in.h>
@@ -86,6 +89,57 @@ void test_shmem_init_attr(int rank_id, int n_ranks, uint64_t local_mem_size)
     }
 }
 
+// host emulation backend end to end: no device is set, RMA, shmem_p/g and barriers run on the loopback domain
+void test_shmem_init_attr_host(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    const size_t count = 1024;
+    shmem_init_attr_t *attributes = new shmem_init_attr_t{
+        rank_id, n_ranks, {}, local_mem_size, {0, SHMEM_DATA_OP_HOST, 120, 120, 120}};
+    std::copy_n(test_global_ipport, SHMEM_MAX_IP_PORT_LEN, attributes->ip_port);
+    int status = shmem_init_attr(attributes);
+    delete attributes;
+    ASSERT_EQ(status, SHMEM_SUCCESS);
+    EXPECT_EQ(shmem_init_status(), SHMEM_STATUS_IS_INITIALIZED);
+    EXPECT_EQ(shmem_team_my_pe(SHMEM_TEAM_WORLD), rank_id);
+    EXPECT_EQ(shmem_team_n_pes(SHMEM_TEAM_WORLD), n_ranks);
+    int algo = -1;
+    int k = -1;
+    double predicted_us = 0;
+    EXPECT_EQ(shmemx_team_barrier_info(SHMEM_TEAM_WORLD, &algo, &k, &predicted_us), SHMEM_SUCCESS);
+    shmem_team_t new_team = SHMEM_TEAM_INVALID;
+    EXPECT_NE(shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 1, n_ranks, &new_team), SHMEM_SUCCESS);
+    EXPECT_EQ(new_team, SHMEM_TEAM_INVALID);
+
+    int next_pe = (rank_id + 1) % n_ranks;
+    int prev_pe = (rank_id + n_ranks - 1) % n_ranks;
+    int32_t *sym_ptr = (int32_t *)shmem_malloc(count * sizeof(int32_t) + sizeof(int32_t));
+    ASSERT_NE(sym_ptr, nullptr);
+    std::vector<int32_t> in(count);
+    for (size_t i = 0; i < count; i++) {
+        in[i] = rank_id * 100000 + static_cast<int32_t>(i);
+    }
+    shmem_putmem(sym_ptr, in.data(), count * sizeof(int32_t), next_pe);
+    shmem_int32_p(sym_ptr + count, rank_id, next_pe);
+    shmemx_barrier_all_on_stream(nullptr);
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_EQ(sym_ptr[i], prev_pe * 100000 + static_cast<int32_t>(i));
+    }
+    EXPECT_EQ(sym_ptr[count], prev_pe);
+
+    std::vector<int32_t> out(count, -1);
+    shmem_getmem(out.data(), sym_ptr, count * sizeof(int32_t), next_pe);
+    EXPECT_EQ(out, in);
+    EXPECT_EQ(shmem_int32_g(sym_ptr + count, next_pe), rank_id);
+    shmemx_barrier_all_on_stream(nullptr);
+
+    shmem_free(sym_ptr);
+    EXPECT_EQ(shmem_finalize(), SHMEM_SUCCESS);
+    EXPECT_EQ(shmem_init_status(), SHMEM_STATUS_NOT_INITIALIZED);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
 void test_shmem_init_invalid_rank_id(int rank_id, int n_ranks, uint64_t local_mem_size)
 {
     int erank_id = -1;
@@ -294,6 +348,13 @@ TEST(TestInitAPI, TestShmemInitAttr)
     test_mutil_task(test_shmem_init_attr, local_mem_size, process_count);
 }
 
+TEST(TestInitAPI, TestShmemInitAttrHost)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 16UL * 1024UL * 1024UL;
+    test_mutil_task(test_shmem_init_attr_host, local_mem_size, process_count);
+}
+
 TEST(TestInitAPI, TestShmemInitErrorInvalidRankId)
 {
     const int process_count = test_gnpu_num;
@@ -372,6 +433,36 @@ TEST(TestInitAPI, TestInfoGetNameNull)
     EXPECT_EQ(input, nullptr);
 }
 
+TEST(TestInitAPI, TestShmemRouteInit)
+{
+    int32_t saved_npes = shm::g_state.npes;
+    int32_t saved_mype = shm::g_state.mype;
+    std::vector<uint8_t> saved_topo(shm::g_state.topo_list, shm::g_state.topo_list + SHMEM_MAX_RANKS);
+    std::vector<uint8_t> saved_route(shm::g_state.route_list, shm::g_state.route_list + SHMEM_MAX_RANKS);
+
+    shm::g_state.npes = 5;
+    shm::g_state.mype = 0;
+    shm::g_state.topo_list[0] = SHMEM_TRANSPORT_MTE | SHMEM_TRANSPORT_SDMA;
+    shm::g_state.topo_list[1] = SHMEM_TRANSPORT_MTE | SHMEM_TRANSPORT_ROCE;
+    shm::g_state.topo_list[2] = SHMEM_TRANSPORT_ROCE;
+    shm::g_state.topo_list[3] = SHMEM_TRANSPORT_SDMA;
+    shm::g_state.topo_list[4] = 0;
+    memset(shm::g_state.route_list, 0xff, SHMEM_MAX_RANKS);
+    shm::shmemi_route_init();
+    EXPECT_EQ(shm::g_state.route_list[0], SHMEM_TRANSPORT_MTE);
+    EXPECT_EQ(shm::g_state.route_list[1], SHMEM_TRANSPORT_MTE);
+    EXPECT_EQ(shm::g_state.route_list[2], SHMEM_TRANSPORT_ROCE);
+    EXPECT_EQ(shm::g_state.route_list[3], 0);
+    EXPECT_EQ(shm::g_state.route_list[4], 0);
+    // entries past npes are left alone
+    EXPECT_EQ(shm::g_state.route_list[5], 0xff);
+
+    shm::g_state.npes = saved_npes;
+    shm::g_state.mype = saved_mype;
+    std::copy(saved_topo.begin(), saved_topo.end(), shm::g_state.topo_list);
+    std::copy(saved_route.begin(), saved_route.end(), shm::g_state.route_list);
+}
+
 TEST(TestInitAPI, TestShmemGlobalExit)
 {
     const int process_count = test_gnpu_num;
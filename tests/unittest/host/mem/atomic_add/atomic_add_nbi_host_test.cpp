@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+
+extern int test_gnpu_num;
+extern int test_first_npu;
+extern void test_mutil_task(std::function<void(int, int, uint64_t)> func, uint64_t local_mem_size, int processCount);
+extern void test_init(int rank_id, int n_ranks, uint64_t local_mem_size, aclrtStream *st);
+extern void test_finalize(aclrtStream stream, int device_id);
+
+constexpr size_t NBI_TEST_BYTES = 1024;
+
+#define TEST_ATOMIC_ADD_NBI_FUNC(NAME, TYPE) \
+    extern void test_atomic_add_nbi_##NAME##_do(uint32_t block_dim, void *stream, uint8_t *gva, uint64_t config)
+TEST_ATOMIC_ADD_NBI_FUNC(int32, int32_t);
+TEST_ATOMIC_ADD_NBI_FUNC(float, float);
+
+// every PE adds rank + 1 to each PE with atomic_add_nbi and 1 twice to each PE with the device atomic_add_vec
+#define TEST_SHMEM_ATOMIC_ADD_NBI_HOST(NAME, TYPE)                                                          \
+    static void test_atomic_add_nbi_##NAME##_host(aclrtStream stream, uint32_t rank_size)                   \
+    {                                                                                                       \
+        uint8_t *ptr = (uint8_t *)shmem_malloc(NBI_TEST_BYTES);                                             \
+        ASSERT_NE(ptr, nullptr);                                                                            \
+        ASSERT_EQ(aclrtMemset(ptr, NBI_TEST_BYTES, 0, NBI_TEST_BYTES), 0);                                  \
+        shm::shmemi_control_barrier_all();                                                                  \
+                                                                                                            \
+        test_atomic_add_nbi_##NAME##_do(1, stream, ptr, shmemx_get_ffts_config());                          \
+        ASSERT_EQ(aclrtSynchronizeStream(stream), 0);                                                       \
+                                                                                                            \
+        TYPE out[2];                                                                                        \
+        ASSERT_EQ(aclrtMemcpy(out, sizeof(out), ptr, sizeof(out), ACL_MEMCPY_DEVICE_TO_HOST), 0);           \
+        ASSERT_EQ(out[0], static_cast<TYPE>(rank_size * (rank_size + 1) / 2));                              \
+        ASSERT_EQ(out[1], static_cast<TYPE>(2 * rank_size));                                                \
+        shm::shmemi_control_barrier_all();                                                                  \
+        shmem_free(ptr);                                                                                    \
+    }                                                                                                       \
+                                                                                                            \
+    void test_shmem_atomic_add_nbi_##NAME(int rank_id, int n_ranks, uint64_t local_mem_size)                \
+    {                                                                                                       \
+        int32_t device_id = rank_id % test_gnpu_num + test_first_npu;                                       \
+        aclrtStream stream;                                                                                 \
+        test_init(rank_id, n_ranks, local_mem_size, &stream);                                               \
+        ASSERT_NE(stream, nullptr);                                                                         \
+        test_atomic_add_nbi_##NAME##_host(stream, n_ranks);                                                 \
+        std::cout << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;                        \
+        test_finalize(stream, device_id);                                                                   \
+        if (::testing::Test::HasFailure()) {                                                                \
+            exit(1);                                                                                        \
+        }                                                                                                   \
+    }                                                                                                       \
+                                                                                                            \
+    TEST(TestMemApi, TestShmemAtomicAddNbi##NAME)                                                           \
+    {                                                                                                       \
+        const int processCount = test_gnpu_num;                                                             \
+        uint64_t local_mem_size = 1024UL * 1024UL * 64;                                                     \
+        test_mutil_task(test_shmem_atomic_add_nbi_##NAME, local_mem_size, processCount);                    \
+    }
+
+TEST_SHMEM_ATOMIC_ADD_NBI_HOST(int32, int32_t);
+TEST_SHMEM_ATOMIC_ADD_NBI_HOST(float, float);
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+
+extern int test_gnpu_num;
+extern int test_first_npu;
+extern void test_mutil_task(std::function<void(int, int, uint64_t)> func, uint64_t local_mem_size, int processCount);
+extern void test_init(int rank_id, int n_ranks, uint64_t local_mem_size, aclrtStream *st);
+extern void test_finalize(aclrtStream stream, int device_id);
+
+constexpr int ADD_VEC_ROUNDS = 3;
+
+// every PE scatters many small updates over all PEs, several of them hitting the same PE
+#define TEST_SHMEM_ATOMIC_ADD_VEC_HOST(NAME, TYPE)                                                   \
+    static void test_atomic_add_vec_##NAME##_host(int rank_id, int n_ranks)                          \
+    {                                                                                                \
+        const size_t n = 8 * n_ranks + 3;                                                            \
+        TYPE *ptr = (TYPE *)shmem_malloc(sizeof(TYPE));                                              \
+        ASSERT_NE(ptr, nullptr);                                                                     \
+        ASSERT_EQ(aclrtMemset(ptr, sizeof(TYPE), 0, sizeof(TYPE)), 0);                               \
+        shm::shmemi_control_barrier_all();                                                           \
+                                                                                                     \
+        std::vector<TYPE> values(n);                                                                 \
+        std::vector<int> pes(n);                                                                     \
+        for (size_t i = 0; i < n; i++) {                                                             \
+            pes[i] = static_cast<int>((i * 7 + rank_id) % n_ranks);                                  \
+            values[i] = static_cast<TYPE>(1);                                                        \
+        }                                                                                            \
+        /* back to back calls alternate the staging halves */                                        \
+        for (int round = 0; round < ADD_VEC_ROUNDS; round++) {                                       \
+            ASSERT_EQ(shmemx_##NAME##_atomic_add_vec(ptr, values.data(), pes.data(), n), 0);         \
+        }                                                                                            \
+        ASSERT_EQ(aclrtSynchronizeStream(shm::g_state_host.default_stream), 0);                      \
+        shm::shmemi_control_barrier_all();                                                           \
+                                                                                                     \
+        /* each PE computes how many updates every rank sent to it */                                \
+        size_t expect = 0;                                                                           \
+        for (int r = 0; r < n_ranks; r++) {                                                          \
+            for (size_t i = 0; i < n; i++) {                                                         \
+                expect += ((i * 7 + r) % n_ranks) == static_cast<size_t>(rank_id) ? 1 : 0;           \
+            }                                                                                        \
+        }                                                                                            \
+        TYPE out;                                                                                    \
+        ASSERT_EQ(aclrtMemcpy(&out, sizeof(TYPE), ptr, sizeof(TYPE), ACL_MEMCPY_DEVICE_TO_HOST), 0); \
+        ASSERT_EQ(out, static_cast<TYPE>(expect * ADD_VEC_ROUNDS));                                  \
+                                                                                                     \
+        /* invalid PE rejects the whole vector */                                                    \
+        pes[0] = n_ranks;                                                                            \
+        ASSERT_NE(shmemx_##NAME##_atomic_add_vec(ptr, values.data(), pes.data(), n), 0);             \
+        shm::shmemi_control_barrier_all();                                                           \
+        shmem_free(ptr);                                                                             \
+    }                                                                                                \
+                                                                                                     \
+    void test_shmem_atomic_add_vec_##NAME(int rank_id, int n_ranks, uint64_t local_mem_size)         \
+    {                                                                                                \
+        int32_t device_id = rank_id % test_gnpu_num + test_first_npu;                                \
+        aclrtStream stream;                                                                          \
+        test_init(rank_id, n_ranks, local_mem_size, &stream);                                        \
+        ASSERT_NE(stream, nullptr);                                                                  \
+        test_atomic_add_vec_##NAME##_host(rank_id, n_ranks);                                         \
+        std::cout << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;                 \
+        test_finalize(stream, device_id);                                                            \
+        if (::testing::Test::HasFailure()) {                                                         \
+            exit(1);                                                                                 \
+        }                                                                                            \
+    }                                                                                                \
+                                                                                                     \
+    TEST(TestMemApi, TestShmemxAtomicAddVec##NAME)                                                   \
+    {                                                                                                \
+        const int processCount = test_gnpu_num;                                                      \
+        uint64_t local_mem_size = 1024UL * 1024UL * 64;                                              \
+        test_mutil_task(test_shmem_atomic_add_vec_##NAME, local_mem_size, processCount);             \
+    }
+
+TEST_SHMEM_ATOMIC_ADD_VEC_HOST(int32, int32_t);
+TEST_SHMEM_ATOMIC_ADD_VEC_HOST(float, float);
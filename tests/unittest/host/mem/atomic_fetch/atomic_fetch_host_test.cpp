@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+#include "func_type.h"
+
+extern int test_gnpu_num;
+extern int test_first_npu;
+extern void test_mutil_task(std::function<void(int, int, uint64_t)> func, uint64_t local_mem_size, int processCount);
+extern void test_init(int rank_id, int n_ranks, uint64_t local_mem_size, aclrtStream *st);
+extern void test_finalize(aclrtStream stream, int device_id);
+
+constexpr uint64_t FETCH_TEST_ITERS = 16;
+
+TEST(TestAtomicReference, FetchingSemantics)
+{
+    shm::atomic_reference<int64_t> ref(2, 5);
+    EXPECT_EQ(ref.fetch_add(0, 3), 5);
+    EXPECT_EQ(ref.fetch(0), 8);
+    EXPECT_EQ(ref.compare_swap(0, 7, 100), 8);
+    EXPECT_EQ(ref.fetch(0), 8);
+    EXPECT_EQ(ref.compare_swap(0, 8, 100), 8);
+    EXPECT_EQ(ref.fetch(0), 100);
+    EXPECT_EQ(ref.swap(1, -1), 5);
+    EXPECT_EQ(ref.fetch(1), -1);
+
+    shm::atomic_reference<uint32_t> wrap(1, UINT32_MAX);
+    EXPECT_EQ(wrap.fetch_add(0, 2), UINT32_MAX);
+    EXPECT_EQ(wrap.fetch(0), 1U);
+}
+
+TEST(TestAtomicReference, ConcurrentTicketsAreUnique)
+{
+    const int n_threads = 8;
+    shm::atomic_reference<uint64_t> ref(1);
+    std::vector<std::vector<uint64_t>> tickets(n_threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < n_threads; t++) {
+        threads.emplace_back([&ref, &tickets, t]() {
+            for (uint64_t i = 0; i < FETCH_TEST_ITERS; i++) {
+                tickets[t].push_back(ref.fetch_add(0, 1));
+            }
+        });
+    }
+    for (auto &th : threads) {
+        th.join();
+    }
+    std::vector<uint64_t> all;
+    for (auto &v : tickets) {
+        all.insert(all.end(), v.begin(), v.end());
+    }
+    std::sort(all.begin(), all.end());
+    for (size_t i = 0; i < all.size(); i++) {
+        ASSERT_EQ(all[i], i);
+    }
+    EXPECT_EQ(ref.fetch(0), n_threads * FETCH_TEST_ITERS);
+}
+
+#define TEST_ATOMIC_FETCH_FUNC(NAME, TYPE) \
+    extern void test_atomic_fetch_##NAME##_do(uint32_t block_dim, void *stream, uint8_t *gva, uint64_t config)
+SHMEM_ATOMIC_FETCH_FUNC_TYPE(TEST_ATOMIC_FETCH_FUNC);
+
+#define TEST_SHMEM_ATOMIC_FETCH_HOST(NAME, TYPE)                                                          \
+    static void test_atomic_fetch_##NAME##_host(aclrtStream stream, uint32_t rank_id, uint32_t rank_size) \
+    {                                                                                                     \
+        size_t words = 3 + FETCH_TEST_ITERS;                                                              \
+        TYPE *ptr = (TYPE *)shmem_malloc(words * sizeof(TYPE));                                           \
+        ASSERT_NE(ptr, nullptr);                                                                          \
+        ASSERT_EQ(aclrtMemset(ptr, words * sizeof(TYPE), 0, words * sizeof(TYPE)), 0);                    \
+        shm::shmemi_control_barrier_all();                                                                \
+                                                                                                          \
+        /* device side: tickets from PE 0's counter, then a compare_swap / swap chain on PE 0's word */   \
+        test_atomic_fetch_##NAME##_do(1, stream, (uint8_t *)ptr, shmemx_get_ffts_config());               \
+        ASSERT_EQ(aclrtSynchronizeStream(stream), 0);                                                     \
+                                                                                                          \
+        std::vector<TYPE> all;                                                                            \
+        std::vector<TYPE> prevs;                                                                          \
+        for (uint32_t pe = 0; pe < rank_size; pe++) {                                                     \
+            for (uint64_t i = 0; i < FETCH_TEST_ITERS; i++) {                                             \
+                all.push_back(shmem_##NAME##_g(ptr + 2 + i, pe));                                         \
+            }                                                                                             \
+            prevs.push_back(shmem_##NAME##_g(ptr + 2 + FETCH_TEST_ITERS, pe));                            \
+        }                                                                                                 \
+        std::sort(all.begin(), all.end());                                                                \
+        for (size_t i = 0; i < all.size(); i++) {                                                         \
+            ASSERT_EQ(all[i], static_cast<TYPE>(i));                                                      \
+        }                                                                                                 \
+        ASSERT_EQ(shmem_##NAME##_atomic_fetch(ptr, 0), static_cast<TYPE>(rank_size * FETCH_TEST_ITERS));  \
+        /* exactly one PE saw the initial 0, every other returned value is a distinct rank + 1 */         \
+        std::sort(prevs.begin(), prevs.end());                                                            \
+        ASSERT_EQ(prevs[0], static_cast<TYPE>(0));                                                        \
+        for (size_t i = 1; i < prevs.size(); i++) {                                                       \
+            ASSERT_NE(prevs[i], prevs[i - 1]);                                                            \
+        }                                                                                                 \
+        shm::shmemi_control_barrier_all();                                                                \
+                                                                                                          \
+        /* host side, checked against the CPU reference replaying the same operations */                  \
+        shm::atomic_reference<TYPE> ref(1, shmem_##NAME##_atomic_fetch(ptr, 0));                          \
+        shm::shmemi_control_barrier_all();                                                                \
+        if (rank_id == 0) {                                                                               \
+            ASSERT_EQ(shmem_##NAME##_atomic_fetch_add(ptr, 7, 0), ref.fetch_add(0, 7));                   \
+            ASSERT_EQ(shmem_##NAME##_atomic_compare_swap(ptr, 1, 2, 0), ref.compare_swap(0, 1, 2));       \
+            TYPE cur = ref.fetch(0);                                                                      \
+            ASSERT_EQ(shmem_##NAME##_atomic_compare_swap(ptr, cur, 42, 0), ref.compare_swap(0, cur, 42)); \
+            ASSERT_EQ(shmem_##NAME##_atomic_swap(ptr, 9, 0), ref.swap(0, 9));                             \
+            ASSERT_EQ(shmem_##NAME##_atomic_fetch(ptr, 0), ref.fetch(0));                                 \
+        }                                                                                                 \
+        shm::shmemi_control_barrier_all();                                                                \
+        shmem_free(ptr);                                                                                  \
+    }
+SHMEM_ATOMIC_FETCH_FUNC_TYPE(TEST_SHMEM_ATOMIC_FETCH_HOST);
+
+#define TEST_SHMEM_ATOMIC_FETCH(NAME, TYPE)                                                      \
+    void test_shmem_atomic_fetch_##NAME##_mem(int rank_id, int n_ranks, uint64_t local_mem_size) \
+    {                                                                                            \
+        int32_t device_id = rank_id % test_gnpu_num + test_first_npu;                            \
+        aclrtStream stream;                                                                      \
+        test_init(rank_id, n_ranks, local_mem_size, &stream);                                    \
+        ASSERT_NE(stream, nullptr);                                                              \
+        test_atomic_fetch_##NAME##_host(stream, rank_id, n_ranks);                               \
+        std::cout << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;             \
+        test_finalize(stream, device_id);                                                        \
+        if (::testing::Test::HasFailure()) {                                                     \
+            exit(1);                                                                             \
+        }                                                                                        \
+    }
+SHMEM_ATOMIC_FETCH_FUNC_TYPE(TEST_SHMEM_ATOMIC_FETCH);
+
+#define TEST_ATOMIC_FETCH_API(NAME, TYPE)                                                    \
+    TEST(TestMemApi, TestShmemAtomicFetch##NAME##Mem)                                        \
+    {                                                                                        \
+        const int processCount = test_gnpu_num;                                              \
+        uint64_t local_mem_size = 1024UL * 1024UL * 64;                                      \
+        test_mutil_task(test_shmem_atomic_fetch_##NAME##_mem, local_mem_size, processCount); \
+    }
+SHMEM_ATOMIC_FETCH_FUNC_TYPE(TEST_ATOMIC_FETCH_API);
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+
+extern int test_gnpu_num;
+extern int test_first_npu;
+extern void test_mutil_task(std::function<void(int, int, uint64_t)> func, uint64_t local_mem_size, int processCount);
+extern void test_init(int rank_id, int n_ranks, uint64_t local_mem_size, aclrtStream *st);
+extern void test_finalize(aclrtStream stream, int device_id);
+
+constexpr size_t P_NBI_TEST_BYTES = 4096;
+constexpr uint32_t P_NBI_TEST_LINES = 20;
+constexpr uint32_t P_NBI_TEST_LINE_BYTES = 64;
+
+#define TEST_P_NBI_FUNC(NAME, TYPE) \
+    extern void test_p_nbi_##NAME##_do(uint32_t block_dim, void *stream, uint8_t *gva, uint64_t config, \
+        int use_fence)
+TEST_P_NBI_FUNC(int32, int32_t);
+TEST_P_NBI_FUNC(float, float);
+
+// every PE stores two elements into each of P_NBI_TEST_LINES cachelines of the next PE and drains them with
+// shmemx_quiet_pe, or with shmem_fence when use_fence is set
+#define TEST_SHMEM_P_NBI_HOST(NAME, TYPE)                                                                   \
+    static void test_p_nbi_##NAME##_host(aclrtStream stream, uint32_t rank_id, uint32_t rank_size,          \
+        int use_fence)                                                                                      \
+    {                                                                                                       \
+        uint8_t *ptr = (uint8_t *)shmem_malloc(P_NBI_TEST_BYTES);                                           \
+        ASSERT_NE(ptr, nullptr);                                                                            \
+        ASSERT_EQ(aclrtMemset(ptr, P_NBI_TEST_BYTES, 0, P_NBI_TEST_BYTES), 0);                              \
+        shm::shmemi_control_barrier_all();                                                                  \
+                                                                                                            \
+        test_p_nbi_##NAME##_do(1, stream, ptr, shmemx_get_ffts_config(), use_fence);                        \
+        ASSERT_EQ(aclrtSynchronizeStream(stream), 0);                                                       \
+                                                                                                            \
+        constexpr uint32_t stride = P_NBI_TEST_LINE_BYTES / sizeof(TYPE);                                 \
+        std::vector<TYPE> out(P_NBI_TEST_BYTES / sizeof(TYPE));                                             \
+        ASSERT_EQ(aclrtMemcpy(out.data(), P_NBI_TEST_BYTES, ptr, P_NBI_TEST_BYTES,                          \
+                              ACL_MEMCPY_DEVICE_TO_HOST), 0);                                               \
+        uint32_t prev = (rank_id + rank_size - 1) % rank_size;                                              \
+        for (uint32_t i = 0; i < P_NBI_TEST_LINES; i++) {                                                   \
+            ASSERT_EQ(out[i * stride], static_cast<TYPE>(i + prev + 1)) << "line " << i;                    \
+            ASSERT_EQ(out[i * stride + 1], static_cast<TYPE>(prev + 1)) << "line " << i;                    \
+        }                                                                                                   \
+        shm::shmemi_control_barrier_all();                                                                  \
+        shmem_free(ptr);                                                                                    \
+    }                                                                                                       \
+                                                                                                            \
+    void test_shmem_p_nbi_##NAME(int rank_id, int n_ranks, uint64_t local_mem_size)                         \
+    {                                                                                                       \
+        int32_t device_id = rank_id % test_gnpu_num + test_first_npu;                                       \
+        aclrtStream stream;                                                                                 \
+        test_init(rank_id, n_ranks, local_mem_size, &stream);                                               \
+        ASSERT_NE(stream, nullptr);                                                                         \
+        test_p_nbi_##NAME##_host(stream, rank_id, n_ranks, 0);                                              \
+        test_p_nbi_##NAME##_host(stream, rank_id, n_ranks, 1);                                              \
+        std::cout << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;                        \
+        test_finalize(stream, device_id);                                                                   \
+        if (::testing::Test::HasFailure()) {                                                                \
+            exit(1);                                                                                        \
+        }                                                                                                   \
+    }                                                                                                       \
+                                                                                                            \
+    TEST(TestScalarApi, TestShmemPNbi##NAME)                                                                \
+    {                                                                                                       \
+        const int processCount = test_gnpu_num;                                                             \
+        uint64_t local_mem_size = 1024UL * 1024UL * 64;                                                     \
+        test_mutil_task(test_shmem_p_nbi_##NAME, local_mem_size, processCount);                             \
+    }
+
+TEST_SHMEM_P_NBI_HOST(int32, int32_t);
+TEST_SHMEM_P_NBI_HOST(float, float);
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "acl/acl.h"
+#include "shmem_api.h"
+#include "shmemi_host_common.h"
+
+using namespace std;
+
+extern int test_gnpu_num;
+extern int test_first_npu;
+extern void test_mutil_task(std::function<void(int, int, uint64_t)> func, uint64_t local_mem_size, int process_count);
+extern void test_init(int rank_id, int n_ranks, uint64_t local_mem_size, aclrtStream *st);
+extern void test_finalize(aclrtStream stream, int device_id);
+
+// the on-stream barrier drains pending shmem_p before it is launched
+static void test_barrier_all()
+{
+    shmemx_barrier_all_on_stream(nullptr);
+    ASSERT_EQ(aclrtSynchronizeStream(shm::g_state_host.default_stream), 0);
+}
+
+static void host_test_p_aggregate(int rank_id, int n_ranks)
+{
+    // more than one ring half so that both the full-ring launch and the barrier flush are exercised
+    const size_t count = shm::P_AGG_RING_SLOTS * 2 + 17;
+    int next_pe = (rank_id + 1) % n_ranks;
+    int prev_pe = (rank_id + n_ranks - 1) % n_ranks;
+
+    int32_t *sym_ptr = (int32_t *)shmem_malloc(count * sizeof(int32_t));
+    ASSERT_NE(sym_ptr, nullptr);
+    ASSERT_EQ(aclrtMemset(sym_ptr, count * sizeof(int32_t), 0, count * sizeof(int32_t)), 0);
+    test_barrier_all();
+
+    for (size_t i = 0; i < count; i++) {
+        shmem_int32_p(sym_ptr + i, rank_id * 100000 + static_cast<int32_t>(i), next_pe);
+    }
+    test_barrier_all();
+
+    std::vector<int32_t> out(count, 0);
+    ASSERT_EQ(aclrtMemcpy(out.data(), count * sizeof(int32_t), sym_ptr, count * sizeof(int32_t),
+                          ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_EQ(out[i], prev_pe * 100000 + static_cast<int32_t>(i));
+    }
+
+    // read back what this PE wrote on the next PE with one vectorized get
+    std::vector<int32_t *> srcs(count);
+    std::vector<int> pes(count, next_pe);
+    for (size_t i = 0; i < count; i++) {
+        srcs[i] = sym_ptr + i;
+    }
+    std::vector<int32_t> values(count, -1);
+    ASSERT_EQ(shmemx_int32_g_vec(values.data(), srcs.data(), pes.data(), count), 0);
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_EQ(values[i], rank_id * 100000 + static_cast<int32_t>(i));
+    }
+    ASSERT_EQ(shmem_int32_g(sym_ptr + count - 1, next_pe), rank_id * 100000 + static_cast<int32_t>(count - 1));
+
+    test_barrier_all();
+    shmem_free(sym_ptr);
+}
+
+void test_host_shmem_p_aggregate(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    host_test_p_aggregate(rank_id, n_ranks);
+    std::cout << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TestPAggregateHostApi, TestShmemPAggregateAndGVec)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 1024;
+    test_mutil_task(
+        [this](int rank_id, int n_ranks, uint64_t local_mem_size) {
+            test_host_shmem_p_aggregate(rank_id, n_ranks, local_mem_size);
+        },
+        local_mem_size, process_count);
+}
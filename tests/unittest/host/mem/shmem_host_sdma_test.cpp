@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "acl/acl.h"
+#include "shmem_api.h"
+#include "shmemi_host_common.h"
+
+using namespace std;
+
+extern int test_gnpu_num;
+extern int test_first_npu;
+extern void test_mutil_task(std::function<void(int, int, uint64_t)> func, uint64_t local_mem_size, int process_count);
+extern void test_init(int rank_id, int n_ranks, uint64_t local_mem_size, aclrtStream *st);
+extern void test_finalize(aclrtStream stream, int device_id);
+
+// small enough that the test buffers take the SDMA path on SDMA reachable peers
+constexpr uint64_t SDMA_TEST_MIN_BYTES = 4096;
+constexpr size_t SDMA_TEST_COUNT = 64 * 1024;
+
+static void host_test_sdma_eligible(int rank_id, int n_ranks)
+{
+    uint64_t saved_min = shm::g_state_host.sdma_min_bytes;
+    shm::g_state_host.sdma_min_bytes = SDMA_TEST_MIN_BYTES;
+    int next_pe = (rank_id + 1) % n_ranks;
+    uint8_t *base = static_cast<uint8_t *>(shm::g_state.heap_base);
+    uint64_t size = shm::g_state.heap_size;
+
+    // threshold
+    EXPECT_FALSE(shm::sdma_eligible(base, SDMA_TEST_MIN_BYTES - 1, next_pe));
+    shm::g_state_host.sdma_min_bytes = 0;
+    EXPECT_FALSE(shm::sdma_eligible(base, SDMA_TEST_MIN_BYTES, next_pe));
+    shm::g_state_host.sdma_min_bytes = SDMA_TEST_MIN_BYTES;
+
+    // peer and heap bounds
+    EXPECT_FALSE(shm::sdma_eligible(base, SDMA_TEST_MIN_BYTES, -1));
+    EXPECT_FALSE(shm::sdma_eligible(base, SDMA_TEST_MIN_BYTES, n_ranks));
+    EXPECT_FALSE(shm::sdma_eligible(base - 1, SDMA_TEST_MIN_BYTES, next_pe));
+    EXPECT_FALSE(shm::sdma_eligible(base + size, SDMA_TEST_MIN_BYTES, next_pe));
+    EXPECT_FALSE(shm::sdma_eligible(base + size - SDMA_TEST_MIN_BYTES + 1, SDMA_TEST_MIN_BYTES, next_pe));
+    EXPECT_FALSE(shm::sdma_eligible(base, size + 1, next_pe));
+
+    bool reachable = (shm::g_state.topo_list[next_pe] & SHMEM_TRANSPORT_SDMA) != 0;
+    EXPECT_EQ(shm::sdma_eligible(base, SDMA_TEST_MIN_BYTES, next_pe), reachable);
+    EXPECT_EQ(shm::sdma_eligible(base + size - SDMA_TEST_MIN_BYTES, SDMA_TEST_MIN_BYTES, next_pe), reachable);
+    shm::g_state_host.sdma_min_bytes = saved_min;
+}
+
+static void host_test_sdma_order(int rank_id, int n_ranks, aclrtStream other_stream)
+{
+    uint64_t saved_min = shm::g_state_host.sdma_min_bytes;
+    shm::g_state_host.sdma_min_bytes = SDMA_TEST_MIN_BYTES;
+    int next_pe = (rank_id + 1) % n_ranks;
+    int prev_pe = (rank_id + n_ranks - 1) % n_ranks;
+    size_t bytes = SDMA_TEST_COUNT * sizeof(int32_t);
+
+    int32_t *sym_ptr = (int32_t *)shmem_malloc(bytes);
+    ASSERT_NE(sym_ptr, nullptr);
+    void *local = nullptr;
+    ASSERT_EQ(aclrtMalloc(&local, bytes, ACL_MEM_MALLOC_NORMAL_ONLY), 0);
+    void *marker = nullptr;
+    ASSERT_EQ(aclrtMalloc(&marker, sizeof(int32_t), ACL_MEM_MALLOC_NORMAL_ONLY), 0);
+    int32_t marker_value = -1 - rank_id;
+    ASSERT_EQ(aclrtMemcpy(marker, sizeof(int32_t), &marker_value, sizeof(int32_t), ACL_MEMCPY_HOST_TO_DEVICE), 0);
+    std::vector<int32_t> in(SDMA_TEST_COUNT);
+    for (size_t i = 0; i < SDMA_TEST_COUNT; i++) {
+        in[i] = rank_id * 100000 + static_cast<int32_t>(i);
+    }
+    ASSERT_EQ(aclrtMemcpy(local, bytes, in.data(), bytes, ACL_MEMCPY_HOST_TO_DEVICE), 0);
+    ASSERT_EQ(aclrtMemset(sym_ptr, bytes, 0, bytes), 0);
+    shmemx_barrier_all_on_stream(nullptr);
+    ASSERT_EQ(aclrtSynchronizeStream(shm::g_state_host.default_stream), 0);
+
+    // the small put below the threshold is a kernel of the default stream, it has to land after the bulk copy
+    shmem_putmem_nbi(sym_ptr, local, bytes, next_pe);
+    shmem_putmem_nbi(sym_ptr, marker, sizeof(int32_t), next_pe);
+    shmemx_barrier_all_on_stream(nullptr);
+    ASSERT_EQ(aclrtSynchronizeStream(shm::g_state_host.default_stream), 0);
+
+    std::vector<int32_t> out(SDMA_TEST_COUNT, 0);
+    ASSERT_EQ(aclrtMemcpy(out.data(), bytes, sym_ptr, bytes, ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    ASSERT_EQ(out[0], -1 - prev_pe);
+    for (size_t i = 1; i < SDMA_TEST_COUNT; i++) {
+        ASSERT_EQ(out[i], prev_pe * 100000 + static_cast<int32_t>(i));
+    }
+
+    // a barrier on another stream waits for the bulk get as well
+    ASSERT_EQ(aclrtMemset(local, bytes, 0, bytes), 0);
+    shmem_getmem_nbi(local, sym_ptr, bytes, next_pe);
+    shmemx_barrier_all_on_stream(other_stream);
+    ASSERT_EQ(aclrtSynchronizeStream(other_stream), 0);
+    ASSERT_EQ(aclrtMemcpy(out.data(), bytes, local, bytes, ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    ASSERT_EQ(out[0], -1 - rank_id);
+    for (size_t i = 1; i < SDMA_TEST_COUNT; i++) {
+        ASSERT_EQ(out[i], in[i]);
+    }
+
+    shmemx_barrier_all_on_stream(nullptr);
+    ASSERT_EQ(aclrtSynchronizeStream(shm::g_state_host.default_stream), 0);
+    EXPECT_EQ(aclrtFree(local), 0);
+    EXPECT_EQ(aclrtFree(marker), 0);
+    shmem_free(sym_ptr);
+    shm::g_state_host.sdma_min_bytes = saved_min;
+}
+
+void test_host_shmem_sdma(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    host_test_sdma_eligible(rank_id, n_ranks);
+    aclrtStream other_stream = nullptr;
+    ASSERT_EQ(aclrtCreateStream(&other_stream), 0);
+    host_test_sdma_order(rank_id, n_ranks, other_stream);
+    EXPECT_EQ(aclrtDestroyStream(other_stream), 0);
+    std::cout << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TestSdmaHostApi, TestShmemSdmaEligibleAndOrder)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 64;
+    test_mutil_task(
+        [](int rank_id, int n_ranks, uint64_t local_mem_size) {
+            test_host_shmem_sdma(rank_id, n_ranks, local_mem_size);
+        },
+        local_mem_size, process_count);
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "acl/acl.h"
+#include "shmem_api.h"
+#include "shmemi_host_common.h"
+
+using namespace std;
+
+extern int test_gnpu_num;
+extern int test_first_npu;
+extern void test_mutil_task(std::function<void(int, int, uint64_t)> func, uint64_t local_mem_size, int process_count);
+extern void test_init(int rank_id, int n_ranks, uint64_t local_mem_size, aclrtStream *st);
+extern void test_finalize(aclrtStream stream, int device_id);
+
+static void host_test_iput_iget(int rank_id, int n_ranks)
+{
+    const size_t nelems = 64;
+    const ptrdiff_t sst = 3;
+    const ptrdiff_t dst = 2;
+    size_t total = nelems * sst;
+    int next_pe = (rank_id + 1) % n_ranks;
+
+    std::vector<int32_t> input(total, -1);
+    for (size_t i = 0; i < nelems; i++) {
+        input[i * sst] = rank_id * 1000 + static_cast<int32_t>(i);
+    }
+    int32_t *dev_ptr;
+    ASSERT_EQ(aclrtMalloc((void **)&dev_ptr, total * sizeof(int32_t), ACL_MEM_MALLOC_NORMAL_ONLY), 0);
+    ASSERT_EQ(aclrtMemcpy(dev_ptr, total * sizeof(int32_t), input.data(), total * sizeof(int32_t),
+                          ACL_MEMCPY_HOST_TO_DEVICE), 0);
+
+    int32_t *sym_ptr = (int32_t *)shmem_malloc(total * sizeof(int32_t));
+    ASSERT_NE(sym_ptr, nullptr);
+    ASSERT_EQ(aclrtMemset(sym_ptr, total * sizeof(int32_t), 0, total * sizeof(int32_t)), 0);
+    shm::shmemi_control_barrier_all();
+
+    shmem_int32_iput(sym_ptr, dev_ptr, dst, sst, nelems, next_pe);
+    ASSERT_EQ(aclrtSynchronizeStream(shm::g_state_host.default_stream), 0);
+    shm::shmemi_control_barrier_all();
+
+    std::vector<int32_t> out(total, 0);
+    ASSERT_EQ(aclrtMemcpy(out.data(), total * sizeof(int32_t), sym_ptr, total * sizeof(int32_t),
+                          ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    int prev_pe = (rank_id + n_ranks - 1) % n_ranks;
+    for (size_t i = 0; i < nelems; i++) {
+        ASSERT_EQ(out[i * dst], prev_pe * 1000 + static_cast<int32_t>(i));
+        ASSERT_EQ(out[i * dst + 1], 0);
+    }
+
+    // gather the strided elements back into a contiguous local buffer
+    ASSERT_EQ(aclrtMemset(dev_ptr, total * sizeof(int32_t), 0, total * sizeof(int32_t)), 0);
+    shmem_int32_iget(dev_ptr, sym_ptr, 1, dst, nelems, next_pe);
+    ASSERT_EQ(aclrtSynchronizeStream(shm::g_state_host.default_stream), 0);
+    ASSERT_EQ(aclrtMemcpy(out.data(), total * sizeof(int32_t), dev_ptr, total * sizeof(int32_t),
+                          ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    for (size_t i = 0; i < nelems; i++) {
+        ASSERT_EQ(out[i], rank_id * 1000 + static_cast<int32_t>(i));
+    }
+    shm::shmemi_control_barrier_all();
+    shmem_free(sym_ptr);
+    ASSERT_EQ(aclrtFree(dev_ptr), 0);
+}
+
+static void host_test_put_2d(int rank_id, int n_ranks)
+{
+    const size_t rows = 128;
+    const size_t cols = 40;
+    const size_t src_ld = 64;
+    const size_t dst_ld = 48;
+    int next_pe = (rank_id + 1) % n_ranks;
+
+    std::vector<float> input(rows * src_ld, 0);
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            input[r * src_ld + c] = static_cast<float>(rank_id + r % 16 + c % 8);
+        }
+    }
+    float *dev_ptr;
+    ASSERT_EQ(aclrtMalloc((void **)&dev_ptr, input.size() * sizeof(float), ACL_MEM_MALLOC_NORMAL_ONLY), 0);
+    ASSERT_EQ(aclrtMemcpy(dev_ptr, input.size() * sizeof(float), input.data(), input.size() * sizeof(float),
+                          ACL_MEMCPY_HOST_TO_DEVICE), 0);
+
+    size_t sym_bytes = rows * dst_ld * sizeof(float);
+    float *sym_ptr = (float *)shmem_malloc(sym_bytes);
+    ASSERT_NE(sym_ptr, nullptr);
+    ASSERT_EQ(aclrtMemset(sym_ptr, sym_bytes, 0, sym_bytes), 0);
+    shm::shmemi_control_barrier_all();
+
+    shmemx_float_put_2d(sym_ptr, dev_ptr, rows, cols, dst_ld, src_ld, next_pe);
+    ASSERT_EQ(aclrtSynchronizeStream(shm::g_state_host.default_stream), 0);
+    shm::shmemi_control_barrier_all();
+
+    std::vector<float> out(rows * dst_ld, 0);
+    ASSERT_EQ(aclrtMemcpy(out.data(), sym_bytes, sym_ptr, sym_bytes, ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    int prev_pe = (rank_id + n_ranks - 1) % n_ranks;
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < dst_ld; c++) {
+            float expect = c < cols ? static_cast<float>(prev_pe + r % 16 + c % 8) : 0.0f;
+            ASSERT_EQ(out[r * dst_ld + c], expect);
+        }
+    }
+    shm::shmemi_control_barrier_all();
+    shmem_free(sym_ptr);
+    ASSERT_EQ(aclrtFree(dev_ptr), 0);
+}
+
+void test_host_shmem_strided_rma(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    host_test_iput_iget(rank_id, n_ranks);
+    host_test_put_2d(rank_id, n_ranks);
+    std::cout << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TestStridedHostApi, TestShmemIputIgetPut2d)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 1024;
+    test_mutil_task(
+        [this](int rank_id, int n_ranks, uint64_t local_mem_size) {
+            test_host_shmem_strided_rma(rank_id, n_ranks, local_mem_size);
+        },
+        local_mem_size, process_count);
+}
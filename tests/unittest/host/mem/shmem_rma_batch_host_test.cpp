@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "acl/acl.h"
+#include "shmem_api.h"
+#include "shmemi_host_common.h"
+
+using namespace std;
+
+extern int test_gnpu_num;
+extern int test_first_npu;
+extern void test_mutil_task(std::function<void(int, int, uint64_t)> func, uint64_t local_mem_size, int process_count);
+extern void test_init(int rank_id, int n_ranks, uint64_t local_mem_size, aclrtStream *st);
+extern void test_finalize(aclrtStream stream, int device_id);
+
+namespace {
+constexpr uint64_t FAKE_HEAP_SIZE = 1024UL * 1024UL;
+constexpr int32_t FAKE_NPES = 4;
+alignas(64) uint8_t g_fake_heap[FAKE_HEAP_SIZE];
+uint8_t g_fake_local[256];
+}
+
+TEST(TestRmaBatchBuilder, AcceptsValidDescriptors)
+{
+    shm::rma_batch_builder builder(g_fake_heap, FAKE_HEAP_SIZE, FAKE_NPES);
+    EXPECT_EQ(builder.add_put(g_fake_heap, g_fake_local, sizeof(g_fake_local), 1), SHMEM_SUCCESS);
+    EXPECT_EQ(builder.add_get(g_fake_local, g_fake_heap + FAKE_HEAP_SIZE - 16, 16, 3), SHMEM_SUCCESS);
+    EXPECT_EQ(builder.add_put_signal(g_fake_heap + 512, g_fake_local, 64, (int32_t *)g_fake_heap, 1,
+                                     SHMEM_SIGNAL_ADD, 0), SHMEM_SUCCESS);
+    ASSERT_EQ(builder.size(), 3U);
+    EXPECT_EQ(builder.data()[0].op, SHMEMX_RMA_PUT);
+    EXPECT_EQ(builder.data()[1].op, SHMEMX_RMA_GET);
+    EXPECT_EQ(builder.data()[1].pe, 3);
+    EXPECT_EQ(builder.data()[2].sig_addr, reinterpret_cast<uint64_t>(g_fake_heap));
+    builder.clear();
+    EXPECT_EQ(builder.size(), 0U);
+}
+
+TEST(TestRmaBatchBuilder, RejectsInvalidDescriptors)
+{
+    shm::rma_batch_builder builder(g_fake_heap, FAKE_HEAP_SIZE, FAKE_NPES);
+    // pe out of range
+    EXPECT_NE(builder.add_put(g_fake_heap, g_fake_local, 16, FAKE_NPES), SHMEM_SUCCESS);
+    EXPECT_NE(builder.add_put(g_fake_heap, g_fake_local, 16, -1), SHMEM_SUCCESS);
+    // empty transfer
+    EXPECT_NE(builder.add_put(g_fake_heap, g_fake_local, 0, 0), SHMEM_SUCCESS);
+    // remote side not symmetric, or running past the end of the heap
+    EXPECT_NE(builder.add_put(g_fake_local, g_fake_heap, 16, 0), SHMEM_SUCCESS);
+    EXPECT_NE(builder.add_get(g_fake_heap, g_fake_local, 16, 0), SHMEM_SUCCESS);
+    EXPECT_NE(builder.add_put(g_fake_heap + FAKE_HEAP_SIZE - 8, g_fake_local, 16, 0), SHMEM_SUCCESS);
+    // signal word outside the heap and unknown signal op
+    EXPECT_NE(builder.add_put_signal(g_fake_heap, g_fake_local, 16, (int32_t *)g_fake_local, 1, SHMEM_SIGNAL_SET, 0),
+              SHMEM_SUCCESS);
+    EXPECT_NE(builder.add_put_signal(g_fake_heap, g_fake_local, 16, (int32_t *)g_fake_heap, 1, 7, 0), SHMEM_SUCCESS);
+    // unsupported op
+    shmemx_rma_desc_t desc = {SHMEMI_OP_G, 0, reinterpret_cast<uint64_t>(g_fake_local),
+                              reinterpret_cast<uint64_t>(g_fake_heap), 4, 0, 0, 0};
+    EXPECT_NE(builder.add(desc), SHMEM_SUCCESS);
+    EXPECT_EQ(builder.size(), 0U);
+}
+
+static void host_test_rma_batch(int rank_id, int n_ranks, aclrtStream stream)
+{
+    const size_t chunk = 64;
+    const size_t n_desc = 256;
+    size_t total = chunk * n_desc;
+
+    std::vector<uint8_t> input(total);
+    for (size_t i = 0; i < total; i++) {
+        input[i] = static_cast<uint8_t>(rank_id + i / chunk);
+    }
+    uint8_t *dev_ptr;
+    ASSERT_EQ(aclrtMalloc((void **)&dev_ptr, total, ACL_MEM_MALLOC_NORMAL_ONLY), 0);
+    ASSERT_EQ(aclrtMemcpy(dev_ptr, total, input.data(), total, ACL_MEMCPY_HOST_TO_DEVICE), 0);
+    uint8_t *sym_ptr = (uint8_t *)shmem_malloc(total);
+    ASSERT_NE(sym_ptr, nullptr);
+    ASSERT_EQ(aclrtMemset(sym_ptr, total, 0, total), 0);
+    shm::shmemi_control_barrier_all();
+
+    // every chunk whose index maps to the next PE is put there, at the same offset
+    shm::rma_batch_builder builder(shm::g_state.heap_base, shm::g_state.heap_size, n_ranks);
+    int next_pe = (rank_id + 1) % n_ranks;
+    for (size_t i = 0; i < n_desc; i++) {
+        if (static_cast<int>(i % n_ranks) != next_pe) {
+            continue;
+        }
+        ASSERT_EQ(builder.add_put(sym_ptr + i * chunk, dev_ptr + i * chunk, chunk, next_pe), SHMEM_SUCCESS);
+    }
+    ASSERT_EQ(shmemx_rma_batch(builder.data(), builder.size(), stream), SHMEM_SUCCESS);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    shm::shmemi_control_barrier_all();
+
+    std::vector<uint8_t> out(total, 0);
+    ASSERT_EQ(aclrtMemcpy(out.data(), total, sym_ptr, total, ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    int prev_pe = (rank_id + n_ranks - 1) % n_ranks;
+    for (size_t i = 0; i < total; i++) {
+        size_t idx = i / chunk;
+        uint8_t expect = (static_cast<int>(idx % n_ranks) == rank_id) ? static_cast<uint8_t>(prev_pe + idx) : 0;
+        ASSERT_EQ(out[i], expect);
+    }
+    shm::shmemi_control_barrier_all();
+    shmem_free(sym_ptr);
+    ASSERT_EQ(aclrtFree(dev_ptr), 0);
+}
+
+// batches submitted without waiting in between alternate the staging halves, each must run its own descriptors
+static void host_test_rma_batch_back_to_back(int rank_id, int n_ranks, aclrtStream stream)
+{
+    const size_t chunk = 64;
+    const size_t rounds = 5;
+    const size_t n_desc = 32;
+    size_t per_round = chunk * n_desc;
+    size_t total = per_round * rounds;
+
+    std::vector<uint8_t> input(total);
+    for (size_t i = 0; i < total; i++) {
+        input[i] = static_cast<uint8_t>(rank_id * 16 + i / per_round + 1);
+    }
+    uint8_t *dev_ptr;
+    ASSERT_EQ(aclrtMalloc((void **)&dev_ptr, total, ACL_MEM_MALLOC_NORMAL_ONLY), 0);
+    ASSERT_EQ(aclrtMemcpy(dev_ptr, total, input.data(), total, ACL_MEMCPY_HOST_TO_DEVICE), 0);
+    uint8_t *sym_ptr = (uint8_t *)shmem_malloc(total);
+    ASSERT_NE(sym_ptr, nullptr);
+    ASSERT_EQ(aclrtMemset(sym_ptr, total, 0, total), 0);
+    shm::shmemi_control_barrier_all();
+
+    int next_pe = (rank_id + 1) % n_ranks;
+    shm::rma_batch_builder builder(shm::g_state.heap_base, shm::g_state.heap_size, n_ranks);
+    for (size_t round = 0; round < rounds; round++) {
+        builder.clear();
+        for (size_t i = 0; i < n_desc; i++) {
+            size_t off = round * per_round + i * chunk;
+            ASSERT_EQ(builder.add_put(sym_ptr + off, dev_ptr + off, chunk, next_pe), SHMEM_SUCCESS);
+        }
+        ASSERT_EQ(shmemx_rma_batch(builder.data(), builder.size(), stream), SHMEM_SUCCESS);
+    }
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    shm::shmemi_control_barrier_all();
+
+    std::vector<uint8_t> out(total, 0);
+    ASSERT_EQ(aclrtMemcpy(out.data(), total, sym_ptr, total, ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    int prev_pe = (rank_id + n_ranks - 1) % n_ranks;
+    for (size_t i = 0; i < total; i++) {
+        ASSERT_EQ(out[i], static_cast<uint8_t>(prev_pe * 16 + i / per_round + 1));
+    }
+    shm::shmemi_control_barrier_all();
+    shmem_free(sym_ptr);
+    ASSERT_EQ(aclrtFree(dev_ptr), 0);
+}
+
+void test_host_shmem_rma_batch(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    host_test_rma_batch(rank_id, n_ranks, stream);
+    host_test_rma_batch_back_to_back(rank_id, n_ranks, stream);
+    std::cout << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TestRmaBatchHostApi, TestShmemRmaBatchPut)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 1024;
+    test_mutil_task(
+        [this](int rank_id, int n_ranks, uint64_t local_mem_size) {
+            test_host_shmem_rma_batch(rank_id, n_ranks, local_mem_size);
+        },
+        local_mem_size, process_count);
+}
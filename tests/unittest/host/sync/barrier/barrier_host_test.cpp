@@ -9,6 +9,7 @@
  */
 #include <iostream>
 #include <string>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "acl/acl.h"
@@ -55,10 +56,25 @@ static void test_barrier_black_box(int32_t rank_id, int32_t n_ranks, uint64_t lo
         shm::shmemi_control_barrier_all();
     }
 
+    uint64_t *addr_dev_split = static_cast<uint64_t *>(shmem_malloc(sizeof(uint64_t)));
+    ASSERT_EQ(aclrtMemset(addr_dev_split, sizeof(uint64_t), 0, sizeof(uint64_t)), 0);
+    uint64_t addr_host_split = 0;
+
+    for (int32_t i = 1; i <= SHMEM_BARRIER_TEST_NUM; i++) {
+        std::cout << "[TEST] split barriers test blackbox rank_id: " << rank_id << " time: " << i << std::endl;
+        increase_split_do(stream, shmemx_get_ffts_config(), (uint8_t *)addr_dev_split, rank_id, n_ranks);
+        ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+        ASSERT_EQ(aclrtMemcpy(&addr_host_split, sizeof(uint64_t), addr_dev_split, sizeof(uint64_t),
+                              ACL_MEMCPY_DEVICE_TO_HOST), 0);
+        ASSERT_EQ(addr_host_split, i);
+        shm::shmemi_control_barrier_all();
+    }
+
     ASSERT_EQ(aclrtFreeHost(addr_host), 0);
     shmem_free(addr_dev);
     ASSERT_EQ(aclrtFreeHost(addr_host_vec), 0);
     shmem_free(addr_dev_vec);
+    shmem_free(addr_dev_split);
 
     test_finalize(stream, device_id);
     if (::testing::Test::HasFailure()) {
@@ -225,6 +241,68 @@ void test_partial_barrier_black_box(int32_t rank_id, int32_t n_ranks, uint64_t l
     test_finalize(stream, device_id);
 }
 
+// More partial barriers than SHMEM_PARTIAL_BARRIER_MAX_SLOTS, so every slot is reused with a higher epoch
+static void test_partial_barrier_epoch_reuse(int32_t rank_id, int32_t n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    // a fresh team starts with a zeroed counter and zeroed slots
+    shmem_team_t team;
+    ASSERT_EQ(shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 1, n_ranks, &team), 0);
+    std::vector<uint32_t> pes_host;
+    for (int i = 0; i < n_ranks; ++i) {
+        pes_host.push_back(static_cast<uint32_t>(i));
+    }
+    uint32_t count = static_cast<uint32_t>(pes_host.size());
+    uint32_t *pes_dev = static_cast<uint32_t *>(shmem_malloc(sizeof(uint32_t) * count));
+    ASSERT_NE(pes_dev, nullptr);
+    ASSERT_EQ(aclrtMemcpy(pes_dev, sizeof(uint32_t) * count, pes_host.data(), sizeof(uint32_t) * count,
+                          ACL_MEMCPY_HOST_TO_DEVICE), 0);
+    uint64_t *addr_dev = static_cast<uint64_t *>(shmem_malloc(sizeof(uint64_t)));
+    ASSERT_NE(addr_dev, nullptr);
+    ASSERT_EQ(aclrtMemset(addr_dev, sizeof(uint64_t), 0, sizeof(uint64_t)), 0);
+    shm::shmemi_control_barrier_all();
+
+    // the kernel runs two partial barriers per launch
+    const int32_t launches = SHMEM_PARTIAL_BARRIER_MAX_SLOTS + 8;
+    const int32_t calls = launches * 2;
+    uint64_t value = 0;
+    for (int32_t i = 1; i <= launches; i++) {
+        partial_increase_vec_do(stream, shmemx_get_ffts_config(), reinterpret_cast<uint8_t *>(addr_dev),
+                                reinterpret_cast<uint8_t *>(pes_dev), count, rank_id, n_ranks, team);
+        ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+        ASSERT_EQ(aclrtMemcpy(&value, sizeof(uint64_t), addr_dev, sizeof(uint64_t), ACL_MEMCPY_DEVICE_TO_HOST), 0);
+        ASSERT_EQ(value, static_cast<uint64_t>(i));
+    }
+    shm::shmemi_control_barrier_all();
+
+    // slot s was used by every call idx with idx % SHMEM_PARTIAL_BARRIER_MAX_SLOTS == s and holds its last epoch
+    std::vector<uint8_t> region(SHMEM_PARTIAL_BARRIER_PER_TEAM_SIZE);
+    void *team_region = reinterpret_cast<void *>(shm::g_state.partial_barrier_pool +
+                                                 static_cast<uint64_t>(team) * SHMEM_PARTIAL_BARRIER_PER_TEAM_SIZE);
+    ASSERT_EQ(aclrtMemcpy(region.data(), region.size(), team_region, region.size(), ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    auto word = [&region](uint32_t slot) {
+        return *reinterpret_cast<int32_t *>(region.data() + slot * SHMEMI_SYNCBIT_SIZE);
+    };
+    EXPECT_EQ(word(SHMEM_PARTIAL_BARRIER_MAX_SLOTS), calls);
+    for (int32_t slot = 0; slot < SHMEM_PARTIAL_BARRIER_MAX_SLOTS; slot++) {
+        int32_t uses = (calls - slot + SHMEM_PARTIAL_BARRIER_MAX_SLOTS - 1) / SHMEM_PARTIAL_BARRIER_MAX_SLOTS;
+        EXPECT_EQ(word(slot), uses) << "slot " << slot;
+    }
+
+    shm::shmemi_control_barrier_all();
+    shmem_free(addr_dev);
+    shmem_free(pes_dev);
+    shmem_team_destroy(team);
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
 TEST(TEST_SYNC_API, test_barrier_black_box)
 {
     const int32_t process_count = test_gnpu_num;
@@ -244,4 +322,11 @@ TEST(TEST_SYNC_API, test_partial_barrier_black_box)
     const int32_t process_count = test_gnpu_num;
     uint64_t local_mem_size = 1024UL * 1024UL * 16;
     test_mutil_task(test_partial_barrier_black_box, local_mem_size, process_count);
+}
+
+TEST(TEST_SYNC_API, test_partial_barrier_epoch_reuse)
+{
+    const int32_t process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 16;
+    test_mutil_task(test_partial_barrier_epoch_reuse, local_mem_size, process_count);
 }
\ No newline at end of file
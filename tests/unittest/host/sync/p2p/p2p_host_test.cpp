@@ -9,6 +9,7 @@
  */
 #include <iostream>
 #include <string>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "acl/acl.h"
@@ -40,4 +41,155 @@ TEST(TEST_SYNC_API, test_p2p)
     const int32_t process_count = test_gnpu_num;
     uint64_t local_mem_size = 1024UL * 1024UL * 16;
     test_mutil_task(test_p2p, local_mem_size, process_count);
-}
\ No newline at end of file
+}
+
+static void test_p2p_wait_any(int rank_id, int rank_size, uint64_t local_mem_size)
+{
+    aclrtStream stream;
+    test_init(rank_id, rank_size, local_mem_size, &stream);
+
+    size_t bytes = (rank_size + 1) * sizeof(int32_t);
+    int32_t *addr_dev = static_cast<int32_t *>(shmem_malloc(bytes));
+    ASSERT_EQ(aclrtMemset(addr_dev, bytes, 0, bytes), 0);
+    p2p_wait_any_do(stream, shmemx_get_ffts_config(), (uint8_t *)addr_dev, rank_id, rank_size);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    if (rank_id == 0) {
+        int32_t consumed = 0;
+        ASSERT_EQ(aclrtMemcpy(&consumed, sizeof(int32_t), addr_dev + rank_size, sizeof(int32_t),
+                              ACL_MEMCPY_DEVICE_TO_HOST), 0);
+        ASSERT_EQ(consumed, rank_size);
+    }
+    shmem_free(addr_dev);
+
+    int32_t dev_id = rank_id % test_gnpu_num + test_first_npu;
+    test_finalize(stream, dev_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TEST_SYNC_API, test_p2p_wait_until_any_some)
+{
+    const int32_t process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 16;
+    test_mutil_task(test_p2p_wait_any, local_mem_size, process_count);
+}
+
+TEST(TEST_SYNC_API, test_wait_diag_decode)
+{
+    std::vector<uint8_t> ring(SHMEM_WAIT_DIAG_RING_SIZE, 0);
+    std::vector<shmemx_wait_diag_record_t> records;
+    EXPECT_EQ(shm::wait_diag_decode(ring.data(), records), 0U);
+    EXPECT_TRUE(records.empty());
+
+    // wrap around once and leave the newest claimed slot unwritten
+    const uint64_t head = SHMEM_WAIT_DIAG_RING_ENTRIES + 3;
+    memcpy(ring.data(), &head, sizeof(head));
+    for (uint64_t i = 0; i < head - 1; i++) {
+        shmemx_wait_diag_record_t rec = {};
+        rec.round = static_cast<int32_t>(i);
+        rec.timestamp = static_cast<int64_t>(i + 1);
+        memcpy(ring.data() + SHMEM_WAIT_DIAG_HEAD_SIZE + (i % SHMEM_WAIT_DIAG_RING_ENTRIES) *
+               SHMEM_WAIT_DIAG_RECORD_SIZE, &rec, sizeof(rec));
+    }
+    shmemx_wait_diag_record_t pending = {};
+    memcpy(ring.data() + SHMEM_WAIT_DIAG_HEAD_SIZE + ((head - 1) % SHMEM_WAIT_DIAG_RING_ENTRIES) *
+           SHMEM_WAIT_DIAG_RECORD_SIZE, &pending, sizeof(pending));
+
+    EXPECT_EQ(shm::wait_diag_decode(ring.data(), records), 3U);
+    ASSERT_EQ(records.size(), SHMEM_WAIT_DIAG_RING_ENTRIES - 1U);
+    EXPECT_EQ(records.front().round, 3);
+    EXPECT_EQ(records.back().round, static_cast<int32_t>(head - 2));
+}
+
+TEST(TEST_SYNC_API, test_watchdog_scan)
+{
+    std::vector<uint8_t> region(SHMEM_WATCHDOG_REGION_SIZE, 0);
+    std::vector<shm::watchdog_core_state> cores;
+    std::vector<shmemi_watchdog_record_t> stalled;
+    const uint64_t stall_ms = 100;
+    auto put = [&region](uint32_t core, uint64_t progress, int32_t site, int32_t pe) {
+        shmemi_watchdog_record_t rec = {};
+        rec.progress = progress;
+        rec.site = site;
+        rec.team = SHMEM_TEAM_WORLD;
+        rec.pe = pe;
+        memcpy(region.data() + core * SHMEM_WATCHDOG_RECORD_SIZE, &rec, sizeof(rec));
+    };
+
+    // core 1 blocks in a barrier, core 2 keeps moving, core 3 is idle
+    put(1, 1, SHMEMI_SITE_BARRIER, 5);
+    put(2, 1, SHMEMI_SITE_WAIT, -1);
+    put(3, 2, SHMEMI_SITE_IDLE, -1);
+    shm::watchdog_scan(region.data(), 1000, stall_ms, cores, stalled);
+    EXPECT_TRUE(stalled.empty());
+
+    put(2, 3, SHMEMI_SITE_WAIT, -1);
+    shm::watchdog_scan(region.data(), 1000 + stall_ms, stall_ms, cores, stalled);
+    ASSERT_EQ(stalled.size(), 1U);
+    EXPECT_EQ(stalled[0].core, 1);
+    EXPECT_EQ(stalled[0].site, SHMEMI_SITE_BARRIER);
+    EXPECT_EQ(stalled[0].pe, 5);
+
+    // a stall is reported once, and again only after the core moved and stalled anew
+    stalled.clear();
+    shm::watchdog_scan(region.data(), 1000 + 2 * stall_ms, stall_ms, cores, stalled);
+    EXPECT_EQ(stalled.size(), 1U);
+    EXPECT_EQ(stalled[0].core, 2);
+    stalled.clear();
+    put(1, 2, SHMEMI_SITE_ROCE_QUIET, 6);
+    shm::watchdog_scan(region.data(), 1000 + 3 * stall_ms, stall_ms, cores, stalled);
+    EXPECT_TRUE(stalled.empty());
+    shm::watchdog_scan(region.data(), 1000 + 4 * stall_ms, stall_ms, cores, stalled);
+    ASSERT_EQ(stalled.size(), 1U);
+    EXPECT_EQ(stalled[0].site, SHMEMI_SITE_ROCE_QUIET);
+    EXPECT_STREQ(shm::watchdog_site_name(stalled[0].site), "roce_quiet");
+}
+
+static void test_p2p_wait_timeout(int rank_id, int rank_size, uint64_t local_mem_size)
+{
+    aclrtStream stream;
+    test_init(rank_id, rank_size, local_mem_size, &stream);
+
+    const int line = SCALAR_DATA_CACHELINE_SIZE / sizeof(int32_t);
+    size_t bytes = 4 * SCALAR_DATA_CACHELINE_SIZE;
+    int32_t *addr_dev = static_cast<int32_t *>(shmem_malloc(bytes));
+    ASSERT_EQ(aclrtMemset(addr_dev, bytes, 0, bytes), 0);
+    const int64_t timeout_cycles = 1000 * SHMEM_SYS_CYCLES_PER_US;
+    p2p_wait_timeout_do(stream, shmemx_get_ffts_config(), (uint8_t *)addr_dev, rank_id, rank_size, timeout_cycles);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+
+    std::vector<int32_t> out(4 * line, 0);
+    ASSERT_EQ(aclrtMemcpy(out.data(), bytes, addr_dev, bytes, ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    EXPECT_EQ(out[line], -1);
+    EXPECT_EQ(out[2 * line], rank_id + 1);
+    EXPECT_EQ(out[3 * line], 0);
+
+    std::vector<shmemx_wait_diag_record_t> records(SHMEM_WAIT_DIAG_RING_ENTRIES);
+    uint32_t count = 0;
+    ASSERT_EQ(shmemx_wait_diag_fetch(records.data(), records.size(), &count), SHMEM_SUCCESS);
+    ASSERT_GE(count, 1U);
+    const shmemx_wait_diag_record_t &rec = records[count - 1];
+    EXPECT_EQ(rec.mype, rank_id);
+    EXPECT_EQ(rec.team, SHMEM_TEAM_INVALID);
+    EXPECT_EQ(rec.cmp, SHMEM_CMP_EQ);
+    EXPECT_EQ(rec.observed, 0);
+    EXPECT_EQ(rec.expected, 1);
+    EXPECT_EQ(rec.addr, reinterpret_cast<uint64_t>(addr_dev));
+    EXPECT_GE(rec.elapsed, timeout_cycles);
+    EXPECT_GE(shmemx_wait_diag_dump(), 1);
+    shmem_free(addr_dev);
+
+    int32_t dev_id = rank_id % test_gnpu_num + test_first_npu;
+    test_finalize(stream, dev_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TEST_SYNC_API, test_p2p_wait_until_timeout)
+{
+    const int32_t process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 16;
+    test_mutil_task(test_p2p_wait_timeout, local_mem_size, process_count);
+}
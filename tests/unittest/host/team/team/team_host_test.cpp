@@ -221,4 +221,69 @@ TEST(TestTeamApi, ShmemTeamSplit2d_failConditions)
 
     errorCode = shmem_team_split_2d(-1, 0, &team_x, nullptr);
     EXPECT_EQ(errorCode, SHMEM_INVALID_PARAM);
-}
\ No newline at end of file
+}
+
+TEST(TestTeamApi, TeamHostLocalSize)
+{
+    // 4 hosts of 4 PEs
+    int32_t host_ids[16];
+    for (int32_t i = 0; i < 16; i++) {
+        host_ids[i] = i / 4 * 4;
+    }
+    shmemi_team_t world{0, 0, 1, 16, 0};
+    EXPECT_EQ(shm::team_host_local_size(&world, host_ids), 4);
+
+    // even PEs: 2 per host
+    shmemi_team_t even{0, 0, 2, 8, 1};
+    EXPECT_EQ(shm::team_host_local_size(&even, host_ids), 2);
+
+    // one PE per host, or all PEs on one host
+    shmemi_team_t one_per_host{0, 0, 4, 4, 1};
+    EXPECT_EQ(shm::team_host_local_size(&one_per_host, host_ids), 1);
+    shmemi_team_t one_host{0, 4, 1, 4, 1};
+    EXPECT_EQ(shm::team_host_local_size(&one_host, host_ids), 4);
+
+    // uneven blocks: 4 + 2
+    shmemi_team_t uneven{0, 0, 1, 6, 1};
+    EXPECT_EQ(shm::team_host_local_size(&uneven, host_ids), 0);
+
+    // hosts interleaved in team order
+    for (int32_t i = 0; i < 16; i++) {
+        host_ids[i] = i % 2;
+    }
+    EXPECT_EQ(shm::team_host_local_size(&world, host_ids), 0);
+}
+
+TEST(TestTeamApi, BarrierAlgoSelection)
+{
+    shm::barrier_cost_model model = {2.0, 0.5, 10.0};
+    int32_t algo = SHMEMX_BARRIER_AUTO;
+    int32_t k = 0;
+
+    // small team inside one host: centralized pull reads every flag in one step
+    shm::barrier_select(model, 8, 8, true, &algo, &k);
+    EXPECT_EQ(algo, SHMEMX_BARRIER_CENTRAL);
+    EXPECT_EQ(k, SHMEM_BARRIER_TG_DISSEM_KVAL);
+
+    // large team inside one MTE domain: logarithmic rounds win over sequential reads
+    shm::barrier_select(model, 1024, 1024, true, &algo, &k);
+    EXPECT_EQ(algo, SHMEMX_BARRIER_TG_DISSEM);
+    double best_us = shm::barrier_predict_us(model, 1024, 1024, true, algo, k);
+    for (int32_t cand_k = 2; cand_k <= SHMEM_BARRIER_TG_DISSEM_KVAL; cand_k++) {
+        EXPECT_LE(best_us, shm::barrier_predict_us(model, 1024, 1024, true, SHMEMX_BARRIER_TG_DISSEM, cand_k));
+    }
+    EXPECT_LE(best_us, shm::barrier_predict_us(model, 1024, 1024, true, SHMEMX_BARRIER_CENTRAL, 8));
+
+    // across hosts only the hierarchical barrier applies, with log2(hosts) RoCE rounds
+    shm::barrier_select(model, 64, 8, false, &algo, &k);
+    EXPECT_EQ(algo, SHMEMX_BARRIER_HIER);
+    EXPECT_DOUBLE_EQ(shm::barrier_predict_us(model, 64, 8, false, SHMEMX_BARRIER_HIER, k),
+                     2 * 2.0 + 6 * 0.5 + 3 * 10.0);
+    EXPECT_LT(shm::barrier_predict_us(model, 64, 8, false, SHMEMX_BARRIER_HIER, k),
+              shm::barrier_predict_us(model, 64, 8, false, SHMEMX_BARRIER_DISSEM, 2));
+    EXPECT_LT(shm::barrier_predict_us(model, 64, 0, false, SHMEMX_BARRIER_HIER, k), 0);
+
+    EXPECT_EQ(shm::barrier_algo_from_name("tg_dissem"), SHMEMX_BARRIER_TG_DISSEM);
+    EXPECT_EQ(shm::barrier_algo_from_name("hier"), SHMEMX_BARRIER_HIER);
+    EXPECT_EQ(shm::barrier_algo_from_name("fastest"), -1);
+}
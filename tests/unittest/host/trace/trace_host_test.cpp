@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "shmem_api.h"
+#include "shmemi_host_common.h"
+
+namespace {
+void trace_put(std::vector<uint8_t> &region, uint32_t core, uint64_t slot, uint16_t op, int64_t start, int64_t end)
+{
+    shmemx_trace_record_t rec = {};
+    rec.op = op;
+    rec.core = static_cast<uint16_t>(core);
+    rec.pe = 1;
+    rec.bytes = 256;
+    rec.start = start;
+    rec.end = end;
+    memcpy(region.data() + core * SHMEM_TRACE_CORE_RING_SIZE + SHMEM_TRACE_HEAD_SIZE +
+           (slot % SHMEM_TRACE_RING_ENTRIES) * SHMEM_TRACE_RECORD_SIZE, &rec, sizeof(rec));
+}
+
+void trace_head(std::vector<uint8_t> &region, uint32_t core, uint64_t head)
+{
+    memcpy(region.data() + core * SHMEM_TRACE_CORE_RING_SIZE, &head, sizeof(head));
+}
+}
+
+TEST(TestTraceDecode, EmptyRegion)
+{
+    std::vector<uint8_t> region(SHMEM_TRACE_REGION_SIZE, 0);
+    std::vector<shmemx_trace_record_t> records;
+    EXPECT_EQ(shm::trace_decode(region.data(), records), 0U);
+    EXPECT_TRUE(records.empty());
+    EXPECT_EQ(shm::trace_to_chrome_json(records, 0), "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n");
+}
+
+TEST(TestTraceDecode, MergesCoresAndDropsOverwritten)
+{
+    std::vector<uint8_t> region(SHMEM_TRACE_REGION_SIZE, 0);
+    // core 0 wrapped twice past the ring size, the last cube core holds two late records
+    const uint64_t head = SHMEM_TRACE_RING_ENTRIES + 2;
+    for (uint64_t i = 0; i < head; i++) {
+        trace_put(region, 0, i, SHMEMX_TRACE_PUT, static_cast<int64_t>(i * 10), static_cast<int64_t>(i * 10 + 5));
+    }
+    trace_head(region, 0, head);
+    const uint32_t cube = SHMEM_TRACE_MAX_CORES - 1;
+    trace_put(region, cube, 0, SHMEMX_TRACE_BARRIER, 25, 40);
+    trace_put(region, cube, 1, SHMEMX_TRACE_WAIT, 100000, 100100);
+    trace_head(region, cube, 2);
+
+    std::vector<shmemx_trace_record_t> records;
+    EXPECT_EQ(shm::trace_decode(region.data(), records), 2U);
+    ASSERT_EQ(records.size(), SHMEM_TRACE_RING_ENTRIES + 2U);
+    EXPECT_EQ(records.front().op, SHMEMX_TRACE_PUT);
+    EXPECT_EQ(records.front().start, 20);
+    EXPECT_EQ(records[1].op, SHMEMX_TRACE_BARRIER);
+    EXPECT_EQ(records[1].core, cube);
+    EXPECT_EQ(records[records.size() - 2].start, static_cast<int64_t>((head - 1) * 10));
+    EXPECT_EQ(records.back().op, SHMEMX_TRACE_WAIT);
+    for (size_t i = 1; i < records.size(); i++) {
+        EXPECT_LE(records[i - 1].start, records[i].start);
+    }
+}
+
+TEST(TestTraceDecode, ChromeJson)
+{
+    std::vector<shmemx_trace_record_t> records(2);
+    records[0] = {SHMEMX_TRACE_GET, 3, 1, 4096, 100, 150};
+    records[1] = {SHMEMX_TRACE_BARRIER, 4, 0, 0, 200, 1200};
+    std::string json = shm::trace_to_chrome_json(records, 7);
+    EXPECT_NE(json.find("{\"name\":\"get\",\"cat\":\"rma\",\"ph\":\"X\",\"pid\":7,\"tid\":3,\"ts\":2.000,"
+                        "\"dur\":1.000,\"args\":{\"pe\":1,\"bytes\":4096}}"), std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"barrier\",\"cat\":\"sync\",\"ph\":\"X\",\"pid\":7,\"tid\":4,\"ts\":4.000,"
+                        "\"dur\":20.000,\"args\":{\"team\":0,\"bytes\":0}}"), std::string::npos);
+    EXPECT_STREQ(shm::trace_op_name(0), "unknown");
+    EXPECT_STREQ(shm::trace_op_name(SHMEMX_TRACE_ROCE_QUIET), "roce_quiet");
+}
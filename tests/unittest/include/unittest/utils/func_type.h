@@ -67,4 +67,10 @@
     FUNC(int16, int16_t);                       \
     FUNC(int32, int32_t)
 
+#define SHMEM_ATOMIC_FETCH_FUNC_TYPE(FUNC) \
+    FUNC(int32, int32_t);                  \
+    FUNC(uint32, uint32_t);                \
+    FUNC(int64, int64_t);                  \
+    FUNC(uint64, uint64_t)
+
 #endif  // UT_FUNC_TYPE_H
\ No newline at end of file
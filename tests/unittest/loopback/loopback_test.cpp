@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+#include "shmemi_loopback.h"
+
+using shm::loopback_domain;
+
+namespace {
+constexpr int32_t MANY_PES = 64;
+constexpr uint64_t HEAP_SIZE = 64 * 1024;
+constexpr uint64_t TIMEOUT_MS = 20000;
+constexpr uint64_t BLOCK = 1024;
+constexpr uint64_t COUNTER_OFF = 0;
+constexpr uint64_t RING_OFF = 4096;
+constexpr uint64_t ROUND_OFF = 8192;
+constexpr int32_t ADDS_PER_PE = 1000;
+constexpr int32_t FLOAT_ADDS_PER_PE = 100;
+constexpr int32_t BARRIER_ROUNDS = 200;
+constexpr uint32_t GATHER_BYTES = 600;  // more than one staging slot
+
+std::string unique_name(const char *test)
+{
+    return std::string("/shmem_loopback_test_") + std::to_string(getpid()) + "_" + test;
+}
+
+// The functional sequence every PE runs, returns the number of failed checks
+int32_t run_pe(loopback_domain &dom)
+{
+    int32_t failures = 0;
+    int32_t me = dom.my_pe();
+    int32_t n = dom.npes();
+    int32_t next = (me + 1) % n;
+    int32_t prev = (me + n - 1) % n;
+    uint8_t *heap = dom.heap(me);
+    auto check = [&failures](bool ok) {
+        failures += ok ? 0 : 1;
+    };
+
+    // ring put of a PE stamped block, then get it back from the right neighbour
+    std::vector<uint8_t> block(BLOCK);
+    for (uint64_t i = 0; i < BLOCK; i++) {
+        block[i] = static_cast<uint8_t>(me * 31 + i);
+    }
+    check(dom.put(heap + RING_OFF, block.data(), BLOCK, next) == SHMEM_SUCCESS);
+    check(dom.barrier() == SHMEM_SUCCESS);
+    for (uint64_t i = 0; i < BLOCK; i++) {
+        check(heap[RING_OFF + i] == static_cast<uint8_t>(prev * 31 + i));
+    }
+    std::vector<uint8_t> back(BLOCK);
+    check(dom.get(back.data(), heap + RING_OFF, BLOCK, next) == SHMEM_SUCCESS);
+    check(memcmp(back.data(), block.data(), BLOCK) == 0);
+
+    // every PE hammers the counter of PE 0, no increment may be lost
+    auto *counter = reinterpret_cast<uint64_t *>(heap + COUNTER_OFF);
+    uint64_t old = 0;
+    for (int32_t i = 0; i < ADDS_PER_PE; i++) {
+        check(dom.fetch_add<uint64_t>(counter, 1, 0, &old) == SHMEM_SUCCESS);
+    }
+    check(dom.barrier() == SHMEM_SUCCESS);
+    check(dom.fetch<uint64_t>(counter, 0, &old) == SHMEM_SUCCESS);
+    check(old == static_cast<uint64_t>(ADDS_PER_PE) * n);
+
+    // float adds go through the compare and swap loop, halves sum up exactly
+    auto *sum = reinterpret_cast<float *>(heap + COUNTER_OFF + 3 * sizeof(uint64_t));
+    for (int32_t i = 0; i < FLOAT_ADDS_PER_PE; i++) {
+        check(dom.add<float>(sum, 0.5f, 0) == SHMEM_SUCCESS);
+    }
+    check(dom.barrier() == SHMEM_SUCCESS);
+    check(*reinterpret_cast<volatile float *>(dom.ptr(sum, 0)) == 0.5f * FLOAT_ADDS_PER_PE * n);
+
+    // compare_swap on the flag of PE 1: exactly one PE wins the swap from the initial zero
+    auto *flag = reinterpret_cast<int32_t *>(heap + COUNTER_OFF + sizeof(uint64_t));
+    int32_t seen = -1;
+    check(dom.compare_swap<int32_t>(flag, 0, me + 1, 1 % n, &seen) == SHMEM_SUCCESS);
+    int32_t won = seen == 0 ? 1 : 0;
+    auto *winners = reinterpret_cast<int32_t *>(heap + COUNTER_OFF + 2 * sizeof(uint64_t));
+    check(dom.fetch_add<int32_t>(winners, won, 0, &seen) == SHMEM_SUCCESS);
+    check(dom.barrier() == SHMEM_SUCCESS);
+    check(dom.fetch<int32_t>(winners, 0, &seen) == SHMEM_SUCCESS);
+    check(seen == 1);
+    // the flag of PE 1 holds the winner, every other flag is still zero
+    check(dom.swap<int32_t>(flag, -1, me, &seen) == SHMEM_SUCCESS);
+    check(me == 1 % n ? (seen > 0 && seen <= n) : seen == 0);
+
+    // barrier rounds: a value written before a barrier is seen by the neighbour after it
+    auto *slot = reinterpret_cast<int32_t *>(heap + ROUND_OFF);
+    for (int32_t round = 1; round <= BARRIER_ROUNDS; round++) {
+        int32_t value = round * MANY_PES + me;
+        check(dom.put(slot, &value, sizeof(value), next) == SHMEM_SUCCESS);
+        check(dom.barrier() == SHMEM_SUCCESS);
+        check(*slot == round * MANY_PES + prev);
+        check(dom.barrier() == SHMEM_SUCCESS);
+    }
+
+    std::vector<uint8_t> send(GATHER_BYTES);
+    std::vector<uint8_t> recv(GATHER_BYTES * n);
+    for (uint32_t i = 0; i < GATHER_BYTES; i++) {
+        send[i] = static_cast<uint8_t>(me + i);
+    }
+    check(dom.allgather(send.data(), GATHER_BYTES, recv.data()) == SHMEM_SUCCESS);
+    for (int32_t pe = 0; pe < n; pe++) {
+        for (uint32_t i = 0; i < GATHER_BYTES; i++) {
+            check(recv[pe * GATHER_BYTES + i] == static_cast<uint8_t>(pe + i));
+        }
+    }
+    check(dom.barrier() == SHMEM_SUCCESS);
+    return failures;
+}
+
+void run_threads(const std::string &name, int32_t npes, const std::function<int32_t(loopback_domain &)> &body,
+                 std::vector<int32_t> &results)
+{
+    results.assign(npes, -1);
+    std::vector<std::thread> threads;
+    for (int32_t pe = 0; pe < npes; pe++) {
+        threads.emplace_back([&, pe]() {
+            loopback_domain dom;
+            int32_t ret = dom.attach(name, pe, npes, HEAP_SIZE, TIMEOUT_MS);
+            results[pe] = ret == SHMEM_SUCCESS ? body(dom) : 1000 - ret;
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+}
+
+TEST(TestLoopbackDomain, ThreadsManyPes)
+{
+    std::vector<int32_t> results;
+    run_threads(unique_name("threads"), MANY_PES, run_pe, results);
+    for (int32_t pe = 0; pe < MANY_PES; pe++) {
+        EXPECT_EQ(results[pe], 0) << "pe " << pe;
+    }
+}
+
+TEST(TestLoopbackDomain, ProcessesManyPes)
+{
+    std::string name = unique_name("procs");
+    std::vector<pid_t> children;
+    for (int32_t pe = 0; pe < MANY_PES; pe++) {
+        pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) {
+            loopback_domain dom;
+            int32_t ret = dom.attach(name, pe, MANY_PES, HEAP_SIZE, TIMEOUT_MS);
+            _exit(ret != SHMEM_SUCCESS ? 100 : (run_pe(dom) == 0 ? 0 : 1));
+        }
+        children.push_back(pid);
+    }
+    for (int32_t pe = 0; pe < MANY_PES; pe++) {
+        int status = 0;
+        ASSERT_EQ(waitpid(children[pe], &status, 0), children[pe]);
+        EXPECT_TRUE(WIFEXITED(status)) << "pe " << pe;
+        EXPECT_EQ(WEXITSTATUS(status), 0) << "pe " << pe;
+    }
+}
+
+TEST(TestLoopbackDomain, SymmetricTranslation)
+{
+    std::vector<int32_t> results;
+    run_threads(unique_name("ptr"), 2, [](loopback_domain &dom) {
+        int32_t failures = 0;
+        uint8_t *heap = dom.heap(dom.my_pe());
+        uint64_t size = dom.heap_size();
+        failures += dom.ptr(heap + 16, 1 - dom.my_pe()) == dom.heap(1 - dom.my_pe()) + 16 ? 0 : 1;
+        failures += dom.ptr(heap + size, 0) == nullptr ? 0 : 1;
+        failures += dom.ptr(heap + size - 8, 0, 16) == nullptr ? 0 : 1;
+        failures += dom.ptr(heap, 2) == nullptr ? 0 : 1;
+        failures += dom.ptr(heap - 1, 0) == nullptr ? 0 : 1;
+        uint64_t local = 0;
+        failures += dom.put(&local, &local, sizeof(local), 0) == SHMEM_INVALID_PARAM ? 0 : 1;
+        uint64_t old = 0;
+        failures += dom.fetch_add<uint64_t>(reinterpret_cast<uint64_t *>(heap + 4), 1, 0, &old) ==
+                    SHMEM_INVALID_PARAM ? 0 : 1;
+        failures += dom.barrier() == SHMEM_SUCCESS ? 0 : 1;
+        return failures;
+    }, results);
+    EXPECT_EQ(results[0], 0);
+    EXPECT_EQ(results[1], 0);
+}
+
+TEST(TestLoopbackDomain, AttachErrors)
+{
+    loopback_domain dom;
+    EXPECT_EQ(dom.attach("no_slash", 0, 1, HEAP_SIZE, TIMEOUT_MS), SHMEM_INVALID_PARAM);
+    EXPECT_EQ(dom.attach(unique_name("bad"), 2, 2, HEAP_SIZE, TIMEOUT_MS), SHMEM_INVALID_PARAM);
+    EXPECT_EQ(dom.attach(unique_name("bad"), 0, 1, 0, TIMEOUT_MS), SHMEM_INVALID_PARAM);
+    // PE 0 never shows up
+    EXPECT_EQ(dom.attach(unique_name("alone"), 1, 2, HEAP_SIZE, 50), SHMEM_INNER_ERROR);
+    EXPECT_FALSE(dom.attached());
+    EXPECT_EQ(dom.barrier(), SHMEM_NOT_INITED);
+
+    EXPECT_EQ(dom.attach(unique_name("single"), 0, 1, HEAP_SIZE, TIMEOUT_MS), SHMEM_SUCCESS);
+    EXPECT_EQ(dom.barrier(), SHMEM_SUCCESS);
+    EXPECT_EQ(dom.attach(unique_name("single"), 0, 1, HEAP_SIZE, TIMEOUT_MS), SHMEM_INVALID_PARAM);
+    dom.detach();
+    EXPECT_FALSE(dom.attached());
+}
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "roce_model.h"
+
+namespace roce_model {
+namespace {
+thread_local roce_model_nic *g_bound_nic = nullptr;
+thread_local uint32_t g_block_idx = 0;
+thread_local uint32_t g_block_num = 1;
+
+constexpr uint32_t SQ_DB_CMD = 0;        // HNS_ROCE_V2_SQ_DB
+constexpr uint32_t CQ_DB_CMD = 3;        // HNS_ROCE_V2_CQ_DB_PTR
+constexpr uint32_t DB_TAG_MASK = 0xFFFFFF;
+constexpr uint32_t SQ_PI_MASK = 0xFFFF;
+constexpr uint32_t CQ_CI_MASK = 0xFFFFFF;
+constexpr uint32_t CQN_BASE = 0x1000;
+}
+
+uint64_t current_meta_addr()
+{
+    return g_bound_nic->meta_addr();
+}
+
+int current_pe()
+{
+    return static_cast<int>(g_bound_nic->config().my_pe);
+}
+
+void current_mark_site(int32_t site, [[maybe_unused]] int32_t pe)
+{
+    g_bound_nic->mark_site(site);
+}
+
+void current_diag_record(int32_t cmp, [[maybe_unused]] int64_t observed, [[maybe_unused]] int32_t pe)
+{
+    g_bound_nic->record_diag(cmp);
+}
+
+uint32_t current_block_idx()
+{
+    return g_block_idx;
+}
+
+uint32_t current_block_num()
+{
+    return g_block_num;
+}
+
+struct roce_model_nic::qp_state {
+    uint32_t pe = 0;                      // remote PE of the connection
+    uint32_t index = 0;                   // entry in the QP context arrays, pe * qp_num + qp
+    std::unique_ptr<uint8_t[]> sq_buf;
+    std::unique_ptr<uint8_t[]> cq_buf;
+    alignas(64) uint32_t sq_head = 0;     // written by the device after each doorbell
+    alignas(64) uint32_t sq_tail = 0;     // written by the device when it retires WQEs
+    alignas(64) uint64_t sq_db = 0;
+    alignas(64) uint32_t cq_head = 0;     // written by the NIC, for inspection only
+    alignas(64) uint32_t cq_tail = 0;     // written by the device after polling
+    alignas(64) uint64_t cq_db = 0;
+    uint32_t consumed = 0;                // WQEs fetched by the NIC
+    uint32_t produced = 0;                // CQEs written by the NIC
+    uint64_t last_sq_db = 0;
+    uint64_t last_cq_db = 0;
+    bool in_error = false;
+    bool stalled = false;
+    std::atomic<uint32_t> error_idx{0};
+    std::atomic<uint8_t> error_status{0};
+    std::atomic<uint64_t> wqes{0};
+    std::atomic<uint64_t> cqes{0};
+    std::atomic<uint64_t> doorbells{0};
+    std::atomic<uint64_t> fenced{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> owner_errors{0};
+    std::atomic<uint64_t> doorbell_errors{0};
+    std::atomic<uint64_t> sq_overruns{0};
+    std::atomic<uint64_t> cq_full_stalls{0};
+};
+
+roce_model_nic::roce_model_nic(const roce_model_config &config) : config_(config)
+{
+    uint32_t qp_count = config_.n_pes * config_.qp_num;
+    meta_.reset(new uint8_t[SMEM_SHM_DEVICE_GLOBAL_META_SIZE + sizeof(SHMEMHybmDeviceMeta)]());
+    heaps_.reset(new uint8_t[config_.heap_size * config_.n_pes]());
+    qps_.reset(new qp_state[qp_count]);
+    sq_ctx_.resize(qp_count);
+    cq_ctx_.resize(qp_count);
+    mem_info_.resize(config_.n_pes);
+
+    for (uint32_t pe = 0; pe < config_.n_pes; pe++) {
+        mem_info_[pe].size = config_.heap_size;
+        mem_info_[pe].addr = reinterpret_cast<uint64_t>(heap(pe));
+        mem_info_[pe].lkey = ROCE_MODEL_KEY_BASE + pe * 2;
+        mem_info_[pe].rkey = ROCE_MODEL_KEY_BASE + pe * 2 + 1;
+    }
+    for (uint32_t i = 0; i < qp_count; i++) {
+        qp_state &qp = qps_[i];
+        qp.pe = i / config_.qp_num;
+        qp.index = i;
+        qp.sq_buf.reset(new uint8_t[(uint64_t)config_.sq_depth * ROCE_MODEL_WQE_SIZE]());
+        qp.cq_buf.reset(new uint8_t[(uint64_t)config_.cq_depth * sizeof(SHMEMcqeCtx)]());
+
+        SHMEMWQCtx &sq = sq_ctx_[i];
+        sq.wqn = i + 1;
+        sq.bufAddr = reinterpret_cast<uint64_t>(qp.sq_buf.get());
+        sq.wqeSize = ROCE_MODEL_WQE_SIZE;
+        sq.depth = config_.sq_depth;
+        sq.headAddr = reinterpret_cast<uint64_t>(&qp.sq_head);
+        sq.tailAddr = reinterpret_cast<uint64_t>(&qp.sq_tail);
+        sq.dbMode = SHMEMDBMode::HW_DB;
+        sq.dbAddr = reinterpret_cast<uint64_t>(&qp.sq_db);
+        sq.sl = 0;
+
+        SHMEMCQCtx &cq = cq_ctx_[i];
+        cq.cqn = CQN_BASE + i;
+        cq.bufAddr = reinterpret_cast<uint64_t>(qp.cq_buf.get());
+        cq.cqeSize = sizeof(SHMEMcqeCtx);
+        cq.depth = config_.cq_depth;
+        cq.headAddr = reinterpret_cast<uint64_t>(&qp.cq_head);
+        cq.tailAddr = reinterpret_cast<uint64_t>(&qp.cq_tail);
+        cq.dbMode = config_.cq_db_mode;
+        cq.dbAddr = reinterpret_cast<uint64_t>(&qp.cq_db);
+    }
+
+    rdma_info_.qpNum = config_.qp_num;
+    rdma_info_.sqPtr = reinterpret_cast<uint64_t>(sq_ctx_.data());
+    rdma_info_.rqPtr = 0;
+    rdma_info_.scqPtr = reinterpret_cast<uint64_t>(cq_ctx_.data());
+    rdma_info_.rcqPtr = 0;
+    rdma_info_.memPtr = reinterpret_cast<uint64_t>(mem_info_.data());
+
+    auto meta = reinterpret_cast<SHMEMHybmDeviceMeta *>(meta_.get() + SMEM_SHM_DEVICE_GLOBAL_META_SIZE);
+    meta->rankId = config_.my_pe;
+    meta->rankSize = config_.n_pes;
+    meta->symmetricSize = config_.heap_size;
+    meta->qpInfoAddress = reinterpret_cast<uint64_t>(&rdma_info_);
+}
+
+roce_model_nic::~roce_model_nic()
+{
+    stop();
+}
+
+void roce_model_nic::start()
+{
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread(&roce_model_nic::nic_loop, this);
+}
+
+void roce_model_nic::stop()
+{
+    if (!running_.exchange(false)) {
+        return;
+    }
+    thread_.join();
+}
+
+void roce_model_nic::pause()
+{
+    paused_.store(true);
+}
+
+void roce_model_nic::resume()
+{
+    paused_.store(false);
+}
+
+void roce_model_nic::bind(uint32_t core_idx, uint32_t core_num)
+{
+    g_bound_nic = this;
+    g_block_idx = core_idx;
+    g_block_num = core_num;
+}
+
+void roce_model_nic::inject_error(uint32_t pe, uint32_t qp, uint32_t wqe_idx, uint8_t status)
+{
+    qp_state &state = qps_[pe * config_.qp_num + qp];
+    state.error_idx.store(wqe_idx, std::memory_order_relaxed);
+    state.error_status.store(status, std::memory_order_release);
+}
+
+uint8_t *roce_model_nic::heap(uint32_t pe) const
+{
+    return heaps_.get() + config_.heap_size * pe;
+}
+
+uint32_t roce_model_nic::sq_head(uint32_t pe, uint32_t qp) const
+{
+    return __atomic_load_n(&qps_[pe * config_.qp_num + qp].sq_head, __ATOMIC_ACQUIRE);
+}
+
+uint32_t roce_model_nic::sq_tail(uint32_t pe, uint32_t qp) const
+{
+    return __atomic_load_n(&qps_[pe * config_.qp_num + qp].sq_tail, __ATOMIC_ACQUIRE);
+}
+
+int32_t roce_model_nic::last_site() const
+{
+    return site_.load(std::memory_order_relaxed);
+}
+
+int32_t roce_model_nic::last_diag() const
+{
+    return diag_.load(std::memory_order_relaxed);
+}
+
+roce_model_stats roce_model_nic::stats() const
+{
+    roce_model_stats total = {};
+    for (uint32_t i = 0; i < config_.n_pes * config_.qp_num; i++) {
+        const qp_state &qp = qps_[i];
+        total.wqes += qp.wqes.load();
+        total.cqes += qp.cqes.load();
+        total.doorbells += qp.doorbells.load();
+        total.fenced += qp.fenced.load();
+        total.bytes += qp.bytes.load();
+        total.owner_errors += qp.owner_errors.load();
+        total.doorbell_errors += qp.doorbell_errors.load();
+        total.sq_overruns += qp.sq_overruns.load();
+        total.cq_full_stalls += qp.cq_full_stalls.load();
+    }
+    return total;
+}
+
+void roce_model_nic::nic_loop()
+{
+    uint32_t qp_count = config_.n_pes * config_.qp_num;
+    while (running_.load(std::memory_order_relaxed)) {
+        bool busy = false;
+        for (uint32_t i = 0; i < qp_count; i++) {
+            busy = progress(qps_[i]) || busy;
+        }
+        if (!busy) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+uint32_t roce_model_nic::cq_consumer(qp_state &qp)
+{
+    const SHMEMCQCtx &ctx = cq_ctx_[qp.index];
+    if (ctx.dbMode == SHMEMDBMode::SW_DB) {
+        return __atomic_load_n(reinterpret_cast<const uint32_t *>(&qp.cq_db), __ATOMIC_ACQUIRE) & CQ_CI_MASK;
+    }
+    uint64_t db = __atomic_load_n(&qp.cq_db, __ATOMIC_ACQUIRE);
+    if (db != qp.last_cq_db) {
+        qp.last_cq_db = db;
+        if ((db & DB_TAG_MASK) != ctx.cqn || ((db >> 24) & 0xF) != CQ_DB_CMD) {
+            qp.doorbell_errors++;
+        }
+    }
+    return (db >> 32) & CQ_CI_MASK;
+}
+
+bool roce_model_nic::in_region(uint32_t pe, uint64_t addr, uint64_t len) const
+{
+    const SHMEMmemInfo &mr = mem_info_[pe];
+    return addr >= mr.addr && len <= mr.size && addr - mr.addr <= mr.size - len;
+}
+
+uint8_t roce_model_nic::execute(qp_state &qp, const SHMEMwqeCtx &wqe, const SHMEMsegCtx &sge)
+{
+    auto opcode = static_cast<SHMEMAIVOPCODE>(wqe.byte4 & 0x1F);
+    if ((opcode != SHMEMAIVOPCODE::OP_RDMA_WRITE && opcode != SHMEMAIVOPCODE::OP_RDMA_READ) ||
+        (wqe.byte16 >> 24) != 1 || sge.len != wqe.msgLen) {
+        return ROCE_MODEL_STATUS_LOC_QP_OP_ERR;
+    }
+    if (sge.lkey != mem_info_[config_.my_pe].lkey || !in_region(config_.my_pe, sge.addr, sge.len)) {
+        return ROCE_MODEL_STATUS_LOC_PROT_ERR;
+    }
+    if (wqe.rkey != mem_info_[qp.pe].rkey || !in_region(qp.pe, wqe.va, sge.len)) {
+        return ROCE_MODEL_STATUS_REM_ACCESS_ERR;
+    }
+    return ROCE_MODEL_STATUS_SUCCESS;
+}
+
+void roce_model_nic::write_cqe(qp_state &qp, uint32_t wqe_idx, uint8_t status)
+{
+    const SHMEMCQCtx &ctx = cq_ctx_[qp.index];
+    auto cqe = reinterpret_cast<SHMEMcqeCtx *>(qp.cq_buf.get() + ctx.cqeSize * (qp.produced & (ctx.depth - 1)));
+    cqe->immtdata = 0;
+    cqe->byte12 = 0;
+    cqe->byte16 = sq_ctx_[qp.index].wqn & DB_TAG_MASK;
+    uint32_t owner = (qp.produced & ctx.depth) != 0 ? 0 : 1;
+    uint32_t byte4 = (owner << 7) | ((uint32_t)status << 8) | ((wqe_idx & SQ_PI_MASK) << 16);
+    __atomic_store_n(&cqe->byte4, byte4, __ATOMIC_RELEASE);
+    qp.produced++;
+    __atomic_store_n(&qp.cq_head, qp.produced, __ATOMIC_RELEASE);
+    qp.cqes++;
+}
+
+bool roce_model_nic::progress(qp_state &qp)
+{
+    const SHMEMWQCtx &ctx = sq_ctx_[qp.index];
+    uint64_t db = __atomic_load_n(&qp.sq_db, __ATOMIC_ACQUIRE);
+    uint32_t pi = (db >> 32) & SQ_PI_MASK;
+    if (db != qp.last_sq_db) {
+        qp.last_sq_db = db;
+        qp.doorbells++;
+        if ((db & DB_TAG_MASK) != ctx.wqn || ((db >> 24) & 0xF) != SQ_DB_CMD || ((db >> 48) & 0x7) != ctx.sl) {
+            qp.doorbell_errors++;
+        }
+        if (((pi - qp.consumed) & SQ_PI_MASK) > ctx.depth) {
+            qp.sq_overruns++;
+        }
+    }
+
+    bool busy = false;
+    while ((qp.consumed & SQ_PI_MASK) != pi) {
+        if (paused_.load(std::memory_order_relaxed)) {
+            return busy;
+        }
+        auto slot = reinterpret_cast<const uint8_t *>(ctx.bufAddr) + ctx.wqeSize * (qp.consumed & (ctx.depth - 1));
+        SHMEMwqeCtx wqe;
+        SHMEMsegCtx sge;
+        memcpy(&wqe, slot, sizeof(wqe));
+        memcpy(&sge, slot + sizeof(wqe), sizeof(sge));
+
+        uint8_t status = ROCE_MODEL_STATUS_SUCCESS;
+        if (qp.in_error) {
+            status = ROCE_MODEL_STATUS_WR_FLUSH_ERR;
+        } else if (qp.error_status.load(std::memory_order_acquire) != 0 &&
+                   qp.error_idx.load(std::memory_order_relaxed) == qp.consumed) {
+            status = qp.error_status.load(std::memory_order_relaxed);
+        } else {
+            status = execute(qp, wqe, sge);
+        }
+        bool signaled = (wqe.byte4 & (1 << 8)) != 0;
+        if ((signaled || status != ROCE_MODEL_STATUS_SUCCESS) &&
+            ((qp.produced - cq_consumer(qp)) & CQ_CI_MASK) >= cq_ctx_[qp.index].depth) {
+            if (!qp.stalled) {
+                qp.stalled = true;
+                qp.cq_full_stalls++;
+            }
+            return busy;
+        }
+        qp.stalled = false;
+
+        uint32_t expect_owner = ((qp.consumed / ctx.depth) & 1) ^ 1;
+        if (((wqe.byte4 >> 7) & 1) != expect_owner) {
+            qp.owner_errors++;
+        }
+        if ((wqe.byte4 & (1 << 9)) != 0) {
+            qp.fenced++;
+        }
+        if (status == ROCE_MODEL_STATUS_SUCCESS) {
+            if (static_cast<SHMEMAIVOPCODE>(wqe.byte4 & 0x1F) == SHMEMAIVOPCODE::OP_RDMA_WRITE) {
+                memmove(reinterpret_cast<void *>(wqe.va), reinterpret_cast<const void *>(sge.addr), sge.len);
+            } else {
+                memmove(reinterpret_cast<void *>(sge.addr), reinterpret_cast<const void *>(wqe.va), sge.len);
+            }
+            qp.bytes += sge.len;
+        } else {
+            qp.in_error = true;
+        }
+        if (signaled || status != ROCE_MODEL_STATUS_SUCCESS) {
+            write_cqe(qp, qp.consumed, status);
+        }
+        qp.consumed++;
+        qp.wqes++;
+        busy = true;
+    }
+    return busy;
+}
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef ROCE_MODEL_H
+#define ROCE_MODEL_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "device/low_level/shmem_device_low_level_roce.h"
+
+namespace roce_model {
+// CQE status codes produced by the model, numbered after ibv_wc_status
+constexpr uint8_t ROCE_MODEL_STATUS_SUCCESS = 0;
+constexpr uint8_t ROCE_MODEL_STATUS_LOC_QP_OP_ERR = 2;
+constexpr uint8_t ROCE_MODEL_STATUS_LOC_PROT_ERR = 4;
+constexpr uint8_t ROCE_MODEL_STATUS_WR_FLUSH_ERR = 5;
+constexpr uint8_t ROCE_MODEL_STATUS_REM_ACCESS_ERR = 10;
+
+constexpr uint32_t ROCE_MODEL_WQE_SIZE = 64;
+constexpr uint32_t ROCE_MODEL_KEY_BASE = 0x100;
+
+struct roce_model_config {
+    uint32_t my_pe = 0;                              // PE whose send queues the bound device code posts to
+    uint32_t n_pes = 2;                              // number of PEs, every one backed by a local heap
+    uint32_t qp_num = 1;                             // QPs per peer
+    uint32_t sq_depth = 8192;                        // send queue depth, power of two up to 32768
+    uint32_t cq_depth = 8192;                        // completion queue depth, power of two, not below sq_depth
+    SHMEMDBMode cq_db_mode = SHMEMDBMode::HW_DB;     // how the device reports the CQ consumer index
+    uint64_t heap_size = 1024UL * 1024UL;            // bytes of memory region registered per PE
+};
+
+// Counters summed over every QP, all of them except wqes, cqes, doorbells and bytes flag a protocol violation
+struct roce_model_stats {
+    uint64_t wqes;             // WQEs consumed by the NIC
+    uint64_t cqes;             // CQEs produced, including error and flush CQEs
+    uint64_t doorbells;        // SQ doorbell writes observed with a new producer index
+    uint64_t fenced;           // WQEs carrying the fence flag
+    uint64_t bytes;            // payload bytes moved
+    uint64_t owner_errors;     // WQEs whose owner bit does not match the ring pass they were consumed in
+    uint64_t doorbell_errors;  // SQ or CQ doorbells with a wrong tag or command
+    uint64_t sq_overruns;      // doorbells that published more outstanding WQEs than the send queue holds
+    uint64_t cq_full_stalls;   // times the NIC waited for the device to free CQ entries
+};
+
+/**
+ * Loopback software NIC serving the SHMEMWQCtx/SHMEMCQCtx rings of one PE. It lays out the same meta area,
+ * QP contexts and memory region table that hybm publishes to the AIV, so the post and poll functions of
+ * shmem_device_low_level_roce.h run unchanged on a host thread bound with bind(). A NIC thread consumes WQEs
+ * up to the producer index of each SQ doorbell, copies the payload between the PE heaps and writes a CQE for
+ * every signaled WQE. WQEs of a QP execute in posting order, so fenced WQEs are trivially honoured.
+ */
+class roce_model_nic {
+public:
+    explicit roce_model_nic(const roce_model_config &config);
+    ~roce_model_nic();
+
+    roce_model_nic(const roce_model_nic &) = delete;
+    roce_model_nic &operator=(const roce_model_nic &) = delete;
+
+    void start();
+    void stop();
+    void pause();
+    void resume();
+
+    // Makes the calling thread act as vector core core_idx of core_num on my_pe
+    void bind(uint32_t core_idx = 0, uint32_t core_num = 1);
+
+    // The WQE of send queue (pe, qp) with producer index wqe_idx completes with status, the QP then flushes
+    void inject_error(uint32_t pe, uint32_t qp, uint32_t wqe_idx, uint8_t status);
+
+    uint8_t *heap(uint32_t pe) const;
+    uint32_t sq_head(uint32_t pe, uint32_t qp) const;
+    uint32_t sq_tail(uint32_t pe, uint32_t qp) const;
+    int32_t last_site() const;
+    // cmp of the last wait diagnostic record written by the bound device code, 0 when none was written
+    int32_t last_diag() const;
+    roce_model_stats stats() const;
+    const roce_model_config &config() const
+    {
+        return config_;
+    }
+
+    uint64_t meta_addr() const
+    {
+        return reinterpret_cast<uint64_t>(meta_.get());
+    }
+
+    void mark_site(int32_t site)
+    {
+        site_.store(site, std::memory_order_relaxed);
+    }
+
+    void record_diag(int32_t cmp)
+    {
+        diag_.store(cmp, std::memory_order_relaxed);
+    }
+
+private:
+    struct qp_state;
+
+    void nic_loop();
+    bool progress(qp_state &qp);
+    uint8_t execute(qp_state &qp, const SHMEMwqeCtx &wqe, const SHMEMsegCtx &sge);
+    bool in_region(uint32_t pe, uint64_t addr, uint64_t len) const;
+    void write_cqe(qp_state &qp, uint32_t wqe_idx, uint8_t status);
+    uint32_t cq_consumer(qp_state &qp);
+
+    roce_model_config config_;
+    std::unique_ptr<uint8_t[]> meta_;
+    std::unique_ptr<uint8_t[]> heaps_;
+    std::unique_ptr<qp_state[]> qps_;
+    std::vector<SHMEMWQCtx> sq_ctx_;
+    std::vector<SHMEMCQCtx> cq_ctx_;
+    std::vector<SHMEMmemInfo> mem_info_;
+    SHMEMAIVRDMAInfo rdma_info_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> paused_{false};
+    std::atomic<int32_t> site_{SHMEMI_SITE_IDLE};
+    std::atomic<int32_t> diag_{0};
+};
+}
+
+#endif
@@ -0,0 +1,533 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "roce_model.h"
+
+using namespace roce_model;
+
+namespace {
+constexpr uint32_t PEER = 1;
+
+void fill_pattern(uint8_t *buf, uint64_t len, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    for (uint64_t i = 0; i < len; i++) {
+        buf[i] = static_cast<uint8_t>(rng());
+    }
+}
+
+void expect_clean(const roce_model_stats &stats)
+{
+    EXPECT_EQ(stats.owner_errors, 0U);
+    EXPECT_EQ(stats.doorbell_errors, 0U);
+    EXPECT_EQ(stats.sq_overruns, 0U);
+}
+}
+
+class TestRoceModel : public testing::Test {
+protected:
+    void start_nic(const roce_model_config &config)
+    {
+        nic_.reset(new roce_model_nic(config));
+        nic_->bind();
+        nic_->start();
+    }
+
+    void TearDown() override
+    {
+        nic_.reset();
+    }
+
+    std::unique_ptr<roce_model_nic> nic_;
+    AscendC::LocalTensor<uint64_t> ub64_;
+    AscendC::LocalTensor<uint32_t> ub32_;
+};
+
+TEST_F(TestRoceModel, WriteReadLoopback)
+{
+    start_nic(roce_model_config());
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+    const uint64_t len = 4096;
+    fill_pattern(local, len, 1);
+
+    shmemi_roce_write(remote + 256, local, PEER, 0, len, ub64_, ub32_);
+    shmemi_roce_quiet(PEER, 0, ub64_, ub32_);
+    EXPECT_EQ(memcmp(remote + 256, local, len), 0);
+
+    shmemi_roce_read(local + 2 * len, remote + 256, PEER, 0, len, ub64_, ub32_);
+    shmemi_roce_quiet(PEER, 0, ub64_, ub32_);
+    EXPECT_EQ(memcmp(local + 2 * len, local, len), 0);
+
+    roce_model_stats stats = nic_->stats();
+    EXPECT_EQ(stats.wqes, 2U);
+    EXPECT_EQ(stats.cqes, 2U);
+    EXPECT_EQ(stats.bytes, 2 * len);
+    EXPECT_EQ(nic_->sq_head(PEER, 0), 2U);
+    EXPECT_EQ(nic_->sq_tail(PEER, 0), 2U);
+    expect_clean(stats);
+}
+
+TEST_F(TestRoceModel, BatchWrapsSendQueueAndProducerIndex)
+{
+    roce_model_config config;
+    start_nic(config);
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+    // three rounds post more WQEs than the 16 bit doorbell producer index holds
+    const uint32_t count = 3 * config.sq_depth + 77;
+    const uint64_t msg = 8;
+    const uint32_t rounds = 3;
+    fill_pattern(local, count * msg, 2);
+
+    for (uint32_t round = 0; round < rounds; round++) {
+        memset(remote, 0, count * msg);
+        shmemi_roce_write_batch(remote, local, PEER, 0, msg, count, msg, msg, SHMEM_ROCE_SIGNAL_INTERVAL,
+                                ub64_, ub32_);
+        shmemi_roce_quiet(PEER, 0, ub64_, ub32_);
+        ASSERT_EQ(memcmp(remote, local, count * msg), 0) << "round " << round;
+    }
+
+    roce_model_stats stats = nic_->stats();
+    EXPECT_EQ(stats.wqes, (uint64_t)count * rounds);
+    EXPECT_LT(stats.cqes, stats.wqes / (SHMEM_ROCE_SIGNAL_INTERVAL / 2));
+    EXPECT_EQ(nic_->sq_head(PEER, 0), count * rounds);
+    EXPECT_EQ(nic_->sq_tail(PEER, 0), count * rounds);
+    expect_clean(stats);
+}
+
+class TestRoceModelCqDoorbell : public TestRoceModel, public testing::WithParamInterface<SHMEMDBMode> {
+};
+
+TEST_P(TestRoceModelCqDoorbell, CompletionQueueWraps)
+{
+    roce_model_config config;
+    config.cq_db_mode = GetParam();
+    start_nic(config);
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+    // every WQE is signaled, so the CQ wraps twice and the device reaps it each time the SQ fills up
+    const uint32_t count = 2 * config.cq_depth + 3000;
+    const uint64_t msg = 16;
+    fill_pattern(local, count * msg, 3);
+
+    for (uint32_t i = 0; i < count; i++) {
+        shmemi_roce_write(remote + i * msg, local + i * msg, PEER, 0, msg, ub64_, ub32_);
+    }
+    shmemi_roce_quiet(PEER, 0, ub64_, ub32_);
+    EXPECT_EQ(memcmp(remote, local, count * msg), 0);
+
+    roce_model_stats stats = nic_->stats();
+    EXPECT_EQ(stats.cqes, count);
+    EXPECT_EQ(stats.cq_full_stalls, 0U);
+    expect_clean(stats);
+}
+
+INSTANTIATE_TEST_SUITE_P(DoorbellModes, TestRoceModelCqDoorbell,
+                         testing::Values(SHMEMDBMode::HW_DB, SHMEMDBMode::SW_DB));
+
+TEST_F(TestRoceModel, PutSignalFencesSignalBehindPayload)
+{
+    start_nic(roce_model_config());
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+    const uint64_t len = 1024;
+    const uint64_t sig_offset = 64 * 1024;
+    fill_pattern(local, len, 4);
+    *(int32_t *)(local + sig_offset) = 7;
+
+    uint32_t sig_idx = shmemi_rdma_post_write_signal(remote, local, len, remote + sig_offset, local + sig_offset,
+                                                     PEER, 0, ub64_, ub32_);
+    EXPECT_EQ(sig_idx, 1U);
+    EXPECT_EQ(shmemi_roce_poll_cq(PEER, 0, sig_idx + 1, ub64_, ub32_), 0U);
+    EXPECT_EQ(memcmp(remote, local, len), 0);
+    EXPECT_EQ(*(int32_t *)(remote + sig_offset), 7);
+
+    roce_model_stats stats = nic_->stats();
+    EXPECT_EQ(stats.wqes, 2U);
+    EXPECT_EQ(stats.cqes, 1U);
+    EXPECT_EQ(stats.fenced, 1U);
+    expect_clean(stats);
+}
+
+TEST_F(TestRoceModel, PutSignalNbiReapsStagingSlotOnRingWrap)
+{
+    start_nic(roce_model_config());
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+    uint8_t *ring = local + 128 * 1024;
+    const uint64_t msg = 64;
+    const uint64_t sig_offset = 64 * 1024;
+    const uint32_t usable = SHMEM_ROCE_SIGNAL_SLOTS - 1;
+    const uint32_t count = 3 * usable;
+    fill_pattern(local, msg * count, 11);
+
+    // every usable slot stays busy while the NIC is paused, the next post has to reap the oldest one
+    nic_->pause();
+    std::thread device([&]() {
+        nic_->bind();
+        AscendC::LocalTensor<uint64_t> ub64;
+        AscendC::LocalTensor<uint32_t> ub32;
+        for (uint32_t i = 0; i < count; i++) {
+            shmemi_roce_put_signal_staged(ring, remote + i * msg, local + i * msg, msg,
+                                          remote + sig_offset + i * sizeof(int32_t), (int32_t)(i + 1), PEER, 0,
+                                          false, ub64, ub32);
+        }
+        shmemi_roce_quiet(PEER, 0, ub64, ub32);
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ((nic_->sq_head(PEER, 0) != 2 * usable || nic_->last_site() != SHMEMI_SITE_ROCE_QUIET) &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(nic_->sq_head(PEER, 0), 2 * usable);
+    EXPECT_EQ(nic_->last_site(), SHMEMI_SITE_ROCE_QUIET);
+
+    nic_->resume();
+    device.join();
+    EXPECT_EQ(*(uint32_t *)ring, count);
+    // a slot rewritten before its signal WQE read it would land a later signal value here
+    for (uint32_t i = 0; i < count; i++) {
+        EXPECT_EQ(*(int32_t *)(remote + sig_offset + i * sizeof(int32_t)), (int32_t)(i + 1)) << "signal " << i;
+    }
+    EXPECT_EQ(memcmp(remote, local, msg * count), 0);
+    for (uint32_t slot = 1; slot < SHMEM_ROCE_SIGNAL_SLOTS; slot++) {
+        EXPECT_EQ(*(uint32_t *)(ring + slot * SHMEMI_SYNCBIT_SIZE + SHMEMI_ROCE_SIG_BUSY_OFFSET), 1U);
+    }
+    EXPECT_EQ(nic_->sq_tail(PEER, 0), 2 * count);
+    EXPECT_EQ(nic_->stats().cqes, count);
+    expect_clean(nic_->stats());
+}
+
+TEST_F(TestRoceModel, ErrorCompletionIsReported)
+{
+    roce_model_config config;
+    start_nic(config);
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+    const uint64_t msg = 64;
+    fill_pattern(local, 8 * msg, 5);
+
+    nic_->inject_error(PEER, 0, 3, ROCE_MODEL_STATUS_REM_ACCESS_ERR);
+    for (uint32_t i = 0; i < 6; i++) {
+        shmemi_roce_write(remote + i * msg, local + i * msg, PEER, 0, msg, ub64_, ub32_);
+    }
+    EXPECT_EQ(shmemi_roce_poll_cq(PEER, 0, nic_->sq_head(PEER, 0), ub64_, ub32_), ROCE_MODEL_STATUS_REM_ACCESS_ERR);
+    EXPECT_EQ(memcmp(remote, local, 3 * msg), 0);
+    std::vector<uint8_t> zero(3 * msg, 0);
+    EXPECT_EQ(memcmp(remote + 3 * msg, zero.data(), zero.size()), 0);
+}
+
+TEST_F(TestRoceModel, QuietOwnedLeavesQpsOfOtherCores)
+{
+    roce_model_config config;
+    config.qp_num = 4;
+    start_nic(config);
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+    const uint64_t len = 2 * SHMEM_ROCE_STRIPE_MIN_BYTES;
+    fill_pattern(local, len, 13);
+
+    // core 1 of 2 stripes over QPs 1 and 3, core 0 owns QPs 0 and 2 and must not reap the others
+    nic_->bind(1, 2);
+    ASSERT_EQ(shmemi_roce_write_striped(remote, local, PEER, len, ub64_, ub32_), 0U);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (nic_->stats().cqes != 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    nic_->bind(0, 2);
+    shmemi_roce_quiet_owned(PEER, ub64_, ub32_);
+    EXPECT_EQ(nic_->sq_head(PEER, 1), 1U);
+    EXPECT_EQ(nic_->sq_head(PEER, 3), 1U);
+    EXPECT_EQ(nic_->sq_tail(PEER, 1), 0U);
+    EXPECT_EQ(nic_->sq_tail(PEER, 3), 0U);
+
+    nic_->bind(1, 2);
+    shmemi_roce_quiet_owned(PEER, ub64_, ub32_);
+    EXPECT_EQ(nic_->sq_tail(PEER, 1), 1U);
+    EXPECT_EQ(nic_->sq_tail(PEER, 3), 1U);
+    EXPECT_EQ(memcmp(remote, local, len), 0);
+    expect_clean(nic_->stats());
+}
+
+TEST_F(TestRoceModel, BatchReturnsErrorMetWhileWaitingForCredits)
+{
+    roce_model_config config;
+    start_nic(config);
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+    const uint64_t msg = 64;
+    uint32_t full = config.sq_depth - SHMEM_ROCE_SQ_RESERVED_WQE;
+    fill_pattern(local, msg, 9);
+
+    // the first WQE fails, so the batch finds the error while waiting for the credits of its second ring
+    nic_->inject_error(PEER, 0, 0, ROCE_MODEL_STATUS_REM_ACCESS_ERR);
+    EXPECT_EQ(shmemi_roce_write_batch(remote, local, PEER, 0, msg, full + 8, 0, 0, 1, ub64_, ub32_),
+              ROCE_MODEL_STATUS_REM_ACCESS_ERR);
+    EXPECT_EQ(nic_->sq_head(PEER, 0), full);
+    EXPECT_EQ(nic_->last_diag(), SHMEMX_DIAG_ERR_ROCE_QP);
+}
+
+TEST_F(TestRoceModel, WriteReportsErrorMetWhileWaitingForCredits)
+{
+    roce_model_config config;
+    start_nic(config);
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+    const uint64_t msg = 64;
+    uint32_t full = config.sq_depth - SHMEM_ROCE_SQ_RESERVED_WQE;
+    fill_pattern(local, msg, 11);
+
+    // the first WQE fails, the write that has to wait for credits finds the error and drops its WQE
+    nic_->inject_error(PEER, 0, 0, ROCE_MODEL_STATUS_REM_ACCESS_ERR);
+    for (uint32_t i = 0; i < full; i++) {
+        ASSERT_EQ(shmemi_roce_write(remote, local, PEER, 0, msg, ub64_, ub32_), 0U);
+    }
+    EXPECT_EQ(nic_->last_diag(), 0);
+    EXPECT_EQ(shmemi_roce_write(remote, local, PEER, 0, msg, ub64_, ub32_), ROCE_MODEL_STATUS_REM_ACCESS_ERR);
+    EXPECT_EQ(nic_->sq_head(PEER, 0), full);
+    EXPECT_EQ(nic_->last_diag(), SHMEMX_DIAG_ERR_ROCE_QP);
+}
+
+TEST_F(TestRoceModel, OutOfRegionWriteIsRejected)
+{
+    // a write running past the memory region of the peer fails on a healthy QP
+    roce_model_config config;
+    start_nic(config);
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+
+    shmemi_roce_write(remote + config.heap_size - 8, local, PEER, 0, 64, ub64_, ub32_);
+    EXPECT_EQ(shmemi_roce_poll_cq(PEER, 0, 1, ub64_, ub32_), ROCE_MODEL_STATUS_REM_ACCESS_ERR);
+    EXPECT_EQ(nic_->stats().bytes, 0U);
+}
+
+TEST_F(TestRoceModel, ReapRetiresOneWindowPerCall)
+{
+    start_nic(roce_model_config());
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+    const uint32_t count = 3 * SHMEM_ROCE_POLL_WINDOW + 5;
+    const uint64_t msg = 32;
+    fill_pattern(local, count * msg, 7);
+
+    uint32_t status = 0;
+    EXPECT_EQ(shmemi_roce_reap_cq(PEER, 0, 1, status, ub64_, ub32_), 0U);
+    shmemi_roce_write_batch(remote, local, PEER, 0, msg, count, msg, msg, 1, ub64_, ub32_);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (nic_->stats().cqes != count && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+
+    // every WQE is signaled, so each window retires exactly SHMEM_ROCE_POLL_WINDOW WQEs
+    EXPECT_EQ(shmemi_roce_reap_cq(PEER, 0, 1, status, ub64_, ub32_), SHMEM_ROCE_POLL_WINDOW);
+    EXPECT_EQ(status, 0U);
+    EXPECT_EQ(nic_->sq_tail(PEER, 0), SHMEM_ROCE_POLL_WINDOW);
+    EXPECT_EQ(shmemi_roce_reap_cq(PEER, 0, count, status, ub64_, ub32_), count - SHMEM_ROCE_POLL_WINDOW);
+    EXPECT_EQ(nic_->sq_tail(PEER, 0), count);
+    EXPECT_EQ(memcmp(remote, local, count * msg), 0);
+    expect_clean(nic_->stats());
+}
+
+TEST_F(TestRoceModel, PostWaitsForCompletionsWhenSendQueueIsFull)
+{
+    roce_model_config config;
+    start_nic(config);
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+    const uint64_t msg = 64;
+    const uint32_t count = config.sq_depth;
+    fill_pattern(local, msg, 6);
+
+    nic_->pause();
+    std::thread device([&]() {
+        nic_->bind();
+        AscendC::LocalTensor<uint64_t> ub64;
+        AscendC::LocalTensor<uint32_t> ub32;
+        for (uint32_t i = 0; i < count; i++) {
+            shmemi_roce_write(remote + (i % 64) * msg, local, PEER, 0, msg, ub64, ub32);
+        }
+        shmemi_roce_quiet(PEER, 0, ub64, ub32);
+    });
+
+    // the device stops posting once only the reserved WQEs are left and spins on the CQ
+    uint32_t full = config.sq_depth - SHMEM_ROCE_SQ_RESERVED_WQE;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ((nic_->sq_head(PEER, 0) != full || nic_->last_site() != SHMEMI_SITE_ROCE_QUIET) &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(nic_->sq_head(PEER, 0), full);
+    EXPECT_EQ(nic_->last_site(), SHMEMI_SITE_ROCE_QUIET);
+
+    nic_->resume();
+    device.join();
+    EXPECT_EQ(nic_->sq_head(PEER, 0), count);
+    EXPECT_EQ(nic_->sq_tail(PEER, 0), count);
+    EXPECT_EQ(nic_->last_site(), SHMEMI_SITE_IDLE);
+    EXPECT_EQ(nic_->stats().wqes, count);
+    expect_clean(nic_->stats());
+}
+
+TEST_F(TestRoceModel, MixedPostsStopAtSendQueueCredits)
+{
+    roce_model_config config;
+    start_nic(config);
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+    const uint64_t msg = 64;
+    const uint32_t sig_offset = 64 * 1024;
+    uint32_t full = config.sq_depth - SHMEM_ROCE_SQ_RESERVED_WQE;
+    fill_pattern(local, msg, 8);
+
+    // one credit short of a put with signal, then single posts behind it
+    nic_->pause();
+    std::thread device([&]() {
+        nic_->bind();
+        AscendC::LocalTensor<uint64_t> ub64;
+        AscendC::LocalTensor<uint32_t> ub32;
+        shmemi_rdma_post_send_batch(remote, local, PEER, 0, SHMEMAIVOPCODE::OP_RDMA_WRITE, msg, full - 1, 0, 0,
+                                    SHMEM_ROCE_SIGNAL_INTERVAL, ub64, ub32);
+        shmemi_rdma_post_write_signal(remote, local, msg, remote + sig_offset, local + sig_offset, PEER, 0,
+                                      ub64, ub32);
+        for (uint32_t i = 0; i < 4; i++) {
+            shmemi_roce_write(remote, local, PEER, 0, msg, ub64, ub32);
+        }
+        shmemi_roce_quiet(PEER, 0, ub64, ub32);
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (nic_->last_site() != SHMEMI_SITE_ROCE_QUIET && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(nic_->sq_head(PEER, 0), full - 1);
+
+    nic_->resume();
+    device.join();
+    EXPECT_EQ(nic_->sq_head(PEER, 0), full + 5);
+    EXPECT_EQ(nic_->sq_tail(PEER, 0), full + 5);
+    EXPECT_EQ(nic_->stats().wqes, full + 5);
+    expect_clean(nic_->stats());
+}
+
+TEST_F(TestRoceModel, FuzzRandomPostSequences)
+{
+    const uint64_t region = 256 * 1024;
+    const uint32_t iterations = 3000;
+    for (uint32_t seed = 1; seed <= 4; seed++) {
+        SCOPED_TRACE("seed " + std::to_string(seed));
+        roce_model_config config;
+        start_nic(config);
+        // local: [write sources][read destinations], remote: [write destinations][read sources]
+        uint8_t *src = nic_->heap(0);
+        uint8_t *read_dst = src + region;
+        uint8_t *dst = nic_->heap(PEER);
+        uint8_t *read_src = dst + region;
+        fill_pattern(src, region, seed);
+        fill_pattern(read_src, region, seed + 100);
+        std::vector<uint8_t> dst_shadow(region, 0);
+        std::vector<uint8_t> read_shadow(region, 0);
+
+        std::mt19937 rng(seed);
+        auto pick = [&rng](uint64_t bound) { return rng() % bound; };
+        for (uint32_t iter = 0; iter < iterations; iter++) {
+            switch (pick(5)) {
+                case 0: {
+                    uint64_t len = 1 + pick(4096);
+                    uint64_t from = pick(region - len);
+                    uint64_t to = pick(region - len);
+                    shmemi_roce_write(dst + to, src + from, PEER, 0, len, ub64_, ub32_);
+                    memcpy(dst_shadow.data() + to, src + from, len);
+                    break;
+                }
+                case 1: {
+                    uint64_t len = 1 + pick(4096);
+                    uint64_t from = pick(region - len);
+                    uint64_t to = pick(region - len);
+                    shmemi_roce_read(read_dst + to, read_src + from, PEER, 0, len, ub64_, ub32_);
+                    memcpy(read_shadow.data() + to, read_src + from, len);
+                    break;
+                }
+                case 2: {
+                    uint32_t count = 1 + pick(512);
+                    uint64_t len = 1 + pick(64);
+                    uint64_t dst_stride = len + pick(64);
+                    uint64_t src_stride = len + pick(64);
+                    uint64_t from = pick(region - (count - 1) * src_stride - len);
+                    uint64_t to = pick(region - (count - 1) * dst_stride - len);
+                    uint32_t interval = pick(33);
+                    shmemi_roce_write_batch(dst + to, src + from, PEER, 0, len, count, dst_stride, src_stride,
+                                            interval, ub64_, ub32_);
+                    for (uint32_t i = 0; i < count; i++) {
+                        memcpy(dst_shadow.data() + to + i * dst_stride, src + from + i * src_stride, len);
+                    }
+                    break;
+                }
+                case 3: {
+                    uint64_t len = 1 + pick(1024);
+                    uint64_t from = pick(region - len);
+                    uint64_t to = pick(region - len);
+                    uint64_t sig_from = pick(region / 4) * 4;
+                    uint64_t sig_to = pick(region / 4) * 4;
+                    shmemi_rdma_post_write_signal(dst + to, src + from, len, dst + sig_to, src + sig_from, PEER, 0,
+                                                  ub64_, ub32_);
+                    memcpy(dst_shadow.data() + to, src + from, len);
+                    memcpy(dst_shadow.data() + sig_to, src + sig_from, sizeof(int32_t));
+                    break;
+                }
+                default:
+                    shmemi_roce_quiet(PEER, 0, ub64_, ub32_);
+                    break;
+            }
+        }
+        shmemi_roce_quiet(PEER, 0, ub64_, ub32_);
+        EXPECT_EQ(memcmp(dst, dst_shadow.data(), region), 0);
+        EXPECT_EQ(memcmp(read_dst, read_shadow.data(), region), 0);
+        EXPECT_EQ(nic_->sq_tail(PEER, 0), nic_->sq_head(PEER, 0));
+        expect_clean(nic_->stats());
+    }
+}
+
+// every batch rings one doorbell, produces one CQE per signal interval and gets all of its credits back
+TEST_F(TestRoceModel, BatchCompletionsBySignalInterval)
+{
+    start_nic(roce_model_config());
+    uint8_t *local = nic_->heap(0);
+    uint8_t *remote = nic_->heap(PEER);
+    const uint32_t count = 4096;
+    const uint32_t batches = 4;
+    const uint64_t msg = 8;
+    uint64_t posted = 0;
+    for (uint32_t interval : {1U, 4U, 16U, 64U}) {
+        for (uint32_t i = 0; i < batches; i++) {
+            roce_model_stats before = nic_->stats();
+            ASSERT_EQ(shmemi_roce_write_batch(remote, local, PEER, 0, msg, count, msg, msg, interval, ub64_, ub32_),
+                      0U);
+            shmemi_roce_quiet(PEER, 0, ub64_, ub32_);
+            roce_model_stats after = nic_->stats();
+            posted += count;
+            EXPECT_EQ(after.wqes - before.wqes, count) << "interval " << interval;
+            EXPECT_EQ(after.cqes - before.cqes, count / interval) << "interval " << interval;
+            EXPECT_EQ(after.doorbells - before.doorbells, 1U) << "interval " << interval;
+            EXPECT_EQ(nic_->sq_tail(PEER, 0), nic_->sq_head(PEER, 0)) << "interval " << interval;
+        }
+    }
+    EXPECT_EQ(nic_->stats().wqes, posted);
+    expect_clean(nic_->stats());
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_DEVICE_COMMON_H
+#define SHMEMI_DEVICE_COMMON_H
+
+/*
+ * Host stand-in for the device common helpers used by shmem_device_low_level_roce.h. The meta area, the calling
+ * PE, the watchdog site and the wait diagnostic ring come from the roce_model_nic bound to the calling thread, see
+ * roce_model.h.
+ */
+#include "kernel_operator.h"
+#include "host_device/shmem_types.h"
+#include "internal/host_device/shmemi_types.h"
+
+namespace roce_model {
+uint64_t current_meta_addr();
+int current_pe();
+void current_mark_site(int32_t site, int32_t pe);
+void current_diag_record(int32_t cmp, int64_t observed, int32_t pe);
+}
+
+constexpr uint64_t SMEM_SHM_DEVICE_GLOBAL_META_SIZE = 128;
+#define SMEM_SHM_DEVICE_META_ADDR (roce_model::current_meta_addr())
+
+inline void dcci_cachelines([[maybe_unused]] __gm__ uint8_t *addr, [[maybe_unused]] uint64_t len)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+inline void dcci_cacheline([[maybe_unused]] __gm__ uint8_t *addr)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+SHMEM_DEVICE int shmemi_get_my_pe()
+{
+    return roce_model::current_pe();
+}
+
+SHMEM_DEVICE void shmemi_watchdog_mark(int32_t site, [[maybe_unused]] int32_t team, int32_t pe)
+{
+    roce_model::current_mark_site(site, pe);
+}
+
+SHMEM_DEVICE void shmemi_wait_diag_record([[maybe_unused]] __gm__ void *addr, int cmp, int64_t observed,
+                                          [[maybe_unused]] int64_t expected, [[maybe_unused]] int32_t team,
+                                          [[maybe_unused]] int32_t round, int32_t pe,
+                                          [[maybe_unused]] int64_t elapsed)
+{
+    roce_model::current_diag_record(cmp, observed, pe);
+}
+
+#define SHMEMI_TRACE_BEGIN(name)
+#define SHMEMI_TRACE_END(name, op, pe, bytes)
+
+#endif
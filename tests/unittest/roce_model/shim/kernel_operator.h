@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef ROCE_MODEL_KERNEL_OPERATOR_H
+#define ROCE_MODEL_KERNEL_OPERATOR_H
+
+/*
+ * Host stand-in for the part of the AscendC API used by shmem_device_low_level_roce.h. It shadows the real
+ * kernel_operator.h for the RoCE model test only, so the device ring logic is compiled unchanged for x86.
+ * GM is plain host memory, the UB tensors are small host arrays and every barrier is a full memory fence.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#define __aicore__
+#define __gm__
+
+enum pipe_t {
+    PIPE_ALL = 0,
+};
+
+namespace roce_model {
+uint32_t current_block_idx();
+uint32_t current_block_num();
+}
+
+namespace AscendC {
+constexpr uint32_t ROCE_MODEL_UB_ELEMENTS = 32;
+
+template <typename T>
+class LocalTensor {
+public:
+    void SetValue(uint32_t index, T value)
+    {
+        buf_[index % ROCE_MODEL_UB_ELEMENTS] = value;
+    }
+
+    T GetValue(uint32_t index) const
+    {
+        return buf_[index % ROCE_MODEL_UB_ELEMENTS];
+    }
+
+    const T *Data() const
+    {
+        return buf_;
+    }
+
+private:
+    T buf_[ROCE_MODEL_UB_ELEMENTS] = {};
+};
+
+template <typename T>
+class GlobalTensor {
+public:
+    void SetGlobalBuffer(T *addr)
+    {
+        addr_ = addr;
+    }
+
+    T *GetPhyAddr() const
+    {
+        return addr_;
+    }
+
+private:
+    T *addr_ = nullptr;
+};
+
+struct DataCopyExtParams {
+    uint16_t blockCount;
+    uint32_t blockLen;
+    uint32_t srcStride;
+    uint32_t dstStride;
+    uint32_t rsv;
+};
+
+template <pipe_t pipe>
+inline void PipeBarrier()
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+// Doorbells and head/tail words are single element copies, stored atomically so the NIC thread never sees a torn value
+template <typename T>
+inline void DataCopyPad(const GlobalTensor<T> &dst, const LocalTensor<T> &src, const DataCopyExtParams &params)
+{
+    if (params.blockCount == 1 && params.blockLen == sizeof(T)) {
+        __atomic_store_n(dst.GetPhyAddr(), src.GetValue(0), __ATOMIC_RELEASE);
+        return;
+    }
+    uint64_t len = (uint64_t)params.blockCount * params.blockLen;
+    uint64_t cap = (uint64_t)ROCE_MODEL_UB_ELEMENTS * sizeof(T);
+    memcpy(dst.GetPhyAddr(), src.Data(), len < cap ? len : cap);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+inline int64_t GetSystemCycle()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline uint32_t GetBlockIdx()
+{
+    return roce_model::current_block_idx();
+}
+
+inline uint32_t GetBlockNum()
+{
+    return roce_model::current_block_num();
+}
+
+inline uint32_t GetTaskRation()
+{
+    return 1;
+}
+}
+
+#endif